@@ -0,0 +1,390 @@
+// hinape_bench: scenario x size x SIMD level x thread count matrix over the public API.
+//
+//   hinape_bench [--scenario cloth,fluid,rigid] [--sizes cloth=1024,16384] [--threads 1,2,4|max]
+//                [--simd scalar,sse42,avx2,avx512|best]
+//                [--frames N] [--warmup N] [--quick] [--json out.json] [--csv out.csv]
+//                [--baseline base.json] [--threshold 0.10] [--threshold cloth=0.25]
+//
+// Every case prints one table row; --json / --csv write the same rows machine-readably. With
+// --baseline, each case's median frame time is compared to the baseline case of the same key and
+// the run fails (exit code 1) when it is slower by more than the scenario's threshold. Cases
+// missing on either side are listed but never fail the run. Exit code 2 means bad arguments or
+// unwritable output.
+#include "rphys/api_capability.h"
+#include "rphys/api_domain.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct bench_case {
+        std::string       scenario;
+        std::uint32_t     size{0}; // requested element count (vertices, particles, bodies)
+        rphys::simd_level simd{rphys::simd_level::automatic};
+        std::uint32_t     threads{1};
+    };
+
+    struct bench_result {
+        bench_case    c;
+        std::string   key;
+        std::uint32_t elements{0}; // actual count after rounding to the scene lattice
+        double        median_ms{0.0}, p90_ms{0.0}, min_ms{0.0}, mean_ms{0.0};
+        double        speedup{0.0}; // vs. the same case at one thread; 0 when not measured
+    };
+
+    struct options {
+        std::vector<std::string>                          scenarios{"cloth", "fluid", "rigid"};
+        std::map<std::string, std::vector<std::uint32_t>> sizes{{"cloth", {1024, 16384, 262144, 1048576}}, {"fluid", {1000, 8000, 64000}}, {"rigid", {64, 512, 4096}}};
+        std::vector<std::uint32_t>                        threads;
+        std::vector<rphys::simd_level>                    simd{rphys::simd_level::scalar, rphys::simd_level::sse42, rphys::simd_level::avx2, rphys::simd_level::avx512};
+        int                                               frames{30};
+        int                                               warmup{5};
+        std::string                                       json_path, csv_path, baseline_path;
+        double                                            threshold{0.10};
+        std::map<std::string, double>                     scenario_threshold;
+    };
+
+    const char* simd_label(rphys::simd_level l) {
+        switch (l) {
+            case rphys::simd_level::scalar: return "scalar";
+            case rphys::simd_level::sse42: return "sse42";
+            case rphys::simd_level::avx2: return "avx2";
+            case rphys::simd_level::avx512: return "avx512";
+            default: return "best";
+        }
+    }
+
+    std::vector<std::string> split(const std::string& s, char sep) {
+        std::vector<std::string> out;
+        std::stringstream        in(s);
+        for (std::string item; std::getline(in, item, sep);) {
+            if (!item.empty()) out.push_back(item);
+        }
+        return out;
+    }
+
+    bool parse_u32_list(const std::string& s, std::vector<std::uint32_t>& out) {
+        out.clear();
+        for (const auto& item : split(s, ',')) {
+            char*               end = nullptr;
+            const unsigned long v   = std::strtoul(item.c_str(), &end, 10);
+            if (*end != '\0' || v == 0 || v > 0xffffffffUL) return false;
+            out.push_back(static_cast<std::uint32_t>(v));
+        }
+        return !out.empty();
+    }
+
+    std::vector<std::uint32_t> default_threads() {
+        const std::uint32_t        hw = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<std::uint32_t> t;
+        for (std::uint32_t n = 1; n < hw; n *= 2) t.push_back(n);
+        t.push_back(hw);
+        return t;
+    }
+
+    bool parse_args(int argc, char** argv, options& o) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string a    = argv[i];
+            auto              next = [&](std::string& v) {
+                if (i + 1 >= argc) return false;
+                v = argv[++i];
+                return true;
+            };
+            std::string v;
+            if (a == "--quick") {
+                o.sizes   = {{"cloth", {1024}}, {"fluid", {1000}}, {"rigid", {64}}};
+                o.threads = {1, 2};
+                o.frames  = 3;
+                o.warmup  = 1;
+            } else if (a == "--scenario" && next(v)) {
+                o.scenarios = split(v, ',');
+            } else if (a == "--sizes" && next(v)) {
+                const auto eq = v.find('=');
+                if (eq == std::string::npos || !parse_u32_list(v.substr(eq + 1), o.sizes[v.substr(0, eq)])) return false;
+            } else if (a == "--threads" && next(v)) {
+                if (v == "max") o.threads = {std::max(1u, std::thread::hardware_concurrency())};
+                else if (!parse_u32_list(v, o.threads)) return false;
+            } else if (a == "--simd" && next(v)) {
+                o.simd.clear();
+                for (const auto& l : split(v, ',')) {
+                    if (l == "scalar") o.simd.push_back(rphys::simd_level::scalar);
+                    else if (l == "sse42") o.simd.push_back(rphys::simd_level::sse42);
+                    else if (l == "avx2") o.simd.push_back(rphys::simd_level::avx2);
+                    else if (l == "avx512") o.simd.push_back(rphys::simd_level::avx512);
+                    else if (l == "best") o.simd.push_back(rphys::simd_level::automatic);
+                    else return false;
+                }
+            } else if (a == "--frames" && next(v)) {
+                o.frames = std::atoi(v.c_str());
+            } else if (a == "--warmup" && next(v)) {
+                o.warmup = std::atoi(v.c_str());
+            } else if (a == "--json" && next(v)) {
+                o.json_path = v;
+            } else if (a == "--csv" && next(v)) {
+                o.csv_path = v;
+            } else if (a == "--baseline" && next(v)) {
+                o.baseline_path = v;
+            } else if (a == "--threshold" && next(v)) {
+                const auto eq = v.find('=');
+                if (eq == std::string::npos) o.threshold = std::atof(v.c_str());
+                else o.scenario_threshold[v.substr(0, eq)] = std::atof(v.c_str() + eq + 1);
+            } else {
+                return false;
+            }
+        }
+        if (o.threads.empty()) o.threads = default_threads();
+        return o.frames > 0 && o.warmup >= 0 && !o.simd.empty();
+    }
+
+    std::uint32_t lattice_side(std::uint32_t n, int dims) { return std::max(1u, static_cast<std::uint32_t>(std::lround(std::pow(static_cast<double>(n), 1.0 / dims)))); }
+
+    // Builds the scenario; returns the element count (0 on failure).
+    std::uint32_t build(rphys::world_id w, const bench_case& c) {
+        if (c.scenario == "cloth") {
+            const std::uint32_t side  = lattice_side(c.size, 2);
+            auto                cloth = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+            rphys::scene_primitive grid{};
+            grid.type          = rphys::scene_primitive_type::cloth_grid;
+            grid.resolution[0] = grid.resolution[1] = side;
+            grid.flags         = rphys::scene_pin_top_row;
+            return cloth.value && rphys::build_scene(w, cloth, {grid}) ? side * side : 0;
+        }
+        if (c.scenario == "fluid") {
+            const std::uint32_t side    = lattice_side(c.size, 3);
+            const float         spacing = 0.02f;
+            auto                fluid   = rphys::add_domain(w, rphys::domain_desc{0, "fluid"});
+            rphys::scene_primitive box{}, bounds{};
+            box.type = rphys::scene_primitive_type::particle_box;
+            box.extent[0] = box.extent[1] = box.extent[2] = spacing * static_cast<float>(side);
+            box.resolution[0] = box.resolution[1] = box.resolution[2] = side;
+            bounds.type      = rphys::scene_primitive_type::fluid_bounds;
+            bounds.extent[0] = bounds.extent[2] = 2.0f * spacing * static_cast<float>(side);
+            bounds.extent[1] = spacing * static_cast<float>(side);
+            return fluid.value && rphys::build_scene(w, fluid, {box, bounds}) ? side * side * side : 0;
+        }
+        if (c.scenario == "rigid") {
+            // Half the bodies are box columns, the other half a lattice of spheres dropped into the
+            // gaps between them, so every pair type (box-box, sphere-box, sphere-sphere) is exercised.
+            const std::uint32_t side  = lattice_side(std::max(c.size / 2, 1u), 3);
+            auto                rigid = rphys::add_domain(w, rphys::domain_desc{0, "rigid"});
+            rphys::scene_primitive boxes{}, spheres{};
+            boxes.type      = rphys::scene_primitive_type::rigid_box;
+            boxes.origin[1] = 0.1f;
+            boxes.extent[0] = boxes.extent[1] = boxes.extent[2] = 0.2f;
+            boxes.resolution[0] = boxes.resolution[1] = boxes.resolution[2] = side;
+            spheres.type      = rphys::scene_primitive_type::rigid_sphere;
+            spheres.origin[0] = spheres.origin[2] = 0.11f;
+            spheres.origin[1] = 0.1f + 0.22f * static_cast<float>(side) + 0.2f;
+            spheres.extent[0] = 0.1f;
+            spheres.resolution[0] = spheres.resolution[1] = spheres.resolution[2] = side;
+            return rigid.value && rphys::build_scene(w, rigid, {boxes, spheres}) ? 2 * side * side * side : 0;
+        }
+        return 0;
+    }
+
+    std::string active_simd(rphys::world_id w) {
+        rphys::capability_record records[16];
+        const std::size_t        n = std::min<std::size_t>(rphys::list_perf_layers(w, records, 16), 16);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (std::strncmp(records[i].name, "simd:", 5) == 0) return records[i].name + 5;
+        }
+        return "scalar";
+    }
+
+    // Runs one case; false when the case does not apply here (e.g. SIMD level above the CPU's).
+    bool run_case(const bench_case& c, const options& o, bench_result& r) {
+        rphys::world_desc wd{};
+        wd.threads = c.threads; // automatic scheduler on a pool of exactly this size
+        wd.simd    = c.simd;
+        auto w     = rphys::create_world(wd);
+        if (!w.value) return false;
+        const std::string simd = active_simd(w);
+        if (c.simd != rphys::simd_level::automatic && simd != simd_label(c.simd)) {
+            rphys::destroy_world(w);
+            return false;
+        }
+        r.c        = c;
+        r.elements = build(w, c);
+        if (!r.elements) {
+            rphys::destroy_world(w);
+            return false;
+        }
+        const double dt = 1.0 / 120.0;
+        for (int i = 0; i < o.warmup; ++i) rphys::step_world(w, dt);
+        std::vector<double> ms(static_cast<std::size_t>(o.frames));
+        for (double& m : ms) {
+            const auto start = std::chrono::steady_clock::now();
+            rphys::step_world(w, dt);
+            m = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        rphys::destroy_world(w);
+
+        std::sort(ms.begin(), ms.end());
+        r.median_ms = ms[ms.size() / 2];
+        r.p90_ms    = ms[std::min(ms.size() - 1, ms.size() * 9 / 10)];
+        r.min_ms    = ms.front();
+        double sum  = 0.0;
+        for (double m : ms) sum += m;
+        r.mean_ms = sum / static_cast<double>(ms.size());
+
+        std::ostringstream key;
+        key << c.scenario << "/n=" << r.elements;
+        if (c.scenario != "rigid") key << "/simd=" << (c.simd == rphys::simd_level::automatic ? "best:" + simd : simd);
+        key << "/threads=" << c.threads;
+        r.key = key.str();
+        return true;
+    }
+
+    std::vector<bench_case> expand(const options& o) {
+        std::vector<bench_case> cases;
+        for (const auto& s : o.scenarios) {
+            const auto sizes = o.sizes.find(s);
+            if (sizes == o.sizes.end()) continue;
+            // SIMD kernels cover cloth and fluid integration.
+            const std::vector<rphys::simd_level> levels = s == "rigid" ? std::vector<rphys::simd_level>{rphys::simd_level::automatic} : o.simd;
+            for (std::uint32_t n : sizes->second)
+                for (auto level : levels)
+                    for (std::uint32_t t : o.threads) cases.push_back(bench_case{s, n, level, t});
+        }
+        return cases;
+    }
+
+    void fill_speedups(std::vector<bench_result>& results) {
+        std::map<std::string, double> single;
+        auto base_key = [](const bench_result& r) { return r.key.substr(0, r.key.rfind("/threads=")); };
+        for (const auto& r : results) {
+            if (r.c.threads == 1) single[base_key(r)] = r.median_ms;
+        }
+        for (auto& r : results) {
+            const auto it = single.find(base_key(r));
+            if (it != single.end() && r.median_ms > 0.0) r.speedup = it->second / r.median_ms;
+        }
+    }
+
+    bool write_json(const std::string& path, const std::vector<bench_result>& results, const options& o) {
+        std::ofstream out(path);
+        if (!out) return false;
+        out << "{\"version\":1,\"hardware_threads\":" << std::thread::hardware_concurrency() << ",\"frames\":" << o.frames << ",\"warmup\":" << o.warmup << ",\"results\":[\n";
+        char buf[512];
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const bench_result& r = results[i];
+            // One result per line: the baseline reader relies on it.
+            std::snprintf(buf, sizeof(buf),
+                          "{\"case\":\"%s\",\"scenario\":\"%s\",\"elements\":%u,\"simd\":\"%s\",\"threads\":%u,"
+                          "\"median_ms\":%.6f,\"p90_ms\":%.6f,\"min_ms\":%.6f,\"mean_ms\":%.6f,\"speedup\":%.4f}%s\n",
+                          r.key.c_str(), r.c.scenario.c_str(), r.elements, simd_label(r.c.simd), r.c.threads, r.median_ms, r.p90_ms, r.min_ms,
+                          r.mean_ms, r.speedup, i + 1 < results.size() ? "," : "");
+            out << buf;
+        }
+        out << "]}\n";
+        return static_cast<bool>(out);
+    }
+
+    bool write_csv(const std::string& path, const std::vector<bench_result>& results) {
+        std::ofstream out(path);
+        if (!out) return false;
+        out << "case,scenario,elements,simd,threads,median_ms,p90_ms,min_ms,mean_ms,speedup\n";
+        for (const auto& r : results) {
+            out << r.key << ',' << r.c.scenario << ',' << r.elements << ',' << simd_label(r.c.simd) << ',' << r.c.threads << ','
+                << r.median_ms << ',' << r.p90_ms << ',' << r.min_ms << ',' << r.mean_ms << ',' << r.speedup << '\n';
+        }
+        return static_cast<bool>(out);
+    }
+
+    // Reads "case" -> median_ms from a file written by write_json.
+    bool read_baseline(const std::string& path, std::map<std::string, double>& out) {
+        std::ifstream in(path);
+        if (!in) return false;
+        for (std::string line; std::getline(in, line);) {
+            const auto k = line.find("\"case\":\"");
+            const auto m = line.find("\"median_ms\":");
+            if (k == std::string::npos || m == std::string::npos) continue;
+            const auto end = line.find('"', k + 8);
+            if (end == std::string::npos) continue;
+            out[line.substr(k + 8, end - k - 8)] = std::strtod(line.c_str() + m + 12, nullptr);
+        }
+        return true;
+    }
+
+    // Prints the comparison; returns the number of regressions.
+    int compare(const std::vector<bench_result>& results, const std::map<std::string, double>& baseline, const options& o) {
+        int regressions = 0;
+        std::cout << "\nbaseline comparison (median ms, default threshold " << o.threshold * 100.0 << "%)\n";
+        for (const auto& r : results) {
+            const auto it = baseline.find(r.key);
+            if (it == baseline.end()) {
+                std::cout << "  new      " << r.key << '\n';
+                continue;
+            }
+            const auto   t         = o.scenario_threshold.find(r.c.scenario);
+            const double threshold = t != o.scenario_threshold.end() ? t->second : o.threshold;
+            const double change    = it->second > 0.0 ? r.median_ms / it->second - 1.0 : 0.0;
+            const bool   regressed = change > threshold;
+            regressions += regressed ? 1 : 0;
+            char buf[64];
+            std::snprintf(buf, sizeof(buf), "%+7.1f%%", change * 100.0);
+            std::cout << (regressed ? "  REGRESS  " : "  ok       ") << r.key << "  " << it->second << " -> " << r.median_ms << " (" << buf << ")\n";
+        }
+        for (const auto& [key, ms] : baseline) {
+            const bool measured = std::any_of(results.begin(), results.end(), [&](const bench_result& r) { return r.key == key; });
+            if (!measured) std::cout << "  missing  " << key << '\n';
+        }
+        return regressions;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    options o;
+    if (!parse_args(argc, argv, o)) {
+        std::cerr << "usage: hinape_bench [--scenario list] [--sizes scenario=n,...] [--threads list|max] [--simd list]\n"
+                     "                    [--frames N] [--warmup N] [--quick] [--json path] [--csv path] [--baseline path]\n"
+                     "                    [--threshold fraction] [--threshold scenario=fraction]\n";
+        return 2;
+    }
+
+    std::vector<bench_result> results;
+    std::printf("%-56s %10s %10s %10s %8s\n", "case", "median_ms", "p90_ms", "min_ms", "Melem/s");
+    for (const bench_case& c : expand(o)) {
+        bench_result r;
+        if (!run_case(c, o, r)) continue;
+        std::printf("%-56s %10.3f %10.3f %10.3f %8.2f\n", r.key.c_str(), r.median_ms, r.p90_ms, r.min_ms, r.median_ms > 0.0 ? r.elements / (r.median_ms * 1e3) : 0.0);
+        std::fflush(stdout);
+        results.push_back(std::move(r));
+    }
+    fill_speedups(results);
+
+    if (!o.json_path.empty() && !write_json(o.json_path, results, o)) {
+        std::cerr << "cannot write " << o.json_path << '\n';
+        return 2;
+    }
+    if (!o.csv_path.empty() && !write_csv(o.csv_path, results)) {
+        std::cerr << "cannot write " << o.csv_path << '\n';
+        return 2;
+    }
+    if (!o.baseline_path.empty()) {
+        std::map<std::string, double> baseline;
+        if (!read_baseline(o.baseline_path, baseline)) {
+            std::cerr << "cannot read baseline " << o.baseline_path << '\n';
+            return 2;
+        }
+        const int regressions = compare(results, baseline, o);
+        if (regressions > 0) {
+            std::cout << regressions << " case(s) regressed\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -8,8 +8,12 @@ namespace rphys {
 
 struct capability_record { const char* name; };
 
+// Each call writes at most `capacity` records into `buffer` (may be null) and returns the number
+// of records available.
 std::size_t list_algorithms(world_id, capability_record* buffer, std::size_t capacity);
 std::size_t list_schedulers(world_id, capability_record* buffer, std::size_t capacity);
+// Perf layers of one world: "simd:<level>" (the world's active kernel set, see
+// world_desc::simd), then "cpu:<level>" (the best level this machine supports).
 std::size_t list_perf_layers(world_id, capability_record* buffer, std::size_t capacity);
 
 } // namespace rphys
@@ -2,13 +2,34 @@
 #define RPHYS_API_COMMANDS_H
 
 #include "forward.h"
+#include <cstdint>
 
 namespace rphys {
 
-struct command_desc { const char* name; };
+enum class command_kind : std::uint8_t {
+    set_param,   // name = parameter key, value[0] = new value
+    pin,         // domain + index: fix an element in place
+    unpin,       // domain + index: release a pinned element
+    impulse,     // domain + index: add value[0..2] to the element's velocity (scaled by inverse mass)
+    field_patch  // domain + name + index: overwrite one element of a writable field with value[]
+};
+
+// Fixed-size command; `name` is copied on enqueue (at most command_name_capacity - 1 chars).
+struct command_desc {
+    const char*   name{nullptr};
+    command_kind  kind{command_kind::set_param};
+    domain_id     domain{};
+    std::uint32_t index{0};
+    double        value[4]{};
+};
+
+constexpr std::size_t command_name_capacity = 48;
+
+// Non-blocking and safe from any thread. Commands are applied in one batch at the start of the
+// next step, in enqueue order. Returns false if the world is invalid, the name is too long or the
+// world's command queue is full (the command is dropped and counted in frame_stats).
 bool enqueue_command(world_id, const command_desc&);
 
 } // namespace rphys
 
 #endif // RPHYS_API_COMMANDS_H
-
@@ -2,12 +2,50 @@
 #define RPHYS_API_DOMAIN_H
 
 #include "forward.h"
+#include <cstdint>
 
 namespace rphys {
 
+// desc.type selects a built-in domain ("cloth", "fluid", "rigid"); returns id 0 when unknown.
 domain_id add_domain(world_id world, const domain_desc& desc);
+// Also removes couplings attached to the domain.
 void remove_domain(world_id world, domain_id domain);
 
+// Level of detail and sleeping (README "Activity & LOD"). A domain steps every
+// `interval` frames with the frames in between folded into its dt, where interval =
+// floor(1 / importance), lowered further by near_distance / distance when use_camera_distance is
+// set (camera position: params "lod.camera.x/y/z"), clamped to [1, max_interval]. A folded step
+// longer than the frame dt and than max_step (or the domain's own stability limit: the fluid
+// CFL bound) runs as equal substeps under that limit (max_step 0: no user limit). A domain whose
+// mean 0.5 |v|^2 stays below sleep_energy for sleep_frames steps sleeps until a command, field
+// write, parameter change, rebuild or new coupling touches it (sleep_energy 0: never sleeps).
+// Sleep is per domain, not per body or island. Coupled domains share the finest interval of the
+// group and only sleep together, so a coupling never has to wake a sleeping partner.
+// Settings are not checkpointed.
+struct domain_activity_desc {
+    bool          enabled{true}; // false: step every frame (the default for new domains)
+    float         importance{1.0f};
+    bool          use_camera_distance{false};
+    float         near_distance{5.0f};
+    std::uint32_t max_interval{8};
+    float         sleep_energy{0.0f};
+    std::uint32_t sleep_frames{30};
+    double        max_step{0.0};
+};
+
+struct domain_activity_info {
+    std::uint32_t interval{1};
+    bool          asleep{false};
+    bool          stepped{true}; // the domain ran in the last frame
+    float         energy{0.0f};  // mean 0.5 |v|^2 after its last step
+    float         distance{0.0f};
+    std::uint32_t substeps{1}; // in the last frame; > 1 when a folded step was split
+};
+
+// Both return false for an unknown world or domain; settings apply from the next step.
+bool set_domain_activity(world_id world, domain_id domain, const domain_activity_desc& desc);
+bool get_domain_activity(world_id world, domain_id domain, domain_activity_info& out);
+
 } // namespace rphys
 
 #endif // RPHYS_API_DOMAIN_H
@@ -2,13 +2,22 @@
 #define RPHYS_API_EVENTS_H
 
 #include "forward.h"
+#include "api_commands.h"
 
 namespace rphys {
 
-struct event_desc { const char* name; };
+// A command stamped with a simulation time. It is applied at the start of the first step whose
+// end time reaches `time`; events that are already due are applied with the next step's commands.
+struct event_desc {
+    command_desc command{};
+    double       time{0.0};
+};
+
+// Same queue and guarantees as enqueue_command; also returns false when `time` is NaN or
+// infinite. At most command_capacity events wait for their time at once; an event drained into a
+// full wait list is dropped and counted in frame_stats.
 bool schedule_event(world_id, const event_desc&);
 
 } // namespace rphys
 
 #endif // RPHYS_API_EVENTS_H
-
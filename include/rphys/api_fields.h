@@ -6,7 +6,9 @@
 
 namespace rphys {
 
+// Views stay valid until the next step / structural change of the world (stride in bytes).
 bool get_field(world_id, domain_id, const char* name, field_view& out);
+// Overwrites the first `count` elements of a writable field; stride 0 means tightly packed.
 bool set_field(world_id, domain_id, const char* name, const void* data, std::size_t count, std::size_t stride);
 
 } // namespace rphys
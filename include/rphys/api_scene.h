@@ -2,16 +2,61 @@
 #define RPHYS_API_SCENE_H
 
 #include "forward.h"
+#include <cstdint>
+#include <span>
 #include <vector>
 
 namespace rphys {
 
-struct scene_primitive { int type{0}; };
+enum class scene_primitive_type : std::int32_t {
+    none = 0,
+    cloth_grid,   // cloth: resolution[0] x resolution[1] vertices spanning extent[0] (x) by extent[1] (y) from origin
+    particle_box, // fluid: particles filling [origin, origin + extent], resolution[] particles per axis
+    fluid_bounds, // fluid: container box [origin, origin + extent]
+    rigid_sphere, // rigid: radius extent[0]; resolution[] > 1 stacks a lattice of spheres
+    rigid_box     // rigid: full size extent[]; resolution[] > 1 stacks a lattice of boxes
+};
+
+enum scene_primitive_flags : std::uint32_t {
+    scene_pin_top_corners = 1u << 0, // cloth_grid: pin the two corners of the last row
+    scene_pin_top_row     = 1u << 1  // cloth_grid: pin the whole last row
+};
+
+struct scene_primitive {
+    scene_primitive_type type{scene_primitive_type::none};
+    float         origin[3]{};
+    float         extent[3]{1.0f, 1.0f, 1.0f};
+    std::uint32_t resolution[3]{1, 1, 1};
+    float         mass{1.0f}; // total mass (cloth, fluid) or mass per body (rigid)
+    std::uint32_t flags{0};
+};
 using scene_primitive_list = std::vector<scene_primitive>;
 
-void build_scene(world_id, domain_id, const scene_primitive_list&);
+// Appends primitives to a domain; each domain type consumes the primitives it understands.
+// Returns false (and leaves the domain inert) when the domain rejects the input.
+bool build_scene(world_id, domain_id, const scene_primitive_list&);
+
+// Triangle mesh for cloth domains (e.g. parsed from an OBJ by the host). Arrays are borrowed for
+// the duration of the call.
+struct scene_mesh {
+    const float*         positions{nullptr}; // xyz per vertex
+    std::uint32_t        vertex_count{0};
+    const std::uint32_t* indices{nullptr};   // 3 per triangle
+    std::uint32_t        triangle_count{0};
+    float                mass{1.0f};         // total, spread evenly over the vertices
+    const std::uint32_t* pinned{nullptr};    // vertex indices held in place
+    std::uint32_t        pinned_count{0};
+};
+
+// Cooks primitives and meshes into a versioned binary scene file: positions, indices, constraint
+// topology, rest data and solver colouring are computed once and stored as flat arrays.
+bool write_scene_file(const char* path, const scene_primitive_list&, std::span<const scene_mesh> meshes = {});
+
+// Memory-maps a scene file and streams its sections into the domain; the result matches
+// build_scene on the cooked input. A missing, truncated or incompatible file returns false and
+// leaves the domain untouched; a scene the domain rejects leaves it inert, as with build_scene.
+bool build_scene_file(world_id, domain_id, const char* path);
 
 } // namespace rphys
 
 #endif // RPHYS_API_SCENE_H
-
@@ -2,14 +2,88 @@
 #define RPHYS_API_TELEMETRY_H
 
 #include "forward.h"
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 namespace rphys {
 
-struct frame_stats { double frame_ms{0.0}; };
+// Last-step totals of one domain phase or coupling exchange (profiling only, see set_profiling).
+struct phase_stats {
+    const char*   name{nullptr};     // phase name, or the coupling module name
+    std::uint32_t owner{0};          // domain id, or coupling id when `coupling` is set
+    bool          coupling{false};
+    std::uint32_t calls{0};
+    double        ms{0.0};           // wall time summed over calls
+    std::uint32_t iterations{0};     // solver iterations reported by the phase (0 if it reports none)
+    double        residual{0.0};     // residual reported by the phase after its last call
+    std::uint32_t scratch_allocs{0}; // frame arena blocks allocated on the phase's thread
+};
+
+struct frame_stats {
+    double        frame_ms{0.0};
+    std::uint64_t frame_index{0};
+    // Step-scoped scratch memory (per-thread frame arenas), summed over threads.
+    std::size_t   scratch_bytes{0};       // bytes used during the last step
+    std::size_t   scratch_high_water{0};  // peak bytes used by any step so far
+    std::size_t   scratch_reserved{0};    // bytes currently held by the arenas
+    std::uint32_t scratch_heap_allocs{0}; // arena blocks allocated during the last step (0 in steady state)
+    std::uint32_t scratch_threads{0};     // threads that own an arena in this world
+    // Command / event queue (see api_commands.h, api_events.h).
+    std::uint32_t commands_applied{0};    // commands and due events applied at the start of the last step
+    std::uint32_t commands_rejected{0};   // ... that had no valid target (unknown field, domain or index)
+    std::uint64_t commands_dropped{0};    // commands / events dropped because the queue or event list was full (cumulative)
+    std::uint32_t events_pending{0};      // timed events waiting for their sim time
+    // Phase profiler (empty unless enabled). Sorted by (domains before couplings, owner, name);
+    // the array lives as long as the rest of these stats.
+    const phase_stats* phases{nullptr};
+    std::uint32_t      phase_count{0};
+    std::uint64_t      profile_events_dropped{0}; // ring overwrote events before the step collected them
+    // Telemetry stream (see open_telemetry_stream).
+    std::uint64_t      stream_frames_dropped{0}; // frames not streamed because the buffer was full (cumulative)
+};
+
+// Stats of the most recent step. The pointer stays valid until the world is destroyed; its
+// contents change on the next step, so read it from the thread that steps the world.
 const frame_stats* get_last_frame_stats(world_id);
 
+// Phase profiler: scoped timers around every domain phase, coupling exchange and the step itself
+// record into per-thread rings of `ring_events` entries (rounded up to a power of two). Each step
+// aggregates its events into frame_stats::phases; the rings keep the most recent events for
+// export_chrome_trace. Disabling frees the rings. Off by default: disabled timers cost one branch.
+bool set_profiling(world_id, bool enabled, std::uint32_t ring_events = 16384);
+
+// Writes the events still held by the worlds' rings as Chrome trace JSON (chrome://tracing,
+// Perfetto): one process per world, one track per thread, nested scopes as slices.
+bool export_chrome_trace(std::span<const world_id> worlds, const char* path);
+
+enum class telemetry_format : std::uint8_t {
+    csv,        // one row per frame and per phase, `record` column tells them apart
+    json_lines, // one JSON object per line
+};
+
+// What a step does when the stream buffer is full.
+enum class telemetry_overflow : std::uint8_t {
+    drop,  // drop the whole frame and count it (stream_frames_dropped); the step never waits
+    block, // wait for the writer thread; nothing is lost, the step absorbs disk latency
+};
+
+struct telemetry_stream_desc {
+    const char*        path{nullptr};
+    telemetry_format   format{telemetry_format::csv};
+    std::uint32_t      capacity{4096};   // buffered records (a frame takes 1 + phase_count)
+    std::uint64_t      rotate_bytes{0};  // continue in <path>.1, <path>.2, ... past this size; 0 = one file
+    telemetry_overflow overflow{telemetry_overflow::drop};
+};
+
+// Streams the stats of every following step (including profiler phases when enabled) to a file.
+// The step copies fixed-size records into a preallocated single-producer ring; formatting and
+// file I/O run on a writer thread owned by the stream. Replaces an open stream of the world.
+bool open_telemetry_stream(world_id, const telemetry_stream_desc&);
+// Writes everything still buffered and closes the file; false if no stream was open or a write
+// failed. Destroying the world closes its stream the same way.
+bool close_telemetry_stream(world_id);
+
 } // namespace rphys
 
 #endif // RPHYS_API_TELEMETRY_H
-
@@ -4,7 +4,7 @@
 namespace rphys {
 
 constexpr int version_major = 0;
-constexpr int version_minor = 1;
+constexpr int version_minor = 12;
 constexpr int version_patch = 0;
 
 const char* version_string();
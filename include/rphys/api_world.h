@@ -3,6 +3,8 @@
 
 #include "forward.h"
 #include <cstdint>
+#include <span>
+#include <vector>
 
 namespace rphys {
 
@@ -10,10 +12,38 @@ world_id create_world(const world_desc& desc);
 void destroy_world(world_id id);
 void step_world(world_id id, double dt);
 
+// Steps independent worlds concurrently on the shared task pool. Invalid or stale ids are skipped.
+// Each world is stepped at most once at a time; duplicates in `ids` are stepped one after another.
+void step_worlds(std::span<const world_id> ids, double dt);
+
 // Query functions (added for minimal vertical slice diagnostics)
 std::uint64_t world_frame_count(world_id id);
 double world_total_time(world_id id);
 
+// Checkpoints. A snapshot holds everything stepping depends on: domains and couplings with their
+// SoA state and solver / contact caches, parameters, pending timed events and the clock. Commands
+// still in flight (enqueued but not yet drained) are not part of it.
+struct snapshot_options {
+    bool compress_cold{true}; // LZ-compress data that only scene building changes (topology, rest state)
+};
+
+// Serializes the world into one binary blob. `out` keeps its capacity across calls, so periodic
+// checkpoints do not reallocate. Returns false for an invalid id or a domain without checkpoint support.
+bool save_world(world_id id, std::vector<std::uint8_t>& out, const snapshot_options& options = {});
+
+// Replaces the world's domains, couplings and state with a blob from save_world (same major
+// format version). The world keeps its scheduler and determinism level; domain and coupling ids
+// are those of the saved world. Returns false and leaves the world untouched on any error.
+bool load_world(world_id id, std::span<const std::uint8_t> blob);
+
+// In-memory rollback: after every step the world keeps its state for the last `frames` steps
+// (0 disables and frees the history). Enabling captures the current state as the oldest entry.
+bool set_rollback_depth(world_id id, std::uint32_t frames);
+
+// Returns the world to its state `frames` steps ago (1 undoes the last step). Newer entries are
+// discarded. Returns false when the history is shorter than `frames`.
+bool rollback_world(world_id id, std::uint32_t frames);
+
 } // namespace rphys
 
 #endif // RPHYS_API_WORLD_H
@@ -13,10 +13,46 @@ struct coupling_id { std::uint32_t value{0}; };
 struct field_id { std::uint32_t value{0}; };
 struct param_id { std::uint32_t value{0}; };
 
-struct world_desc { int reserved{}; }; // placeholder
-struct domain_desc { int reserved{}; };
+// Frame scheduler used to run domain phases and couplings (see api_capability list_schedulers).
+enum class scheduler_kind : std::uint8_t {
+    automatic,     // tbb when built with oneTBB, otherwise work_stealing
+    serial,        // canonical phase order on the stepping thread
+    work_stealing, // dependency graph on the built-in work-stealing pool
+    tbb            // dependency graph on oneTBB (falls back to work_stealing when unavailable)
+};
+
+// Reproducibility tier (README "Determinism Levels"). Results never depend on the scheduler's
+// thread count at task_stable and above; the extra buffering and sorting is only paid when enabled.
+enum class determinism_level : std::uint8_t {
+    fast,        // completion-order merges and reductions
+    task_stable, // fixed partitions merged and reduced in partition order
+    bit_stable   // task_stable + canonically sorted pairs / neighbours
+};
+
+// Instruction set of the SIMD kernels (README "SIMD Dispatch"). automatic picks the best level
+// the CPU supports; explicit levels above that are lowered to it. Results are identical at every
+// level, so the override is for measurement and for working around platform issues.
+enum class simd_level : std::uint8_t { automatic, scalar, sse42, avx2, avx512 };
+
+struct world_desc {
+    int reserved{};
+    std::uint32_t command_capacity{4096}; // per-world command/event queue slots (rounded up to a power of two)
+    scheduler_kind scheduler{scheduler_kind::automatic};
+    determinism_level determinism{determinism_level::fast};
+    simd_level simd{simd_level::automatic};
+    std::uint32_t threads{0}; // parallel schedulers: threads stepping this world incl. the caller; 0 = whole shared pool
+};
+struct domain_desc {
+    int reserved{};
+    const char* type{nullptr}; // "cloth", "fluid", "rigid"
+};
 struct algorithm_desc { int reserved{}; };
-struct coupling_desc { int reserved{}; };
+struct coupling_desc {
+    int reserved{};
+    const char* type{nullptr}; // registered coupling module name
+    domain_id first{};         // domains in the order the module expects (e.g. cloth, fluid)
+    domain_id second{};
+};
 struct field_view { const void* data{nullptr}; std::size_t count{0}; std::size_t stride{0}; };
 
 } // namespace rphys
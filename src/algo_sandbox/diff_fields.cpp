@@ -1,3 +1,112 @@
 #include "diff_fields.hpp"
-// skeleton
+#include "api_layer/gateway_world.hpp"
+#include "core_base/world_core.hpp"
+#include "perf_layers/simd_vec.hpp"
+#include "rphys/api_world.h"
+#include "schedulers/task_pool.hpp"
+#include <algorithm>
+#include <atomic>
 
+namespace rphys {
+
+namespace {
+    // Scalars per task: large enough to amortize scheduling, small enough that an early stop
+    // wastes little work.
+    constexpr std::size_t k_block = std::size_t{1} << 16;
+
+    simd_diff_limits limits_for(const diff_tolerance& t) {
+        const float abs = std::max(0.0f, t.abs), rel = std::max(0.0f, t.rel);
+        switch (t.policy) {
+            case diff_policy::absolute: return {abs, 0.0f, 0};
+            case diff_policy::relative: return {0.0f, rel, 0};
+            case diff_policy::ulp: return {0.0f, 0.0f, t.ulps};
+            case diff_policy::combined: return {abs, rel, 0};
+            default: return {};
+        }
+    }
+
+    // Reads a field as flat f32 scalars; only 32-bit float fields with no padding between
+    // elements qualify (u32 index fields share the scalar size but not the representation).
+    bool field_scalars(world_id w, domain_id d, const char* name, const float*& data, std::size_t& n) {
+        bool ok = false;
+        gw_with_world(w, [&](world_core& core) {
+            const field_bus_entry* f = find_field(&core.fields, d.value, name);
+            if (!f || f->scalar != field_scalar::f32 || f->stride != f->components * sizeof(float)) return;
+            data = static_cast<const float*>(f->data);
+            n    = f->count * f->components;
+            ok   = true;
+        });
+        return ok;
+    }
+} // namespace
+
+void diff_arrays(const float* a, const float* b, std::size_t n, const diff_tolerance& tol, diff_report& out, simd_level simd) {
+    out       = diff_report{};
+    out.count = n;
+    if (n == 0) return;
+
+    const simd_kernels&      kernels = simd_kernels_for(simd_resolve(simd));
+    const simd_diff_limits   lim     = limits_for(tol);
+    const std::size_t        blocks  = (n + k_block - 1) / k_block;
+    std::vector<simd_diff_result> partial(blocks);
+    std::vector<std::uint8_t>     scanned(blocks, 0);
+    std::atomic<std::size_t>      first_bad{blocks}; // lowest block holding a violation so far
+
+    parallel_for(default_task_pool(), blocks, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t blk = begin; blk < end; ++blk) {
+            // Blocks below the first known violation still run, so first_divergence stays exact.
+            if (tol.stop_at_first && blk > first_bad.load(std::memory_order_relaxed)) return;
+            const std::size_t lo  = blk * k_block;
+            const std::size_t len = std::min(k_block, n - lo);
+            kernels.diff(a + lo, b + lo, len, lim, partial[blk]);
+            scanned[blk] = 1;
+            if (partial[blk].first_violation < len) {
+                std::size_t seen = first_bad.load(std::memory_order_relaxed);
+                while (blk < seen && !first_bad.compare_exchange_weak(seen, blk, std::memory_order_relaxed)) {}
+            }
+        }
+    });
+
+    for (std::size_t blk = 0; blk < blocks; ++blk) {
+        if (!scanned[blk]) continue;
+        const simd_diff_result& r   = partial[blk];
+        const std::size_t       lo  = blk * k_block;
+        const std::size_t       len = std::min(k_block, n - lo);
+        out.compared += len;
+        out.max_abs = std::max(out.max_abs, static_cast<double>(r.max_abs));
+        out.max_rel = std::max(out.max_rel, static_cast<double>(r.max_rel));
+        out.max_ulp = std::max(out.max_ulp, r.max_ulp);
+        if (r.first_violation < len && out.first_divergence == diff_npos) out.first_divergence = lo + r.first_violation;
+    }
+}
+
+bool diff_world_fields(world_id a, world_id b, domain_id domain, const char* field, const diff_tolerance& tol, diff_report& out) {
+    out = diff_report{};
+    const float* da = nullptr;
+    const float* db = nullptr;
+    std::size_t  na = 0, nb = 0;
+    if (!field_scalars(a, domain, field, da, na) || !field_scalars(b, domain, field, db, nb)) return false;
+    if (na != nb) {
+        out.count         = std::max(na, nb);
+        out.size_mismatch = true;
+        return true;
+    }
+    diff_arrays(da, db, na, tol, out);
+    return true;
+}
+
+bool diff_world_checkpoint(world_id world, std::span<const std::uint8_t> checkpoint, domain_id domain, std::span<const char* const> fields,
+                           const diff_tolerance& tol, std::vector<diff_report>& out) {
+    out.clear();
+    const world_id scratch = create_world(world_desc{});
+    bool ok = scratch.value != 0 && load_world(scratch, checkpoint);
+    for (std::size_t i = 0; ok && i < fields.size(); ++i) {
+        diff_report r;
+        ok = diff_world_fields(world, scratch, domain, fields[i], tol, r);
+        out.push_back(r);
+    }
+    destroy_world(scratch);
+    return ok;
+}
+
+} // namespace rphys
@@ -1,7 +1,63 @@
 #ifndef RPHYS_ALGO_SANDBOX_DIFF_FIELDS_HPP
 #define RPHYS_ALGO_SANDBOX_DIFF_FIELDS_HPP
 
-namespace rphys { struct sandbox_diff_fields; }
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "rphys/forward.h"
 
-#endif // RPHYS_ALGO_SANDBOX_DIFF_FIELDS_HPP
+namespace rphys {
+
+// How far two values may drift apart. Values that are equal (+0 == -0, NaN == NaN) always pass;
+// a pair with one non-finite member never does.
+enum class diff_policy : std::uint8_t {
+    exact,    // bit-equal otherwise
+    absolute, // |a - b| <= abs
+    relative, // |a - b| <= rel * max(|a|, |b|)
+    ulp,      // at most `ulps` representable floats apart
+    combined  // |a - b| <= abs + rel * max(|a|, |b|) (allclose)
+};
+
+struct diff_tolerance {
+    diff_policy   policy{diff_policy::exact};
+    float         abs{0.0f};
+    float         rel{0.0f};
+    std::uint32_t ulps{0};
+    bool          stop_at_first{true}; // stop scanning past the first block that holds a violation
+};
+
+constexpr std::size_t diff_npos = std::numeric_limits<std::size_t>::max();
+
+// Statistics over the compared scalars. With stop_at_first, blocks after the first violating one
+// may be skipped: the maxima then cover a prefix, but first_divergence is always exact.
+struct diff_report {
+    std::size_t   count{0};                    // scalars in each input
+    std::size_t   compared{0};                 // scalars actually scanned
+    double        max_abs{0.0};
+    double        max_rel{0.0};
+    std::uint32_t max_ulp{0};
+    std::size_t   first_divergence{diff_npos}; // first scalar outside the tolerance
+    bool          size_mismatch{false};        // inputs differ in length (nothing compared)
+
+    bool within_tolerance() const { return !size_mismatch && first_divergence == diff_npos; }
+};
 
+// Compares a[0..n) with b[0..n) in fixed blocks spread over the shared task pool, each block
+// through the SIMD diff kernel of `simd` (results are identical at every level).
+void diff_arrays(const float* a, const float* b, std::size_t n, const diff_tolerance&, diff_report& out, simd_level simd = simd_level::automatic);
+
+// Compares one f32 field of two worlds as flat scalars (element * components + component).
+// False when either field is missing or not a tightly packed 32-bit field.
+bool diff_world_fields(world_id a, world_id b, domain_id, const char* field, const diff_tolerance&, diff_report& out);
+
+// Restores `checkpoint` (save_world) into a scratch world and compares each named field of
+// `domain` against `world`; one report per field. False when the checkpoint does not load or a
+// field is missing on either side.
+bool diff_world_checkpoint(world_id world, std::span<const std::uint8_t> checkpoint, domain_id domain, std::span<const char* const> fields,
+                           const diff_tolerance&, std::vector<diff_report>& out);
+
+} // namespace rphys
+
+#endif // RPHYS_ALGO_SANDBOX_DIFF_FIELDS_HPP
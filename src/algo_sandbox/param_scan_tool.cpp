@@ -1,3 +1,79 @@
 #include "param_scan_tool.hpp"
-// skeleton
+#include <algorithm>
+#include <charconv>
+#include <limits>
 
+namespace rphys {
+
+namespace {
+    bool parse_double(std::string_view s, double& out) {
+        const auto r = std::from_chars(s.data(), s.data() + s.size(), out);
+        return r.ec == std::errc{} && r.ptr == s.data() + s.size();
+    }
+
+    bool parse_count(std::string_view s, std::uint32_t& out) {
+        const auto r = std::from_chars(s.data(), s.data() + s.size(), out);
+        return r.ec == std::errc{} && r.ptr == s.data() + s.size();
+    }
+} // namespace
+
+bool param_grid_add(param_grid& g, std::string_view name, std::vector<double> values) {
+    if (name.empty() || values.empty()) return false;
+    if (std::any_of(g.axes.begin(), g.axes.end(), [&](const param_axis& a) { return a.name == name; })) return false;
+    g.axes.push_back(param_axis{std::string(name), std::move(values)});
+    return true;
+}
+
+bool param_grid_add_range(param_grid& g, std::string_view name, double first, double last, std::uint32_t count) {
+    if (count == 0) return false;
+    std::vector<double> values(count);
+    for (std::uint32_t i = 0; i < count; ++i) values[i] = count == 1 ? first : first + (last - first) * (static_cast<double>(i) / (count - 1));
+    return param_grid_add(g, name, std::move(values));
+}
+
+bool param_grid_parse_axis(param_grid& g, std::string_view spec) {
+    const std::size_t eq = spec.find('=');
+    if (eq == std::string_view::npos) return false;
+    const std::string_view name = spec.substr(0, eq);
+    std::string_view       list = spec.substr(eq + 1);
+    if (list.find(':') != std::string_view::npos) {
+        const std::size_t c0 = list.find(':'), c1 = list.find(':', c0 + 1);
+        double        first = 0.0, last = 0.0;
+        std::uint32_t count = 0;
+        if (c1 == std::string_view::npos || !parse_double(list.substr(0, c0), first) || !parse_double(list.substr(c0 + 1, c1 - c0 - 1), last) ||
+            !parse_count(list.substr(c1 + 1), count)) {
+            return false;
+        }
+        return param_grid_add_range(g, name, first, last, count);
+    }
+    std::vector<double> values;
+    while (!list.empty()) {
+        const std::size_t comma = std::min(list.find(','), list.size());
+        double            v     = 0.0;
+        if (!parse_double(list.substr(0, comma), v)) return false;
+        values.push_back(v);
+        list.remove_prefix(std::min(comma + 1, list.size()));
+    }
+    return param_grid_add(g, name, std::move(values));
+}
+
+std::size_t param_grid_size(const param_grid& g) {
+    std::size_t n = 1;
+    for (const auto& a : g.axes) {
+        if (a.values.empty()) return 0;
+        if (n > std::numeric_limits<std::size_t>::max() / a.values.size()) return 0;
+        n *= a.values.size();
+    }
+    return n;
+}
+
+void param_grid_point(const param_grid& g, std::size_t index, std::vector<double>& out) {
+    out.resize(g.axes.size());
+    for (std::size_t k = g.axes.size(); k-- > 0;) {
+        const auto& values = g.axes[k].values;
+        out[k]             = values[index % values.size()];
+        index /= values.size();
+    }
+}
+
+} // namespace rphys
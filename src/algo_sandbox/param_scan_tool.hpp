@@ -1,7 +1,41 @@
 #ifndef RPHYS_ALGO_SANDBOX_PARAM_SCAN_TOOL_HPP
 #define RPHYS_ALGO_SANDBOX_PARAM_SCAN_TOOL_HPP
 
-namespace rphys { struct sandbox_param_scan_tool; }
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
 
-#endif // RPHYS_ALGO_SANDBOX_PARAM_SCAN_TOOL_HPP
+namespace rphys {
+
+// One swept world parameter (a set_param name such as "cloth.compliance") and its values.
+struct param_axis {
+    std::string         name;
+    std::vector<double> values;
+};
+
+// Cartesian product of its axes; run `i` of a sweep takes the i-th combination, last axis fastest.
+struct param_grid {
+    std::vector<param_axis> axes;
+};
+
+// Adds an axis. False for an empty value list or a name that already has an axis.
+bool param_grid_add(param_grid&, std::string_view name, std::vector<double> values);
+
+// `count` evenly spaced values from `first` to `last` inclusive (count 1 gives `first`).
+bool param_grid_add_range(param_grid&, std::string_view name, double first, double last, std::uint32_t count);
 
+// Parses "name=v0,v1,..." or "name=first:last:count" (the command-line form) and adds the axis.
+bool param_grid_parse_axis(param_grid&, std::string_view spec);
+
+// Number of combinations; 1 for a grid without axes (a single run with no overrides), 0 when the
+// product does not fit in size_t.
+std::size_t param_grid_size(const param_grid&);
+
+// Values of combination `index` (< param_grid_size), one per axis in axis order.
+void param_grid_point(const param_grid&, std::size_t index, std::vector<double>& out);
+
+} // namespace rphys
+
+#endif // RPHYS_ALGO_SANDBOX_PARAM_SCAN_TOOL_HPP
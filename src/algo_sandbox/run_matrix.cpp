@@ -1,3 +1,158 @@
 #include "run_matrix.hpp"
-// skeleton
+#include "rphys/api_coupling.h"
+#include "rphys/api_domain.h"
+#include "rphys/api_params.h"
+#include "rphys/api_telemetry.h"
+#include "rphys/api_world.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
 
+namespace rphys {
+
+namespace {
+    constexpr std::uint32_t k_profile_ring_events = 4096; // one serial world records a few events per phase
+
+    std::string temp_scene_path() {
+        static std::atomic<std::uint64_t> serial{0};
+        std::error_code ec;
+        const std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+        if (ec) return {};
+        char name[64];
+        std::snprintf(name, sizeof(name), "rphys_sweep_%llx_%llu.rps", static_cast<unsigned long long>(std::chrono::steady_clock::now().time_since_epoch().count()),
+                      static_cast<unsigned long long>(serial.fetch_add(1, std::memory_order_relaxed)));
+        return (dir / name).string();
+    }
+
+    // Removes the scene file the sweep cooked itself.
+    struct temp_scene {
+        std::string path;
+        ~temp_scene() {
+            std::error_code ec;
+            if (!path.empty()) std::filesystem::remove(path, ec);
+        }
+    };
+
+    // Domains plus the scene; what the sentinel world and every run have in common.
+    bool build_domains(const run_matrix_desc& desc, world_id w, const std::string& scene, std::vector<domain_id>& domains) {
+        domains.clear();
+        for (const auto& d : desc.domains) {
+            const domain_id id = add_domain(w, d);
+            if (!id.value || !build_scene_file(w, id, scene.c_str())) return false;
+            domains.push_back(id);
+        }
+        return true;
+    }
+
+    bool setup_run(const run_matrix_desc& desc, world_id w, const std::string& scene, const run_metrics& m) {
+        std::vector<domain_id> domains;
+        if (!build_domains(desc, w, scene, domains)) return false;
+        for (const auto& c : desc.couplings) {
+            if (c.first >= domains.size() || c.second >= domains.size()) return false;
+            if (!register_coupling(w, coupling_desc{0, c.type, domains[c.first], domains[c.second]}).value) return false;
+        }
+        for (const auto& [name, value] : desc.fixed_params) {
+            if (!set_param(w, name.c_str(), value)) return false;
+        }
+        for (std::size_t k = 0; k < m.params.size(); ++k) {
+            if (!set_param(w, desc.grid.axes[k].name.c_str(), m.params[k])) return false;
+        }
+        if (desc.profile && !set_profiling(w, true, k_profile_ring_events)) return false;
+        if (!desc.telemetry_dir.empty()) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "run_%05zu.csv", m.index);
+            const std::string path = (std::filesystem::path(desc.telemetry_dir) / name).string();
+            telemetry_stream_desc stream;
+            stream.path     = path.c_str();
+            stream.overflow = telemetry_overflow::block; // a sweep wants every frame, not minimal latency
+            if (!open_telemetry_stream(w, stream)) return false;
+        }
+        return true;
+    }
+
+    void record_frame(run_metrics& m, const frame_stats* s) {
+        if (!s) return;
+        ++m.frames;
+        m.frame_ms_mean += s->frame_ms; // summed here, divided when the run ends
+        m.frame_ms_max = std::max(m.frame_ms_max, s->frame_ms);
+        double residual = 0.0;
+        for (std::uint32_t i = 0; i < s->phase_count; ++i) {
+            m.solver_iterations += s->phases[i].iterations;
+            residual = std::max(residual, s->phases[i].residual);
+        }
+        m.final_residual        = residual;
+        m.scratch_high_water    = s->scratch_high_water;
+        m.stream_frames_dropped = s->stream_frames_dropped;
+    }
+} // namespace
+
+bool run_matrix_execute(const run_matrix_desc& desc, run_matrix_result& out) {
+    out = run_matrix_result{};
+    const std::size_t total = param_grid_size(desc.grid);
+    if (total == 0 || desc.domains.empty() || desc.dt <= 0.0) return false;
+    const auto start = std::chrono::steady_clock::now();
+
+    temp_scene  cooked;
+    std::string scene = desc.scene_path;
+    if (scene.empty()) {
+        cooked.path = temp_scene_path();
+        if (cooked.path.empty() || !write_scene_file(cooked.path.c_str(), desc.primitives)) return false;
+        scene = cooked.path;
+    }
+
+    // The sentinel loads the scene first (a broken scene fails here, once) and keeps the shared
+    // buffers alive between waves.
+    std::vector<domain_id> sentinel_domains;
+    const world_id sentinel = create_world(desc.world);
+    if (!sentinel.value || !build_domains(desc, sentinel, scene, sentinel_domains)) {
+        destroy_world(sentinel);
+        return false;
+    }
+
+    const std::uint32_t hw = std::max(1u, std::thread::hardware_concurrency());
+    out.concurrency        = static_cast<std::uint32_t>(std::min<std::size_t>(desc.concurrency ? desc.concurrency : hw, total));
+    out.runs.resize(total);
+
+    std::vector<world_id>    wave;
+    std::vector<std::size_t> slots;
+    wave.reserve(out.concurrency);
+    slots.reserve(out.concurrency);
+    for (std::size_t first = 0; first < total; first += out.concurrency) {
+        const std::size_t last = std::min(total, first + out.concurrency);
+        wave.clear();
+        slots.clear();
+        for (std::size_t i = first; i < last; ++i) {
+            run_metrics& m = out.runs[i];
+            m.index        = i;
+            param_grid_point(desc.grid, i, m.params);
+            const world_id w = create_world(desc.world);
+            m.ok             = w.value && setup_run(desc, w, scene, m);
+            if (!m.ok) {
+                destroy_world(w);
+                continue;
+            }
+            wave.push_back(w);
+            slots.push_back(i);
+        }
+        for (std::uint32_t f = 0; f < desc.frames && !wave.empty(); ++f) {
+            step_worlds(wave, desc.dt);
+            for (std::size_t k = 0; k < wave.size(); ++k) record_frame(out.runs[slots[k]], get_last_frame_stats(wave[k]));
+        }
+        for (std::size_t k = 0; k < wave.size(); ++k) {
+            run_metrics& m = out.runs[slots[k]];
+            if (m.frames) m.frame_ms_mean /= static_cast<double>(m.frames);
+            if (!desc.telemetry_dir.empty()) m.stream_ok = close_telemetry_stream(wave[k]);
+            if (desc.inspect) desc.inspect(wave[k], m);
+            destroy_world(wave[k]);
+        }
+    }
+
+    destroy_world(sentinel);
+    out.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+} // namespace rphys
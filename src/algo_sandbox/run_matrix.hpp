@@ -1,7 +1,75 @@
 #ifndef RPHYS_ALGO_SANDBOX_RUN_MATRIX_HPP
 #define RPHYS_ALGO_SANDBOX_RUN_MATRIX_HPP
 
-namespace rphys { struct sandbox_run_matrix; }
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "param_scan_tool.hpp"
+#include "rphys/api_scene.h"
+#include "rphys/forward.h"
 
-#endif // RPHYS_ALGO_SANDBOX_RUN_MATRIX_HPP
+namespace rphys {
+
+// Coupling of a sweep world, by index into run_matrix_desc::domains.
+struct run_matrix_coupling {
+    const char*   type{nullptr};
+    std::uint32_t first{0};
+    std::uint32_t second{0};
+};
+
+// Per-run results, gathered from the world's frame_stats after every step.
+struct run_metrics {
+    std::size_t         index{0};
+    std::vector<double> params;   // one value per grid axis
+    bool                ok{false}; // world, domains, scene and parameters all set up
+    std::uint64_t       frames{0};
+    double              frame_ms_mean{0.0};
+    double              frame_ms_max{0.0};
+    std::uint64_t       solver_iterations{0}; // summed over frames and phases (profiling only)
+    double              final_residual{0.0};  // largest phase residual of the last frame (profiling only)
+    std::size_t         scratch_high_water{0};
+    std::uint64_t       stream_frames_dropped{0};
+    bool                stream_ok{true};
+    std::vector<double> extra; // filled by run_matrix_desc::inspect
+};
+
+// Parameter sweep over one scene. Every run gets its own world (domains, couplings, fixed params,
+// then its grid point) and the scene is loaded from one cooked scene file, so the immutable arrays
+// a domain keeps copy-on-write (cloth topology, rest lengths, colouring) exist once for the whole
+// sweep instead of once per run.
+struct run_matrix_desc {
+    world_desc                                 world{0, 4096, scheduler_kind::serial}; // parallelism comes from concurrent runs
+    std::vector<domain_desc>                   domains;
+    std::vector<run_matrix_coupling>           couplings;
+    std::string                                scene_path; // cooked scene file; when empty `primitives` are cooked once
+    scene_primitive_list                       primitives;
+    std::vector<std::pair<std::string, double>> fixed_params; // applied to every run before its grid point
+    param_grid                                 grid;
+    std::uint32_t                              frames{60};
+    double                                     dt{1.0 / 60.0};
+    std::uint32_t                              concurrency{0}; // worlds alive and stepped at once; 0 = hardware threads
+    bool                                       profile{true};  // per-phase iterations / residuals via set_profiling
+    std::string                                telemetry_dir;  // non-empty: stream each run to <dir>/run_<index>.csv
+    // Called on the sweeping thread after a run's last frame, before its world is destroyed.
+    std::function<void(world_id, run_metrics&)> inspect;
+};
 
+struct run_matrix_result {
+    std::vector<run_metrics> runs;           // in grid order
+    std::uint32_t            concurrency{0}; // worlds stepped at once
+    double                   wall_ms{0.0};
+};
+
+// Runs the whole grid in waves of `concurrency` worlds stepped together with step_worlds (the
+// shared task pool spreads them across cores). A sentinel world holds the loaded scene for the
+// duration of the sweep, so later waves share the same buffers rather than reloading them.
+// False when the grid is empty or the scene cannot be cooked or loaded at all; individual runs
+// that fail to set up are reported with ok == false.
+bool run_matrix_execute(const run_matrix_desc&, run_matrix_result& out);
+
+} // namespace rphys
+
+#endif // RPHYS_ALGO_SANDBOX_RUN_MATRIX_HPP
@@ -11,6 +11,9 @@
 #include "rphys/api_capability.h"
 #include "rphys/api_version.h"
 
+#include "api_layer/gateway_coupling.hpp"
+#include "api_layer/gateway_domain.hpp"
+#include "api_layer/gateway_fields.hpp"
 #include "api_layer/gateway_world.hpp"
 
 namespace rphys {
@@ -18,7 +21,42 @@ namespace rphys {
 world_id create_world(const world_desc& desc) { return gw_create_world(desc); }
 void destroy_world(world_id id) { gw_destroy_world(id); }
 void step_world(world_id id, double dt) { gw_step_world(id, dt); }
+void step_worlds(std::span<const world_id> ids, double dt) { gw_step_worlds(ids, dt); }
 std::uint64_t world_frame_count(world_id id) { return gw_world_frame_count(id); }
 double world_total_time(world_id id) { return gw_world_total_time(id); }
+const frame_stats* get_last_frame_stats(world_id id) { return gw_last_frame_stats(id); }
+bool set_profiling(world_id id, bool enabled, std::uint32_t ring_events) { return gw_set_profiling(id, enabled, ring_events); }
+bool export_chrome_trace(std::span<const world_id> worlds, const char* path) { return path && gw_export_chrome_trace(worlds, path); }
+bool open_telemetry_stream(world_id id, const telemetry_stream_desc& desc) { return desc.path && gw_open_telemetry_stream(id, desc); }
+bool close_telemetry_stream(world_id id) { return gw_close_telemetry_stream(id); }
+bool save_world(world_id id, std::vector<std::uint8_t>& out, const snapshot_options& options) { return gw_save_world(id, out, options); }
+bool load_world(world_id id, std::span<const std::uint8_t> blob) { return gw_load_world(id, blob); }
+bool set_rollback_depth(world_id id, std::uint32_t frames) { return gw_set_rollback_depth(id, frames); }
+bool rollback_world(world_id id, std::uint32_t frames) { return gw_rollback_world(id, frames); }
+
+domain_id add_domain(world_id world, const domain_desc& desc) { return gw_add_domain(world, desc); }
+void remove_domain(world_id world, domain_id domain) { gw_remove_domain(world, domain); }
+bool build_scene(world_id world, domain_id domain, const scene_primitive_list& prims) { return gw_build_scene(world, domain, prims); }
+bool set_domain_activity(world_id world, domain_id domain, const domain_activity_desc& desc) { return gw_set_domain_activity(world, domain, desc); }
+bool get_domain_activity(world_id world, domain_id domain, domain_activity_info& out) { return gw_get_domain_activity(world, domain, out); }
+bool write_scene_file(const char* path, const scene_primitive_list& prims, std::span<const scene_mesh> meshes) { return gw_write_scene_file(path, prims, meshes); }
+bool build_scene_file(world_id world, domain_id domain, const char* path) { return gw_build_scene_file(world, domain, path); }
+
+bool get_field(world_id world, domain_id domain, const char* name, field_view& out) { return name && gw_get_field(world, domain, name, out); }
+bool set_field(world_id world, domain_id domain, const char* name, const void* data, std::size_t count, std::size_t stride) {
+    return name && gw_set_field(world, domain, name, data, count, stride);
+}
+
+coupling_id register_coupling(world_id world, const coupling_desc& desc) { return gw_register_coupling(world, desc); }
+void remove_coupling(world_id world, coupling_id coupling) { gw_remove_coupling(world, coupling); }
+
+std::size_t list_schedulers(world_id world, capability_record* buffer, std::size_t capacity) { return gw_list_schedulers(world, buffer, capacity); }
+std::size_t list_perf_layers(world_id world, capability_record* buffer, std::size_t capacity) { return gw_list_perf_layers(world, buffer, capacity); }
+
+bool enqueue_command(world_id id, const command_desc& desc) { return gw_enqueue_command(id, desc); }
+bool schedule_event(world_id id, const event_desc& desc) { return gw_schedule_event(id, desc); }
+
+bool set_param(world_id id, const char* name, double value) { return name && gw_set_param(id, name, value); }
+double get_param(world_id id, const char* name, double default_value) { return name ? gw_get_param(id, name, default_value) : default_value; }
 
 } // namespace rphys
@@ -1,3 +1,37 @@
 #include "gateway_coupling.hpp"
-// skeleton
+#include "gateway_world.hpp"
+#include "core_base/world_core.hpp"
+#include "coupling_modules/cloth_fluid_simple_drag.hpp"
+#include "coupling_modules/cloth_fluid_two_way_pressure.hpp"
+#include "coupling_modules/cloth_rigid_penalty.hpp"
+#include "coupling_modules/cloth_rigid_projection.hpp"
+#include <array>
 
+namespace rphys {
+
+namespace {
+    std::array<const coupling_contract*, 4> builtin_contracts() {
+        return {&cloth_rigid_projection_contract(), &cloth_rigid_penalty_contract(), &cloth_fluid_two_way_pressure_contract(), &cloth_fluid_simple_drag_contract()};
+    }
+} // namespace
+
+const coupling_contract* gw_find_coupling_contract(std::string_view type) {
+    for (const auto* c : builtin_contracts()) {
+        if (type == c->type) return c;
+    }
+    return nullptr;
+}
+
+coupling_id gw_register_coupling(world_id world, const coupling_desc& desc) {
+    const coupling_contract* contract = desc.type ? gw_find_coupling_contract(desc.type) : nullptr;
+    if (!contract) return coupling_id{0};
+    std::uint32_t id = 0;
+    gw_with_world(world, [&](world_core& w) { id = world_add_coupling(w, contract, desc.first.value, desc.second.value); });
+    return coupling_id{id};
+}
+
+void gw_remove_coupling(world_id world, coupling_id coupling) {
+    gw_with_world(world, [&](world_core& w) { world_remove_coupling(w, coupling.value); });
+}
+
+} // namespace rphys
@@ -1,7 +1,20 @@
 #ifndef RPHYS_GATEWAY_COUPLING_HPP
 #define RPHYS_GATEWAY_COUPLING_HPP
 
-namespace rphys { }
+#include <string_view>
+#include "rphys/forward.h"
 
-#endif // RPHYS_GATEWAY_COUPLING_HPP
+namespace rphys {
+
+struct coupling_contract;
+
+// Built-in coupling modules by name; nullptr when unknown.
+const coupling_contract* gw_find_coupling_contract(std::string_view type);
 
+// Fails (id 0) for unknown modules, missing domains or domains of the wrong type.
+coupling_id gw_register_coupling(world_id world, const coupling_desc& desc);
+void        gw_remove_coupling(world_id world, coupling_id coupling);
+
+} // namespace rphys
+
+#endif // RPHYS_GATEWAY_COUPLING_HPP
@@ -1,3 +1,96 @@
 #include "gateway_domain.hpp"
-// skeleton
+#include "gateway_world.hpp"
+#include "core_base/scene_file.hpp"
+#include "core_base/world_core.hpp"
+#include "domain_cloth/pipeline_contract.hpp"
+#include "domain_fluid/pipeline_contract.hpp"
+#include "domain_rigid/pipeline_contract.hpp"
+#include <array>
 
+namespace rphys {
+
+namespace {
+    std::array<const domain_pipeline_contract*, 3> builtin_contracts() {
+        return {&cloth_domain_contract(), &fluid_domain_contract(), &rigid_domain_contract()};
+    }
+} // namespace
+
+const domain_pipeline_contract* gw_find_domain_contract(std::string_view type) {
+    for (const auto* c : builtin_contracts()) {
+        if (type == c->type) return c;
+    }
+    return nullptr;
+}
+
+domain_id gw_add_domain(world_id world, const domain_desc& desc) {
+    const domain_pipeline_contract* contract = desc.type ? gw_find_domain_contract(desc.type) : nullptr;
+    if (!contract) return domain_id{0};
+    std::uint32_t id = 0;
+    gw_with_world(world, [&](world_core& w) { id = world_add_domain(w, contract); });
+    return domain_id{id};
+}
+
+void gw_remove_domain(world_id world, domain_id domain) {
+    gw_with_world(world, [&](world_core& w) { world_remove_domain(w, domain.value); });
+}
+
+bool gw_build_scene(world_id world, domain_id domain, const scene_primitive_list& prims) {
+    bool ok = false;
+    gw_with_world(world, [&](world_core& w) { ok = world_build_domain(w, domain.value, prims); });
+    return ok;
+}
+
+bool gw_set_domain_activity(world_id world, domain_id domain, const domain_activity_desc& desc) {
+    bool ok = false;
+    gw_with_world(world, [&](world_core& w) {
+        domain_core* d = world_find_domain(w, domain.value);
+        if (!d) return;
+        domain_activity& a = d->activity;
+        a.enabled       = desc.enabled;
+        a.importance    = desc.importance;
+        a.use_camera    = desc.use_camera_distance;
+        a.near_distance = desc.near_distance;
+        a.max_interval  = desc.max_interval;
+        a.sleep_energy  = desc.sleep_energy;
+        a.sleep_frames  = desc.sleep_frames;
+        a.max_step      = desc.max_step;
+        // Restart the cadence and sleep counters so the new settings take effect from a clean state.
+        a.interval = 1;
+        domain_activity_wake(a);
+        ok = true;
+    });
+    return ok;
+}
+
+bool gw_get_domain_activity(world_id world, domain_id domain, domain_activity_info& out) {
+    bool ok = false;
+    gw_with_world(world, [&](world_core& w) {
+        const domain_core* d = world_find_domain(w, domain.value);
+        if (!d) return;
+        const domain_activity& a = d->activity;
+        out = domain_activity_info{a.interval, a.asleep, a.substeps > 0, a.energy, a.distance, a.substeps};
+        ok  = true;
+    });
+    return ok;
+}
+
+bool gw_write_scene_file(const char* path, const scene_primitive_list& prims, std::span<const scene_mesh> meshes) {
+    if (!path) return false;
+    scene_file_writer writer;
+    writer.add_primitives(prims);
+    for (const auto* c : builtin_contracts()) {
+        if (c->cook_scene && !c->cook_scene(prims, meshes, writer)) return false;
+    }
+    return writer.write(path);
+}
+
+bool gw_build_scene_file(world_id world, domain_id domain, const char* path) {
+    // Map and validate before taking the world lock; only the section copies run under it.
+    scene_file file;
+    if (!scene_file_open(file, path)) return false;
+    bool ok = false;
+    gw_with_world(world, [&](world_core& w) { ok = world_load_domain(w, domain.value, file); });
+    return ok;
+}
+
+} // namespace rphys
@@ -1,7 +1,29 @@
 #ifndef RPHYS_GATEWAY_DOMAIN_HPP
 #define RPHYS_GATEWAY_DOMAIN_HPP
 
-namespace rphys { }
+#include <span>
+#include <string_view>
+#include "rphys/api_domain.h"
+#include "rphys/api_scene.h"
+#include "rphys/forward.h"
 
-#endif // RPHYS_GATEWAY_DOMAIN_HPP
+namespace rphys {
+
+struct domain_pipeline_contract;
+
+// Built-in domain types by name ("cloth", "fluid", "rigid"); nullptr when unknown.
+const domain_pipeline_contract* gw_find_domain_contract(std::string_view type);
+
+domain_id gw_add_domain(world_id world, const domain_desc& desc);
+void      gw_remove_domain(world_id world, domain_id domain);
+bool      gw_build_scene(world_id world, domain_id domain, const scene_primitive_list& prims);
+bool      gw_set_domain_activity(world_id world, domain_id domain, const domain_activity_desc& desc);
+bool      gw_get_domain_activity(world_id world, domain_id domain, domain_activity_info& out);
 
+// Scene files: every built-in contract with a cook hook adds its sections next to the primitives.
+bool gw_write_scene_file(const char* path, const scene_primitive_list& prims, std::span<const scene_mesh> meshes);
+bool gw_build_scene_file(world_id world, domain_id domain, const char* path);
+
+} // namespace rphys
+
+#endif // RPHYS_GATEWAY_DOMAIN_HPP
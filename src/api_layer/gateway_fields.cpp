@@ -1,3 +1,36 @@
 #include "gateway_fields.hpp"
-// skeleton
+#include "gateway_world.hpp"
+#include "core_base/world_core.hpp"
+#include <cstring>
 
+namespace rphys {
+
+bool gw_get_field(world_id world, domain_id domain, std::string_view name, field_view& out) {
+    bool ok = false;
+    gw_with_world(world, [&](world_core& w) {
+        const field_bus_entry* f = find_field(&w.fields, domain.value, name);
+        if (!f) return;
+        out = field_view{f->data, f->count, f->stride};
+        ok  = true;
+    });
+    return ok;
+}
+
+bool gw_set_field(world_id world, domain_id domain, std::string_view name, const void* data, std::size_t count, std::size_t stride) {
+    if (!data && count != 0) return false;
+    bool ok = false;
+    gw_with_world(world, [&](world_core& w) {
+        const field_bus_entry* f = find_field(&w.fields, domain.value, name);
+        if (!f || !f->mutable_data || count > f->count) return;
+        const std::size_t elem = field_scalar_size(f->scalar) * f->components;
+        if (stride == 0) stride = elem;
+        auto* dst       = static_cast<unsigned char*>(f->mutable_data);
+        const auto* src = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < count; ++i) std::memcpy(dst + i * f->stride, src + i * stride, elem);
+        world_wake_domains(w, domain.value);
+        ok = true;
+    });
+    return ok;
+}
+
+} // namespace rphys
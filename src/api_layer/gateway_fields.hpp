@@ -1,7 +1,17 @@
 #ifndef RPHYS_GATEWAY_FIELDS_HPP
 #define RPHYS_GATEWAY_FIELDS_HPP
 
-namespace rphys { }
+#include <cstddef>
+#include <string_view>
+#include "rphys/forward.h"
 
-#endif // RPHYS_GATEWAY_FIELDS_HPP
+namespace rphys {
+
+bool gw_get_field(world_id world, domain_id domain, std::string_view name, field_view& out);
+// Copies `count` elements (element i at data + i * stride; stride 0 = packed) into the front of
+// a writable field. Fails without writing when the field is read-only or too short.
+bool gw_set_field(world_id world, domain_id domain, std::string_view name, const void* data, std::size_t count, std::size_t stride);
 
+} // namespace rphys
+
+#endif // RPHYS_GATEWAY_FIELDS_HPP
@@ -1,65 +1,358 @@
 #include "gateway_world.hpp"
+#include "gateway_coupling.hpp"
+#include "gateway_domain.hpp"
 #include "core_base/world_core.hpp"
-#include <vector>
+#include "perf_layers/simd_vec.hpp"
+#include "rphys/api_capability.h"
+#include "rphys/api_events.h"
+#include "rphys/api_world.h"
+#include "schedulers/job_system.hpp"
+#include "schedulers/serial.hpp"
+#include "schedulers/task_pool.hpp"
+#include "telemetry_export/csv_dump.hpp"
+#include "telemetry_export/json_dump.hpp"
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace rphys {
 
 namespace {
-    struct world_slot { world_core* ptr{nullptr}; };
-    static std::vector<world_slot> g_worlds; // index = id.value - 1
-
-    bool valid(world_id id) {
-        if (id.value == 0) return false;
-        std::size_t idx = static_cast<std::size_t>(id.value - 1);
-        if (idx >= g_worlds.size()) return false;
-        return g_worlds[idx].ptr != nullptr;
+    // world_id.value layout: [generation:12][slot index:20]. Generations start at 1 and skip 0 on
+    // wrap-around, so a valid id is never 0 and an id whose slot was recycled no longer resolves.
+    constexpr std::uint32_t k_index_bits      = 20;
+    constexpr std::uint32_t k_index_mask      = (1u << k_index_bits) - 1u;
+    constexpr std::uint32_t k_generation_mask = (1u << (32u - k_index_bits)) - 1u;
+    constexpr std::size_t   k_page_size       = 256;
+    constexpr std::size_t   k_page_count      = (std::size_t{k_index_mask} + 1u) / k_page_size;
+
+    struct world_slot {
+        std::atomic<world_core*>   ptr{nullptr};
+        std::atomic<std::uint32_t> generation{1};
+        std::atomic<std::uint32_t> pins{0}; // in-flight lookups; destroy waits for zero
+        std::mutex                 step_lock; // serializes stepping / queries of one world
+    };
+
+    // Slots live in fixed pages that are never moved or freed while the process runs, so lookups
+    // only need an acquire load of the page pointer. Create/destroy take `mutex`; lookups never do.
+    struct world_registry {
+        std::array<std::atomic<world_slot*>, k_page_count> pages{};
+        std::mutex                 mutex;
+        std::vector<std::uint32_t> free_slots;
+        std::uint32_t              slot_count{0};
+
+        ~world_registry() {
+            for (auto& p : pages) {
+                world_slot* page = p.load(std::memory_order_relaxed);
+                if (!page) continue;
+                for (std::size_t i = 0; i < k_page_size; ++i) destroy_world_core(page[i].ptr.load(std::memory_order_relaxed));
+                delete[] page;
+            }
+        }
+
+        world_slot* slot_at(std::uint32_t index) const {
+            world_slot* page = pages[index / k_page_size].load(std::memory_order_acquire);
+            return page ? &page[index % k_page_size] : nullptr;
+        }
+    };
+
+    world_registry& registry() {
+        static world_registry r;
+        return r;
     }
 
-    world_core* fetch(world_id id) {
-        if (!valid(id)) return nullptr;
-        return g_worlds[static_cast<std::size_t>(id.value - 1)].ptr;
+    constexpr std::uint32_t index_of(world_id id) { return id.value & k_index_mask; }
+    constexpr std::uint32_t generation_of(world_id id) { return id.value >> k_index_bits; }
+    constexpr world_id make_id(std::uint32_t index, std::uint32_t generation) { return world_id{(generation << k_index_bits) | index}; }
+
+    // RAII lookup. While a pin is held the world cannot be destroyed underneath the caller.
+    class world_pin {
+    public:
+        explicit world_pin(world_id id) {
+            if (generation_of(id) == 0) return;
+            world_slot* slot = registry().slot_at(index_of(id));
+            if (!slot) return;
+            // seq_cst pairs with the generation bump + pin wait in gw_destroy_world.
+            slot->pins.fetch_add(1, std::memory_order_seq_cst);
+            world_core* core = slot->ptr.load(std::memory_order_seq_cst);
+            if (slot->generation.load(std::memory_order_seq_cst) != generation_of(id) || !core) {
+                slot->pins.fetch_sub(1, std::memory_order_release);
+                return;
+            }
+            slot_ = slot;
+            core_ = core;
+        }
+        ~world_pin() {
+            if (slot_) slot_->pins.fetch_sub(1, std::memory_order_release);
+        }
+        world_pin(const world_pin&)            = delete;
+        world_pin& operator=(const world_pin&) = delete;
+
+        world_core* core() const { return core_; }
+        std::mutex& step_lock() const { return slot_->step_lock; }
+
+    private:
+        world_slot* slot_{nullptr};
+        world_core* core_{nullptr};
+    };
+
+    world_scheduler make_scheduler(scheduler_kind kind, std::size_t threads) {
+        switch (kind) {
+            case scheduler_kind::serial: return make_serial_scheduler();
+            case scheduler_kind::work_stealing: return make_job_system_scheduler(task_backend::builtin, threads);
+            case scheduler_kind::automatic:
+            case scheduler_kind::tbb: break;
+        }
+        world_scheduler s = make_job_system_scheduler(task_backend::tbb, threads);
+        return s.run_frame ? s : make_job_system_scheduler(task_backend::builtin, threads);
     }
-}
+
+    snapshot_contracts builtin_contracts() { return snapshot_contracts{gw_find_domain_contract, gw_find_coupling_contract}; }
+
+    void step_pinned(world_id id, double dt) {
+        world_pin pin(id);
+        if (!pin.core()) return;
+        std::lock_guard<std::mutex> lock(pin.step_lock());
+        step_world_core(pin.core(), dt);
+    }
+} // namespace
 
 world_id gw_create_world(const world_desc& desc) {
-    (void)desc; // suppress unused parameter until mapping fields implemented
-    world_config cfg{}; // map fields if/when extended
+    world_config cfg{};
+    cfg.command_capacity = desc.command_capacity;
+    cfg.determinism      = desc.determinism;
+    cfg.simd             = simd_resolve(desc.simd);
     world_core* core = create_world_core(cfg);
     if (!core) return world_id{0};
+    world_scheduler sched = make_scheduler(desc.scheduler, desc.threads);
+    if (!sched.run_frame) {
+        destroy_world_core(core);
+        return world_id{0};
+    }
+    world_bind_scheduler(*core, sched);
 
-    // find free slot
-    for (std::size_t i = 0; i < g_worlds.size(); ++i) {
-        if (g_worlds[i].ptr == nullptr) {
-            g_worlds[i].ptr = core;
-            return world_id{ static_cast<std::uint32_t>(i + 1) };
+    world_registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::uint32_t index = 0;
+    if (!reg.free_slots.empty()) {
+        index = reg.free_slots.back();
+        reg.free_slots.pop_back();
+    } else {
+        if (reg.slot_count > k_index_mask) {
+            destroy_world_core(core);
+            return world_id{0};
         }
+        index = reg.slot_count++;
+        auto& page = reg.pages[index / k_page_size];
+        if (!page.load(std::memory_order_relaxed)) page.store(new world_slot[k_page_size], std::memory_order_release);
     }
-    g_worlds.push_back(world_slot{core});
-    return world_id{ static_cast<std::uint32_t>(g_worlds.size()) };
+    world_slot* slot = reg.slot_at(index);
+    slot->ptr.store(core, std::memory_order_release);
+    return make_id(index, slot->generation.load(std::memory_order_relaxed));
 }
 
 void gw_destroy_world(world_id id) {
-    world_core* core = fetch(id);
-    if (!core) return; // silently ignore invalid id for now
+    world_registry& reg = registry();
+    world_slot* slot    = nullptr;
+    world_core* core    = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (generation_of(id) == 0) return;
+        slot = reg.slot_at(index_of(id));
+        if (!slot || slot->generation.load(std::memory_order_relaxed) != generation_of(id)) return; // stale or invalid id
+        core = slot->ptr.exchange(nullptr, std::memory_order_seq_cst);
+        if (!core) return;
+        std::uint32_t next = (generation_of(id) + 1u) & k_generation_mask;
+        slot->generation.store(next == 0 ? 1u : next, std::memory_order_seq_cst);
+    }
+    // New lookups now fail; wait for in-flight steps/queries before tearing the world down.
+    while (slot->pins.load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
     destroy_world_core(core);
-    g_worlds[static_cast<std::size_t>(id.value - 1)].ptr = nullptr;
+
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.free_slots.push_back(index_of(id));
 }
 
 void gw_step_world(world_id id, double dt) {
-    world_core* core = fetch(id);
-    if (!core) return;
-    step_world_core(core, dt);
+    step_pinned(id, dt);
+}
+
+void gw_step_worlds(std::span<const world_id> ids, double dt) {
+    if (ids.size() == 1) {
+        step_pinned(ids[0], dt);
+        return;
+    }
+    parallel_for(default_task_pool(), ids.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) step_pinned(ids[i], dt);
+    });
 }
 
 std::uint64_t gw_world_frame_count(world_id id) {
-    world_core* core = fetch(id);
-    return core ? core->frame_count : 0ULL;
+    world_pin pin(id);
+    if (!pin.core()) return 0ULL;
+    std::lock_guard<std::mutex> lock(pin.step_lock());
+    return pin.core()->frame_count;
 }
 
 double gw_world_total_time(world_id id) {
-    world_core* core = fetch(id);
-    return core ? core->total_time : 0.0;
+    world_pin pin(id);
+    if (!pin.core()) return 0.0;
+    std::lock_guard<std::mutex> lock(pin.step_lock());
+    return pin.core()->total_time;
+}
+
+bool gw_enqueue_command(world_id id, const command_desc& desc) {
+    world_pin pin(id);
+    return pin.core() && command_queue_push(pin.core()->commands, desc, false, 0.0);
+}
+
+bool gw_schedule_event(world_id id, const event_desc& desc) {
+    world_pin pin(id);
+    return pin.core() && command_queue_push(pin.core()->commands, desc.command, true, desc.time);
+}
+
+bool gw_set_param(world_id id, std::string_view name, double value) {
+    world_pin pin(id);
+    if (!pin.core() || name.empty()) return false;
+    std::lock_guard<std::mutex> lock(pin.step_lock());
+    ps_set_double(&pin.core()->params, name, value);
+    if (!name.starts_with("lod.")) world_wake_domains(*pin.core(), 0);
+    return true;
+}
+
+double gw_get_param(world_id id, std::string_view name, double default_value) {
+    world_pin pin(id);
+    if (!pin.core()) return default_value;
+    std::lock_guard<std::mutex> lock(pin.step_lock());
+    double v = default_value;
+    return ps_get_double(&pin.core()->params, name, v) ? v : default_value;
+}
+
+bool gw_visit_world(world_id id, void (*fn)(world_core&, void* user), void* user) {
+    world_pin pin(id);
+    if (!pin.core() || !fn) return false;
+    std::lock_guard<std::mutex> lock(pin.step_lock());
+    fn(*pin.core(), user);
+    return true;
+}
+
+bool gw_save_world(world_id id, std::vector<std::uint8_t>& out, const snapshot_options& options) {
+    bool ok = false;
+    gw_with_world(id, [&](world_core& w) { ok = world_save_blob(w, out, options.compress_cold); });
+    return ok;
+}
+
+bool gw_load_world(world_id id, std::span<const std::uint8_t> blob) {
+    bool ok = false;
+    gw_with_world(id, [&](world_core& w) { ok = world_restore_blob(w, blob, builtin_contracts()); });
+    return ok;
+}
+
+bool gw_set_rollback_depth(world_id id, std::uint32_t frames) {
+    bool ok = false;
+    gw_with_world(id, [&](world_core& w) { ok = world_set_history_depth(w, frames, builtin_contracts()); });
+    return ok;
+}
+
+bool gw_rollback_world(world_id id, std::uint32_t frames) {
+    bool ok = false;
+    gw_with_world(id, [&](world_core& w) { ok = world_history_rollback(w, frames); });
+    return ok;
+}
+
+bool gw_set_profiling(world_id id, bool enabled, std::uint32_t ring_events) {
+    return gw_with_world(id, [&](world_core& w) {
+        w.telemetry.profiler = enabled ? std::make_unique<world_profiler>(ring_events, id.value) : nullptr;
+        w.telemetry.phases.clear();
+        w.telemetry.last_frame.phases      = nullptr;
+        w.telemetry.last_frame.phase_count = 0;
+    });
+}
+
+bool gw_export_chrome_trace(std::span<const world_id> ids, const char* path) {
+    std::string out;
+    json_trace_begin(out);
+    for (world_id id : ids) {
+        bool profiled = false;
+        if (!gw_with_world(id, [&](world_core& w) {
+                if (!w.telemetry.profiler) return;
+                json_trace_append(out, *w.telemetry.profiler);
+                profiled = true;
+            }) ||
+            !profiled)
+            return false;
+    }
+    json_trace_end(out);
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+    const bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+bool gw_open_telemetry_stream(world_id id, const telemetry_stream_desc& desc) {
+    const telemetry_format_ops& ops = desc.format == telemetry_format::json_lines ? json_lines_stream_format() : csv_stream_format();
+    bool ok = false;
+    gw_with_world(id, [&](world_core& w) {
+        if (w.telemetry.stream) w.telemetry.stream->finish();
+        w.telemetry.stream = telemetry_stream::open(desc, ops, id.value);
+        ok                 = w.telemetry.stream != nullptr;
+    });
+    return ok;
+}
+
+bool gw_close_telemetry_stream(world_id id) {
+    bool ok = false;
+    gw_with_world(id, [&](world_core& w) {
+        if (!w.telemetry.stream) return;
+        ok = w.telemetry.stream->finish();
+        w.telemetry.stream.reset();
+    });
+    return ok;
+}
+
+std::size_t gw_list_schedulers(world_id id, capability_record* buffer, std::size_t capacity) {
+    world_pin pin(id);
+    if (!pin.core()) return 0;
+    static const capability_record k_builtin[] = {{"serial"}, {"work_stealing"}};
+    std::size_t n = 0;
+    for (const auto& rec : k_builtin) {
+        if (buffer && n < capacity) buffer[n] = rec;
+        ++n;
+    }
+    if (task_pool_for(task_backend::tbb)) {
+        if (buffer && n < capacity) buffer[n] = capability_record{"tbb"};
+        ++n;
+    }
+    return n;
+}
+
+std::size_t gw_list_perf_layers(world_id id, capability_record* buffer, std::size_t capacity) {
+    world_pin pin(id);
+    if (!pin.core()) return 0;
+    // Indexed by simd_level; names must outlive the call.
+    static const char* const k_active[] = {"simd:automatic", "simd:scalar", "simd:sse42", "simd:avx2", "simd:avx512"};
+    static const char* const k_cpu[]    = {"cpu:automatic", "cpu:scalar", "cpu:sse42", "cpu:avx2", "cpu:avx512"};
+    const capability_record records[] = {
+        {k_active[static_cast<std::size_t>(pin.core()->config.simd)]},
+        {k_cpu[static_cast<std::size_t>(simd_detect())]},
+    };
+    std::size_t n = 0;
+    for (const auto& rec : records) {
+        if (buffer && n < capacity) buffer[n] = rec;
+        ++n;
+    }
+    return n;
+}
+
+const frame_stats* gw_last_frame_stats(world_id id) {
+    world_pin pin(id);
+    return pin.core() ? &pin.core()->telemetry.last_frame : nullptr;
 }
 
 } // namespace rphys
@@ -2,19 +2,69 @@
 #define RPHYS_GATEWAY_WORLD_HPP
 
 #include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 #include "rphys/forward.h"
 
 namespace rphys {
 
 struct world_core;
 struct world_config;
+struct frame_stats;
+struct command_desc;
+struct event_desc;
+struct capability_record;
+struct snapshot_options;
+struct telemetry_stream_desc;
 
 // Internal gateway (not part of public stable API) managing id<->pointer mapping.
+// Ids are generational: a destroyed world's id never resolves to a later world in the same slot.
+// All functions are safe to call concurrently from any thread.
 world_id gw_create_world(const world_desc& desc);
 void     gw_destroy_world(world_id id);
 void     gw_step_world(world_id id, double dt);
+void     gw_step_worlds(std::span<const world_id> ids, double dt);
 std::uint64_t gw_world_frame_count(world_id id);
 double   gw_world_total_time(world_id id);
+const frame_stats* gw_last_frame_stats(world_id id);
+
+// Queue producers: lock-free, never wait for a running step.
+bool     gw_enqueue_command(world_id id, const command_desc& desc);
+bool     gw_schedule_event(world_id id, const event_desc& desc);
+// Direct parameter access: waits for a running step of the same world to finish.
+bool     gw_set_param(world_id id, std::string_view name, double value);
+double   gw_get_param(world_id id, std::string_view name, double default_value);
+
+// Runs fn(world_core&, user) with the world pinned and its step lock held, i.e. never concurrently
+// with a step of the same world. Returns false for invalid or stale ids (fn is not called).
+bool     gw_visit_world(world_id id, void (*fn)(world_core&, void* user), void* user);
+
+template <class Fn>
+bool gw_with_world(world_id id, Fn&& fn) {
+    return gw_visit_world(id, [](world_core& w, void* u) { (*static_cast<std::remove_reference_t<Fn>*>(u))(w); }, &fn);
+}
+
+// Checkpoints and rollback; contract types in snapshots resolve against the built-in tables.
+bool     gw_save_world(world_id id, std::vector<std::uint8_t>& out, const snapshot_options& options);
+bool     gw_load_world(world_id id, std::span<const std::uint8_t> blob);
+bool     gw_set_rollback_depth(world_id id, std::uint32_t frames);
+bool     gw_rollback_world(world_id id, std::uint32_t frames);
+
+// Phase profiler: enabling replaces any existing rings, disabling frees them.
+bool     gw_set_profiling(world_id id, bool enabled, std::uint32_t ring_events);
+// Fails without writing if any world is invalid or not profiling.
+bool     gw_export_chrome_trace(std::span<const world_id> ids, const char* path);
+// Per-frame telemetry file stream; opening replaces (and drains) an open stream.
+bool     gw_open_telemetry_stream(world_id id, const telemetry_stream_desc& desc);
+bool     gw_close_telemetry_stream(world_id id);
+
+// Names of the frame schedulers a world can be created with (see world_desc::scheduler).
+std::size_t gw_list_schedulers(world_id id, capability_record* buffer, std::size_t capacity);
+// Active SIMD level of the world, then the best level of the CPU.
+std::size_t gw_list_perf_layers(world_id id, capability_record* buffer, std::size_t capacity);
 
 } // namespace rphys
 
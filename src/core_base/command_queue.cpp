@@ -0,0 +1,44 @@
+#include "command_queue.hpp"
+#include <bit>
+#include <cstring>
+
+namespace rphys {
+
+world_command_queue::world_command_queue(std::size_t capacity) : ring(capacity) {
+    pending_events.reserve(ring.capacity());
+}
+
+bool event_fires_after(const command_record& a, const command_record& b) {
+    if (a.time != b.time) return a.time > b.time;
+    return a.sequence > b.sequence;
+}
+
+// Bit test rather than std::isfinite, which fast-math builds may fold away.
+bool event_time_valid(double time) {
+    constexpr std::uint64_t exponent = 0x7ff0000000000000ull;
+    return (std::bit_cast<std::uint64_t>(time) & exponent) != exponent;
+}
+
+bool command_queue_push(world_command_queue& q, const command_desc& desc, bool timed, double time) {
+    if (timed && !event_time_valid(time)) return false;
+    command_record rec;
+    if (desc.name) {
+        std::size_t len = std::strlen(desc.name);
+        if (len >= command_name_capacity) return false;
+        std::memcpy(rec.name, desc.name, len);
+    }
+    rec.kind   = desc.kind;
+    rec.timed  = timed;
+    rec.domain = desc.domain.value;
+    rec.index  = desc.index;
+    rec.time   = time;
+    for (int i = 0; i < 4; ++i) rec.value[i] = desc.value[i];
+
+    if (!q.ring.try_push(rec)) {
+        q.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+} // namespace rphys
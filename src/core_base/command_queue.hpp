@@ -0,0 +1,133 @@
+#ifndef RPHYS_COMMAND_QUEUE_HPP
+#define RPHYS_COMMAND_QUEUE_HPP
+
+#include "rphys/api_commands.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace rphys {
+
+// Bounded multi-producer / single-consumer ring (Vyukov-style per-cell sequence numbers).
+// Producers claim a slot with one CAS and never block; a full ring makes try_push fail.
+template <class T>
+class mpsc_ring {
+public:
+    explicit mpsc_ring(std::size_t capacity) {
+        std::size_t n = std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity);
+        cells_        = std::make_unique<cell[]>(n);
+        mask_         = n - 1;
+        for (std::size_t i = 0; i < n; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    bool try_push(const T& value) {
+        std::uint64_t pos = tail_.load(std::memory_order_relaxed);
+        cell* c           = nullptr;
+        for (;;) {
+            c                  = &cells_[pos & mask_];
+            std::uint64_t seq  = c->seq.load(std::memory_order_acquire);
+            std::int64_t  diff = static_cast<std::int64_t>(seq - pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        c->value = value;
+        c->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. Items leave in slot-claim order; stops at the first slot whose producer has
+    // not finished publishing yet (it is picked up by the next drain).
+    bool try_pop(T& out) {
+        cell& c = cells_[head_ & mask_];
+        if (c.seq.load(std::memory_order_acquire) != head_ + 1) return false;
+        out = c.value;
+        c.seq.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+
+private:
+    struct cell {
+        std::atomic<std::uint64_t> seq{0};
+        T                          value{};
+    };
+    std::unique_ptr<cell[]> cells_;
+    std::size_t             mask_{0};
+    alignas(64) std::atomic<std::uint64_t> tail_{0}; // shared by producers
+    alignas(64) std::uint64_t head_{0};              // consumer private
+};
+
+// Queue record for both immediate commands and timed events.
+struct command_record {
+    command_kind  kind{command_kind::set_param};
+    bool          timed{false};
+    std::uint32_t domain{0};
+    std::uint32_t index{0};
+    std::uint64_t sequence{0}; // dequeue order; tie-breaker for events sharing a timestamp
+    double        time{0.0};
+    double        value[4]{};
+    char          name[command_name_capacity]{};
+
+    std::string_view name_view() const { return std::string_view(name); }
+};
+
+struct world_command_queue {
+    mpsc_ring<command_record>   ring;
+    std::vector<command_record> pending_events; // consumer-side min-heap on (time, sequence); never outgrows ring capacity
+    std::uint64_t               next_sequence{0};
+    std::atomic<std::uint64_t>  dropped{0};     // pushes rejected by a full ring, events rejected by a full heap
+
+    explicit world_command_queue(std::size_t capacity);
+};
+
+// Producer side (any thread). Copies `desc` into a fixed record; never allocates or blocks. Fails
+// without counting a drop for names that do not fit and timed records with an invalid time.
+bool command_queue_push(world_command_queue&, const command_desc& desc, bool timed, double time);
+
+// Heap order for pending events: the earliest (time, sequence) sits at the front.
+bool event_fires_after(const command_record& a, const command_record& b);
+
+// Event times must be finite: NaN breaks the strict weak order event_fires_after relies on.
+bool event_time_valid(double time);
+
+// Consumer side (stepping thread). Moves every published record into `immediate` (enqueue order)
+// or the pending event heap, then appends events due at `step_end_time` to `immediate`. The heap
+// holds at most ring capacity events (reserved up front, so draining never allocates); a timed
+// record arriving at a full heap is dropped and counted like a full ring.
+template <class Alloc>
+void command_queue_drain(world_command_queue& q, std::vector<command_record, Alloc>& immediate, double step_end_time) {
+    command_record rec;
+    while (q.ring.try_pop(rec)) {
+        rec.sequence = q.next_sequence++;
+        if (!rec.timed) {
+            immediate.push_back(rec);
+            continue;
+        }
+        if (q.pending_events.size() >= q.ring.capacity()) {
+            q.dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        q.pending_events.push_back(rec);
+        std::push_heap(q.pending_events.begin(), q.pending_events.end(), event_fires_after);
+    }
+    while (!q.pending_events.empty() && q.pending_events.front().time <= step_end_time) {
+        std::pop_heap(q.pending_events.begin(), q.pending_events.end(), event_fires_after);
+        immediate.push_back(q.pending_events.back());
+        q.pending_events.pop_back();
+    }
+}
+
+} // namespace rphys
+
+#endif // RPHYS_COMMAND_QUEUE_HPP
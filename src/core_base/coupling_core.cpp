@@ -0,0 +1,28 @@
+#include "coupling_core.hpp"
+#include <new>
+
+namespace rphys {
+
+coupling_core* create_coupling_core(const coupling_contract* contract, std::uint32_t id, std::uint32_t first, std::uint32_t second) {
+    if (!contract || !contract->create || !contract->destroy || !contract->exchange) return nullptr;
+    coupling_core* c = new (std::nothrow) coupling_core{};
+    if (!c) return nullptr;
+    c->id         = id;
+    c->contract   = contract;
+    c->domains[0] = first;
+    c->domains[1] = second;
+    c->state      = contract->create(c->domains);
+    if (!c->state) {
+        delete c;
+        return nullptr;
+    }
+    return c;
+}
+
+void destroy_coupling_core(coupling_core* c) noexcept {
+    if (!c) return;
+    c->contract->destroy(c->state);
+    delete c;
+}
+
+} // namespace rphys
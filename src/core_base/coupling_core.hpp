@@ -0,0 +1,51 @@
+#ifndef RPHYS_COUPLING_CORE_HPP
+#define RPHYS_COUPLING_CORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "domain_core.hpp"
+
+namespace rphys {
+
+// Field referenced by a coupling: `endpoint` 0 is the binding's first domain, 1 the second.
+struct coupling_field {
+    std::uint8_t endpoint{0};
+    const char*  name{nullptr};
+};
+
+// Coupling contract (see README "Core Internal Contracts"). Couplings only see domains through
+// the field bus; their declared field sets order them against domain phases in the frame graph.
+struct coupling_contract {
+    const char*           type{nullptr};
+    const char*           endpoint_types[2]{}; // expected domain types, checked at registration
+    const coupling_field* reads{nullptr};
+    std::size_t           read_count{0};
+    const coupling_field* writes{nullptr};
+    std::size_t           write_count{0};
+    phase_stage           stage{phase_stage::exchange};
+    void* (*create)(const std::uint32_t domains[2]){nullptr};
+    void  (*destroy)(void* state){nullptr};
+    // Returning false detaches the coupling; the domains keep stepping.
+    bool  (*exchange)(void* state, const field_bus&, step_context&){nullptr};
+    // Optional checkpoint hooks for couplings that carry state across frames (caches, warm starts);
+    // same stream rules as domain_pipeline_contract::save_state / load_state.
+    void  (*save_state)(const void* state, snapshot_writer&){nullptr};
+    bool  (*load_state)(void* state, snapshot_reader&){nullptr};
+};
+
+struct coupling_core {
+    std::uint32_t            id{0};
+    const coupling_contract* contract{nullptr};
+    void*                    state{nullptr};
+    std::uint32_t            domains[2]{};
+    bool                     detached{false};
+    bool                     active{true};  // this pass: both endpoints step (world_activity_pass)
+    double                   step_dt{0.0};
+};
+
+coupling_core* create_coupling_core(const coupling_contract*, std::uint32_t id, std::uint32_t first, std::uint32_t second);
+void destroy_coupling_core(coupling_core*) noexcept;
+
+} // namespace rphys
+
+#endif // RPHYS_COUPLING_CORE_HPP
@@ -0,0 +1,176 @@
+#include "domain_activity.hpp"
+#include "vec_math.hpp"
+#include "world_core.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace rphys {
+
+namespace {
+    // Reads element i of an f32 x3 (or wider) field.
+    vec3f element3(const field_bus_entry& f, std::size_t i) {
+        vec3f v;
+        std::memcpy(&v, static_cast<const char*>(f.data) + i * f.stride, sizeof(vec3f));
+        return v;
+    }
+
+    const field_bus_entry* vec3_field(const world_core& w, const domain_core& d, const char* suffix) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s.%s", d.contract->type, suffix);
+        const field_bus_entry* f = find_field(&w.fields, d.id, name);
+        return f && f->data && f->scalar == field_scalar::f32 && f->components >= 3 && f->stride >= sizeof(vec3f) ? f : nullptr;
+    }
+
+    // Mean 0.5 |v|^2 of "<type>.velocity" (rigid domains: "<type>.linear_velocity"); negative when
+    // the domain exports neither, which keeps it from ever settling.
+    float kinetic_energy(const world_core& w, const domain_core& d) {
+        const field_bus_entry* v = vec3_field(w, d, "velocity");
+        if (!v) v = vec3_field(w, d, "linear_velocity");
+        if (!v) return -1.0f;
+        if (v->count == 0) return 0.0f;
+        double sum = 0.0;
+        for (std::size_t i = 0; i < v->count; ++i) sum += length_sq(element3(*v, i));
+        return static_cast<float>(0.5 * sum / static_cast<double>(v->count));
+    }
+
+    // Distance from the camera to the bounds of "<type>.position"; 0 inside them or without positions.
+    float camera_distance(const world_core& w, const domain_core& d, vec3f camera) {
+        const field_bus_entry* x = vec3_field(w, d, "position");
+        if (!x || x->count == 0) return 0.0f;
+        vec3f lo = element3(*x, 0), hi = lo;
+        for (std::size_t i = 1; i < x->count; ++i) {
+            const vec3f p = element3(*x, i);
+            lo = vec3f{std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z)};
+            hi = vec3f{std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z)};
+        }
+        const vec3f gap{std::max({lo.x - camera.x, 0.0f, camera.x - hi.x}), std::max({lo.y - camera.y, 0.0f, camera.y - hi.y}),
+                        std::max({lo.z - camera.z, 0.0f, camera.z - hi.z})};
+        return length(gap);
+    }
+
+    float param_or(const param_store& ps, std::string_view key, float fallback) {
+        double v = fallback;
+        return ps_get_double(&ps, key, v) ? static_cast<float>(v) : fallback;
+    }
+
+    std::uint32_t own_interval(const domain_activity& a) {
+        if (!a.enabled) return 1;
+        float importance = a.importance;
+        if (a.use_camera && a.distance > a.near_distance) importance *= a.near_distance / a.distance;
+        const std::uint32_t coarsest = std::max(a.max_interval, 1u);
+        if (!(importance > 0.0f)) return coarsest;
+        const float frames = std::floor(1.0f / std::min(importance, 1.0f) + 1e-4f);
+        return frames >= static_cast<float>(coarsest) ? coarsest : std::max(static_cast<std::uint32_t>(frames), 1u);
+    }
+
+    // Substeps a folded step of `pending` needs: never coarser than the frame dt, otherwise bounded
+    // by the contract's stability limit and the user's max_step.
+    std::uint32_t fold_substeps(const world_core& w, const domain_core& d, double pending, double dt) {
+        double limit = d.activity.max_step > 0.0 ? d.activity.max_step : 0.0;
+        if (d.contract->stable_dt && !d.inert) {
+            const double stable = d.contract->stable_dt(d.state, w.params);
+            if (stable > 0.0) limit = limit > 0.0 ? std::min(limit, stable) : stable;
+        }
+        if (!(limit > 0.0)) return 1;
+        return static_cast<std::uint32_t>(std::max(std::ceil(pending / std::max(limit, dt) - 1e-9), 1.0));
+    }
+
+    std::size_t group_root(frame_vector<std::uint32_t>& parent, std::size_t i) {
+        while (parent[i] != i) i = parent[i] = parent[parent[i]];
+        return i;
+    }
+} // namespace
+
+void domain_activity_wake(domain_activity& a) {
+    a.asleep     = false;
+    a.settled    = 0;
+    a.pending_dt = 0.0;
+}
+
+std::uint32_t world_plan_activity(world_core& w, double dt) {
+    const bool any = std::any_of(w.domains.begin(), w.domains.end(), [](const domain_core* d) { return d->activity.enabled; });
+    if (!any) {
+        for (domain_core* d : w.domains) {
+            d->activity.substeps = 1;
+            d->activity.dt       = dt;
+        }
+        return 1;
+    }
+
+    const std::size_t n = w.domains.size();
+    auto index_of = [&](std::uint32_t id) {
+        auto it = std::lower_bound(w.domains.begin(), w.domains.end(), id, [](const domain_core* d, std::uint32_t v) { return d->id < v; });
+        return static_cast<std::size_t>(it - w.domains.begin());
+    };
+    frame_vector<std::uint32_t> parent{frame_allocator<std::uint32_t>(world_scratch(w))};
+    parent.resize(n);
+    for (std::size_t i = 0; i < n; ++i) parent[i] = static_cast<std::uint32_t>(i);
+    for (const coupling_core* c : w.couplings) {
+        if (c->detached) continue;
+        const std::size_t a = group_root(parent, index_of(c->domains[0])), b = group_root(parent, index_of(c->domains[1]));
+        parent[std::max(a, b)] = static_cast<std::uint32_t>(std::min(a, b));
+    }
+
+    // Measure after the last step, then fold every member into its group root.
+    const vec3f camera{param_or(w.params, "lod.camera.x", 0.0f), param_or(w.params, "lod.camera.y", 0.0f), param_or(w.params, "lod.camera.z", 0.0f)};
+    frame_vector<std::uint32_t> interval{frame_allocator<std::uint32_t>(world_scratch(w))};
+    frame_vector<std::uint8_t>  settled{frame_allocator<std::uint8_t>(world_scratch(w))};
+    interval.assign(n, 0xffffffffu);
+    settled.assign(n, 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        domain_activity& a = w.domains[i]->activity;
+        if (a.enabled && a.substeps > 0 && !w.domains[i]->inert) {
+            a.energy  = kinetic_energy(w, *w.domains[i]);
+            a.settled = a.sleep_energy > 0.0f && a.energy >= 0.0f && a.energy < a.sleep_energy ? a.settled + 1 : 0;
+        }
+        if (a.enabled && a.use_camera) a.distance = camera_distance(w, *w.domains[i], camera);
+        const std::size_t root = group_root(parent, i);
+        interval[root] = std::min(interval[root], own_interval(a));
+        if (!a.enabled || a.sleep_energy <= 0.0f || a.settled < std::max(a.sleep_frames, 1u)) settled[root] = 0;
+    }
+
+    // Groups step together, so a group takes as many substeps as its most constrained member.
+    frame_vector<std::uint32_t> substeps{frame_allocator<std::uint32_t>(world_scratch(w))};
+    substeps.assign(n, 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        domain_activity&  a    = w.domains[i]->activity;
+        const std::size_t root = group_root(parent, i);
+        a.interval = interval[root];
+        a.substeps = 0;
+        if (settled[root]) {
+            a.asleep     = true;
+            a.pending_dt = 0.0;
+            continue;
+        }
+        if (a.asleep) domain_activity_wake(a);
+        a.pending_dt += dt;
+        if (w.frame_count % a.interval != 0) continue;
+        a.substeps = 1;
+        if (a.pending_dt > dt) substeps[root] = std::max(substeps[root], fold_substeps(w, *w.domains[i], a.pending_dt, dt));
+    }
+
+    std::uint32_t passes = 1;
+    for (std::size_t i = 0; i < n; ++i) {
+        domain_activity& a = w.domains[i]->activity;
+        if (a.substeps == 0) continue;
+        a.substeps   = substeps[group_root(parent, i)];
+        a.dt         = a.substeps == 1 ? a.pending_dt : a.pending_dt / a.substeps;
+        a.pending_dt = 0.0;
+        passes       = std::max(passes, a.substeps);
+    }
+    return passes;
+}
+
+void world_activity_pass(world_core& w, std::uint32_t pass) {
+    for (domain_core* d : w.domains) d->activity.run = pass < d->activity.substeps;
+    for (coupling_core* c : w.couplings) {
+        const domain_core* a = world_find_domain(w, c->domains[0]);
+        const domain_core* b = world_find_domain(w, c->domains[1]);
+        c->active  = a && b && a->activity.run && b->activity.run;
+        c->step_dt = a && b ? std::min(a->activity.dt, b->activity.dt) : 0.0;
+    }
+}
+
+} // namespace rphys
@@ -0,0 +1,52 @@
+#ifndef RPHYS_DOMAIN_ACTIVITY_HPP
+#define RPHYS_DOMAIN_ACTIVITY_HPP
+
+#include <cstdint>
+
+namespace rphys {
+
+struct world_core;
+
+// Level of detail and sleeping of one domain (README "Activity & LOD"). The settings mirror
+// domain_activity_desc; the rest is planner state. Domains without settings step every frame.
+struct domain_activity {
+    bool          enabled{false};
+    float         importance{1.0f};
+    bool          use_camera{false};
+    float         near_distance{5.0f};
+    std::uint32_t max_interval{8};
+    float         sleep_energy{0.0f};
+    std::uint32_t sleep_frames{30};
+    double        max_step{0.0}; // longest folded step before it is split into substeps; 0: none
+
+    std::uint32_t interval{1};    // frames per step of the domain's group
+    bool          asleep{false};
+    std::uint32_t settled{0};     // consecutive steps that ended below sleep_energy
+    float         energy{0.0f};   // mean 0.5 |v|^2 after the last step
+    float         distance{0.0f}; // from the LOD camera to the domain's bounds
+    double        pending_dt{0.0};
+
+    std::uint32_t substeps{1}; // this frame, set by world_plan_activity; 0 while skipped
+    double        dt{0.0};     // per substep
+    bool          run{true};   // this pass, set by world_activity_pass
+};
+
+// Clears the sleep state; the domain's group steps again from the next frame.
+void domain_activity_wake(domain_activity&);
+
+// Decides which domains run this frame, with how many substeps of which dt, and returns the
+// number of passes the frame needs (at least 1). Domains linked by a live coupling form a group
+// that steps at the finest interval of its members and sleeps only once every member has
+// settled, so an active partner keeps the whole group awake. Skipped frames accumulate into the
+// dt of the next step; frames slept through are dropped. A folded step longer than both the
+// frame dt and the domain's limit (contract stable_dt, max_step) is split into the fewest equal
+// substeps under that limit, so reduced rates never step coarser than the full rate would.
+std::uint32_t world_plan_activity(world_core&, double dt);
+
+// Marks the domains and couplings that run in `pass` of the current plan. Couplings run when
+// both endpoints do, with the smaller of their substep dts.
+void world_activity_pass(world_core&, std::uint32_t pass);
+
+} // namespace rphys
+
+#endif // RPHYS_DOMAIN_ACTIVITY_HPP
@@ -1,4 +1,26 @@
 #include "domain_core.hpp"
+#include <new>
 
-// skeleton only
+namespace rphys {
 
+domain_core* create_domain_core(const domain_pipeline_contract* contract, std::uint32_t id) {
+    if (!contract || !contract->create || !contract->destroy) return nullptr;
+    domain_core* d = new (std::nothrow) domain_core{};
+    if (!d) return nullptr;
+    d->id       = id;
+    d->contract = contract;
+    d->state    = contract->create(id);
+    if (!d->state) {
+        delete d;
+        return nullptr;
+    }
+    return d;
+}
+
+void destroy_domain_core(domain_core* d) noexcept {
+    if (!d) return;
+    d->contract->destroy(d->state);
+    delete d;
+}
+
+} // namespace rphys
@@ -1,11 +1,164 @@
 #ifndef RPHYS_DOMAIN_CORE_HPP
 #define RPHYS_DOMAIN_CORE_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "domain_activity.hpp"
+#include "frame_arena.hpp"
+#include "rphys/api_scene.h"
+
 namespace rphys {
 
-struct domain_core;
+struct world_core;
+struct world_profiler;
+struct field_bus;
+struct param_store;
+struct command_record;
+struct scene_file;
+class scene_file_writer;
+class snapshot_writer;
+class snapshot_reader;
+
+using range_fn = void (*)(void* user, std::size_t begin, std::size_t end);
+
+// Data-parallel loop service handed to phases by the active scheduler, so domains and couplings
+// never include a scheduler header. The serial scheduler runs the range inline.
+struct parallel_executor {
+    void*       self{nullptr};
+    void        (*run)(void* self, std::size_t count, std::size_t grain, range_fn fn, void* user){nullptr};
+    std::size_t concurrency{1};
+};
+
+template <class Fn>
+void parallel_for(const parallel_executor& exec, std::size_t count, std::size_t grain, Fn&& fn) {
+    using fn_type = std::remove_reference_t<Fn>;
+    if (count == 0) return;
+    if (!exec.run || exec.concurrency <= 1 || count <= grain) {
+        fn(std::size_t{0}, count);
+        return;
+    }
+    void* user = const_cast<std::remove_const_t<fn_type>*>(&fn);
+    exec.run(exec.self, count, grain, [](void* u, std::size_t begin, std::size_t end) { (*static_cast<fn_type*>(u))(begin, end); }, user);
+}
+
+struct step_context {
+    world_core*       world{nullptr};
+    double            dt{0.0};
+    double            time{0.0}; // sim time at the start of the step
+    std::uint64_t     frame{0};
+    const param_store* params{nullptr}; // world parameters; read-only while phases run
+    determinism_level  determinism{determinism_level::fast};
+    simd_level         simd{simd_level::scalar}; // resolved level for simd_kernels_for
+    world_profiler*    profiler{nullptr};        // null unless profiling (core_base/telemetry_core.hpp)
+    parallel_executor  exec{};
+};
+
+inline bool ordered_merges(const step_context& ctx) { return ctx.determinism != determinism_level::fast; }
+
+// Scratch arena of the calling thread for the world being stepped; nullptr outside a world step
+// (standalone callers with a default step_context).
+frame_arena* step_scratch(const step_context&);
+// step_scratch, or `fallback` (usually a local arena) outside a world step.
+inline frame_arena& step_scratch_or(const step_context& ctx, frame_arena& fallback) {
+    frame_arena* scratch = step_scratch(ctx);
+    return scratch ? *scratch : fallback;
+}
+
+// Reduces fn(begin, end) -> T over [0, count). At task_stable and above the range is cut into
+// fixed chunks of `grain` items whose partials are combined left to right in chunk order, so the
+// result is the same for any thread count (including the serial scheduler); the partials live in
+// the step's frame arena. Under fast, partials are combined in completion order.
+template <class T, class Fn, class Combine>
+T parallel_reduce(const step_context& ctx, std::size_t count, std::size_t grain, T identity, Fn&& fn, Combine&& combine) {
+    if (count == 0) return identity;
+    grain = grain ? grain : 1;
+    if (ordered_merges(ctx)) {
+        const std::size_t chunks = (count + grain - 1) / grain;
+        auto ordered = [&](auto& partial) {
+            parallel_for(ctx.exec, chunks, 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t c = begin; c < end; ++c) partial[c] = fn(c * grain, c * grain + grain < count ? c * grain + grain : count);
+            });
+            T result = identity;
+            for (const T& p : partial) result = combine(result, p);
+            return result;
+        };
+        if (frame_arena* scratch = step_scratch(ctx)) {
+            frame_vector<T> partial(chunks, identity, frame_allocator<T>(*scratch));
+            return ordered(partial);
+        }
+        std::vector<T> partial(chunks, identity);
+        return ordered(partial);
+    }
+    T          result = identity;
+    std::mutex merge;
+    parallel_for(ctx.exec, count, grain, [&](std::size_t begin, std::size_t end) {
+        T part = fn(begin, end);
+        std::lock_guard<std::mutex> lock(merge);
+        result = combine(result, part);
+    });
+    return result;
+}
+
+// Canonical position of a phase inside a frame. The serial order of a frame is
+// (stage, domains before couplings, owner id, declaration index); schedulers may reorder
+// anything whose declared field sets do not conflict.
+enum class phase_stage : std::uint8_t { prepare, solve, exchange, finalize };
+
+// One schedulable unit of a domain pipeline. `reads` / `writes` name fields of the owning domain
+// (e.g. "cloth.position"); they are the only dependency information the scheduler uses.
+struct domain_phase {
+    const char*        name{nullptr};
+    phase_stage        stage{phase_stage::solve};
+    const char* const* reads{nullptr};
+    std::size_t        read_count{0};
+    const char* const* writes{nullptr};
+    std::size_t        write_count{0};
+    void               (*run)(void* state, step_context&){nullptr};
+};
+
+// Domain pipeline contract (see README "Core Internal Contracts"). The contract owns `state`:
+// create allocates it, destroy frees it. Hooks other than create/destroy may be null.
+struct domain_pipeline_contract {
+    const char* type{nullptr};
+    void*       (*create)(std::uint32_t domain){nullptr};
+    void        (*destroy)(void* state){nullptr};
+    bool        (*build_static)(void* state, const scene_primitive_list&){nullptr};
+    bool        (*apply_command)(void* state, const command_record&){nullptr};
+    // Publishes views of the domain's fields; called after build_static and after every step.
+    void        (*export_fields)(void* state, field_bus&){nullptr};
+    const domain_phase* phases{nullptr};
+    std::size_t         phase_count{0};
+    // Binary scene files (core_base/scene_file.hpp). cook_scene appends the domain's precomputed
+    // sections for the input; load_scene rebuilds from a mapped file. Without load_scene the world
+    // feeds the file's primitive records to build_static.
+    bool                (*cook_scene)(const scene_primitive_list&, std::span<const scene_mesh>, scene_file_writer&){nullptr};
+    bool                (*load_scene)(void* state, const scene_file&){nullptr};
+    // Checkpoints (core_base/world_snapshot.hpp). save_state writes everything a step reads into
+    // the hot / cold streams; load_state reads it back in the same order into a fresh state and
+    // rejects inconsistent data. Required for worlds that are saved or rolled back.
+    void                (*save_state)(const void* state, snapshot_writer&){nullptr};
+    bool                (*load_state)(void* state, snapshot_reader&){nullptr};
+    // Largest dt the domain's integrator is stable at from its current state (0: no bound).
+    // Only consulted when reduced-rate stepping folds several frames into one step.
+    double              (*stable_dt)(const void* state, const param_store&){nullptr};
+};
+
+struct domain_core {
+    std::uint32_t                   id{0};
+    const domain_pipeline_contract* contract{nullptr};
+    void*                           state{nullptr};
+    bool                            inert{false}; // set when build_static fails; phases are skipped
+    domain_activity                 activity{};   // LOD / sleeping; decides whether phases run this frame
+};
+
+// Returns nullptr when the contract is incomplete or its create hook fails.
+domain_core* create_domain_core(const domain_pipeline_contract*, std::uint32_t id);
+void destroy_domain_core(domain_core*) noexcept;
 
 } // namespace rphys
 
 #endif // RPHYS_DOMAIN_CORE_HPP
-
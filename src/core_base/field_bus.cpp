@@ -1,4 +1,78 @@
 #include "field_bus.hpp"
+#include <algorithm>
+#include <cstring>
 
-// skeleton only
+namespace rphys {
 
+void register_field(field_bus* bus, const field_bus_entry& entry) {
+    if (!bus || !entry.name) return;
+    for (auto& e : bus->entries) {
+        if (e.domain == entry.domain && std::string_view(e.name) == entry.name) {
+            e = entry;
+            return;
+        }
+    }
+    bus->entries.push_back(entry);
+}
+
+void unregister_domain_fields(field_bus* bus, std::uint32_t domain) {
+    if (!bus) return;
+    std::erase_if(bus->entries, [&](const field_bus_entry& e) { return e.domain == domain; });
+}
+
+const field_bus_entry* find_field(const field_bus* bus, std::string_view name) {
+    if (!bus) return nullptr;
+    for (const auto& e : bus->entries) {
+        if (name == e.name) return &e;
+    }
+    return nullptr;
+}
+
+const field_bus_entry* find_field(const field_bus* bus, std::uint32_t domain, std::string_view name) {
+    if (!bus) return nullptr;
+    for (const auto& e : bus->entries) {
+        if (e.domain == domain && name == e.name) return &e;
+    }
+    return nullptr;
+}
+
+void export_field(field_bus* bus, std::uint32_t domain, const char* name, void* data, std::size_t count, field_scalar scalar,
+                  std::uint8_t components, bool writable, std::size_t stride) {
+    field_bus_entry e{};
+    e.name         = name;
+    e.data         = data;
+    e.count        = count;
+    e.stride       = stride ? stride : field_scalar_size(scalar) * components;
+    e.domain       = domain;
+    e.scalar       = scalar;
+    e.components   = components;
+    e.mutable_data = writable ? data : nullptr;
+    register_field(bus, e);
+}
+
+std::size_t field_scalar_size(field_scalar s) {
+    switch (s) {
+        case field_scalar::f64: return 8;
+        case field_scalar::f32:
+        case field_scalar::u32:
+        case field_scalar::i32: return 4;
+    }
+    return 0;
+}
+
+bool field_write_element(const field_bus_entry& e, std::size_t index, const double* values, std::size_t value_count) {
+    if (!e.mutable_data || index >= e.count || !values) return false;
+    auto* base          = static_cast<std::byte*>(e.mutable_data) + index * e.stride;
+    const std::size_t n = std::min<std::size_t>(e.components, value_count);
+    for (std::size_t c = 0; c < n; ++c) {
+        switch (e.scalar) {
+            case field_scalar::f32: reinterpret_cast<float*>(base)[c] = static_cast<float>(values[c]); break;
+            case field_scalar::f64: reinterpret_cast<double*>(base)[c] = values[c]; break;
+            case field_scalar::u32: reinterpret_cast<std::uint32_t*>(base)[c] = static_cast<std::uint32_t>(values[c]); break;
+            case field_scalar::i32: reinterpret_cast<std::int32_t*>(base)[c] = static_cast<std::int32_t>(values[c]); break;
+        }
+    }
+    return true;
+}
+
+} // namespace rphys
@@ -2,24 +2,45 @@
 #define RPHYS_FIELD_BUS_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <string_view>
+#include <vector>
 
 namespace rphys {
 
+enum class field_scalar : std::uint8_t { f32, f64, u32, i32 };
+
 struct field_bus_entry {
     const char* name{};
     const void* data{};
     std::size_t count{};
-    std::size_t stride{};
+    std::size_t stride{};           // bytes between consecutive elements
+    std::uint32_t domain{};         // owning domain id (0 = world level)
+    field_scalar  scalar{field_scalar::f32};
+    std::uint8_t  components{1};    // scalars per element (3 for positions)
+    void*         mutable_data{};   // same memory as `data` when outside writes are allowed, else null
 };
 
-struct field_bus;
+// Named, non-owning views exported by domains. Entries are re-registered whenever the owner
+// reallocates, so consumers look fields up per step instead of caching pointers.
+struct field_bus {
+    std::vector<field_bus_entry> entries;
+};
 
-// Registration / lookup interfaces (no implementation in skeleton)
+// Registration / lookup interfaces. Registering an existing (domain, name) pair replaces it.
 void register_field(field_bus*, const field_bus_entry&);
+void unregister_domain_fields(field_bus*, std::uint32_t domain);
 const field_bus_entry* find_field(const field_bus*, std::string_view name);
+const field_bus_entry* find_field(const field_bus*, std::uint32_t domain, std::string_view name);
+
+// Exporter shorthand: registers `count` elements of `components` scalars each; stride 0 = packed.
+void export_field(field_bus*, std::uint32_t domain, const char* name, void* data, std::size_t count, field_scalar scalar,
+                  std::uint8_t components, bool writable, std::size_t stride = 0);
+
+std::size_t field_scalar_size(field_scalar);
+// Writes `values[0..components)` into element `index`, converting to the field's scalar type.
+bool field_write_element(const field_bus_entry&, std::size_t index, const double* values, std::size_t value_count);
 
 } // namespace rphys
 
 #endif // RPHYS_FIELD_BUS_HPP
-
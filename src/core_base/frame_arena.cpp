@@ -0,0 +1,131 @@
+#include "frame_arena.hpp"
+#include <algorithm>
+#include <bit>
+#include <new>
+
+namespace rphys {
+
+namespace {
+    constexpr std::size_t k_min_block_bytes = 64 * 1024;
+    constexpr std::size_t k_block_align     = 64;
+
+    std::byte* allocate_block(std::size_t size) {
+        return static_cast<std::byte*>(::operator new(size, std::align_val_t{k_block_align}, std::nothrow));
+    }
+
+    void free_block(frame_arena::block& b) noexcept {
+        ::operator delete(b.data, std::align_val_t{k_block_align});
+        b = {};
+    }
+
+    std::size_t align_up(std::size_t v, std::size_t a) {
+        return (v + a - 1) & ~(a - 1);
+    }
+
+    std::atomic<std::uint64_t> g_next_set_serial{1};
+
+    struct local_cache {
+        std::uint64_t serial{0};
+        frame_arena*  arena{nullptr};
+    };
+    thread_local local_cache   t_cache;
+    thread_local std::uint64_t t_heap_allocs{0};
+} // namespace
+
+frame_arena::~frame_arena() {
+    for (auto& b : blocks) free_block(b);
+}
+
+void* frame_arena_alloc(frame_arena& a, std::size_t bytes, std::size_t align) {
+    if (bytes == 0) bytes = 1;
+    align = std::max<std::size_t>(align, 1);
+    while (a.active < a.blocks.size()) {
+        frame_arena::block& b = a.blocks[a.active];
+        std::size_t start     = align_up(reinterpret_cast<std::uintptr_t>(b.data) + a.offset, align) - reinterpret_cast<std::uintptr_t>(b.data);
+        if (start + bytes <= b.size) {
+            a.frame_bytes += (start - a.offset) + bytes;
+            a.offset = start + bytes;
+            return b.data + start;
+        }
+        // Spill into the next block; the unused tail still counts so the coalesced block fits.
+        a.frame_bytes += b.size - a.offset;
+        ++a.active;
+        a.offset = 0;
+    }
+    std::size_t size = std::max(k_min_block_bytes, std::bit_ceil(bytes + align));
+    std::byte* data  = allocate_block(size);
+    if (!data) return nullptr;
+    a.blocks.push_back({data, size});
+    ++a.frame_heap_allocs;
+    ++t_heap_allocs;
+    a.active = a.blocks.size() - 1;
+    a.offset = 0;
+    return frame_arena_alloc(a, bytes, align);
+}
+
+void frame_arena_reset(frame_arena& a) {
+    a.high_water = std::max(a.high_water, a.frame_bytes);
+    if (a.blocks.size() > 1) {
+        // The frame outgrew the primary block: replace all blocks with one that fits it.
+        std::size_t size = std::bit_ceil(std::max(a.frame_bytes, k_min_block_bytes));
+        for (auto& b : a.blocks) free_block(b);
+        a.blocks.clear();
+        if (std::byte* data = allocate_block(size)) a.blocks.push_back({data, size});
+    }
+    a.active            = 0;
+    a.offset            = 0;
+    a.frame_bytes       = 0;
+    a.frame_heap_allocs = 0;
+}
+
+std::uint64_t frame_arena_thread_heap_allocs() { return t_heap_allocs; }
+
+std::size_t frame_arena_reserved(const frame_arena& a) {
+    std::size_t total = 0;
+    for (const auto& b : a.blocks) total += b.size;
+    return total;
+}
+
+frame_arena_set::frame_arena_set() : serial(g_next_set_serial.fetch_add(1, std::memory_order_relaxed)) {}
+
+frame_arena_set::~frame_arena_set() {
+    node* n = head.load(std::memory_order_acquire);
+    while (n) {
+        node* next = n->next;
+        delete n;
+        n = next;
+    }
+}
+
+frame_arena& frame_arena_local(frame_arena_set& set) {
+    if (t_cache.serial == set.serial) return *t_cache.arena;
+
+    const std::thread::id self = std::this_thread::get_id();
+    for (auto* n = set.head.load(std::memory_order_acquire); n; n = n->next) {
+        if (n->owner == self) {
+            t_cache = {set.serial, &n->arena};
+            return n->arena;
+        }
+    }
+    auto* fresh  = new frame_arena_set::node{};
+    fresh->owner = self;
+    fresh->next  = set.head.load(std::memory_order_relaxed);
+    while (!set.head.compare_exchange_weak(fresh->next, fresh, std::memory_order_release, std::memory_order_relaxed)) {}
+    t_cache = {set.serial, &fresh->arena};
+    return fresh->arena;
+}
+
+frame_arena_totals frame_arena_reset_all(frame_arena_set& set) {
+    frame_arena_totals totals{};
+    for (auto* n = set.head.load(std::memory_order_acquire); n; n = n->next) {
+        totals.frame_bytes += n->arena.frame_bytes;
+        totals.heap_allocs += n->arena.frame_heap_allocs;
+        frame_arena_reset(n->arena);
+        totals.high_water += n->arena.high_water;
+        totals.reserved += frame_arena_reserved(n->arena);
+        ++totals.arenas;
+    }
+    return totals;
+}
+
+} // namespace rphys
@@ -0,0 +1,104 @@
+#ifndef RPHYS_FRAME_ARENA_HPP
+#define RPHYS_FRAME_ARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace rphys {
+
+// Bump allocator for step-scoped scratch memory (contact lists, neighbor lists, temporaries).
+// Allocations are never freed individually; everything is released by frame_arena_reset.
+// When a frame overflows the primary block, the reset coalesces all blocks into one block
+// large enough for that frame, so a steady workload stops touching the heap after warm-up.
+struct frame_arena {
+    struct block {
+        std::byte*  data{nullptr};
+        std::size_t size{0};
+    };
+    std::vector<block> blocks; // blocks[0] is the primary block
+    std::size_t   active{0};   // index of the block being bumped
+    std::size_t   offset{0};   // bump offset inside blocks[active]
+    std::size_t   frame_bytes{0};      // bytes handed out since the last reset (incl. padding)
+    std::uint32_t frame_heap_allocs{0}; // blocks allocated since the last reset
+    std::size_t   high_water{0};       // largest frame_bytes seen over the arena lifetime
+
+    frame_arena() = default;
+    frame_arena(const frame_arena&)            = delete;
+    frame_arena& operator=(const frame_arena&) = delete;
+    ~frame_arena();
+};
+
+void* frame_arena_alloc(frame_arena&, std::size_t bytes, std::size_t align = alignof(std::max_align_t));
+void  frame_arena_reset(frame_arena&);
+std::size_t frame_arena_reserved(const frame_arena&);
+// Blocks the calling thread has allocated from the heap, over all arenas (profiler attribution).
+std::uint64_t frame_arena_thread_heap_allocs();
+
+template <class T>
+T* frame_arena_alloc_array(frame_arena& a, std::size_t count) {
+    return static_cast<T*>(frame_arena_alloc(a, sizeof(T) * count, alignof(T)));
+}
+
+// Per-world collection of per-thread arenas. Lookup from worker threads is lock-free: arenas are
+// pushed onto an intrusive list once per (world, thread) and cached in a thread_local slot.
+struct frame_arena_set {
+    struct node {
+        frame_arena     arena;
+        std::thread::id owner;
+        node*           next{nullptr};
+    };
+    std::atomic<node*> head{nullptr};
+    std::uint64_t      serial{0}; // unique per set; keys the thread_local cache
+
+    frame_arena_set();
+    frame_arena_set(const frame_arena_set&)            = delete;
+    frame_arena_set& operator=(const frame_arena_set&) = delete;
+    ~frame_arena_set();
+};
+
+struct frame_arena_totals {
+    std::size_t   frame_bytes{0};
+    std::size_t   high_water{0};
+    std::size_t   reserved{0};
+    std::uint32_t heap_allocs{0};
+    std::uint32_t arenas{0};
+};
+
+// Arena owned by the calling thread for this world (created on first use).
+frame_arena& frame_arena_local(frame_arena_set&);
+// Sums usage over all threads and resets every arena. Must only run while no thread allocates
+// from the set (end of step_world_core).
+frame_arena_totals frame_arena_reset_all(frame_arena_set&);
+
+// Minimal allocator so std containers can live in a frame arena for the duration of a step.
+template <class T>
+struct frame_allocator {
+    using value_type = T;
+    frame_arena* arena{nullptr};
+
+    frame_allocator() noexcept = default;
+    explicit frame_allocator(frame_arena& a) noexcept : arena(&a) {}
+    template <class U>
+    frame_allocator(const frame_allocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(std::size_t n) {
+        T* p = frame_arena_alloc_array<T>(*arena, n);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+    void deallocate(T*, std::size_t) noexcept {}
+
+    template <class U>
+    bool operator==(const frame_allocator<U>& other) const noexcept { return arena == other.arena; }
+};
+
+template <class T>
+using frame_vector = std::vector<T, frame_allocator<T>>;
+
+} // namespace rphys
+
+#endif // RPHYS_FRAME_ARENA_HPP
@@ -0,0 +1,101 @@
+#include "lz_codec.hpp"
+#include <cstdint>
+#include <cstring>
+
+namespace rphys {
+
+namespace {
+    constexpr int         k_hash_bits  = 14;
+    constexpr std::size_t k_min_match  = 4;
+    constexpr std::size_t k_max_offset = 65535;
+
+    std::uint32_t load32(const unsigned char* p) {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    std::uint32_t hash32(std::uint32_t v) { return (v * 2654435761u) >> (32 - k_hash_bits); }
+
+    void put_length(std::vector<unsigned char>& out, std::size_t extra) {
+        for (; extra >= 255; extra -= 255) out.push_back(255);
+        out.push_back(static_cast<unsigned char>(extra));
+    }
+
+    // One sequence: token, literals, then (unless this is the final sequence) offset + match length.
+    void put_sequence(std::vector<unsigned char>& out, const unsigned char* literals, std::size_t literal_count, std::size_t offset, std::size_t match) {
+        const std::size_t lit_nibble   = literal_count < 15 ? literal_count : 15;
+        const std::size_t match_extra  = match ? match - k_min_match : 0;
+        const std::size_t match_nibble = match_extra < 15 ? match_extra : 15;
+        out.push_back(static_cast<unsigned char>(lit_nibble << 4 | match_nibble));
+        if (lit_nibble == 15) put_length(out, literal_count - 15);
+        out.insert(out.end(), literals, literals + literal_count);
+        if (!match) return;
+        out.push_back(static_cast<unsigned char>(offset & 0xff));
+        out.push_back(static_cast<unsigned char>(offset >> 8));
+        if (match_nibble == 15) put_length(out, match_extra - 15);
+    }
+
+    bool get_length(const unsigned char*& ip, const unsigned char* end, std::size_t& value) {
+        for (;;) {
+            if (ip == end) return false;
+            const unsigned char b = *ip++;
+            value += b;
+            if (b != 255) return true;
+        }
+    }
+} // namespace
+
+void lz_compress(const unsigned char* src, std::size_t size, std::vector<unsigned char>& out) {
+    out.clear();
+    out.reserve(size / 2 + 16);
+    std::vector<std::uint32_t> table(std::size_t{1} << k_hash_bits, 0); // position + 1, 0 = empty
+    std::size_t anchor = 0, i = 0, misses = 0;
+    while (i + k_min_match <= size) {
+        const std::uint32_t seq  = load32(src + i);
+        std::uint32_t&      slot = table[hash32(seq)];
+        const std::size_t   cand = slot;
+        slot                     = static_cast<std::uint32_t>(i + 1);
+        if (cand == 0 || i - (cand - 1) > k_max_offset || load32(src + cand - 1) != seq) {
+            i += 1 + (misses++ >> 6); // skip faster through incompressible runs
+            continue;
+        }
+        misses = 0;
+        const std::size_t from = cand - 1;
+        std::size_t       len  = k_min_match;
+        while (i + len < size && src[from + len] == src[i + len]) ++len;
+        put_sequence(out, src + anchor, i - anchor, i - from, len);
+        i += len;
+        anchor = i;
+    }
+    put_sequence(out, src + anchor, size - anchor, 0, 0);
+}
+
+bool lz_decompress(const unsigned char* src, std::size_t size, unsigned char* dst, std::size_t dst_size) {
+    const unsigned char* ip  = src;
+    const unsigned char* end = src + size;
+    std::size_t          op  = 0;
+    for (;;) {
+        if (ip == end) return false; // the final literal-only sequence is missing
+        const unsigned char token   = *ip++;
+        std::size_t         literal = token >> 4u;
+        if (literal == 15 && !get_length(ip, end, literal)) return false;
+        if (literal > static_cast<std::size_t>(end - ip) || literal > dst_size - op) return false;
+        std::memcpy(dst + op, ip, literal);
+        ip += literal;
+        op += literal;
+        if (ip == end) return op == dst_size; // final sequence carries literals only
+
+        if (end - ip < 2) return false;
+        const std::size_t offset = std::size_t{ip[0]} | std::size_t{ip[1]} << 8;
+        ip += 2;
+        std::size_t match = token & 15;
+        if (match == 15 && !get_length(ip, end, match)) return false;
+        match += k_min_match;
+        if (offset == 0 || offset > op || match > dst_size - op) return false;
+        // Byte copy: the source may overlap the bytes being written (run-length style matches).
+        for (std::size_t k = 0; k < match; ++k, ++op) dst[op] = dst[op - offset];
+    }
+}
+
+} // namespace rphys
@@ -0,0 +1,20 @@
+#ifndef RPHYS_LZ_CODEC_HPP
+#define RPHYS_LZ_CODEC_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace rphys {
+
+// Byte-oriented LZ77 in the LZ4 block layout (token nibbles for literal / match length, 16-bit
+// offsets). Single pass, one hash probe per position: meant for cold checkpoint data where speed
+// matters more than ratio.
+void lz_compress(const unsigned char* src, std::size_t size, std::vector<unsigned char>& out);
+
+// Decodes exactly `dst_size` bytes; returns false on malformed input instead of reading or
+// writing out of bounds.
+bool lz_decompress(const unsigned char* src, std::size_t size, unsigned char* dst, std::size_t dst_size);
+
+} // namespace rphys
+
+#endif // RPHYS_LZ_CODEC_HPP
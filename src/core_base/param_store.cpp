@@ -1,4 +1,23 @@
 #include "param_store.hpp"
 
-// skeleton only
+namespace rphys {
 
+void ps_set_double(param_store* ps, std::string_view key, double value) {
+    if (!ps || key.empty()) return;
+    auto it = ps->values.find(key);
+    if (it != ps->values.end()) {
+        it->second = value;
+        return;
+    }
+    ps->values.emplace(std::string(key), value);
+}
+
+bool ps_get_double(const param_store* ps, std::string_view key, double& out_value) {
+    if (!ps) return false;
+    auto it = ps->values.find(key);
+    if (it == ps->values.end()) return false;
+    out_value = it->second;
+    return true;
+}
+
+} // namespace rphys
@@ -2,17 +2,21 @@
 #define RPHYS_PARAM_STORE_HPP
 
 #include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
 #include <string_view>
 
 namespace rphys {
 
-struct param_store;
+// Heterogeneous-lookup map so string_view keys never allocate; only inserting a new key does.
+struct param_store {
+    std::map<std::string, double, std::less<>> values;
+};
 
-// Skeleton API declarations
 void ps_set_double(param_store*, std::string_view key, double value);
 bool ps_get_double(const param_store*, std::string_view key, double& out_value);
 
 } // namespace rphys
 
 #endif // RPHYS_PARAM_STORE_HPP
-
@@ -0,0 +1,267 @@
+#include "scene_file.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace rphys {
+
+namespace {
+    constexpr char          k_magic[8]      = {'R', 'P', 'H', 'Y', 'S', 'S', 'C', 'N'};
+    constexpr std::uint32_t k_endian_tag    = 0x01020304u;
+    constexpr std::size_t   k_section_align = 64;
+    constexpr std::size_t   k_stream_block  = std::size_t{4} << 20;
+
+    std::size_t page_size() {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+#else
+        static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+#endif
+    }
+
+    // Device, file number, size and modification time: equal strings mean the same unchanged file.
+    std::string identity_string(std::uint64_t device, std::uint64_t file, std::uint64_t size, std::uint64_t mtime) {
+        char buf[96];
+        std::snprintf(buf, sizeof(buf), "%llx:%llx:%llx:%llx", static_cast<unsigned long long>(device), static_cast<unsigned long long>(file),
+                      static_cast<unsigned long long>(size), static_cast<unsigned long long>(mtime));
+        return buf;
+    }
+
+    bool write_padding(std::FILE* f, std::uint64_t& offset) {
+        static const unsigned char zeros[k_section_align]{};
+        const std::size_t pad = static_cast<std::size_t>((k_section_align - offset % k_section_align) % k_section_align);
+        if (pad && std::fwrite(zeros, 1, pad, f) != pad) return false;
+        offset += pad;
+        return true;
+    }
+} // namespace
+
+mapped_file::~mapped_file() { close(); }
+
+bool mapped_file::open(const char* path) {
+    close();
+    if (!path) return false;
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size{};
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    BY_HANDLE_FILE_INFORMATION info{};
+    const bool have_info = GetFileInformationByHandle(file, &info) != 0;
+    CloseHandle(file);
+    if (!mapping) return false;
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+    data_   = static_cast<const unsigned char*>(view);
+    size_   = static_cast<std::size_t>(size.QuadPart);
+    handle_ = mapping;
+    if (have_info) {
+        identity_ = identity_string(info.dwVolumeSerialNumber, std::uint64_t{info.nFileIndexHigh} << 32 | info.nFileIndexLow, size_,
+                                    std::uint64_t{info.ftLastWriteTime.dwHighDateTime} << 32 | info.ftLastWriteTime.dwLowDateTime);
+    }
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    void* view = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file referenced
+    if (view == MAP_FAILED) return false;
+    data_ = static_cast<const unsigned char*>(view);
+    size_ = static_cast<std::size_t>(st.st_size);
+    posix_madvise(view, size_, POSIX_MADV_SEQUENTIAL);
+#if defined(__APPLE__)
+    const struct timespec mtime = st.st_mtimespec;
+#else
+    const struct timespec mtime = st.st_mtim;
+#endif
+    identity_ = identity_string(static_cast<std::uint64_t>(st.st_dev), static_cast<std::uint64_t>(st.st_ino), size_,
+                                static_cast<std::uint64_t>(mtime.tv_sec) * 1000000000u + static_cast<std::uint64_t>(mtime.tv_nsec));
+#endif
+    return true;
+}
+
+void mapped_file::close() noexcept {
+    if (!data_) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(handle_));
+#else
+    munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+    data_   = nullptr;
+    size_   = 0;
+    handle_ = nullptr;
+    identity_.clear();
+}
+
+void mapped_file::prefetch(std::size_t offset, std::size_t length) const {
+    if (!data_ || offset >= size_) return;
+    length = std::min(length, size_ - offset);
+    const std::size_t begin = offset / page_size() * page_size();
+#if defined(_WIN32)
+    WIN32_MEMORY_RANGE_ENTRY range{const_cast<unsigned char*>(data_) + begin, offset + length - begin};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    posix_madvise(const_cast<unsigned char*>(data_) + begin, offset + length - begin, POSIX_MADV_WILLNEED);
+#endif
+}
+
+void mapped_file::release(std::size_t offset, std::size_t length) const {
+#if defined(_WIN32)
+    (void)offset;
+    (void)length; // the working-set manager trims read-only views on its own
+#else
+    if (!data_ || offset >= size_) return;
+    // Only whole pages inside [offset, offset + length) may go; neighbours can still be unread.
+    const std::size_t page  = page_size();
+    const std::size_t begin = (offset + page - 1) / page * page;
+    const std::size_t end   = std::min(offset + length, size_) / page * page;
+    if (end > begin) posix_madvise(const_cast<unsigned char*>(data_) + begin, end - begin, POSIX_MADV_DONTNEED);
+#endif
+}
+
+bool scene_file_open(scene_file& f, const char* path) {
+    f.header   = nullptr;
+    f.sections = nullptr;
+    if constexpr (std::endian::native != std::endian::little) return false;
+    if (!f.map.open(path)) return false;
+    const std::size_t size = f.map.size();
+    const auto*       h    = reinterpret_cast<const scene_file_header*>(f.map.data());
+    const bool header_ok   = size >= sizeof(scene_file_header) && std::memcmp(h->magic, k_magic, sizeof(k_magic)) == 0 &&
+                           h->version_major == scene_file_version_major && h->endian_tag == k_endian_tag && h->file_size == size &&
+                           h->directory_offset % alignof(scene_section_entry) == 0 && h->directory_offset <= size &&
+                           h->section_count <= (size - h->directory_offset) / sizeof(scene_section_entry);
+    if (!header_ok) {
+        f.map.close();
+        return false;
+    }
+    const auto* sections = reinterpret_cast<const scene_section_entry*>(f.map.data() + h->directory_offset);
+    for (std::uint32_t i = 0; i < h->section_count; ++i) {
+        const scene_section_entry& s = sections[i];
+        if (s.element_size == 0 || s.offset > size || s.count > (size - s.offset) / s.element_size) {
+            f.map.close();
+            return false;
+        }
+    }
+    f.header   = h;
+    f.sections = sections;
+    return true;
+}
+
+const scene_section_entry* scene_file_find(const scene_file& f, std::uint32_t kind) {
+    if (!f.header) return nullptr;
+    for (std::uint32_t i = 0; i < f.header->section_count; ++i) {
+        if (f.sections[i].kind == kind) return &f.sections[i];
+    }
+    return nullptr;
+}
+
+void scene_file_stream(const scene_file& f, const scene_section_entry& s, void* dst) {
+    const std::size_t bytes = static_cast<std::size_t>(s.count) * s.element_size;
+    const std::size_t base  = static_cast<std::size_t>(s.offset);
+    auto*             out   = static_cast<unsigned char*>(dst);
+    for (std::size_t done = 0; done < bytes;) {
+        const std::size_t block = std::min(k_stream_block, bytes - done);
+        if (done + block < bytes) f.map.prefetch(base + done + block, std::min(k_stream_block, bytes - done - block));
+        std::memcpy(out + done, f.map.data() + base + done, block);
+        f.map.release(base + done, block);
+        done += block;
+    }
+}
+
+bool scene_file_read_primitives(const scene_file& f, scene_primitive_list& out) {
+    std::vector<scene_primitive_record> records;
+    out.clear();
+    if (!scene_file_read(f, scene_section_primitives, records)) return scene_file_find(f, scene_section_primitives) == nullptr;
+    out.reserve(records.size());
+    for (const auto& r : records) {
+        scene_primitive p;
+        p.type = static_cast<scene_primitive_type>(r.type);
+        std::copy(std::begin(r.origin), std::end(r.origin), p.origin);
+        std::copy(std::begin(r.extent), std::end(r.extent), p.extent);
+        std::copy(std::begin(r.resolution), std::end(r.resolution), p.resolution);
+        p.mass  = r.mass;
+        p.flags = r.flags;
+        out.push_back(p);
+    }
+    return true;
+}
+
+void scene_file_writer::add_section(std::uint32_t kind, const void* data, std::size_t element_size, std::size_t count) {
+    sections_.push_back(pending_section{kind, data, element_size, count});
+}
+
+void scene_file_writer::add_primitives(const scene_primitive_list& prims) {
+    std::vector<scene_primitive_record> records(prims.size());
+    for (std::size_t i = 0; i < prims.size(); ++i) {
+        const scene_primitive&  p = prims[i];
+        scene_primitive_record& r = records[i];
+        r.type = static_cast<std::int32_t>(p.type);
+        std::copy(std::begin(p.origin), std::end(p.origin), r.origin);
+        std::copy(std::begin(p.extent), std::end(p.extent), r.extent);
+        std::copy(std::begin(p.resolution), std::end(p.resolution), r.resolution);
+        r.mass  = p.mass;
+        r.flags = p.flags;
+    }
+    add_owned(scene_section_primitives, std::move(records));
+}
+
+bool scene_file_writer::write(const char* path) const {
+    if constexpr (std::endian::native != std::endian::little) return false;
+    if (!path) return false;
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+
+    scene_file_header header{};
+    std::memcpy(header.magic, k_magic, sizeof(k_magic));
+    header.version_major = scene_file_version_major;
+    header.version_minor = scene_file_version_minor;
+    header.section_count = static_cast<std::uint32_t>(sections_.size());
+    header.endian_tag    = k_endian_tag;
+
+    std::vector<scene_section_entry> directory(sections_.size());
+    std::uint64_t offset = sizeof(header);
+    bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1;
+    for (std::size_t i = 0; ok && i < sections_.size(); ++i) {
+        const pending_section& s = sections_[i];
+        ok = write_padding(f, offset);
+        directory[i] = scene_section_entry{s.kind, static_cast<std::uint32_t>(s.element_size), s.count, offset, 0};
+        const std::size_t bytes = s.element_size * s.count;
+        ok = ok && (bytes == 0 || std::fwrite(s.data, 1, bytes, f) == bytes);
+        offset += bytes;
+    }
+    ok = ok && write_padding(f, offset);
+    header.directory_offset = offset;
+    ok = ok && (directory.empty() || std::fwrite(directory.data(), sizeof(scene_section_entry), directory.size(), f) == directory.size());
+    header.file_size = offset + directory.size() * sizeof(scene_section_entry);
+    ok = ok && std::fseek(f, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, f) == 1;
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok) std::remove(path);
+    return ok;
+}
+
+} // namespace rphys
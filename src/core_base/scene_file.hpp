@@ -0,0 +1,165 @@
+#ifndef RPHYS_SCENE_FILE_HPP
+#define RPHYS_SCENE_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "rphys/api_scene.h"
+#include "shared_asset.hpp"
+
+namespace rphys {
+
+// Binary scene file, version 1 (little-endian):
+//   [header: 64 B][section payloads, each 64 B aligned][directory: section_count entries]
+// Each section is a flat array that a domain copies straight into one of its SoA arrays, so loading
+// never re-derives topology, rest data or colouring. Readers accept any minor version of their
+// major version and skip section kinds they do not know.
+constexpr std::uint16_t scene_file_version_major = 1;
+constexpr std::uint16_t scene_file_version_minor = 0;
+
+struct scene_file_header {
+    char          magic[8];         // "RPHYSSCN"
+    std::uint16_t version_major;
+    std::uint16_t version_minor;
+    std::uint32_t section_count;
+    std::uint64_t directory_offset;
+    std::uint64_t file_size;
+    std::uint32_t endian_tag;       // 0x01020304 as written by the producer
+    std::uint32_t reserved[7];
+};
+static_assert(sizeof(scene_file_header) == 64);
+
+struct scene_section_entry {
+    std::uint32_t kind;
+    std::uint32_t element_size;
+    std::uint64_t count;
+    std::uint64_t offset; // from the start of the file
+    std::uint64_t reserved;
+};
+static_assert(sizeof(scene_section_entry) == 32);
+
+// Section kinds below 0x100 belong to core; each domain owns a 0x100 block for its cooked data.
+constexpr std::uint32_t scene_section_primitives = 1; // scene_primitive_record[]
+constexpr std::uint32_t scene_section_cloth_base = 0x100;
+
+// On-disk form of scene_primitive, independent of the in-memory struct layout.
+struct scene_primitive_record {
+    std::int32_t  type;
+    float         origin[3];
+    float         extent[3];
+    std::uint32_t resolution[3];
+    float         mass;
+    std::uint32_t flags;
+};
+static_assert(sizeof(scene_primitive_record) == 48);
+
+// Read-only memory mapping of a whole file (mmap / MapViewOfFile).
+class mapped_file {
+public:
+    mapped_file() = default;
+    ~mapped_file();
+    mapped_file(const mapped_file&)            = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    bool open(const char* path);
+    void close() noexcept;
+
+    const unsigned char* data() const { return data_; }
+    std::size_t          size() const { return size_; }
+    // Names the mapped file version (device, file number, size, mtime); empty if unknown.
+    const std::string&   identity() const { return identity_; }
+
+    // Paging hints for streamed reads; both are no-ops where the platform has no equivalent.
+    void prefetch(std::size_t offset, std::size_t length) const;
+    void release(std::size_t offset, std::size_t length) const; // drop pages already consumed
+
+private:
+    const unsigned char* data_{nullptr};
+    std::size_t          size_{0};
+    void*                handle_{nullptr}; // file mapping object on Windows
+    std::string          identity_;
+};
+
+struct scene_file {
+    mapped_file                map;
+    const scene_file_header*   header{nullptr};
+    const scene_section_entry* sections{nullptr};
+};
+
+// Maps `path` and validates header, version and directory bounds.
+bool scene_file_open(scene_file&, const char* path);
+const scene_section_entry* scene_file_find(const scene_file&, std::uint32_t kind);
+
+// Copies a whole section into `dst` (count * element_size bytes) in fixed-size blocks, prefetching
+// the next block and releasing consumed pages, so resident memory stays bounded for large meshes.
+void scene_file_stream(const scene_file&, const scene_section_entry&, void* dst);
+
+// Resizes `out` to the section's element count and streams the payload into it. Returns false when
+// the section is missing or its element size does not match T.
+template <class T>
+bool scene_file_read(const scene_file& f, std::uint32_t kind, std::vector<T>& out) {
+    const scene_section_entry* s = scene_file_find(f, kind);
+    if (!s || s->element_size != sizeof(T)) return false;
+    out.resize(static_cast<std::size_t>(s->count));
+    scene_file_stream(f, *s, out.data());
+    return true;
+}
+
+// Like scene_file_read, but every reader of the same file version and section shares one buffer
+// through the shared asset registry; only the first streams the payload. For sections a domain
+// keeps immutable. Falls back to a private copy when the file identity is unknown.
+template <class T>
+bool scene_file_read_shared(const scene_file& f, std::uint32_t kind, cow_vector<T>& out) {
+    const scene_section_entry* s = scene_file_find(f, kind);
+    if (!s || s->element_size != sizeof(T)) return false;
+    std::string key;
+    if (!f.map.identity().empty()) {
+        key = f.map.identity() + '#' + std::to_string(kind);
+        if (auto hit = shared_asset_find(key)) {
+            out = cow_vector<T>(std::static_pointer_cast<const std::vector<T>>(hit));
+            return true;
+        }
+    }
+    auto values = std::make_shared<std::vector<T>>(static_cast<std::size_t>(s->count));
+    scene_file_stream(f, *s, values->data());
+    std::shared_ptr<const void> published = std::move(values);
+    if (!key.empty()) published = shared_asset_publish(key, std::move(published));
+    out = cow_vector<T>(std::static_pointer_cast<const std::vector<T>>(published));
+    return true;
+}
+
+bool scene_file_read_primitives(const scene_file&, scene_primitive_list& out);
+
+// Collects sections and writes them in one pass. add_section borrows `data` until write();
+// add_owned takes a vector over so cook hooks can hand their results off without copying.
+class scene_file_writer {
+public:
+    void add_section(std::uint32_t kind, const void* data, std::size_t element_size, std::size_t count);
+
+    template <class T>
+    void add_owned(std::uint32_t kind, std::vector<T>&& values) {
+        auto keep = std::make_shared<std::vector<T>>(std::move(values));
+        add_section(kind, keep->data(), sizeof(T), keep->size());
+        owned_.push_back(std::move(keep));
+    }
+
+    void add_primitives(const scene_primitive_list&);
+    bool write(const char* path) const;
+
+private:
+    struct pending_section {
+        std::uint32_t kind;
+        const void*   data;
+        std::size_t   element_size;
+        std::size_t   count;
+    };
+    std::vector<pending_section>       sections_;
+    std::vector<std::shared_ptr<void>> owned_;
+};
+
+} // namespace rphys
+
+#endif // RPHYS_SCENE_FILE_HPP
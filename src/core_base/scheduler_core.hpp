@@ -0,0 +1,59 @@
+#ifndef RPHYS_SCHEDULER_CORE_HPP
+#define RPHYS_SCHEDULER_CORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "coupling_core.hpp"
+#include "domain_core.hpp"
+#include "telemetry_core.hpp"
+
+namespace rphys {
+
+// Everything a scheduler needs to run one frame. `topology_version` changes whenever domains or
+// couplings are added, removed or rebuilt, so schedulers can cache derived structures on it.
+struct frame_view {
+    domain_core* const*   domains{nullptr};
+    std::size_t           domain_count{0};
+    coupling_core* const* couplings{nullptr};
+    std::size_t           coupling_count{0};
+    const field_bus*      fields{nullptr};
+    std::uint64_t         topology_version{0};
+};
+
+// Scheduler bound to a world at creation. core_base never includes schedulers/, so the gateway
+// injects the implementation through this table.
+struct world_scheduler {
+    const char*       name{nullptr};
+    void*             self{nullptr};
+    void              (*run_frame)(void* self, const frame_view&, step_context&){nullptr};
+    void              (*destroy)(void* self){nullptr};
+    parallel_executor exec{}; // data-parallel service handed to phases through step_context
+};
+
+// Runs one graph node. A coupling whose exchange fails is detached and skipped from then on.
+// Both are timed when the world profiles (phase name / coupling type, tagged with the owner id).
+// Nodes of domains that are asleep or between reduced-rate steps are skipped; the others run
+// with the dt their activity plan accumulated.
+inline void run_domain_phase(domain_core& d, const domain_phase& p, step_context& ctx) {
+    if (d.inert || !d.activity.run || !p.run) return;
+    profile_scope scope(ctx.profiler, profile_kind::phase, p.name, d.id);
+    if (d.activity.dt == ctx.dt) {
+        p.run(d.state, ctx);
+        return;
+    }
+    step_context local = ctx;
+    local.dt           = d.activity.dt;
+    p.run(d.state, local);
+}
+
+inline void run_coupling_exchange(coupling_core& c, const field_bus& fields, step_context& ctx) {
+    if (c.detached || !c.active) return;
+    profile_scope scope(ctx.profiler, profile_kind::coupling, c.contract->type, c.id);
+    step_context  local = ctx;
+    local.dt            = c.step_dt;
+    if (!c.contract->exchange(c.state, fields, local)) c.detached = true;
+}
+
+} // namespace rphys
+
+#endif // RPHYS_SCHEDULER_CORE_HPP
@@ -0,0 +1,53 @@
+#include "shared_asset.hpp"
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+
+namespace rphys {
+
+namespace {
+    struct asset_registry {
+        std::mutex                                                  lock;
+        std::unordered_map<std::string, std::weak_ptr<const void>> entries;
+    };
+
+    asset_registry& registry() {
+        static asset_registry r;
+        return r;
+    }
+
+    // Expired entries are dropped lazily whenever the registry is touched on the slow path.
+    void prune(asset_registry& r) {
+        for (auto it = r.entries.begin(); it != r.entries.end();) it = it->second.expired() ? r.entries.erase(it) : std::next(it);
+    }
+} // namespace
+
+std::shared_ptr<const void> shared_asset_find(const std::string& key) {
+    asset_registry&             r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    auto it = r.entries.find(key);
+    return it == r.entries.end() ? nullptr : it->second.lock();
+}
+
+std::shared_ptr<const void> shared_asset_publish(const std::string& key, std::shared_ptr<const void> value) {
+    asset_registry&             r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    auto it = r.entries.find(key);
+    if (it != r.entries.end()) {
+        if (auto live = it->second.lock()) return live;
+        it->second = value;
+        return value;
+    }
+    prune(r);
+    r.entries.emplace(key, value);
+    return value;
+}
+
+std::size_t shared_asset_count() {
+    asset_registry&             r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    prune(r);
+    return r.entries.size();
+}
+
+} // namespace rphys
@@ -0,0 +1,75 @@
+#ifndef RPHYS_SHARED_ASSET_HPP
+#define RPHYS_SHARED_ASSET_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rphys {
+
+// Copy-on-write array for data a domain never changes while stepping (topology, rest state,
+// colouring). Copies share one buffer; reads go straight to it, and the rare writer calls mutate(),
+// which clones the buffer first unless this array is provably its only holder.
+template <class T>
+class cow_vector {
+public:
+    cow_vector() = default;
+    // Adopts a buffer that may also be reachable elsewhere (e.g. the shared asset registry), so the
+    // first mutate() always clones.
+    explicit cow_vector(std::shared_ptr<const std::vector<T>> shared) : data_(std::move(shared)) {}
+
+    cow_vector& operator=(std::vector<T>&& values) {
+        data_      = std::make_shared<std::vector<T>>(std::move(values));
+        exclusive_ = true;
+        return *this;
+    }
+
+    const std::vector<T>& values() const { return data_ ? *data_ : empty_vector(); }
+    const T*              data() const { return values().data(); }
+    std::size_t           size() const { return values().size(); }
+    bool                  empty() const { return values().empty(); }
+    const T&              operator[](std::size_t i) const { return (*data_)[i]; }
+    const T&              front() const { return values().front(); }
+    const T&              back() const { return values().back(); }
+    auto                  begin() const { return values().begin(); }
+    auto                  end() const { return values().end(); }
+
+    std::vector<T>& mutate() {
+        // A use count of 1 on a buffer created here means no other holder exists or can appear;
+        // a stale count only costs an extra clone.
+        if (!data_ || !exclusive_ || data_.use_count() > 1) {
+            data_      = std::make_shared<std::vector<T>>(values());
+            exclusive_ = true;
+        }
+        return const_cast<std::vector<T>&>(*data_); // created non-const above
+    }
+
+    const std::shared_ptr<const std::vector<T>>& buffer() const { return data_; }
+
+private:
+    static const std::vector<T>& empty_vector() {
+        static const std::vector<T> none;
+        return none;
+    }
+
+    std::shared_ptr<const std::vector<T>> data_;
+    bool                                  exclusive_{false}; // buffer created by operator= / mutate
+};
+
+// Process-wide registry of immutable buffers keyed by where they were loaded from (for scene files
+// the file identity plus section kind). Entries are weak: a buffer is freed with its last user
+// and the key then misses. Thread-safe.
+std::shared_ptr<const void> shared_asset_find(const std::string& key);
+
+// Registers `value` under `key` and returns it, or returns the live buffer another thread
+// registered first so that both callers end up sharing one copy.
+std::shared_ptr<const void> shared_asset_publish(const std::string& key, std::shared_ptr<const void> value);
+
+// Live entries, for tests and diagnostics.
+std::size_t shared_asset_count();
+
+} // namespace rphys
+
+#endif // RPHYS_SHARED_ASSET_HPP
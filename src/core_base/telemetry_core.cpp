@@ -1,4 +1,175 @@
 #include "telemetry_core.hpp"
+#include "frame_arena.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
 
-// skeleton only
+namespace rphys {
 
+namespace {
+    struct clock_epoch {
+        std::uint64_t                         ticks{0};
+        std::chrono::steady_clock::time_point time{};
+    };
+
+    // Captured on first use. Spinning for a moment here gives the tick rate a usable baseline
+    // even when a trace is exported right after profiling was enabled.
+    const clock_epoch& epoch() {
+        static const clock_epoch e = [] {
+            clock_epoch c{profile_ticks(), std::chrono::steady_clock::now()};
+#ifdef RPHYS_PROFILE_TSC
+            while (std::chrono::steady_clock::now() - c.time < std::chrono::milliseconds(2)) {}
+#endif
+            return c;
+        }();
+        return e;
+    }
+
+    std::atomic<std::uint64_t> g_next_profiler_serial{1};
+
+    struct local_cache {
+        std::uint64_t serial{0};
+        profile_ring* ring{nullptr};
+    };
+    thread_local local_cache t_cache;
+
+    bool same_phase(const phase_stats& s, const profile_event& e) {
+        return s.owner == e.owner && s.coupling == (e.kind == profile_kind::coupling) && std::strcmp(s.name, e.name) == 0;
+    }
+
+    bool phase_order(const phase_stats& a, const phase_stats& b) {
+        if (a.coupling != b.coupling) return !a.coupling;
+        if (a.owner != b.owner) return a.owner < b.owner;
+        return std::strcmp(a.name, b.name) < 0;
+    }
+
+    // Folds the events recorded since the last collection into `out` (cleared first).
+    std::uint64_t collect_phases(world_profiler& p, std::vector<phase_stats>& out) {
+        out.clear();
+        const double  ms_per_tick = profile_ns_per_tick() * 1e-6;
+        std::uint64_t dropped     = 0;
+        for (auto* n = p.head.load(std::memory_order_acquire); n; n = n->next) {
+            profile_ring&       r        = n->ring;
+            const std::uint64_t retained = r.head > r.events.size() ? r.head - r.events.size() : 0;
+            const std::uint64_t first    = std::max(r.collected, retained);
+            dropped += first - r.collected;
+            for (std::uint64_t i = first; i < r.head; ++i) {
+                const profile_event& e = r.events[i & (r.events.size() - 1)];
+                if (e.kind != profile_kind::phase && e.kind != profile_kind::coupling) continue;
+                auto it = std::find_if(out.begin(), out.end(), [&](const phase_stats& s) { return same_phase(s, e); });
+                if (it == out.end()) {
+                    phase_stats s{};
+                    s.name     = e.name;
+                    s.owner    = e.owner;
+                    s.coupling = e.kind == profile_kind::coupling;
+                    it         = out.insert(out.end(), s);
+                }
+                ++it->calls;
+                it->ms += static_cast<double>(e.end - e.begin) * ms_per_tick;
+                it->iterations += e.iterations;
+                it->scratch_allocs += e.scratch_allocs;
+                if (e.iterations || e.residual != 0.0f) it->residual = e.residual;
+            }
+            r.collected = r.head;
+        }
+        std::sort(out.begin(), out.end(), phase_order);
+        return dropped;
+    }
+} // namespace
+
+double profile_ns_per_tick() {
+#ifdef RPHYS_PROFILE_TSC
+    const clock_epoch& e     = epoch();
+    const std::uint64_t ticks = profile_ticks() - e.ticks;
+    const double        ns    = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - e.time).count();
+    return ticks ? ns / static_cast<double>(ticks) : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+std::uint64_t profile_epoch_ticks() { return epoch().ticks; }
+
+world_profiler::world_profiler(std::size_t ring_events, std::uint32_t world_id)
+    : serial(g_next_profiler_serial.fetch_add(1, std::memory_order_relaxed)), capacity(std::bit_ceil(std::max<std::size_t>(ring_events, 64))), world(world_id) {
+    (void)epoch();
+}
+
+world_profiler::~world_profiler() {
+    node* n = head.load(std::memory_order_acquire);
+    while (n) {
+        node* next = n->next;
+        delete n;
+        n = next;
+    }
+}
+
+profile_ring& profile_ring_local(world_profiler& p) {
+    if (t_cache.serial == p.serial) return *t_cache.ring;
+
+    const std::thread::id self = std::this_thread::get_id();
+    for (auto* n = p.head.load(std::memory_order_acquire); n; n = n->next) {
+        if (n->owner == self) {
+            t_cache = {p.serial, &n->ring};
+            return n->ring;
+        }
+    }
+    auto* fresh  = new world_profiler::node{};
+    fresh->owner = self;
+    fresh->ring.events.resize(p.capacity);
+    fresh->ring.thread = p.thread_count.fetch_add(1, std::memory_order_relaxed);
+    fresh->next        = p.head.load(std::memory_order_relaxed);
+    while (!p.head.compare_exchange_weak(fresh->next, fresh, std::memory_order_release, std::memory_order_relaxed)) {}
+    t_cache = {p.serial, &fresh->ring};
+    return fresh->ring;
+}
+
+void profile_scope::open(profile_kind kind, const char* name, std::uint32_t owner) {
+    ring_           = &profile_ring_local(*profiler_);
+    parent_         = ring_->open;
+    ring_->open     = this;
+    event_.kind     = kind;
+    event_.name     = name;
+    event_.owner    = owner;
+    event_.depth    = ring_->depth++;
+    allocs_at_open_ = frame_arena_thread_heap_allocs();
+    event_.begin    = profile_ticks();
+}
+
+void profile_scope::close() {
+    event_.end            = profile_ticks();
+    event_.scratch_allocs = static_cast<std::uint32_t>(frame_arena_thread_heap_allocs() - allocs_at_open_);
+    ring_->events[ring_->head & (ring_->events.size() - 1)] = event_;
+    ++ring_->head;
+    --ring_->depth;
+    ring_->open = parent_;
+}
+
+void profile_note(world_profiler* p, std::uint32_t iterations, float residual) {
+    if (!p) return;
+    if (profile_scope* s = profile_ring_local(*p).open) s->note(iterations, residual);
+}
+
+void telemetry_record_frame(telemetry_core& t, const frame_stats& frame, const frame_arena_totals& scratch, double sim_time) {
+    const std::size_t peak = std::max(t.last_frame.scratch_high_water, scratch.high_water);
+    frame_stats& s        = t.last_frame;
+    s                     = frame;
+    s.scratch_bytes       = scratch.frame_bytes;
+    s.scratch_high_water  = peak;
+    s.scratch_reserved    = scratch.reserved;
+    s.scratch_heap_allocs = scratch.heap_allocs;
+    s.scratch_threads     = scratch.arenas;
+    if (t.profiler) {
+        s.profile_events_dropped = collect_phases(*t.profiler, t.phases);
+    } else {
+        t.phases.clear();
+    }
+    s.phases      = t.phases.empty() ? nullptr : t.phases.data();
+    s.phase_count = static_cast<std::uint32_t>(t.phases.size());
+    if (t.stream) {
+        t.stream->push_frame(s, sim_time);
+        s.stream_frames_dropped = t.stream->dropped();
+    }
+}
+
+} // namespace rphys
@@ -1,11 +1,150 @@
 #ifndef RPHYS_TELEMETRY_CORE_HPP
 #define RPHYS_TELEMETRY_CORE_HPP
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "rphys/api_telemetry.h"
+#include "telemetry_stream.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define RPHYS_PROFILE_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define RPHYS_PROFILE_TSC 1
+#endif
+
 namespace rphys {
 
-struct telemetry_core;
+struct frame_arena_totals;
+
+// Profiler timestamps: the invariant TSC where available (a few ns to read), otherwise
+// steady_clock nanoseconds. Ticks only become time in collection / export.
+inline std::uint64_t profile_ticks() {
+#ifdef RPHYS_PROFILE_TSC
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Tick rate measured against steady_clock since the first profiler was created (the trace epoch).
+double        profile_ns_per_tick();
+std::uint64_t profile_epoch_ticks();
+
+enum class profile_kind : std::uint8_t { step, commands, phase, coupling, scope };
+
+struct profile_event {
+    std::uint64_t begin{0}; // ticks
+    std::uint64_t end{0};
+    const char*   name{nullptr}; // static storage: phase names, contract types, literals
+    std::uint32_t owner{0};      // domain / coupling id, 0 for world-level events
+    std::uint32_t iterations{0};
+    float         residual{0.0f};
+    std::uint32_t scratch_allocs{0};
+    std::uint16_t depth{0}; // nesting on the recording thread
+    profile_kind  kind{profile_kind::scope};
+};
+
+class profile_scope;
+
+// Event ring of one (world, thread) pair. Only the owning thread writes; the stepping thread
+// reads between steps, after the scheduler has joined every task of the frame, so no atomics are
+// needed on the write path. A frame that records more than the capacity overwrites its oldest
+// events; collection counts them as dropped.
+struct profile_ring {
+    std::vector<profile_event> events; // power-of-two size
+    std::uint64_t              head{0};        // events written so far
+    std::uint64_t              collected{0};   // head at the last collection
+    std::uint32_t              thread{0};      // dense index within the world's profiler
+    std::uint16_t              depth{0};
+    profile_scope*             open{nullptr};  // innermost open scope on this thread
+};
+
+// Per-world set of per-thread rings. Same lock-free lookup as frame_arena_set: a ring is pushed
+// once per (profiler, thread) and cached in a thread_local slot keyed by `serial`.
+struct world_profiler {
+    struct node {
+        profile_ring    ring;
+        std::thread::id owner;
+        node*           next{nullptr};
+    };
+    std::atomic<node*>         head{nullptr};
+    std::atomic<std::uint32_t> thread_count{0};
+    std::uint64_t              serial{0};
+    std::size_t                capacity{0};
+    std::uint32_t              world{0}; // public world id, the trace process id
+
+    world_profiler(std::size_t ring_events, std::uint32_t world_id);
+    world_profiler(const world_profiler&)            = delete;
+    world_profiler& operator=(const world_profiler&) = delete;
+    ~world_profiler();
+};
+
+profile_ring& profile_ring_local(world_profiler&);
+
+// Scoped timer recording one event when it closes. With a null profiler both ends are a single
+// branch, so scopes can stay in hot code permanently.
+class profile_scope {
+public:
+    profile_scope(world_profiler* p, profile_kind kind, const char* name, std::uint32_t owner = 0) : profiler_(p) {
+        if (p) open(kind, name, owner);
+    }
+    ~profile_scope() {
+        if (profiler_) close();
+    }
+    profile_scope(const profile_scope&)            = delete;
+    profile_scope& operator=(const profile_scope&) = delete;
+
+    // Solver progress of this scope: iterations add up, the last residual wins.
+    void note(std::uint32_t iterations, float residual) {
+        event_.iterations += iterations;
+        event_.residual = residual;
+    }
+
+private:
+    void open(profile_kind, const char* name, std::uint32_t owner);
+    void close();
+
+    world_profiler* profiler_{nullptr};
+    profile_ring*   ring_{nullptr};
+    profile_scope*  parent_{nullptr};
+    std::uint64_t   allocs_at_open_{0};
+    profile_event   event_{};
+};
+
+// Attributes solver progress to the innermost open scope of the calling thread (the phase scope
+// when called from a phase body). No-op without a profiler.
+void profile_note(world_profiler*, std::uint32_t iterations, float residual);
+
+// Per-world telemetry sink. Written only by the thread stepping the world.
+struct telemetry_core {
+    frame_stats                       last_frame{};
+    std::vector<phase_stats>          phases;   // backs last_frame.phases
+    std::unique_ptr<world_profiler>   profiler; // null unless profiling is enabled
+    std::unique_ptr<telemetry_stream> stream;   // null unless streaming to a file
+};
+
+// `frame` carries the step-local counters; scratch totals and running peaks are merged in here,
+// with a profiler the events of the step are aggregated into per-phase stats, and with a stream
+// the result is queued for the writer thread.
+void telemetry_record_frame(telemetry_core&, const frame_stats& frame, const frame_arena_totals& scratch, double sim_time);
+
+// Reads every retained event (oldest first per thread); used by exporters between steps.
+template <class Fn>
+void profiler_for_each_event(const world_profiler& p, Fn&& fn) {
+    for (auto* n = p.head.load(std::memory_order_acquire); n; n = n->next) {
+        const profile_ring& r     = n->ring;
+        const std::uint64_t first = r.head > r.events.size() ? r.head - r.events.size() : 0;
+        for (std::uint64_t i = first; i < r.head; ++i) fn(r.thread, r.events[i & (r.events.size() - 1)]);
+    }
+}
 
 } // namespace rphys
 
 #endif // RPHYS_TELEMETRY_CORE_HPP
-
@@ -0,0 +1,123 @@
+#include "telemetry_stream.hpp"
+#include <chrono>
+
+namespace rphys {
+
+namespace {
+    constexpr std::size_t k_write_buffer = 64 * 1024;
+    constexpr auto        k_idle_sleep   = std::chrono::milliseconds(1);
+} // namespace
+
+std::unique_ptr<telemetry_stream> telemetry_stream::open(const telemetry_stream_desc& desc, const telemetry_format_ops& ops, std::uint32_t world) {
+    if (!desc.path || !ops.header || !ops.record) return nullptr;
+    std::FILE* f = std::fopen(desc.path, "wb");
+    if (!f) return nullptr;
+    std::unique_ptr<telemetry_stream> s(new (std::nothrow) telemetry_stream(desc, ops, world, f));
+    if (!s) std::fclose(f);
+    return s;
+}
+
+telemetry_stream::telemetry_stream(const telemetry_stream_desc& desc, const telemetry_format_ops& ops, std::uint32_t world, std::FILE* file)
+    : ring_(desc.capacity), ops_(ops), overflow_(desc.overflow), world_(world), path_(desc.path), rotate_bytes_(desc.rotate_bytes), file_(file) {
+    writer_ = std::thread([this] { run(); });
+}
+
+bool telemetry_stream::finish() {
+    if (writer_.joinable()) {
+        stop_.store(true, std::memory_order_release);
+        writer_.join();
+    }
+    if (file_) {
+        if (std::fclose(file_) != 0) failed_.store(true, std::memory_order_relaxed);
+        file_ = nullptr;
+    }
+    return !failed_.load(std::memory_order_relaxed);
+}
+
+void telemetry_stream::push_frame(const frame_stats& frame, double sim_time) {
+    const std::size_t needed = 1 + std::size_t{frame.phase_count};
+    if (ring_.free_slots() < needed) {
+        if (overflow_ == telemetry_overflow::drop || needed > ring_.capacity()) {
+            ++dropped_;
+            return;
+        }
+        while (ring_.free_slots() < needed) std::this_thread::yield();
+    }
+    telemetry_record r{};
+    r.world                       = world_;
+    r.sim_time                    = sim_time;
+    r.frame                       = frame;
+    r.frame.phases                = nullptr;
+    r.frame.stream_frames_dropped = dropped_;
+    ring_.push(r);
+    r.type = telemetry_record::kind::phase;
+    for (std::uint32_t i = 0; i < frame.phase_count; ++i) {
+        r.phase = frame.phases[i];
+        ring_.push(r);
+    }
+}
+
+bool telemetry_stream::write(const char* data, std::size_t size) {
+    if (failed_.load(std::memory_order_relaxed)) return false;
+    if (size && std::fwrite(data, 1, size, file_) != size) {
+        failed_.store(true, std::memory_order_relaxed);
+        return false;
+    }
+    file_bytes_ += size;
+    return true;
+}
+
+bool telemetry_stream::rotate() {
+    if (std::fclose(file_) != 0) failed_.store(true, std::memory_order_relaxed);
+    const std::string next = path_ + "." + std::to_string(++file_index_);
+    file_       = std::fopen(next.c_str(), "wb");
+    file_bytes_ = 0;
+    if (!file_) {
+        failed_.store(true, std::memory_order_relaxed);
+        return false;
+    }
+    char header[1024];
+    return write(header, ops_.header(header, sizeof(header)));
+}
+
+void telemetry_stream::run() {
+    std::unique_ptr<char[]> buffer(new (std::nothrow) char[k_write_buffer]);
+    if (!buffer) {
+        failed_.store(true, std::memory_order_relaxed);
+        return;
+    }
+    std::size_t used = ops_.header(buffer.get(), k_write_buffer);
+    telemetry_record r;
+    for (;;) {
+        // Read the flag before draining: everything pushed before finish() is still written.
+        const bool stopping = stop_.load(std::memory_order_acquire);
+        bool       popped   = false;
+        while (ring_.try_pop(r)) {
+            popped = true;
+            if (failed_.load(std::memory_order_relaxed)) continue; // keep draining so producers never stall
+            if (rotate_bytes_ && r.type == telemetry_record::kind::frame && file_bytes_ + used >= rotate_bytes_) {
+                write(buffer.get(), used);
+                used = 0;
+                if (!rotate()) continue;
+            }
+            std::size_t n = ops_.record(buffer.get() + used, k_write_buffer - used, r);
+            if (n == 0) {
+                write(buffer.get(), used);
+                used = 0;
+                n    = ops_.record(buffer.get(), k_write_buffer, r);
+            }
+            used += n;
+        }
+        if (used) {
+            write(buffer.get(), used);
+            used = 0;
+            if (file_ && std::fflush(file_) != 0) failed_.store(true, std::memory_order_relaxed);
+        }
+        if (!popped) {
+            if (stopping) break;
+            std::this_thread::sleep_for(k_idle_sleep);
+        }
+    }
+}
+
+} // namespace rphys
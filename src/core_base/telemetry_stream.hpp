@@ -0,0 +1,120 @@
+#ifndef RPHYS_TELEMETRY_STREAM_HPP
+#define RPHYS_TELEMETRY_STREAM_HPP
+
+#include "rphys/api_telemetry.h"
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace rphys {
+
+// Bounded single-producer / single-consumer ring. Each side owns one index and publishes it with
+// a release store; the other side reads it with acquire. No CAS, no per-cell state.
+template <class T>
+class spsc_ring {
+public:
+    explicit spsc_ring(std::size_t capacity) {
+        const std::size_t n = std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity);
+        cells_              = std::make_unique<T[]>(n);
+        mask_               = n - 1;
+    }
+
+    // Producer only. Free slots as seen by the producer (a lower bound while the consumer runs).
+    std::size_t free_slots() const noexcept { return mask_ + 1 - static_cast<std::size_t>(tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire)); }
+
+    // Producer only; callers check free_slots() first.
+    void push(const T& value) {
+        const std::uint64_t t = tail_.load(std::memory_order_relaxed);
+        cells_[t & mask_]     = value;
+        tail_.store(t + 1, std::memory_order_release);
+    }
+
+    // Consumer only.
+    bool try_pop(T& out) {
+        const std::uint64_t h = head_.load(std::memory_order_relaxed);
+        if (h == tail_.load(std::memory_order_acquire)) return false;
+        out = cells_[h & mask_];
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+
+private:
+    std::unique_ptr<T[]> cells_;
+    std::size_t          mask_{0};
+    alignas(64) std::atomic<std::uint64_t> tail_{0}; // written by the producer
+    alignas(64) std::atomic<std::uint64_t> head_{0}; // written by the consumer
+};
+
+// Fixed-size stream entry: one frame record followed by `frame.phase_count` phase records.
+struct telemetry_record {
+    enum class kind : std::uint8_t { frame, phase };
+    kind          type{kind::frame};
+    std::uint32_t world{0};
+    double        sim_time{0.0};
+    frame_stats   frame{}; // `phases` is always null here
+    phase_stats   phase{};
+};
+
+// Formatter of one file format. Both functions write at most `capacity` bytes into `out` and
+// return the length, 0 if the text did not fit. `header` starts every file (also after rotation).
+struct telemetry_format_ops {
+    std::size_t (*header)(char* out, std::size_t capacity){nullptr};
+    std::size_t (*record)(char* out, std::size_t capacity, const telemetry_record&){nullptr};
+};
+
+// Streams per-frame telemetry of one world to disk. The stepping thread only copies records into
+// the ring (no allocation, no I/O, no lock); a writer thread formats them into a fixed buffer and
+// writes it with buffered stdio, rotating to `<path>.1`, `<path>.2`, ... when a file exceeds
+// `rotate_bytes`.
+//
+// Overflow: with telemetry_overflow::drop a frame whose records do not all fit is dropped as a
+// whole and counted; the step never waits. With telemetry_overflow::block the stepping thread
+// yields until the writer has made room, so every frame is kept at the cost of step latency when
+// the disk falls behind.
+class telemetry_stream {
+public:
+    // Opens the first file and starts the writer; nullptr if the file cannot be created.
+    static std::unique_ptr<telemetry_stream> open(const telemetry_stream_desc&, const telemetry_format_ops&, std::uint32_t world);
+    // Drains every queued record and closes the file; false if any write failed. Idempotent.
+    bool finish();
+    ~telemetry_stream() { finish(); }
+    telemetry_stream(const telemetry_stream&)            = delete;
+    telemetry_stream& operator=(const telemetry_stream&) = delete;
+
+    // Stepping thread. `frame.phases` / `phase_count` are read here; nothing is retained.
+    void push_frame(const frame_stats& frame, double sim_time);
+    std::uint64_t dropped() const noexcept { return dropped_; }
+
+private:
+    telemetry_stream(const telemetry_stream_desc&, const telemetry_format_ops&, std::uint32_t world, std::FILE* file);
+    void run();
+    bool write(const char* data, std::size_t size);
+    bool rotate();
+
+    spsc_ring<telemetry_record> ring_;
+    telemetry_format_ops        ops_{};
+    telemetry_overflow          overflow_{telemetry_overflow::drop};
+    std::uint32_t               world_{0};
+    std::uint64_t               dropped_{0}; // stepping thread only
+
+    // Writer thread only.
+    std::string   path_;
+    std::uint64_t rotate_bytes_{0};
+    std::uint64_t file_bytes_{0};
+    std::uint32_t file_index_{0};
+    std::FILE*    file_{nullptr};
+
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> failed_{false};
+    std::thread       writer_;
+};
+
+} // namespace rphys
+
+#endif // RPHYS_TELEMETRY_STREAM_HPP
@@ -0,0 +1,49 @@
+#ifndef RPHYS_VEC_MATH_HPP
+#define RPHYS_VEC_MATH_HPP
+
+#include <cmath>
+
+namespace rphys {
+
+// Packed float3 used by domain state arrays (12-byte stride in exported fields).
+struct vec3f {
+    float x{0.0f}, y{0.0f}, z{0.0f};
+};
+
+inline vec3f operator+(vec3f a, vec3f b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+inline vec3f operator-(vec3f a, vec3f b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+inline vec3f operator-(vec3f a) { return {-a.x, -a.y, -a.z}; }
+inline vec3f operator*(vec3f a, float s) { return {a.x * s, a.y * s, a.z * s}; }
+inline vec3f operator*(float s, vec3f a) { return a * s; }
+inline vec3f& operator+=(vec3f& a, vec3f b) { a = a + b; return a; }
+inline vec3f& operator-=(vec3f& a, vec3f b) { a = a - b; return a; }
+inline vec3f& operator*=(vec3f& a, float s) { a = a * s; return a; }
+
+inline float dot(vec3f a, vec3f b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline vec3f cross(vec3f a, vec3f b) { return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x}; }
+inline float length_sq(vec3f a) { return dot(a, a); }
+inline float length(vec3f a) { return std::sqrt(dot(a, a)); }
+
+// Unit quaternion (x, y, z, w) for rigid orientations.
+struct quatf {
+    float x{0.0f}, y{0.0f}, z{0.0f}, w{1.0f};
+};
+
+inline vec3f rotate(quatf q, vec3f v) {
+    const vec3f u{q.x, q.y, q.z};
+    const vec3f t = 2.0f * cross(u, v);
+    return v + q.w * t + cross(u, t);
+}
+
+inline vec3f rotate_inverse(quatf q, vec3f v) { return rotate(quatf{-q.x, -q.y, -q.z, q.w}, v); }
+
+inline quatf normalized(quatf q) {
+    float n = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    if (n <= 0.0f) return quatf{};
+    float s = 1.0f / n;
+    return {q.x * s, q.y * s, q.z * s, q.w * s};
+}
+
+} // namespace rphys
+
+#endif // RPHYS_VEC_MATH_HPP
@@ -1,26 +1,225 @@
 #include "world_core.hpp"
+#include "scene_file.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <new>
 
 namespace rphys {
 
+namespace {
+    bool apply_command(world_core& w, const command_record& c) {
+        switch (c.kind) {
+            case command_kind::set_param:
+                if (c.name_view().empty()) return false;
+                ps_set_double(&w.params, c.name_view(), c.value[0]);
+                if (!c.name_view().starts_with("lod.")) world_wake_domains(w, 0);
+                return true;
+            case command_kind::field_patch: {
+                const field_bus_entry* f = find_field(&w.fields, c.domain, c.name_view());
+                if (!f || !field_write_element(*f, c.index, c.value, 4)) return false;
+                world_wake_domains(w, c.domain);
+                return true;
+            }
+            case command_kind::pin:
+            case command_kind::unpin:
+            case command_kind::impulse: break;
+        }
+        if (domain_core* d = world_find_domain(w, c.domain)) {
+            if (d->inert || !d->contract->apply_command || !d->contract->apply_command(d->state, c)) return false;
+            domain_activity_wake(d->activity);
+            return true;
+        }
+        for (const auto& t : w.command_targets) {
+            if (t.domain == c.domain && t.apply) return t.apply(t.context, c);
+        }
+        return false;
+    }
+
+    void export_domain_fields(world_core& w, domain_core& d) {
+        if (!d.inert && d.contract->export_fields) d.contract->export_fields(d.state, w.fields);
+    }
+
+    // Shared tail of build_static / load_scene: a failed build leaves the domain inert.
+    bool finish_domain_build(world_core& w, domain_core& d, bool ok) {
+        domain_activity_wake(d.activity);
+        if (!ok) {
+            d.inert = true;
+            unregister_domain_fields(&w.fields, d.id);
+        } else {
+            export_domain_fields(w, d);
+        }
+        ++w.topology_version;
+        return ok;
+    }
+
+    bool endpoint_matches(const coupling_contract& c, int endpoint, const domain_core* d) {
+        if (!d) return false;
+        const char* want = c.endpoint_types[endpoint];
+        return !want || std::strcmp(want, d->contract->type) == 0;
+    }
+} // namespace
+
+frame_arena* step_scratch(const step_context& ctx) { return ctx.world ? &world_scratch(*ctx.world) : nullptr; }
+
+void world_wake_domains(world_core& w, std::uint32_t domain) {
+    for (domain_core* d : w.domains) {
+        if (domain == 0 || d->id == domain) domain_activity_wake(d->activity);
+    }
+}
+
 world_core* create_world_core(const world_config& cfg) {
-    world_core* w = new (std::nothrow) world_core{};
+    world_core* w = new (std::nothrow) world_core(cfg);
     if (!w) return nullptr;
-    w->config = cfg;
     w->frame_count = 0;
     w->total_time = 0.0;
     return w;
 }
 
 void destroy_world_core(world_core* w) noexcept {
+    if (!w) return;
+    for (coupling_core* c : w->couplings) destroy_coupling_core(c);
+    for (domain_core* d : w->domains) destroy_domain_core(d);
+    if (w->scheduler.destroy) w->scheduler.destroy(w->scheduler.self);
     delete w;
 }
 
+void world_bind_scheduler(world_core& w, const world_scheduler& s) {
+    if (w.scheduler.destroy) w.scheduler.destroy(w.scheduler.self);
+    w.scheduler = s;
+}
+
+domain_core* world_find_domain(world_core& w, std::uint32_t id) {
+    auto it = std::lower_bound(w.domains.begin(), w.domains.end(), id, [](const domain_core* d, std::uint32_t v) { return d->id < v; });
+    return it != w.domains.end() && (*it)->id == id ? *it : nullptr;
+}
+
+std::uint32_t world_add_domain(world_core& w, const domain_pipeline_contract* contract) {
+    domain_core* d = create_domain_core(contract, w.next_domain_id);
+    if (!d) return 0;
+    w.domains.push_back(d);
+    ++w.next_domain_id;
+    ++w.topology_version;
+    export_domain_fields(w, *d);
+    return d->id;
+}
+
+bool world_remove_domain(world_core& w, std::uint32_t id) {
+    domain_core* d = world_find_domain(w, id);
+    if (!d) return false;
+    for (std::size_t i = w.couplings.size(); i-- > 0;) {
+        coupling_core* c = w.couplings[i];
+        if (c->domains[0] == id || c->domains[1] == id) world_remove_coupling(w, c->id);
+    }
+    unregister_domain_fields(&w.fields, id);
+    std::erase(w.domains, d);
+    std::erase_if(w.command_targets, [id](const command_target& t) { return t.domain == id; });
+    destroy_domain_core(d);
+    ++w.topology_version;
+    return true;
+}
+
+bool world_build_domain(world_core& w, std::uint32_t id, const scene_primitive_list& prims) {
+    domain_core* d = world_find_domain(w, id);
+    if (!d) return false;
+    return finish_domain_build(w, *d, !d->inert && (!d->contract->build_static || d->contract->build_static(d->state, prims)));
+}
+
+bool world_load_domain(world_core& w, std::uint32_t id, const scene_file& file) {
+    domain_core* d = world_find_domain(w, id);
+    if (!d) return false;
+    bool ok = !d->inert;
+    if (ok && d->contract->load_scene) {
+        ok = d->contract->load_scene(d->state, file);
+    } else if (ok) {
+        scene_primitive_list prims;
+        ok = scene_file_read_primitives(file, prims) && (!d->contract->build_static || d->contract->build_static(d->state, prims));
+    }
+    return finish_domain_build(w, *d, ok);
+}
+
+std::uint32_t world_add_coupling(world_core& w, const coupling_contract* contract, std::uint32_t first, std::uint32_t second) {
+    if (!contract || first == second) return 0;
+    if (!endpoint_matches(*contract, 0, world_find_domain(w, first)) || !endpoint_matches(*contract, 1, world_find_domain(w, second))) return 0;
+    coupling_core* c = create_coupling_core(contract, w.next_coupling_id, first, second);
+    if (!c) return 0;
+    w.couplings.push_back(c);
+    ++w.next_coupling_id;
+    // A new partner disturbs both sides; their groups merge from the next step.
+    world_wake_domains(w, first);
+    world_wake_domains(w, second);
+    ++w.topology_version;
+    return c->id;
+}
+
+bool world_remove_coupling(world_core& w, std::uint32_t id) {
+    auto it = std::find_if(w.couplings.begin(), w.couplings.end(), [id](const coupling_core* c) { return c->id == id; });
+    if (it == w.couplings.end()) return false;
+    destroy_coupling_core(*it);
+    w.couplings.erase(it);
+    ++w.topology_version;
+    return true;
+}
+
 void step_world_core(world_core* w, double dt) {
     if (!w) return;
+    const auto start = std::chrono::steady_clock::now();
     if (dt < 0.0) dt = 0.0; // clamp negative dt
+    frame_stats frame{};
+    world_profiler* profiler = w->telemetry.profiler.get();
+    {
+        profile_scope step_scope(profiler, profile_kind::step, "step");
+
+        // Commands and due events are applied as one batch before any simulation work.
+        {
+            profile_scope scope(profiler, profile_kind::commands, "commands");
+            frame_vector<command_record> batch{frame_allocator<command_record>(world_scratch(*w))};
+            command_queue_drain(w->commands, batch, w->total_time + dt);
+            for (const auto& c : batch) {
+                if (apply_command(*w, c)) ++frame.commands_applied;
+                else ++frame.commands_rejected;
+            }
+        }
+
+        if (!w->domains.empty() && w->scheduler.run_frame) {
+            step_context ctx{};
+            ctx.world       = w;
+            ctx.dt          = dt;
+            ctx.time        = w->total_time;
+            ctx.frame       = w->frame_count;
+            ctx.params      = &w->params;
+            ctx.determinism = w->config.determinism;
+            ctx.simd        = w->config.simd;
+            ctx.profiler    = profiler;
+            ctx.exec        = w->scheduler.exec;
+            const std::uint32_t passes = world_plan_activity(*w, dt);
+            frame_view view{};
+            view.domains          = w->domains.data();
+            view.domain_count     = w->domains.size();
+            view.couplings        = w->couplings.data();
+            view.coupling_count   = w->couplings.size();
+            view.fields           = &w->fields;
+            view.topology_version = w->topology_version;
+            // Folded LOD steps may need substeps; every pass is a full frame over the domains it marks.
+            for (std::uint32_t pass = 0; pass < passes; ++pass) {
+                world_activity_pass(*w, pass);
+                w->scheduler.run_frame(w->scheduler.self, view, ctx);
+                // Phases may reallocate; republish views so the bus is valid for the next pass / step.
+                for (domain_core* d : w->domains) export_domain_fields(*w, *d);
+            }
+        }
+    }
+
     ++w->frame_count;
     w->total_time += dt;
+    if (w->history) world_history_capture(*w);
+
+    frame_arena_totals scratch = frame_arena_reset_all(w->scratch);
+    frame.frame_index      = w->frame_count;
+    frame.frame_ms         = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    frame.commands_dropped = w->commands.dropped.load(std::memory_order_relaxed);
+    frame.events_pending   = static_cast<std::uint32_t>(w->commands.pending_events.size());
+    telemetry_record_frame(w->telemetry, frame, scratch, w->total_time);
 }
 
 } // namespace rphys
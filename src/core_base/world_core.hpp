@@ -2,16 +2,52 @@
 #define RPHYS_WORLD_CORE_HPP
 
 #include <cstdint>
+#include <memory>
+#include <vector>
+#include "command_queue.hpp"
+#include "field_bus.hpp"
+#include "frame_arena.hpp"
+#include "param_store.hpp"
+#include "scheduler_core.hpp"
+#include "telemetry_core.hpp"
+#include "world_snapshot.hpp"
 
 namespace rphys {
 
-struct world_config { int placeholder{}; };
+struct world_config {
+    int placeholder{};
+    std::uint32_t command_capacity{4096};
+    determinism_level determinism{determinism_level::fast};
+    simd_level simd{simd_level::scalar}; // resolved for this CPU (perf_layers/simd_vec)
+};
+
+// Receiver for domain-targeted commands (pin / unpin / impulse). Registered by domain owners.
+struct command_target {
+    std::uint32_t domain{0};
+    void*         context{nullptr};
+    bool (*apply)(void* context, const command_record&){nullptr};
+};
 
 // Internal core implementation structure (opaque to public API)
 struct world_core {
-    std::uint64_t frame_count{0};
-    double        total_time{0.0};
-    world_config  config{};
+    std::uint64_t   frame_count{0};
+    double          total_time{0.0};
+    world_config    config{};
+    frame_arena_set scratch;    // step-scoped per-thread allocations, reset at the end of every step
+    telemetry_core  telemetry{};
+    param_store     params{};
+    field_bus       fields{};
+    world_command_queue         commands; // filled from any thread, drained at the start of each step
+    std::vector<command_target> command_targets;
+    std::vector<domain_core*>   domains;    // ascending id order
+    std::vector<coupling_core*> couplings;  // ascending id order
+    std::uint32_t   next_domain_id{1};      // ids are never reused within a world
+    std::uint32_t   next_coupling_id{1};
+    std::uint64_t   topology_version{0};    // bumped by every domain / coupling change
+    world_scheduler scheduler{};
+    std::unique_ptr<world_history> history; // rollback ring; null unless enabled
+
+    explicit world_core(const world_config& cfg) : config(cfg), commands(cfg.command_capacity) {}
 };
 
 // Factory / lifecycle / stepping (used by gateway layer)
@@ -19,6 +55,24 @@ world_core* create_world_core(const world_config&);
 void destroy_world_core(world_core*) noexcept;
 void step_world_core(world_core*, double dt);
 
+// Scheduler binding; takes ownership (the previous scheduler is destroyed).
+void world_bind_scheduler(world_core&, const world_scheduler&);
+
+// Domain / coupling membership. Removing a domain also removes couplings attached to it.
+domain_core*   world_find_domain(world_core&, std::uint32_t id);
+std::uint32_t  world_add_domain(world_core&, const domain_pipeline_contract*);
+bool           world_remove_domain(world_core&, std::uint32_t id);
+bool           world_build_domain(world_core&, std::uint32_t id, const scene_primitive_list&);
+bool           world_load_domain(world_core&, std::uint32_t id, const scene_file&);
+std::uint32_t  world_add_coupling(world_core&, const coupling_contract*, std::uint32_t first, std::uint32_t second);
+bool           world_remove_coupling(world_core&, std::uint32_t id);
+// Wakes a sleeping domain (0: every domain); called for anything that changes state from outside
+// the step (commands, field writes, rebuilds, parameters other than the "lod." camera keys).
+void           world_wake_domains(world_core&, std::uint32_t domain);
+
+// Scratch arena of the calling thread; memory is valid until the current step returns.
+inline frame_arena& world_scratch(world_core& w) { return frame_arena_local(w.scratch); }
+
 } // namespace rphys
 
 #endif // RPHYS_WORLD_CORE_HPP
@@ -0,0 +1,286 @@
+#include "world_snapshot.hpp"
+#include "lz_codec.hpp"
+#include "world_core.hpp"
+#include <algorithm>
+#include <string>
+
+namespace rphys {
+
+namespace {
+    constexpr char          k_magic[8]      = {'R', 'P', 'H', 'Y', 'S', 'S', 'N', 'P'};
+    constexpr std::uint16_t k_version_major = 1;
+    constexpr std::uint16_t k_version_minor = 0;
+    constexpr std::uint32_t k_flag_cold_lz  = 1u << 0;
+
+    struct blob_header {
+        char          magic[8];
+        std::uint16_t version_major;
+        std::uint16_t version_minor;
+        std::uint32_t flags;
+        std::uint64_t hot_size;
+        std::uint64_t cold_size;     // as stored
+        std::uint64_t cold_raw_size; // after decompression
+        std::uint64_t reserved[3];
+    };
+    static_assert(sizeof(blob_header) == 64);
+
+    // Owns partially restored domains / couplings until they are swapped into the world.
+    struct staged_topology {
+        std::vector<domain_core*>   domains;
+        std::vector<coupling_core*> couplings;
+
+        ~staged_topology() {
+            for (coupling_core* c : couplings) destroy_coupling_core(c);
+            for (domain_core* d : domains) destroy_domain_core(d);
+        }
+
+        bool has_domain(std::uint32_t id) const {
+            return std::any_of(domains.begin(), domains.end(), [id](const domain_core* d) { return d->id == id; });
+        }
+    };
+} // namespace
+
+bool world_save(const world_core& w, snapshot_writer& out) {
+    using enum snapshot_tier;
+    out.write(cold, w.next_domain_id);
+    out.write(cold, w.next_coupling_id);
+    out.write(cold, static_cast<std::uint32_t>(w.domains.size()));
+    for (const domain_core* d : w.domains) {
+        out.write(cold, d->id);
+        out.write_string(cold, d->contract->type);
+        out.write(cold, static_cast<std::uint8_t>(d->inert));
+    }
+    out.write(cold, static_cast<std::uint32_t>(w.couplings.size()));
+    for (const coupling_core* c : w.couplings) {
+        out.write(cold, c->id);
+        out.write_string(cold, c->contract->type);
+        out.write(cold, c->domains[0]);
+        out.write(cold, c->domains[1]);
+    }
+
+    out.write(hot, w.frame_count);
+    out.write(hot, w.total_time);
+    out.write(hot, static_cast<std::uint32_t>(w.params.values.size()));
+    for (const auto& [key, value] : w.params.values) {
+        out.write_string(hot, key);
+        out.write(hot, value);
+    }
+    out.write_array(hot, w.commands.pending_events);
+    out.write(hot, w.commands.next_sequence);
+    for (const coupling_core* c : w.couplings) out.write(hot, static_cast<std::uint8_t>(c->detached));
+
+    for (const domain_core* d : w.domains) {
+        if (d->inert) continue;
+        if (!d->contract->save_state) return false;
+        d->contract->save_state(d->state, out);
+    }
+    for (const coupling_core* c : w.couplings) {
+        if (c->contract->save_state) c->contract->save_state(c->state, out);
+    }
+    return true;
+}
+
+bool world_restore(world_core& w, snapshot_reader& in, const snapshot_contracts& contracts) {
+    using enum snapshot_tier;
+    if (!contracts.find_domain) return false;
+    staged_topology staged;
+    std::uint32_t next_domain = 0, next_coupling = 0, domain_count = 0, coupling_count = 0;
+    in.read(cold, next_domain);
+    in.read(cold, next_coupling);
+    in.read(cold, domain_count);
+    std::string type;
+    for (std::uint32_t i = 0; i < domain_count && in.ok(); ++i) {
+        std::uint32_t id    = 0;
+        std::uint8_t  inert = 0;
+        in.read(cold, id);
+        in.read_string(cold, type);
+        in.read(cold, inert);
+        const domain_pipeline_contract* contract = in.ok() ? contracts.find_domain(type) : nullptr;
+        // Ids ascend and stay below the stored next id, as world_add_domain guarantees.
+        if (!contract || id == 0 || id >= next_domain || (!staged.domains.empty() && id <= staged.domains.back()->id)) return false;
+        domain_core* d = create_domain_core(contract, id);
+        if (!d) return false;
+        d->inert = inert != 0;
+        staged.domains.push_back(d);
+    }
+    in.read(cold, coupling_count);
+    for (std::uint32_t i = 0; i < coupling_count && in.ok(); ++i) {
+        std::uint32_t id = 0, first = 0, second = 0;
+        in.read(cold, id);
+        in.read_string(cold, type);
+        in.read(cold, first);
+        in.read(cold, second);
+        const coupling_contract* contract = in.ok() && contracts.find_coupling ? contracts.find_coupling(type) : nullptr;
+        if (!contract || id == 0 || id >= next_coupling || !staged.has_domain(first) || !staged.has_domain(second)) return false;
+        coupling_core* c = create_coupling_core(contract, id, first, second);
+        if (!c) return false;
+        staged.couplings.push_back(c);
+    }
+
+    std::uint64_t frame_count = 0;
+    double        total_time  = 0.0;
+    std::uint32_t param_count = 0;
+    param_store   params;
+    in.read(hot, frame_count);
+    in.read(hot, total_time);
+    in.read(hot, param_count);
+    for (std::uint32_t i = 0; i < param_count && in.ok(); ++i) {
+        double value = 0.0;
+        in.read_string(hot, type);
+        in.read(hot, value);
+        params.values.insert_or_assign(type, value);
+    }
+    std::vector<command_record> events;
+    std::uint64_t               next_sequence = 0;
+    in.read_array(hot, events);
+    in.read(hot, next_sequence);
+    if (events.size() > w.commands.ring.capacity()) return false;
+    if (!std::all_of(events.begin(), events.end(), [](const command_record& e) { return event_time_valid(e.time); })) return false;
+    if (!std::is_heap(events.begin(), events.end(), event_fires_after)) return false;
+    for (coupling_core* c : staged.couplings) {
+        std::uint8_t detached = 0;
+        in.read(hot, detached);
+        c->detached = detached != 0;
+    }
+    for (domain_core* d : staged.domains) {
+        if (d->inert) continue;
+        if (!in.ok() || !d->contract->load_state || !d->contract->load_state(d->state, in)) return false;
+    }
+    for (coupling_core* c : staged.couplings) {
+        if (c->contract->load_state && (!in.ok() || !c->contract->load_state(c->state, in))) return false;
+    }
+    if (!in.ok() || !in.exhausted()) return false;
+
+    // Everything parsed: swap the staged topology in.
+    for (domain_core* d : w.domains) {
+        unregister_domain_fields(&w.fields, d->id);
+        std::erase_if(w.command_targets, [id = d->id](const command_target& t) { return t.domain == id; });
+    }
+    w.domains.swap(staged.domains);
+    w.couplings.swap(staged.couplings);
+    w.next_domain_id          = next_domain;
+    w.next_coupling_id        = next_coupling;
+    w.frame_count             = frame_count;
+    w.total_time              = total_time;
+    w.params                  = std::move(params);
+    w.commands.pending_events.assign(events.begin(), events.end()); // keeps the reserved capacity
+    w.commands.next_sequence  = next_sequence;
+    for (domain_core* d : w.domains) {
+        if (!d->inert && d->contract->export_fields) d->contract->export_fields(d->state, w.fields);
+    }
+    ++w.topology_version;
+    return true;
+}
+
+bool world_save_blob(const world_core& w, std::vector<unsigned char>& out, bool compress_cold) {
+    // The hot stream is written straight behind the header into the caller's buffer.
+    snapshot_writer s;
+    s.hot.swap(out);
+    s.hot.assign(sizeof(blob_header), 0);
+    if (!world_save(w, s)) {
+        out.clear();
+        return false;
+    }
+    blob_header h{};
+    std::copy(std::begin(k_magic), std::end(k_magic), h.magic);
+    h.version_major = k_version_major;
+    h.version_minor = k_version_minor;
+    h.hot_size      = s.hot.size() - sizeof(blob_header);
+    h.cold_raw_size = s.cold.size();
+
+    std::vector<unsigned char> packed;
+    const std::vector<unsigned char>* cold = &s.cold;
+    if (compress_cold) {
+        lz_compress(s.cold.data(), s.cold.size(), packed);
+        if (packed.size() < s.cold.size()) {
+            cold = &packed;
+            h.flags |= k_flag_cold_lz;
+        }
+    }
+    h.cold_size = cold->size();
+    out.swap(s.hot);
+    out.insert(out.end(), cold->begin(), cold->end());
+    std::memcpy(out.data(), &h, sizeof(h));
+    return true;
+}
+
+bool world_restore_blob(world_core& w, std::span<const unsigned char> blob, const snapshot_contracts& contracts) {
+    blob_header h{};
+    if (blob.size() < sizeof(h)) return false;
+    std::memcpy(&h, blob.data(), sizeof(h));
+    const std::size_t body = blob.size() - sizeof(h);
+    if (!std::equal(std::begin(k_magic), std::end(k_magic), h.magic) || h.version_major != k_version_major) return false;
+    if (h.hot_size > body || h.cold_size != body - h.hot_size) return false;
+    auto hot  = blob.subspan(sizeof(h), static_cast<std::size_t>(h.hot_size));
+    auto cold = blob.subspan(sizeof(h) + hot.size());
+
+    std::vector<unsigned char> unpacked;
+    if (h.flags & k_flag_cold_lz) {
+        // A literal-free LZ sequence expands at most ~255x; anything larger is corrupt.
+        if (h.cold_raw_size / 256 > h.cold_size) return false;
+        unpacked.resize(static_cast<std::size_t>(h.cold_raw_size));
+        if (!lz_decompress(cold.data(), cold.size(), unpacked.data(), unpacked.size())) return false;
+        cold = unpacked;
+    } else if (h.cold_raw_size != h.cold_size) {
+        return false;
+    }
+    snapshot_reader in(hot, cold);
+    return world_restore(w, in, contracts);
+}
+
+bool world_set_history_depth(world_core& w, std::uint32_t depth, const snapshot_contracts& contracts) {
+    if (depth == 0) {
+        w.history.reset();
+        return true;
+    }
+    auto h = std::make_unique<world_history>();
+    h->frames.resize(std::size_t{depth} + 1);
+    h->contracts = contracts;
+    w.history    = std::move(h);
+    world_history_capture(w);
+    if (w.history->count == 0) {
+        w.history.reset(); // some domain cannot be checkpointed
+        return false;
+    }
+    return true;
+}
+
+void world_history_capture(world_core& w) {
+    world_history& h = *w.history;
+    const std::size_t slot = h.count == 0 ? 0 : (h.newest + 1) % h.frames.size();
+    world_history::frame& f = h.frames[slot];
+    snapshot_writer s;
+    s.skip_cold = h.cold && h.cold_topology == w.topology_version;
+    s.hot.swap(f.hot); // reuse the evicted frame's buffer
+    s.hot.clear();
+    const bool ok = world_save(w, s);
+    f.hot.swap(s.hot);
+    if (!ok) {
+        h.count = 0; // history would have a gap; start over
+        return;
+    }
+    if (!s.skip_cold) {
+        h.cold          = std::make_shared<const std::vector<unsigned char>>(std::move(s.cold));
+        h.cold_topology = w.topology_version;
+    }
+    f.cold   = h.cold;
+    h.newest = slot;
+    h.count  = std::min(h.count + 1, h.frames.size());
+}
+
+bool world_history_rollback(world_core& w, std::uint32_t steps) {
+    if (!w.history || steps == 0) return false;
+    world_history& h = *w.history;
+    if (steps >= h.count) return false;
+    const std::size_t slot = (h.newest + h.frames.size() - steps) % h.frames.size();
+    world_history::frame& f = h.frames[slot];
+    snapshot_reader in(f.hot, *f.cold);
+    if (!world_restore(w, in, h.contracts)) return false;
+    h.newest = slot;
+    h.count -= steps;
+    h.cold   = f.cold;
+    h.cold_topology  = w.topology_version; // restore bumped it, but the cold data is unchanged
+    return true;
+}
+
+} // namespace rphys
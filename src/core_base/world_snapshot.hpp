@@ -0,0 +1,159 @@
+#ifndef RPHYS_WORLD_SNAPSHOT_HPP
+#define RPHYS_WORLD_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace rphys {
+
+struct world_core;
+struct domain_pipeline_contract;
+struct coupling_contract;
+
+// Checkpoint data is split in two streams:
+//  - hot:  everything a step may change (SoA state, solver / contact caches, clock, params);
+//          written as raw array copies;
+//  - cold: everything only build_static / topology edits change (masses, topology, rest data,
+//          the domain list). Optionally LZ-compressed in blobs; shared between rollback frames.
+// Readers consume each stream in the order the writer produced it.
+enum class snapshot_tier : std::uint8_t { hot, cold };
+
+class snapshot_writer {
+public:
+    std::vector<unsigned char> hot;
+    std::vector<unsigned char> cold;
+    bool                       skip_cold{false}; // rollback frames reuse an earlier cold stream
+
+    void write_bytes(snapshot_tier tier, const void* data, std::size_t size) {
+        if (tier == snapshot_tier::cold && skip_cold) return;
+        auto& out = tier == snapshot_tier::hot ? hot : cold;
+        const std::size_t at = out.size();
+        out.resize(at + size);
+        if (size) std::memcpy(out.data() + at, data, size);
+    }
+
+    template <class T>
+    void write(snapshot_tier tier, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write_bytes(tier, &value, sizeof(T));
+    }
+
+    template <class T>
+    void write_array(snapshot_tier tier, const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write(tier, static_cast<std::uint64_t>(values.size()));
+        write_bytes(tier, values.data(), values.size() * sizeof(T));
+    }
+
+    void write_string(snapshot_tier tier, std::string_view s) {
+        write(tier, static_cast<std::uint32_t>(s.size()));
+        write_bytes(tier, s.data(), s.size());
+    }
+};
+
+// Bounds-checked counterpart of snapshot_writer. A failed read poisons the reader: every later
+// read fails too, so callers can check ok() once at the end.
+class snapshot_reader {
+public:
+    snapshot_reader(std::span<const unsigned char> hot, std::span<const unsigned char> cold) : hot_(hot), cold_(cold) {}
+
+    bool ok() const { return ok_; }
+    bool fail() { return ok_ = false; }
+    bool exhausted() const { return hot_at_ == hot_.size() && cold_at_ == cold_.size(); }
+
+    bool read_bytes(snapshot_tier tier, void* data, std::size_t size) {
+        auto&       span = tier == snapshot_tier::hot ? hot_ : cold_;
+        std::size_t& at  = tier == snapshot_tier::hot ? hot_at_ : cold_at_;
+        if (!ok_ || size > span.size() - at) return fail();
+        if (size) std::memcpy(data, span.data() + at, size);
+        at += size;
+        return true;
+    }
+
+    template <class T>
+    bool read(snapshot_tier tier, T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return read_bytes(tier, &value, sizeof(T));
+    }
+
+    template <class T>
+    bool read_array(snapshot_tier tier, std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        std::uint64_t count = 0;
+        if (!read(tier, count)) return false;
+        const std::size_t left = tier == snapshot_tier::hot ? hot_.size() - hot_at_ : cold_.size() - cold_at_;
+        if (count > left / (sizeof(T) ? sizeof(T) : 1)) return fail(); // checked before allocating
+        values.resize(static_cast<std::size_t>(count));
+        return read_bytes(tier, values.data(), values.size() * sizeof(T));
+    }
+
+    bool read_string(snapshot_tier tier, std::string& s) {
+        std::uint32_t size = 0;
+        if (!read(tier, size)) return false;
+        const std::size_t left = tier == snapshot_tier::hot ? hot_.size() - hot_at_ : cold_.size() - cold_at_;
+        if (size > left) return fail();
+        s.resize(size);
+        return read_bytes(tier, s.data(), size);
+    }
+
+private:
+    std::span<const unsigned char> hot_;
+    std::span<const unsigned char> cold_;
+    std::size_t                    hot_at_{0};
+    std::size_t                    cold_at_{0};
+    bool                           ok_{true};
+};
+
+// Resolves contract type names stored in a snapshot (the gateway knows the built-in tables).
+struct snapshot_contracts {
+    const domain_pipeline_contract* (*find_domain)(std::string_view type){nullptr};
+    const coupling_contract*        (*find_coupling)(std::string_view type){nullptr};
+};
+
+// Writes the whole world: clock, params, pending events, domain / coupling topology and each
+// contract's save_state. Fails when an active domain has no save_state hook; couplings without
+// one are stateless.
+bool world_save(const world_core&, snapshot_writer&);
+
+// Rebuilds domains and couplings from the snapshot and swaps them in only once every read has
+// succeeded; on failure the world is left exactly as it was. Scheduler and determinism level are
+// properties of the running world and are kept.
+bool world_restore(world_core&, snapshot_reader&, const snapshot_contracts&);
+
+// Single-blob form: [header][hot stream][cold stream, optionally LZ-compressed]. `out` keeps its
+// capacity between calls, so periodic checkpoints do not reallocate.
+bool world_save_blob(const world_core&, std::vector<unsigned char>& out, bool compress_cold);
+bool world_restore_blob(world_core&, std::span<const unsigned char> blob, const snapshot_contracts&);
+
+// In-memory rollback ring: the state after each of the last `depth` steps plus the current one.
+// Hot streams are recaptured every step into reused buffers; the cold stream is shared until
+// the world's topology version changes.
+struct world_history {
+    struct frame {
+        std::vector<unsigned char>                        hot;
+        std::shared_ptr<const std::vector<unsigned char>> cold;
+    };
+    std::vector<frame>                                frames; // ring of depth + 1 entries
+    std::size_t                                       newest{0};
+    std::size_t                                       count{0};
+    std::shared_ptr<const std::vector<unsigned char>> cold;
+    std::uint64_t                                     cold_topology{~std::uint64_t{0}};
+    snapshot_contracts                                contracts{};
+};
+
+// depth 0 drops the history. Otherwise captures the current state as the first entry.
+bool world_set_history_depth(world_core&, std::uint32_t depth, const snapshot_contracts&);
+void world_history_capture(world_core&);
+// Restores the state `steps` captures back (1 = undo the last step) and forgets newer entries.
+bool world_history_rollback(world_core&, std::uint32_t steps);
+
+} // namespace rphys
+
+#endif // RPHYS_WORLD_SNAPSHOT_HPP
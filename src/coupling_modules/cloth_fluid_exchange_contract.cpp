@@ -1,3 +1,280 @@
 #include "cloth_fluid_exchange_contract.hpp"
-// skeleton
+#include "core_base/field_bus.hpp"
+#include "core_base/frame_arena.hpp"
+#include "core_base/param_store.hpp"
+#include "domain_fluid/shared/neighbor_search.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <new>
 
+namespace rphys {
+
+namespace {
+    constexpr std::size_t k_triangle_grain = 256;
+    constexpr std::size_t k_particle_grain = 256;
+    constexpr std::size_t k_vertex_grain   = 1024;
+
+    float param_or(const param_store* ps, std::string_view key, float fallback) {
+        double v = fallback;
+        return ps && ps_get_double(ps, key, v) ? static_cast<float>(v) : fallback;
+    }
+
+    vec3f min3(vec3f a, vec3f b) { return {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)}; }
+    vec3f max3(vec3f a, vec3f b) { return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)}; }
+
+    template <class T>
+    bool packed_field(const field_bus& bus, std::uint32_t domain, const char* name, field_scalar scalar, std::uint8_t components, const field_bus_entry*& out) {
+        out = find_field(&bus, domain, name);
+        return out && out->scalar == scalar && out->components == components && out->stride == sizeof(T);
+    }
+
+    // Closest point of triangle abc to p as barycentric weights (Ericson, Real-Time Collision
+    // Detection 5.1.5).
+    vec3f closest_on_triangle(vec3f p, vec3f a, vec3f b, vec3f c) {
+        const vec3f ab = b - a, ac = c - a, ap = p - a;
+        const float d1 = dot(ab, ap), d2 = dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f) return {1.0f, 0.0f, 0.0f};
+        const vec3f bp = p - b;
+        const float d3 = dot(ab, bp), d4 = dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3) return {0.0f, 1.0f, 0.0f};
+        const float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+            const float v = d1 / (d1 - d3);
+            return {1.0f - v, v, 0.0f};
+        }
+        const vec3f cp = p - c;
+        const float d5 = dot(ab, cp), d6 = dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6) return {0.0f, 0.0f, 1.0f};
+        const float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+            const float w = d2 / (d2 - d6);
+            return {1.0f - w, 0.0f, w};
+        }
+        const float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+            const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            return {0.0f, 1.0f - w, w};
+        }
+        const float denom = 1.0f / (va + vb + vc);
+        const float v = vb * denom, w = vc * denom;
+        return {1.0f - v - w, v, w};
+    }
+
+    // Calls fn(bucket) for every grid cell overlapped by triangle t grown by one cell.
+    template <class Fn>
+    void for_each_triangle_bucket(const fluid_neighbor_search& g, const vec3f* x, const std::uint32_t* tri, Fn&& fn) {
+        const vec3f     a = x[tri[0]], b = x[tri[1]], c = x[tri[2]];
+        const vec3f     grow{g.cell_size, g.cell_size, g.cell_size};
+        const grid_cell lo = grid_cell_of(g, min3(a, min3(b, c)) - grow);
+        const grid_cell hi = grid_cell_of(g, max3(a, max3(b, c)) + grow);
+        for (std::int32_t z = lo.z; z <= hi.z; ++z)
+            for (std::int32_t y = lo.y; y <= hi.y; ++y)
+                for (std::int32_t xx = lo.x; xx <= hi.x; ++xx) fn(grid_bucket_of(g, grid_cell{xx, y, z}));
+    }
+} // namespace
+
+cloth_fluid_settings cloth_fluid_read_settings(const param_store* ps) {
+    cloth_fluid_settings s{};
+    s.drag     = std::clamp(param_or(ps, "cloth_fluid.drag", 0.5f), 0.0f, 1.0f);
+    s.friction = std::clamp(param_or(ps, "cloth_fluid.friction", 0.1f), 0.0f, 1.0f);
+    return s;
+}
+
+void* cloth_fluid_exchange_create(const std::uint32_t domains[2]) {
+    auto* e = new (std::nothrow) cloth_fluid_exchange{};
+    if (!e) return nullptr;
+    e->cloth_domain = domains[0];
+    e->fluid_domain = domains[1];
+    return e;
+}
+
+void cloth_fluid_exchange_destroy(void* state) { delete static_cast<cloth_fluid_exchange*>(state); }
+
+void cloth_fluid_find_contacts(cloth_fluid_exchange& e, const vec3f* cloth, const std::uint32_t* triangles, std::size_t triangle_count,
+                               const vec3f* particles, const std::uint32_t* particle_bucket, std::size_t particle_count, std::uint32_t bucket_count,
+                               float cell_size, const step_context& ctx) {
+    e.hits.assign(particle_count, cloth_fluid_hit{});
+    if (triangle_count == 0 || particle_count == 0 || bucket_count == 0 || !(cell_size > 0.0f)) return;
+    fluid_neighbor_search g; // only the hash parameters; matches the grid the fluid built
+    g.cell_size   = cell_size;
+    g.bucket_mask = bucket_count - 1;
+
+    // Counting sort of triangles by bucket, the same way the fluid sorts its particles. The bins
+    // only live for this call; `own` backs them when there is no world (direct calls).
+    frame_arena                 own;
+    frame_arena&                scratch = step_scratch_or(ctx, own);
+    frame_vector<std::uint32_t> bucket_start{frame_allocator<std::uint32_t>(scratch)};
+    frame_vector<std::uint32_t> entries{frame_allocator<std::uint32_t>(scratch)};
+    frame_vector<std::uint32_t> cursor{frame_allocator<std::uint32_t>(scratch)};
+    bucket_start.assign(std::size_t{bucket_count} + 1, 0);
+    parallel_for(ctx.exec, triangle_count, k_triangle_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; ++t) {
+            for_each_triangle_bucket(g, cloth, triangles + 3 * t, [&](std::uint32_t b) {
+                std::atomic_ref<std::uint32_t>(bucket_start[b + 1]).fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+    });
+    for (std::size_t b = 0; b < bucket_count; ++b) bucket_start[b + 1] += bucket_start[b];
+    entries.resize(bucket_start[bucket_count]);
+    cursor.assign(bucket_start.begin(), bucket_start.end() - 1);
+    parallel_for(ctx.exec, triangle_count, k_triangle_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; ++t) {
+            for_each_triangle_bucket(g, cloth, triangles + 3 * t, [&](std::uint32_t b) {
+                entries[std::atomic_ref<std::uint32_t>(cursor[b]).fetch_add(1, std::memory_order_relaxed)] = static_cast<std::uint32_t>(t);
+            });
+        }
+    });
+
+    // A particle within h of a triangle lies in a cell of the grown bounds, so its own bucket holds
+    // every candidate; hash collisions only add candidates that fail the distance test.
+    const float h = cell_size;
+    parallel_for(ctx.exec, particle_count, k_particle_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const vec3f         p = particles[i];
+            const std::uint32_t b = particle_bucket[i] & g.bucket_mask;
+            cloth_fluid_hit     best;
+            float               best_d2 = h * h;
+            for (std::uint32_t k = bucket_start[b]; k < bucket_start[b + 1]; ++k) {
+                const std::uint32_t  t   = entries[k];
+                const std::uint32_t* tri = triangles + 3 * std::size_t{t};
+                const vec3f          a = cloth[tri[0]], bb = cloth[tri[1]], c = cloth[tri[2]];
+                const vec3f          w = closest_on_triangle(p, a, bb, c);
+                const vec3f          q = a * w.x + bb * w.y + c * w.z;
+                const float          d2 = length_sq(p - q);
+                if (d2 > best_d2 || (d2 == best_d2 && t >= best.triangle)) continue;
+                best_d2       = d2;
+                best.triangle = t;
+                best.bary     = w;
+                best.normal   = p - q;
+                if (d2 == 0.0f) best.normal = cross(bb - a, c - a); // on the sheet: face normal
+            }
+            if (best.triangle == cloth_fluid_no_triangle) continue;
+            best.distance = std::sqrt(best_d2);
+            const float len = length(best.normal);
+            best.normal = len > 0.0f ? best.normal * (1.0f / len) : vec3f{0.0f, 1.0f, 0.0f};
+            e.hits[i]   = best;
+        }
+    });
+}
+
+bool cloth_fluid_exchange_step(cloth_fluid_exchange& e, const field_bus& bus, step_context& ctx, cloth_fluid_impulse_fn impulse) {
+    const field_bus_entry *predicted, *position, *cloth_w, *triangles, *particles, *velocity, *acceleration, *density, *pressure, *bucket, *bucket_start, *mass, *radius;
+    if (!packed_field<vec3f>(bus, e.cloth_domain, "cloth.predicted", field_scalar::f32, 3, predicted) || !predicted->mutable_data ||
+        !packed_field<vec3f>(bus, e.cloth_domain, "cloth.position", field_scalar::f32, 3, position) ||
+        !packed_field<float>(bus, e.cloth_domain, "cloth.inv_mass", field_scalar::f32, 1, cloth_w) ||
+        !packed_field<std::uint32_t[3]>(bus, e.cloth_domain, "cloth.triangles", field_scalar::u32, 3, triangles) ||
+        !packed_field<vec3f>(bus, e.fluid_domain, "fluid.position", field_scalar::f32, 3, particles) ||
+        !packed_field<vec3f>(bus, e.fluid_domain, "fluid.velocity", field_scalar::f32, 3, velocity) || !velocity->mutable_data ||
+        !packed_field<vec3f>(bus, e.fluid_domain, "fluid.acceleration", field_scalar::f32, 3, acceleration) ||
+        !packed_field<float>(bus, e.fluid_domain, "fluid.density", field_scalar::f32, 1, density) ||
+        !packed_field<float>(bus, e.fluid_domain, "fluid.pressure", field_scalar::f32, 1, pressure) ||
+        !packed_field<std::uint32_t>(bus, e.fluid_domain, "fluid.grid_bucket", field_scalar::u32, 1, bucket) ||
+        !packed_field<std::uint32_t>(bus, e.fluid_domain, "fluid.grid_bucket_start", field_scalar::u32, 1, bucket_start) ||
+        !packed_field<float>(bus, e.fluid_domain, "fluid.particle_mass", field_scalar::f32, 1, mass) ||
+        !packed_field<float>(bus, e.fluid_domain, "fluid.smoothing_radius", field_scalar::f32, 1, radius))
+        return false;
+    const std::size_t nc = predicted->count, np = particles->count;
+    if (position->count != nc || cloth_w->count != nc || velocity->count != np || acceleration->count != np || density->count != np || pressure->count != np || bucket->count != np ||
+        mass->count != 1 || radius->count != 1 || bucket_start->count < 2 || !std::has_single_bit(bucket_start->count - 1))
+        return false;
+    const auto* tri = static_cast<const std::uint32_t*>(triangles->data);
+    for (std::size_t k = 0; k < 3 * triangles->count; ++k) {
+        if (tri[k] >= nc) return false;
+    }
+    if (ctx.dt <= 0.0) return true;
+
+    auto*       x   = static_cast<vec3f*>(predicted->mutable_data);
+    const auto* x0  = static_cast<const vec3f*>(position->data);
+    const auto* w   = static_cast<const float*>(cloth_w->data);
+    const auto* p   = static_cast<const vec3f*>(particles->data);
+    auto*       v   = static_cast<vec3f*>(velocity->mutable_data);
+    const auto* a   = static_cast<const vec3f*>(acceleration->data);
+    const auto* rho = static_cast<const float*>(density->data);
+    const auto* pr  = static_cast<const float*>(pressure->data);
+    const float m   = *static_cast<const float*>(mass->data);
+    const float h   = *static_cast<const float*>(radius->data);
+    if (!(m > 0.0f)) return true;
+    cloth_fluid_find_contacts(e, x, tri, triangles->count, p, static_cast<const std::uint32_t*>(bucket->data), np,
+                              static_cast<std::uint32_t>(bucket_start->count - 1), h, ctx);
+
+    const cloth_fluid_settings s      = cloth_fluid_read_settings(ctx.params);
+    const float                dt     = static_cast<float>(ctx.dt);
+    const float                inv_dt = 1.0f / dt;
+    frame_arena         own;
+    frame_arena&        scratch = step_scratch_or(ctx, own);
+    frame_vector<vec3f> impulses{frame_allocator<vec3f>(scratch)};
+    impulses.assign(np, vec3f{});
+    parallel_for(ctx.exec, np, k_particle_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const cloth_fluid_hit& hit = e.hits[i];
+            if (hit.triangle == cloth_fluid_no_triangle) continue;
+            const std::uint32_t* t = tri + 3 * std::size_t{hit.triangle};
+            const float          b[3] = {hit.bary.x, hit.bary.y, hit.bary.z};
+            vec3f                cloth_v{};
+            float                cloth_w_point = 0.0f; // inverse mass seen at the closest point
+            for (int k = 0; k < 3; ++k) {
+                cloth_v += (x[t[k]] - x0[t[k]]) * (b[k] * inv_dt);
+                cloth_w_point += b[k] * b[k] * w[t[k]];
+            }
+            cloth_fluid_contact c;
+            c.normal            = hit.normal;
+            c.relative_velocity = v[i] + a[i] * dt - cloth_v; // the velocity integrate will move the particle with
+            c.weight            = 1.0f - hit.distance / h;
+            c.effective_mass    = 1.0f / (1.0f / m + cloth_w_point);
+            c.particle_mass     = m;
+            c.density           = rho[i];
+            c.pressure          = pr[i];
+            c.h                 = h;
+            c.dt                = dt;
+            const vec3f j = impulse(c, s);
+            impulses[i]   = j;
+            v[i] += j * (1.0f / m);
+        }
+    });
+    // Cloth side: the hits are bucketed per cloth vertex (entry 3 * particle + corner) and every
+    // bucket is sorted, so each vertex applies its share in particle order, exactly as a serial
+    // pass over the particles would, while the vertices run in parallel.
+    frame_vector<std::uint32_t> vertex_start{frame_allocator<std::uint32_t>(scratch)};
+    frame_vector<std::uint32_t> vertex_cursor{frame_allocator<std::uint32_t>(scratch)};
+    frame_vector<std::uint32_t> vertex_hits{frame_allocator<std::uint32_t>(scratch)};
+    vertex_start.assign(nc + 1, 0);
+    parallel_for(ctx.exec, np, k_particle_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (e.hits[i].triangle == cloth_fluid_no_triangle) continue;
+            const std::uint32_t* t = tri + 3 * std::size_t{e.hits[i].triangle};
+            for (int k = 0; k < 3; ++k) std::atomic_ref<std::uint32_t>(vertex_start[std::size_t{t[k]} + 1]).fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    for (std::size_t vert = 0; vert < nc; ++vert) vertex_start[vert + 1] += vertex_start[vert];
+    vertex_hits.resize(vertex_start[nc]);
+    vertex_cursor.assign(vertex_start.begin(), vertex_start.end() - 1);
+    parallel_for(ctx.exec, np, k_particle_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (e.hits[i].triangle == cloth_fluid_no_triangle) continue;
+            const std::uint32_t* t = tri + 3 * std::size_t{e.hits[i].triangle};
+            for (std::uint32_t k = 0; k < 3; ++k) {
+                const std::uint32_t slot = std::atomic_ref<std::uint32_t>(vertex_cursor[t[k]]).fetch_add(1, std::memory_order_relaxed);
+                vertex_hits[slot]        = static_cast<std::uint32_t>(3 * i) + k;
+            }
+        }
+    });
+    parallel_for(ctx.exec, nc, k_vertex_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t vert = begin; vert < end; ++vert) {
+            auto first = vertex_hits.begin() + vertex_start[vert], last = vertex_hits.begin() + vertex_start[vert + 1];
+            if (first == last) continue;
+            std::sort(first, last);
+            for (auto it = first; it != last; ++it) {
+                const std::size_t      i   = *it / 3;
+                const cloth_fluid_hit& hit = e.hits[i];
+                const std::uint32_t    k   = *it % 3;
+                const float            b   = k == 0 ? hit.bary.x : k == 1 ? hit.bary.y : hit.bary.z;
+                x[vert] -= impulses[i] * (b * w[vert] * dt);
+            }
+        }
+    });
+    return true;
+}
+
+} // namespace rphys
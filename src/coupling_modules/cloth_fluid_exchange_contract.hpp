@@ -1,7 +1,81 @@
 #ifndef RPHYS_COUPLING_CLOTH_FLUID_EXCHANGE_CONTRACT_HPP
 #define RPHYS_COUPLING_CLOTH_FLUID_EXCHANGE_CONTRACT_HPP
 
-namespace rphys { struct cloth_fluid_exchange_contract; }
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "core_base/coupling_core.hpp"
+#include "core_base/vec_math.hpp"
 
-#endif // RPHYS_COUPLING_CLOTH_FLUID_EXCHANGE_CONTRACT_HPP
+namespace rphys {
+
+// Exchange layer shared by the cloth <-> fluid couplings (cloth_fluid_two_way_pressure,
+// cloth_fluid_simple_drag). Cloth triangles are binned into the fluid's own cell-sorted grid
+// (fluid.grid_bucket / fluid.grid_bucket_start, cell size fluid.smoothing_radius), so every
+// particle finds its candidate triangles in its own bucket and detection plus the particle side of
+// the exchange is one parallel pass over the particles. Endpoint 0 is the cloth domain, endpoint 1
+// the fluid domain.
+
+constexpr std::uint32_t cloth_fluid_no_triangle = std::numeric_limits<std::uint32_t>::max();
+
+// Closest cloth triangle of one particle within the smoothing radius.
+struct cloth_fluid_hit {
+    std::uint32_t triangle{cloth_fluid_no_triangle};
+    float         distance{0.0f};
+    vec3f         bary{};   // of the closest point
+    vec3f         normal{}; // from the closest point towards the particle
+};
+
+// Everything an impulse model sees of one contact. The impulse returned is applied to the
+// particle; the cloth receives its negative, spread over the triangle by barycentric weight.
+struct cloth_fluid_contact {
+    vec3f normal{};
+    vec3f relative_velocity{}; // particle minus cloth point
+    float weight{0.0f};        // 1 - distance / h
+    float effective_mass{0.0f};
+    float particle_mass{0.0f};
+    float density{0.0f};
+    float pressure{0.0f};
+    float h{0.0f};
+    float dt{0.0f};
+};
+
+// Parameters (param_store keys): cloth_fluid.drag (0.5, share of the normal relative velocity
+// removed per step at full weight), cloth_fluid.friction (0.1, same for the tangential part).
+struct cloth_fluid_settings {
+    float drag{0.5f};
+    float friction{0.1f};
+};
+
+cloth_fluid_settings cloth_fluid_read_settings(const param_store*);
 
+using cloth_fluid_impulse_fn = vec3f (*)(const cloth_fluid_contact&, const cloth_fluid_settings&);
+
+// Per-coupling state. Hits keep their capacity across steps; triangle bins and impulses are
+// step scratch in the frame arena.
+struct cloth_fluid_exchange {
+    std::uint32_t                cloth_domain{0};
+    std::uint32_t                fluid_domain{0};
+    std::vector<cloth_fluid_hit> hits; // one per particle
+};
+
+void* cloth_fluid_exchange_create(const std::uint32_t domains[2]);
+void  cloth_fluid_exchange_destroy(void* state);
+
+// Bins triangles (AABB of `cloth` positions grown by cell_size) into `bucket_count` buckets of the
+// fluid grid's hash, then fills `hits` for every particle from the triangles in its own bucket.
+// Ties between triangles go to the lower index, so hits do not depend on the binning order.
+void cloth_fluid_find_contacts(cloth_fluid_exchange&, const vec3f* cloth, const std::uint32_t* triangles, std::size_t triangle_count,
+                               const vec3f* particles, const std::uint32_t* particle_bucket, std::size_t particle_count, std::uint32_t bucket_count,
+                               float cell_size, const step_context&);
+
+// One exchange step: finds contacts against cloth.predicted, evaluates `impulse` per contact and
+// applies it to fluid.velocity per particle and to cloth.predicted per vertex, both in parallel;
+// each vertex sums its share in particle order, so results match a serial pass bit for bit. False
+// when either domain's fields are missing or malformed.
+bool cloth_fluid_exchange_step(cloth_fluid_exchange&, const field_bus&, step_context&, cloth_fluid_impulse_fn impulse);
+
+} // namespace rphys
+
+#endif // RPHYS_COUPLING_CLOTH_FLUID_EXCHANGE_CONTRACT_HPP
@@ -1,3 +1,32 @@
 #include "cloth_fluid_simple_drag.hpp"
-// skeleton
+#include "cloth_fluid_exchange_contract.hpp"
 
+namespace rphys {
+
+namespace {
+    vec3f drag_impulse(const cloth_fluid_contact& c, const cloth_fluid_settings& s) {
+        const vec3f normal     = c.normal * dot(c.relative_velocity, c.normal);
+        const vec3f tangential = c.relative_velocity - normal;
+        return (normal * s.drag + tangential * s.friction) * (-c.weight * c.effective_mass);
+    }
+
+    bool drag_exchange(void* state, const field_bus& bus, step_context& ctx) {
+        return cloth_fluid_exchange_step(*static_cast<cloth_fluid_exchange*>(state), bus, ctx, drag_impulse);
+    }
+
+    const coupling_field k_reads[] = {
+        {0, "cloth.predicted"}, {0, "cloth.position"}, {0, "cloth.inv_mass"}, {0, "cloth.triangles"}, {1, "fluid.position"},
+        {1, "fluid.velocity"},  {1, "fluid.acceleration"}, {1, "fluid.density"}, {1, "fluid.pressure"}, {1, "fluid.grid"},
+    };
+    const coupling_field k_writes[] = {{0, "cloth.predicted"}, {1, "fluid.velocity"}};
+} // namespace
+
+const coupling_contract& cloth_fluid_simple_drag_contract() {
+    static const coupling_contract contract{
+        "cloth_fluid_simple_drag", {"cloth", "fluid"}, k_reads, std::size(k_reads), k_writes, std::size(k_writes), phase_stage::exchange,
+        cloth_fluid_exchange_create, cloth_fluid_exchange_destroy, drag_exchange, nullptr, nullptr,
+    };
+    return contract;
+}
+
+} // namespace rphys
@@ -1,7 +1,15 @@
 #ifndef RPHYS_COUPLING_CLOTH_FLUID_SIMPLE_DRAG_HPP
 #define RPHYS_COUPLING_CLOTH_FLUID_SIMPLE_DRAG_HPP
 
-namespace rphys { struct cloth_fluid_simple_drag; }
+#include "core_base/coupling_core.hpp"
 
-#endif // RPHYS_COUPLING_CLOTH_FLUID_SIMPLE_DRAG_HPP
+namespace rphys {
+
+// "cloth_fluid_simple_drag" (cloth, fluid): particles within the smoothing radius of the cloth
+// lose cloth_fluid.drag of their normal and cloth_fluid.friction of their tangential velocity
+// relative to the cloth, weighted by 1 - distance / h; the cloth receives the opposite impulse.
+const coupling_contract& cloth_fluid_simple_drag_contract();
 
+} // namespace rphys
+
+#endif // RPHYS_COUPLING_CLOTH_FLUID_SIMPLE_DRAG_HPP
@@ -1,3 +1,35 @@
 #include "cloth_fluid_two_way_pressure.hpp"
-// skeleton
+#include "cloth_fluid_exchange_contract.hpp"
+#include <algorithm>
 
+namespace rphys {
+
+namespace {
+    vec3f pressure_impulse(const cloth_fluid_contact& c, const cloth_fluid_settings&) {
+        const float volume = c.particle_mass / std::max(c.density, 1e-6f);
+        float       j      = std::max(0.0f, c.pressure) * volume / c.h * c.weight * c.dt;
+        const float vn     = dot(c.relative_velocity, c.normal);
+        if (vn < 0.0f) j -= vn * c.weight * c.effective_mass;
+        return c.normal * j;
+    }
+
+    bool pressure_exchange(void* state, const field_bus& bus, step_context& ctx) {
+        return cloth_fluid_exchange_step(*static_cast<cloth_fluid_exchange*>(state), bus, ctx, pressure_impulse);
+    }
+
+    const coupling_field k_reads[] = {
+        {0, "cloth.predicted"}, {0, "cloth.position"}, {0, "cloth.inv_mass"}, {0, "cloth.triangles"}, {1, "fluid.position"},
+        {1, "fluid.velocity"},  {1, "fluid.acceleration"}, {1, "fluid.density"}, {1, "fluid.pressure"}, {1, "fluid.grid"},
+    };
+    const coupling_field k_writes[] = {{0, "cloth.predicted"}, {1, "fluid.velocity"}};
+} // namespace
+
+const coupling_contract& cloth_fluid_two_way_pressure_contract() {
+    static const coupling_contract contract{
+        "cloth_fluid_two_way_pressure", {"cloth", "fluid"}, k_reads, std::size(k_reads), k_writes, std::size(k_writes), phase_stage::exchange,
+        cloth_fluid_exchange_create, cloth_fluid_exchange_destroy, pressure_exchange, nullptr, nullptr,
+    };
+    return contract;
+}
+
+} // namespace rphys
@@ -1,7 +1,16 @@
 #ifndef RPHYS_COUPLING_CLOTH_FLUID_TWO_WAY_PRESSURE_HPP
 #define RPHYS_COUPLING_CLOTH_FLUID_TWO_WAY_PRESSURE_HPP
 
-namespace rphys { struct cloth_fluid_two_way_pressure; }
+#include "core_base/coupling_core.hpp"
 
-#endif // RPHYS_COUPLING_CLOTH_FLUID_TWO_WAY_PRESSURE_HPP
+namespace rphys {
+
+// "cloth_fluid_two_way_pressure" (cloth, fluid): particles within the smoothing radius of the
+// cloth push on it with their pressure times volume over h, and approaching particles have their
+// normal relative velocity removed in proportion to 1 - distance / h. Both impulses act on the
+// particle and, with opposite sign, on the triangle's vertices.
+const coupling_contract& cloth_fluid_two_way_pressure_contract();
 
+} // namespace rphys
+
+#endif // RPHYS_COUPLING_CLOTH_FLUID_TWO_WAY_PRESSURE_HPP
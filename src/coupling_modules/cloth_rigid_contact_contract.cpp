@@ -1,3 +1,251 @@
 #include "cloth_rigid_contact_contract.hpp"
-// skeleton
+#include "core_base/field_bus.hpp"
+#include "core_base/param_store.hpp"
+#include <algorithm>
+#include <cmath>
+#include <new>
 
+namespace rphys {
+
+namespace {
+    constexpr std::uint32_t k_shape_sphere = 0;
+    constexpr std::uint32_t k_shape_box    = 1;
+    constexpr std::size_t   k_leaf_size    = 4;
+    constexpr std::size_t   k_query_block  = 64; // vertices culled and sampled together
+    constexpr std::size_t   k_block_grain  = 4;
+
+    float param_or(const param_store* ps, std::string_view key, float fallback) {
+        double v = fallback;
+        return ps && ps_get_double(ps, key, v) ? static_cast<float>(v) : fallback;
+    }
+
+    vec3f min3(vec3f a, vec3f b) { return {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)}; }
+    vec3f max3(vec3f a, vec3f b) { return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)}; }
+    vec3f abs3(vec3f a) { return {std::abs(a.x), std::abs(a.y), std::abs(a.z)}; }
+    float axis(vec3f v, int a) { return a == 0 ? v.x : a == 1 ? v.y : v.z; }
+
+    bool overlaps(vec3f alo, vec3f ahi, vec3f blo, vec3f bhi) {
+        return alo.x <= bhi.x && blo.x <= ahi.x && alo.y <= bhi.y && blo.y <= ahi.y && alo.z <= bhi.z && blo.z <= ahi.z;
+    }
+
+    // q' = q + dt/2 * (w, 0) q, renormalized.
+    quatf integrate(quatf q, vec3f w, float dt) {
+        const float h = 0.5f * dt;
+        const quatf d{h * (w.x * q.w + w.y * q.z - w.z * q.y), h * (w.y * q.w + w.z * q.x - w.x * q.z), h * (w.z * q.w + w.x * q.y - w.y * q.x),
+                      -h * (w.x * q.x + w.y * q.y + w.z * q.z)};
+        return normalized(quatf{q.x + d.x, q.y + d.y, q.z + d.z, q.w + d.w});
+    }
+
+    // Only the packed layouts the rigid domain exports are accepted.
+    template <class T>
+    bool packed_field(const field_bus& bus, std::uint32_t domain, const char* name, field_scalar scalar, std::uint8_t components, std::size_t count,
+                      const T*& out) {
+        const field_bus_entry* e = find_field(&bus, domain, name);
+        if (!e || e->scalar != scalar || e->components != components || e->stride != sizeof(T) || e->count != count) return false;
+        out = static_cast<const T*>(e->data);
+        return true;
+    }
+
+    void build_node(body_bvh& t, std::uint32_t node, std::uint32_t begin, std::uint32_t end, const vec3f* lo, const vec3f* hi) {
+        vec3f blo = lo[t.order[begin]], bhi = hi[t.order[begin]];
+        vec3f clo = (blo + bhi) * 0.5f, chi = clo;
+        for (std::uint32_t i = begin + 1; i < end; ++i) {
+            const std::uint32_t b = t.order[i];
+            blo = min3(blo, lo[b]);
+            bhi = max3(bhi, hi[b]);
+            clo = min3(clo, (lo[b] + hi[b]) * 0.5f);
+            chi = max3(chi, (lo[b] + hi[b]) * 0.5f);
+        }
+        t.nodes[node].lo = blo;
+        t.nodes[node].hi = bhi;
+        if (end - begin <= k_leaf_size) {
+            t.nodes[node].first = begin;
+            t.nodes[node].count = end - begin;
+            return;
+        }
+        // Median split along the widest spread of centres.
+        const vec3f ext = chi - clo;
+        const int   a   = ext.x >= ext.y && ext.x >= ext.z ? 0 : ext.y >= ext.z ? 1 : 2;
+        const std::uint32_t mid = begin + (end - begin) / 2;
+        std::nth_element(t.order.begin() + begin, t.order.begin() + mid, t.order.begin() + end, [&](std::uint32_t l, std::uint32_t r) {
+            const float cl = axis(lo[l], a) + axis(hi[l], a), cr = axis(lo[r], a) + axis(hi[r], a);
+            return cl < cr || (cl == cr && l < r);
+        });
+        const auto left = static_cast<std::uint32_t>(t.nodes.size());
+        t.nodes.resize(t.nodes.size() + 2);
+        t.nodes[node].first = left;
+        t.nodes[node].count = 0;
+        build_node(t, left, begin, mid, lo, hi);
+        build_node(t, left + 1, mid, end, lo, hi);
+    }
+
+    template <class Out>
+    void query_overlaps(const body_bvh& t, vec3f lo, vec3f hi, Out& out) {
+        if (t.nodes.empty()) return;
+        std::uint32_t stack[64];
+        std::size_t   top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const body_bvh_node& n = t.nodes[stack[--top]];
+            if (!overlaps(lo, hi, n.lo, n.hi)) continue;
+            if (n.count > 0) {
+                for (std::uint32_t i = n.first; i < n.first + n.count; ++i) {
+                    if (overlaps(lo, hi, t.lo[i], t.hi[i])) out.push_back(t.order[i]);
+                }
+            } else {
+                stack[top++] = n.first + 1;
+                stack[top++] = n.first;
+            }
+        }
+    }
+} // namespace
+
+float rigid_shape_distance(std::uint32_t shape, vec3f half, vec3f p, vec3f& normal) {
+    if (shape == k_shape_sphere) {
+        const float len = length(p);
+        normal = len > 0.0f ? p * (1.0f / len) : vec3f{0.0f, 1.0f, 0.0f};
+        return len - half.x;
+    }
+    const vec3f q   = abs3(p) - half;
+    const vec3f out = max3(q, vec3f{});
+    const float gap = length(out);
+    const vec3f sign{p.x < 0.0f ? -1.0f : 1.0f, p.y < 0.0f ? -1.0f : 1.0f, p.z < 0.0f ? -1.0f : 1.0f};
+    if (gap > 0.0f) {
+        normal = vec3f{out.x * sign.x, out.y * sign.y, out.z * sign.z} * (1.0f / gap);
+        return gap;
+    }
+    const int a = q.x >= q.y && q.x >= q.z ? 0 : q.y >= q.z ? 1 : 2;
+    normal = vec3f{a == 0 ? sign.x : 0.0f, a == 1 ? sign.y : 0.0f, a == 2 ? sign.z : 0.0f};
+    return axis(q, a);
+}
+
+void body_bvh_build(body_bvh& t, const vec3f* lo, const vec3f* hi, std::size_t count) {
+    t.nodes.clear();
+    t.order.resize(count);
+    t.lo.clear();
+    t.hi.clear();
+    if (count == 0) return;
+    for (std::size_t i = 0; i < count; ++i) t.order[i] = static_cast<std::uint32_t>(i);
+    t.nodes.reserve(2 * (count / k_leaf_size + 1));
+    t.nodes.resize(1);
+    build_node(t, 0, 0, static_cast<std::uint32_t>(count), lo, hi);
+    t.lo.resize(count);
+    t.hi.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        t.lo[i] = lo[t.order[i]];
+        t.hi[i] = hi[t.order[i]];
+    }
+}
+
+void body_bvh_query(const body_bvh& t, vec3f lo, vec3f hi, std::vector<std::uint32_t>& out) { query_overlaps(t, lo, hi, out); }
+void body_bvh_query(const body_bvh& t, vec3f lo, vec3f hi, frame_vector<std::uint32_t>& out) { query_overlaps(t, lo, hi, out); }
+
+cloth_rigid_settings cloth_rigid_read_settings(const param_store* ps) {
+    cloth_rigid_settings s{};
+    s.thickness      = std::max(0.0f, param_or(ps, "cloth_rigid.thickness", 0.01f));
+    s.margin         = std::max(0.0f, param_or(ps, "cloth_rigid.margin", 0.05f));
+    s.stiffness      = std::clamp(param_or(ps, "cloth_rigid.stiffness", 0.5f), 0.0f, 1.0f);
+    return s;
+}
+
+void* cloth_rigid_collider_create(const std::uint32_t domains[2]) {
+    auto* c = new (std::nothrow) cloth_rigid_collider{};
+    if (!c) return nullptr;
+    c->cloth_domain = domains[0];
+    c->rigid_domain = domains[1];
+    return c;
+}
+
+void cloth_rigid_collider_destroy(void* state) { delete static_cast<cloth_rigid_collider*>(state); }
+
+bool cloth_rigid_update_bodies(cloth_rigid_collider& c, const field_bus& bus, const cloth_rigid_settings& s, float lookahead) {
+    const field_bus_entry* bodies = find_field(&bus, c.rigid_domain, "rigid.position");
+    if (!bodies) return false;
+    const std::size_t    n        = bodies->count;
+    const vec3f*         position = nullptr;
+    const quatf*         rotation = nullptr;
+    const vec3f*         linear   = nullptr;
+    const vec3f*         angular  = nullptr;
+    const vec3f*         half     = nullptr;
+    const std::uint32_t* shape    = nullptr;
+    if (!packed_field(bus, c.rigid_domain, "rigid.position", field_scalar::f32, 3, n, position) ||
+        !packed_field(bus, c.rigid_domain, "rigid.orientation", field_scalar::f32, 4, n, rotation) ||
+        !packed_field(bus, c.rigid_domain, "rigid.linear_velocity", field_scalar::f32, 3, n, linear) ||
+        !packed_field(bus, c.rigid_domain, "rigid.angular_velocity", field_scalar::f32, 3, n, angular) ||
+        !packed_field(bus, c.rigid_domain, "rigid.half_extent", field_scalar::f32, 3, n, half) ||
+        !packed_field(bus, c.rigid_domain, "rigid.shape", field_scalar::u32, 1, n, shape))
+        return false;
+
+    for (std::size_t b = 0; b < n; ++b) {
+        if (shape[b] > k_shape_box || !(half[b].x > 0.0f && half[b].y > 0.0f && half[b].z > 0.0f)) return false;
+    }
+    c.shape.assign(shape, shape + n);
+    c.half_extent.assign(half, half + n);
+
+    const float reach = s.thickness + s.margin;
+    c.center.resize(n);
+    c.rotation.resize(n);
+    c.lo.resize(n);
+    c.hi.resize(n);
+    for (std::size_t b = 0; b < n; ++b) {
+        c.center[b]   = position[b] + linear[b] * lookahead;
+        c.rotation[b] = integrate(rotation[b], angular[b], lookahead);
+        vec3f ext;
+        if (shape[b] == k_shape_sphere) {
+            ext = vec3f{half[b].x, half[b].x, half[b].x};
+        } else {
+            const quatf q = c.rotation[b];
+            ext = abs3(rotate(q, vec3f{half[b].x, 0.0f, 0.0f})) + abs3(rotate(q, vec3f{0.0f, half[b].y, 0.0f})) + abs3(rotate(q, vec3f{0.0f, 0.0f, half[b].z}));
+        }
+        ext += vec3f{reach, reach, reach};
+        c.lo[b] = c.center[b] - ext;
+        c.hi[b] = c.center[b] + ext;
+    }
+    body_bvh_build(c.bvh, c.lo.data(), c.hi.data(), n);
+    return true;
+}
+
+void cloth_rigid_query(cloth_rigid_collider& c, const vec3f* points, std::size_t count, float max_distance, const step_context& ctx) {
+    c.hits.resize(count);
+    const std::size_t blocks = (count + k_query_block - 1) / k_query_block;
+    parallel_for(ctx.exec, blocks, k_block_grain, [&](std::size_t begin, std::size_t end) {
+        // Candidate lists live in the worker's frame arena; `own` only backs calls made outside a step.
+        frame_arena                 own;
+        frame_vector<std::uint32_t> candidates{frame_allocator<std::uint32_t>(step_scratch_or(ctx, own))};
+        candidates.reserve(c.center.size());
+        vec3f                       local[k_query_block];
+        for (std::size_t blk = begin; blk < end; ++blk) {
+            const std::size_t first = blk * k_query_block;
+            const std::size_t len   = std::min(k_query_block, count - first);
+            const vec3f*      p     = points + first;
+            cloth_rigid_hit*  hit   = c.hits.data() + first;
+            vec3f lo = p[0], hi = p[0];
+            for (std::size_t k = 0; k < len; ++k) {
+                hit[k] = cloth_rigid_hit{};
+                lo     = min3(lo, p[k]);
+                hi     = max3(hi, p[k]);
+            }
+            candidates.clear();
+            body_bvh_query(c.bvh, lo, hi, candidates);
+            std::sort(candidates.begin(), candidates.end()); // ties go to the lower body index
+            for (std::uint32_t b : candidates) {
+                const vec3f half   = c.shape[b] == k_shape_sphere ? vec3f{c.half_extent[b].x, c.half_extent[b].x, c.half_extent[b].x} : c.half_extent[b];
+                const vec3f center = c.center[b];
+                const quatf q      = c.rotation[b];
+                const vec3f reach  = half + vec3f{max_distance, max_distance, max_distance};
+                for (std::size_t k = 0; k < len; ++k) local[k] = rotate_inverse(q, p[k] - center);
+                for (std::size_t k = 0; k < len; ++k) {
+                    // Outside the padded body box a point is farther than max_distance from the surface.
+                    const vec3f a = abs3(local[k]);
+                    if (a.x > reach.x || a.y > reach.y || a.z > reach.z) continue;
+                    vec3f       normal;
+                    const float d = rigid_shape_distance(c.shape[b], c.half_extent[b], local[k], normal);
+                    if (d >= max_distance || (hit[k].body != cloth_rigid_no_body && d >= hit[k].distance)) continue;
+                    hit[k] = cloth_rigid_hit{b, d, rotate(q, normal)};
+                }
+            }
+        }
+    });
+}
+
+} // namespace rphys
@@ -1,7 +1,89 @@
 #ifndef RPHYS_COUPLING_CLOTH_RIGID_CONTACT_CONTRACT_HPP
 #define RPHYS_COUPLING_CLOTH_RIGID_CONTACT_CONTRACT_HPP
 
-namespace rphys { struct cloth_rigid_contact_contract; }
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "core_base/coupling_core.hpp"
+#include "core_base/frame_arena.hpp"
+#include "core_base/vec_math.hpp"
 
-#endif // RPHYS_COUPLING_CLOTH_RIGID_CONTACT_CONTRACT_HPP
+namespace rphys {
+
+// Collision layer shared by the cloth <-> rigid couplings (cloth_rigid_projection,
+// cloth_rigid_penalty): exact distances to the rigid shapes, a bounding volume hierarchy over the
+// bodies and batched cloth vertex queries against both. Endpoint 0 is the cloth domain, endpoint 1
+// the rigid domain.
+
+// Signed distance (negative inside) from body-space point p to a rigid shape (a rigid.shape value:
+// 0 sphere of radius half_extent.x, 1 box) and the unit outward normal of the closest surface
+// point. Inside a box the normal is that of the nearest face.
+float rigid_shape_distance(std::uint32_t shape, vec3f half_extent, vec3f p, vec3f& normal);
+
+// Binary tree over body bounds; leaves hold up to four bodies.
+struct body_bvh_node {
+    vec3f         lo{}, hi{};
+    std::uint32_t first{0}; // leaf: first index into `order`; inner: left child (right = first + 1)
+    std::uint32_t count{0}; // bodies in a leaf, 0 for inner nodes
+};
+
+struct body_bvh {
+    std::vector<body_bvh_node> nodes;
+    std::vector<std::uint32_t> order;
+    std::vector<vec3f>         lo, hi; // body bounds, in `order`
+};
+
+void body_bvh_build(body_bvh&, const vec3f* lo, const vec3f* hi, std::size_t count);
+// Appends every body whose bounds overlap [lo, hi] to `out`.
+void body_bvh_query(const body_bvh&, vec3f lo, vec3f hi, std::vector<std::uint32_t>& out);
+void body_bvh_query(const body_bvh&, vec3f lo, vec3f hi, frame_vector<std::uint32_t>& out);
+
+constexpr std::uint32_t cloth_rigid_no_body = std::numeric_limits<std::uint32_t>::max();
+
+// Closest body of one cloth vertex within the query margin.
+struct cloth_rigid_hit {
+    std::uint32_t body{cloth_rigid_no_body};
+    float         distance{0.0f}; // signed, to the body surface
+    vec3f         normal{};       // world space, pointing out of the body
+};
 
+// Parameters (param_store keys): cloth_rigid.thickness (0.01, cloth half thickness kept from the
+// surface), cloth_rigid.margin (0.05, extra distance at which contacts are generated),
+// cloth_rigid.stiffness (0.5, penalty only: fraction of the penetration removed per step).
+struct cloth_rigid_settings {
+    float thickness{0.01f};
+    float margin{0.05f};
+    float stiffness{0.5f};
+};
+
+cloth_rigid_settings cloth_rigid_read_settings(const param_store*);
+
+// Per-coupling state; shapes, poses, bounds and the hierarchy are refreshed every exchange.
+struct cloth_rigid_collider {
+    std::uint32_t                cloth_domain{0};
+    std::uint32_t                rigid_domain{0};
+    std::vector<std::uint32_t>   shape;
+    std::vector<vec3f>           half_extent;
+    std::vector<vec3f>           center;   // pose at the end of the step
+    std::vector<quatf>           rotation;
+    std::vector<vec3f>           lo, hi;   // world bounds, inflated by the query margin
+    body_bvh                     bvh;
+    std::vector<cloth_rigid_hit> hits;     // one per cloth vertex
+};
+
+void* cloth_rigid_collider_create(const std::uint32_t domains[2]);
+void  cloth_rigid_collider_destroy(void* state);
+
+// Reads the rigid fields, extrapolates every body `lookahead` seconds along its velocities and
+// rebuilds the hierarchy. False when the rigid domain's fields are missing.
+bool cloth_rigid_update_bodies(cloth_rigid_collider&, const field_bus&, const cloth_rigid_settings&, float lookahead);
+
+// Fills `hits` for points[0..count): blocks of consecutive vertices are culled against the
+// hierarchy with their joint bounds, then every candidate body evaluates its exact distance for the
+// whole block. Keeps the body with the smallest distance below `max_distance`.
+void cloth_rigid_query(cloth_rigid_collider&, const vec3f* points, std::size_t count, float max_distance, const step_context&);
+
+} // namespace rphys
+
+#endif // RPHYS_COUPLING_CLOTH_RIGID_CONTACT_CONTRACT_HPP
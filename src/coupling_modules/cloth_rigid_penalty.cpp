@@ -1,3 +1,56 @@
 #include "cloth_rigid_penalty.hpp"
-// skeleton
+#include "cloth_rigid_contact_contract.hpp"
+#include "core_base/field_bus.hpp"
 
+namespace rphys {
+
+namespace {
+    bool penalty_exchange(void* state, const field_bus& bus, step_context& ctx) {
+        auto& c = *static_cast<cloth_rigid_collider*>(state);
+        const field_bus_entry* predicted  = find_field(&bus, c.cloth_domain, "cloth.predicted");
+        const field_bus_entry* cloth_w    = find_field(&bus, c.cloth_domain, "cloth.inv_mass");
+        const field_bus_entry* velocity   = find_field(&bus, c.rigid_domain, "rigid.linear_velocity");
+        const field_bus_entry* rigid_w    = find_field(&bus, c.rigid_domain, "rigid.inv_mass");
+        if (!predicted || !predicted->mutable_data || predicted->stride != sizeof(vec3f) || !cloth_w || cloth_w->stride != sizeof(float) ||
+            cloth_w->count != predicted->count || !velocity || !velocity->mutable_data || velocity->stride != sizeof(vec3f) || !rigid_w ||
+            rigid_w->stride != sizeof(float) || rigid_w->count != velocity->count)
+            return false;
+        if (ctx.dt <= 0.0) return true;
+        const cloth_rigid_settings s = cloth_rigid_read_settings(ctx.params);
+        if (!cloth_rigid_update_bodies(c, bus, s, static_cast<float>(ctx.dt))) return false;
+        if (c.center.empty() || s.stiffness <= 0.0f) return true;
+
+        auto*             x = static_cast<vec3f*>(predicted->mutable_data);
+        const auto*       w = static_cast<const float*>(cloth_w->data);
+        auto*             v = static_cast<vec3f*>(velocity->mutable_data);
+        const auto*       body_w = static_cast<const float*>(rigid_w->data);
+        const std::size_t n = predicted->count;
+        cloth_rigid_query(c, x, n, s.thickness, ctx);
+        // Serial in vertex order so body velocities accumulate the same way on every run.
+        const float inv_dt = static_cast<float>(1.0 / ctx.dt);
+        for (std::size_t i = 0; i < n; ++i) {
+            const cloth_rigid_hit& h = c.hits[i];
+            if (h.body == cloth_rigid_no_body || w[i] <= 0.0f) continue;
+            const vec3f push = h.normal * (s.stiffness * (s.thickness - h.distance));
+            x[i] += push;
+            v[h.body] -= push * (inv_dt * body_w[h.body] / w[i]);
+        }
+        return true;
+    }
+
+    const coupling_field k_reads[] = {
+        {0, "cloth.predicted"},       {0, "cloth.inv_mass"},     {1, "rigid.position"}, {1, "rigid.orientation"}, {1, "rigid.linear_velocity"},
+        {1, "rigid.angular_velocity"}, {1, "rigid.half_extent"}, {1, "rigid.shape"},    {1, "rigid.inv_mass"},
+    };
+    const coupling_field k_writes[] = {{0, "cloth.predicted"}, {1, "rigid.linear_velocity"}};
+} // namespace
+
+const coupling_contract& cloth_rigid_penalty_contract() {
+    static const coupling_contract contract{
+        "cloth_rigid_penalty", {"cloth", "rigid"}, k_reads, std::size(k_reads), k_writes, std::size(k_writes), phase_stage::exchange,
+        cloth_rigid_collider_create, cloth_rigid_collider_destroy, penalty_exchange, nullptr, nullptr,
+    };
+    return contract;
+}
+
+} // namespace rphys
@@ -1,7 +1,15 @@
 #ifndef RPHYS_COUPLING_CLOTH_RIGID_PENALTY_HPP
 #define RPHYS_COUPLING_CLOTH_RIGID_PENALTY_HPP
 
-namespace rphys { struct cloth_rigid_penalty; }
+#include "core_base/coupling_core.hpp"
 
-#endif // RPHYS_COUPLING_CLOTH_RIGID_PENALTY_HPP
+namespace rphys {
+
+// "cloth_rigid_penalty" (cloth, rigid): two-way soft contact. After the cloth solve every vertex
+// closer than cloth_rigid.thickness to a body is moved out by cloth_rigid.stiffness times its
+// penetration, and the matching impulse is applied to the body's linear velocity.
+const coupling_contract& cloth_rigid_penalty_contract();
 
+} // namespace rphys
+
+#endif // RPHYS_COUPLING_CLOTH_RIGID_PENALTY_HPP
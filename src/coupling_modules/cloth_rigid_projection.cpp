@@ -1,3 +1,57 @@
 #include "cloth_rigid_projection.hpp"
-// skeleton
+#include "cloth_rigid_contact_contract.hpp"
+#include "core_base/field_bus.hpp"
 
+namespace rphys {
+
+namespace {
+    constexpr std::size_t k_vertex_grain = 1024;
+
+    // Same layout as cloth_contact_plane in the cloth domain: unit normal, offset.
+    struct contact_plane {
+        vec3f normal{};
+        float offset{0.0f};
+    };
+
+    bool projection_exchange(void* state, const field_bus& bus, step_context& ctx) {
+        auto& c = *static_cast<cloth_rigid_collider*>(state);
+        const field_bus_entry* predicted = find_field(&bus, c.cloth_domain, "cloth.predicted");
+        const field_bus_entry* planes    = find_field(&bus, c.cloth_domain, "cloth.contact_plane");
+        if (!predicted || !planes || !planes->mutable_data || predicted->stride != sizeof(vec3f) || planes->stride != sizeof(contact_plane) ||
+            planes->count != predicted->count)
+            return false;
+        const cloth_rigid_settings s = cloth_rigid_read_settings(ctx.params);
+        if (!cloth_rigid_update_bodies(c, bus, s, static_cast<float>(ctx.dt))) return false;
+        if (c.center.empty()) return true; // predict already cleared the planes
+
+        const auto* x = static_cast<const vec3f*>(predicted->data);
+        auto*       out = static_cast<contact_plane*>(planes->mutable_data);
+        const std::size_t n = predicted->count;
+        cloth_rigid_query(c, x, n, s.thickness + s.margin, ctx);
+        // The plane touches the surface point below the vertex and is lifted by the thickness.
+        parallel_for(ctx.exec, n, k_vertex_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const cloth_rigid_hit& h = c.hits[i];
+                if (h.body == cloth_rigid_no_body) continue;
+                out[i] = contact_plane{h.normal, dot(h.normal, x[i]) - h.distance + s.thickness};
+            }
+        });
+        return true;
+    }
+
+    const coupling_field k_reads[] = {
+        {0, "cloth.predicted"},       {1, "rigid.position"},   {1, "rigid.orientation"}, {1, "rigid.linear_velocity"},
+        {1, "rigid.angular_velocity"}, {1, "rigid.half_extent"}, {1, "rigid.shape"},
+    };
+    const coupling_field k_writes[] = {{0, "cloth.contact_plane"}};
+} // namespace
+
+const coupling_contract& cloth_rigid_projection_contract() {
+    static const coupling_contract contract{
+        "cloth_rigid_projection", {"cloth", "rigid"}, k_reads, std::size(k_reads), k_writes, std::size(k_writes), phase_stage::prepare,
+        cloth_rigid_collider_create, cloth_rigid_collider_destroy, projection_exchange, nullptr, nullptr,
+    };
+    return contract;
+}
+
+} // namespace rphys
@@ -1,7 +1,17 @@
 #ifndef RPHYS_COUPLING_CLOTH_RIGID_PROJECTION_HPP
 #define RPHYS_COUPLING_CLOTH_RIGID_PROJECTION_HPP
 
-namespace rphys { struct cloth_rigid_projection; }
+#include "core_base/coupling_core.hpp"
 
-#endif // RPHYS_COUPLING_CLOTH_RIGID_PROJECTION_HPP
+namespace rphys {
+
+// "cloth_rigid_projection" (cloth, rigid): one-way hard contact. After cloth predict it queries
+// the predicted positions against the bodies' exact shape distances (rigid_shape_distance) at
+// their end-of-step poses and writes a cloth.contact_plane for every vertex within thickness +
+// margin of a body; the XPBD solve then enforces the planes in each of its iterations. Bodies
+// are not pushed back.
+const coupling_contract& cloth_rigid_projection_contract();
 
+} // namespace rphys
+
+#endif // RPHYS_COUPLING_CLOTH_RIGID_PROJECTION_HPP
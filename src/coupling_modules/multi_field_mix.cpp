@@ -1,3 +1,177 @@
 #include "multi_field_mix.hpp"
-// skeleton
+#include "core_base/shared_asset.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
 
+namespace rphys {
+
+namespace {
+    constexpr std::size_t k_row_grain   = 1024;
+    constexpr std::size_t k_point_grain = 1024;
+
+    // Lower node and fraction along one axis, clamped onto the grid.
+    void axis_cell(float u, std::uint32_t dim, std::uint32_t& i0, std::uint32_t& i1, float& t) {
+        const float hi = static_cast<float>(dim - 1);
+        u  = std::clamp(u, 0.0f, hi);
+        i0 = std::min(static_cast<std::uint32_t>(u), dim > 1 ? dim - 2 : 0u);
+        i1 = std::min(i0 + 1, dim - 1);
+        t  = u - static_cast<float>(i0);
+    }
+
+    // Writes the 8 trilinear entries of p into col / weight.
+    void trilinear_row(const transfer_grid& g, vec3f p, std::uint32_t* col, float* weight) {
+        const float   inv = 1.0f / g.cell;
+        std::uint32_t x0, x1, y0, y1, z0, z1;
+        float         tx, ty, tz;
+        axis_cell((p.x - g.origin.x) * inv, g.dim[0], x0, x1, tx);
+        axis_cell((p.y - g.origin.y) * inv, g.dim[1], y0, y1, ty);
+        axis_cell((p.z - g.origin.z) * inv, g.dim[2], z0, z1, tz);
+        const std::uint32_t sx = 1, sy = g.dim[0], sz = g.dim[0] * g.dim[1];
+        int k = 0;
+        for (int dz = 0; dz < 2; ++dz)
+            for (int dy = 0; dy < 2; ++dy)
+                for (int dx = 0; dx < 2; ++dx) {
+                    col[k]    = (dx ? x1 : x0) * sx + (dy ? y1 : y0) * sy + (dz ? z1 : z0) * sz;
+                    weight[k] = (dx ? tx : 1.0f - tx) * (dy ? ty : 1.0f - ty) * (dz ? tz : 1.0f - tz);
+                    ++k;
+                }
+    }
+
+    bool valid_grid(const transfer_grid& g) { return g.cell > 0.0f && g.dim[0] > 0 && g.dim[1] > 0 && g.dim[2] > 0; }
+
+    vec3f grid_node(const transfer_grid& g, std::size_t n) {
+        const std::size_t x = n % g.dim[0], y = (n / g.dim[0]) % g.dim[1], z = n / (std::size_t{g.dim[0]} * g.dim[1]);
+        return g.origin + vec3f{static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)} * g.cell;
+    }
+
+    template <class Position>
+    bool build_trilinear(transfer_operator& op, const transfer_grid& g, std::size_t count, const step_context& ctx, Position&& position) {
+        if (!valid_grid(g)) return false;
+        op.rows = static_cast<std::uint32_t>(count);
+        op.cols = static_cast<std::uint32_t>(transfer_grid_nodes(g));
+        op.row_start.resize(count + 1);
+        op.col.resize(8 * count);
+        op.weight.resize(8 * count);
+        parallel_for(ctx.exec, count, k_point_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r = begin; r < end; ++r) {
+                op.row_start[r] = static_cast<std::uint32_t>(8 * r);
+                trilinear_row(g, position(r), &op.col[8 * r], &op.weight[8 * r]);
+            }
+        });
+        op.row_start[count] = static_cast<std::uint32_t>(8 * count);
+        return true;
+    }
+
+    template <int C>
+    void apply_rows(const transfer_operator& op, const float* source, float* target, std::size_t begin, std::size_t end) {
+        for (std::size_t r = begin; r < end; ++r) {
+            float acc[C] = {};
+            for (std::uint32_t k = op.row_start[r]; k < op.row_start[r + 1]; ++k) {
+                const float  w = op.weight[k];
+                const float* s = source + std::size_t{op.col[k]} * C;
+                for (int c = 0; c < C; ++c) acc[c] += w * s[c];
+            }
+            for (int c = 0; c < C; ++c) target[r * C + c] = acc[c];
+        }
+    }
+} // namespace
+
+bool transfer_grid_equal(const transfer_grid& a, const transfer_grid& b) {
+    return a.origin.x == b.origin.x && a.origin.y == b.origin.y && a.origin.z == b.origin.z && a.cell == b.cell && a.dim[0] == b.dim[0] && a.dim[1] == b.dim[1] &&
+           a.dim[2] == b.dim[2];
+}
+
+bool transfer_build_grid_to_points(transfer_operator& op, const transfer_grid& g, const vec3f* points, std::size_t count, const step_context& ctx) {
+    return build_trilinear(op, g, count, ctx, [&](std::size_t r) { return points[r]; });
+}
+
+bool transfer_build_grid_to_grid(transfer_operator& op, const transfer_grid& source, const transfer_grid& target, const step_context& ctx) {
+    if (!valid_grid(target)) return false;
+    return build_trilinear(op, source, transfer_grid_nodes(target), ctx, [&](std::size_t r) { return grid_node(target, r); });
+}
+
+void transfer_build_normalized_transpose(transfer_operator& out, const transfer_operator& in) {
+    out.rows = in.cols;
+    out.cols = in.rows;
+    out.row_start.assign(std::size_t{out.rows} + 1, 0);
+    const std::size_t nnz = in.col.size();
+    for (std::size_t k = 0; k < nnz; ++k) ++out.row_start[std::size_t{in.col[k]} + 1];
+    for (std::size_t r = 0; r < out.rows; ++r) out.row_start[r + 1] += out.row_start[r];
+    out.col.resize(nnz);
+    out.weight.resize(nnz);
+    // Shifted by one, row_start[c + 1] is the fill cursor of row c and ends at the start of row
+    // c + 1, so no cursor array is needed. Walking the input in row order keeps every output row
+    // sorted by column.
+    std::copy_backward(out.row_start.begin(), out.row_start.end() - 1, out.row_start.end());
+    out.row_start[0] = 0;
+    for (std::uint32_t r = 0; r < in.rows; ++r) {
+        for (std::uint32_t k = in.row_start[r]; k < in.row_start[r + 1]; ++k) {
+            const std::uint32_t slot = out.row_start[std::size_t{in.col[k]} + 1]++;
+            out.col[slot]    = r;
+            out.weight[slot] = in.weight[k];
+        }
+    }
+    for (std::size_t r = 0; r < out.rows; ++r) {
+        float sum = 0.0f;
+        for (std::uint32_t k = out.row_start[r]; k < out.row_start[r + 1]; ++k) sum += out.weight[k];
+        const float inv = sum > 0.0f ? 1.0f / sum : 0.0f;
+        for (std::uint32_t k = out.row_start[r]; k < out.row_start[r + 1]; ++k) out.weight[k] *= inv;
+    }
+}
+
+void transfer_apply(const transfer_operator& op, const float* source, float* target, std::uint32_t components, const step_context& ctx) {
+    parallel_for(ctx.exec, op.rows, k_row_grain, [&](std::size_t begin, std::size_t end) {
+        switch (components) {
+            case 1: apply_rows<1>(op, source, target, begin, end); break;
+            case 2: apply_rows<2>(op, source, target, begin, end); break;
+            case 3: apply_rows<3>(op, source, target, begin, end); break;
+            case 4: apply_rows<4>(op, source, target, begin, end); break;
+            default: break;
+        }
+    });
+}
+
+std::shared_ptr<const transfer_operator> transfer_grid_operator(const transfer_grid& source, const transfer_grid& target, const step_context& ctx) {
+    if (!valid_grid(source) || !valid_grid(target)) return nullptr;
+    auto bits = [](float f) { return std::bit_cast<std::uint32_t>(f); };
+    char key[192];
+    std::snprintf(key, sizeof(key), "xfer:%08x:%08x:%08x:%08x:%u:%u:%u>%08x:%08x:%08x:%08x:%u:%u:%u", bits(source.origin.x), bits(source.origin.y),
+                  bits(source.origin.z), bits(source.cell), source.dim[0], source.dim[1], source.dim[2], bits(target.origin.x), bits(target.origin.y),
+                  bits(target.origin.z), bits(target.cell), target.dim[0], target.dim[1], target.dim[2]);
+    if (auto found = shared_asset_find(key)) return std::static_pointer_cast<const transfer_operator>(found);
+    auto op = std::make_shared<transfer_operator>();
+    if (target.cell > source.cell) {
+        transfer_operator prolong;
+        transfer_build_grid_to_grid(prolong, target, source, ctx);
+        transfer_build_normalized_transpose(*op, prolong);
+    } else {
+        transfer_build_grid_to_grid(*op, source, target, ctx);
+    }
+    return std::static_pointer_cast<const transfer_operator>(shared_asset_publish(key, std::shared_ptr<const transfer_operator>(std::move(op))));
+}
+
+bool transfer_point_cache_update(transfer_point_cache& c, const transfer_grid& g, const vec3f* points, std::size_t count, float tolerance,
+                                 const step_context& ctx) {
+    if (!valid_grid(g)) return false;
+    bool stale = c.builds == 0 || !transfer_grid_equal(c.grid, g) || c.points.size() != count;
+    if (!stale) {
+        const float limit = std::max(0.0f, tolerance) * g.cell;
+        const float moved = parallel_reduce(ctx, count, k_point_grain, 0.0f, [&](std::size_t begin, std::size_t end) {
+            float m = 0.0f;
+            for (std::size_t i = begin; i < end; ++i) m = std::max(m, length_sq(points[i] - c.points[i]));
+            return m;
+        }, [](float a, float b) { return std::max(a, b); });
+        stale = moved > limit * limit;
+    }
+    if (!stale) return false;
+    c.grid = g;
+    c.points.assign(points, points + count);
+    transfer_build_grid_to_points(c.to_points, g, points, count, ctx);
+    transfer_build_normalized_transpose(c.to_grid, c.to_points);
+    ++c.builds;
+    return true;
+}
+
+} // namespace rphys
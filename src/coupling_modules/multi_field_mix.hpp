@@ -1,7 +1,74 @@
 #ifndef RPHYS_COUPLING_MULTI_FIELD_MIX_HPP
 #define RPHYS_COUPLING_MULTI_FIELD_MIX_HPP
 
-namespace rphys { struct multi_field_mix; }
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "core_base/domain_core.hpp"
+#include "core_base/vec_math.hpp"
 
-#endif // RPHYS_COUPLING_MULTI_FIELD_MIX_HPP
+namespace rphys {
+
+// Transfer operators between discretizations (particles or mesh vertices <-> grid nodes, coarse
+// grid <-> fine grid). Interpolation weights are built once into a sparse matrix and reused while
+// the source and target layouts stay fixed; moving fields through them is a parallel SpMV.
+
+// Regular node grid: node (i, j, k) sits at origin + cell * (i, j, k), x fastest.
+struct transfer_grid {
+    vec3f         origin{};
+    float         cell{0.0f};
+    std::uint32_t dim[3]{};
+};
+
+inline std::size_t transfer_grid_nodes(const transfer_grid& g) { return std::size_t{g.dim[0]} * g.dim[1] * g.dim[2]; }
+bool               transfer_grid_equal(const transfer_grid&, const transfer_grid&);
+
+// CSR matrix: target[r] = sum of weight[k] * source[col[k]] for k in [row_start[r], row_start[r + 1]).
+struct transfer_operator {
+    std::uint32_t              rows{0};
+    std::uint32_t              cols{0};
+    std::vector<std::uint32_t> row_start; // rows + 1
+    std::vector<std::uint32_t> col;
+    std::vector<float>         weight;
+};
+
+// Trilinear interpolation of grid nodes at each point (8 entries per row, points clamped onto the
+// grid). False for an empty grid.
+bool transfer_build_grid_to_points(transfer_operator&, const transfer_grid&, const vec3f* points, std::size_t count, const step_context&);
+// Trilinear interpolation of `source` at every node of `target`.
+bool transfer_build_grid_to_grid(transfer_operator&, const transfer_grid& source, const transfer_grid& target, const step_context&);
+// Transpose of `in` with every row divided by its weight sum: scatters along the same weights and
+// averages, which turns grid -> points into a points -> grid splat and fine -> coarse
+// interpolation into a restriction. Rows that receive no weight are empty and map to zero.
+void transfer_build_normalized_transpose(transfer_operator& out, const transfer_operator& in);
 
+// target = op * source for `components` interleaved floats per element (1 to 4). Rows are split
+// across the executor; every row sums in column order, so results are the same for any thread
+// count.
+void transfer_apply(const transfer_operator&, const float* source, float* target, std::uint32_t components, const step_context&);
+
+// Grid -> grid operator, shared through the asset registry by every caller mapping between the
+// same two grids. A coarser target gets the restriction (normalized transpose of target ->
+// source interpolation), otherwise interpolation. Null when either grid is empty.
+std::shared_ptr<const transfer_operator> transfer_grid_operator(const transfer_grid& source, const transfer_grid& target, const step_context&);
+
+// Point set <-> grid operators for particles or mesh vertices. update() rebuilds both directions
+// only when the grid or point count changes or some point has moved more than `tolerance` grid
+// cells since the last build (0: any movement), so static or slowly moving sets reuse their
+// weights across steps.
+struct transfer_point_cache {
+    transfer_grid      grid{};
+    std::vector<vec3f> points;    // positions the operators were built for
+    transfer_operator  to_points; // grid -> points
+    transfer_operator  to_grid;   // points -> grid
+    std::uint64_t      builds{0};
+};
+
+// True when the operators were rebuilt.
+bool transfer_point_cache_update(transfer_point_cache&, const transfer_grid&, const vec3f* points, std::size_t count, float tolerance,
+                                 const step_context&);
+
+} // namespace rphys
+
+#endif // RPHYS_COUPLING_MULTI_FIELD_MIX_HPP
@@ -1,3 +1,104 @@
 #include "xpbd_cloth.hpp"
-// skeleton
+#include "core_base/param_store.hpp"
+#include "core_base/telemetry_core.hpp"
+#include "perf_layers/simd_vec.hpp"
+#include <algorithm>
+#include <cmath>
 
+namespace rphys {
+
+namespace {
+    constexpr std::size_t k_vertex_grain = 1024;
+    constexpr std::size_t k_edge_grain   = 512;
+
+    float param_or(const param_store* ps, std::string_view key, float fallback) {
+        double v = fallback;
+        return ps && ps_get_double(ps, key, v) ? static_cast<float>(v) : fallback;
+    }
+} // namespace
+
+xpbd_cloth_settings xpbd_cloth_read_settings(const param_store* ps) {
+    xpbd_cloth_settings s{};
+    s.iterations = std::max(1, static_cast<int>(param_or(ps, "cloth.iterations", 10.0f)));
+    s.compliance = std::max(0.0f, param_or(ps, "cloth.compliance", 0.0f));
+    s.damping    = std::clamp(param_or(ps, "cloth.damping", 0.0f), 0.0f, 1.0f);
+    s.gravity    = vec3f{param_or(ps, "gravity.x", 0.0f), param_or(ps, "gravity.y", -9.81f), param_or(ps, "gravity.z", 0.0f)};
+    return s;
+}
+
+void xpbd_cloth_predict(cloth_domain_context& c, const step_context& ctx) {
+    const xpbd_cloth_settings s = xpbd_cloth_read_settings(ctx.params);
+    const float dt   = static_cast<float>(ctx.dt);
+    const float keep = 1.0f - s.damping * dt;
+    parallel_for(ctx.exec, c.position.size(), k_vertex_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (c.inv_mass[i] > 0.0f) c.velocity[i] = (c.velocity[i] + s.gravity * dt) * keep;
+            else c.velocity[i] = vec3f{};
+        }
+    });
+
+    const simd_kernels& simd = simd_kernels_for(ctx.simd);
+    parallel_for(ctx.exec, c.position.size(), k_vertex_grain, [&](std::size_t begin, std::size_t end) {
+        simd.axpy(&c.predicted[begin].x, &c.position[begin].x, &c.velocity[begin].x, dt, 3 * (end - begin));
+    });
+    std::fill(c.lambda.begin(), c.lambda.end(), 0.0f);
+    std::fill(c.contact_plane.begin(), c.contact_plane.end(), cloth_contact_plane{});
+}
+
+void xpbd_cloth_solve(cloth_domain_context& c, const step_context& ctx) {
+    if (ctx.dt <= 0.0) return;
+    const xpbd_cloth_settings s = xpbd_cloth_read_settings(ctx.params);
+    const float alpha = s.compliance / static_cast<float>(ctx.dt * ctx.dt);
+    const std::size_t n = c.position.size();
+    vec3f*            x = c.predicted.data();
+    const float*      w = c.inv_mass.data();
+    // Cooked arrays are shared copy-on-write; resolve their buffers once, not per edge.
+    const std::uint32_t* edge_ends = c.edges.data();
+    const float*         rest_len  = c.rest_length.data();
+    const simd_kernels&  simd      = simd_kernels_for(ctx.simd);
+    // Vertices a collision coupling gave a contact plane since predict.
+    c.contact_vertices.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (w[i] > 0.0f && length_sq(c.contact_plane[i].normal) > 0.0f) c.contact_vertices.push_back(static_cast<std::uint32_t>(i));
+    }
+    for (int it = 0; it < s.iterations; ++it) {
+        for (std::size_t color = 0; color + 1 < c.color_offsets.size(); ++color) {
+            const std::size_t first = c.color_offsets[color];
+            const std::size_t count = c.color_offsets[color + 1] - first;
+            parallel_for(ctx.exec, count, k_edge_grain, [&](std::size_t begin, std::size_t end) {
+                simd.xpbd_distance(&x->x, w, edge_ends, rest_len, c.lambda.data(), first + begin, first + end, alpha);
+            });
+        }
+        // Contacts last, so no iteration ends with a vertex inside a collider.
+        parallel_for(ctx.exec, c.contact_vertices.size(), k_vertex_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin; k < end; ++k) {
+                const std::uint32_t        i     = c.contact_vertices[k];
+                const cloth_contact_plane& plane = c.contact_plane[i];
+                const float                gap   = dot(plane.normal, x[i]) - plane.offset;
+                if (gap < 0.0f) x[i] = x[i] - plane.normal * gap;
+            }
+        });
+    }
+    if (ctx.profiler) {
+        // Largest remaining stretch violation; only computed while profiling.
+        const std::size_t edges    = c.rest_length.size();
+        const float       residual = parallel_reduce(ctx, edges, k_edge_grain, 0.0f, [&](std::size_t begin, std::size_t end) {
+            float r = 0.0f;
+            for (std::size_t e = begin; e < end; ++e) r = std::max(r, std::abs(length(x[edge_ends[2 * e]] - x[edge_ends[2 * e + 1]]) - rest_len[e]));
+            return r;
+        }, [](float a, float b) { return std::max(a, b); });
+        profile_note(ctx.profiler, static_cast<std::uint32_t>(s.iterations), residual);
+    }
+}
+
+void xpbd_cloth_finalize(cloth_domain_context& c, const step_context& ctx) {
+    if (ctx.dt <= 0.0) return;
+    const float inv_dt = static_cast<float>(1.0 / ctx.dt);
+    const simd_kernels& simd = simd_kernels_for(ctx.simd);
+    parallel_for(ctx.exec, c.position.size(), k_vertex_grain, [&](std::size_t begin, std::size_t end) {
+        simd.sub_scale(&c.velocity[begin].x, &c.predicted[begin].x, &c.position[begin].x, inv_dt, 3 * (end - begin));
+        std::copy(c.predicted.begin() + begin, c.predicted.begin() + end, c.position.begin() + begin);
+    });
+}
+
+} // namespace rphys
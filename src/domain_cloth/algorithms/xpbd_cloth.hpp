@@ -1,7 +1,30 @@
 #ifndef RPHYS_DOMAIN_CLOTH_ALGORITHMS_XPBD_CLOTH_HPP
 #define RPHYS_DOMAIN_CLOTH_ALGORITHMS_XPBD_CLOTH_HPP
 
-namespace rphys { struct xpbd_cloth_algorithm; }
+#include "core_base/vec_math.hpp"
+#include "domain_cloth/pipeline_contract.hpp"
 
-#endif // RPHYS_DOMAIN_CLOTH_ALGORITHMS_XPBD_CLOTH_HPP
+namespace rphys {
+
+// Parameters (param_store keys): cloth.iterations (10), cloth.compliance (0, inverse stiffness),
+// cloth.damping (0, fraction of velocity removed per second), gravity.x/y/z (0, -9.81, 0).
+struct xpbd_cloth_settings {
+    int   iterations{10};
+    float compliance{0.0f};
+    float damping{0.0f};
+    vec3f gravity{0.0f, -9.81f, 0.0f};
+};
+
+xpbd_cloth_settings xpbd_cloth_read_settings(const param_store*);
 
+// predict: v += g dt, damping, x* = x + v dt, lambda = 0, contact planes cleared.
+void xpbd_cloth_predict(cloth_domain_context&, const step_context&);
+// Distance constraints, one colour at a time; edges within a colour run in parallel, followed by
+// the contact planes in every iteration; iterates in place on predicted.
+void xpbd_cloth_solve(cloth_domain_context&, const step_context&);
+// v = (x* - x) / dt, x = x*.
+void xpbd_cloth_finalize(cloth_domain_context&, const step_context&);
+
+} // namespace rphys
+
+#endif // RPHYS_DOMAIN_CLOTH_ALGORITHMS_XPBD_CLOTH_HPP
@@ -1,3 +1,219 @@
 #include "pipeline_contract.hpp"
-// skeleton
+#include "algorithms/xpbd_cloth.hpp"
+#include "core_base/command_queue.hpp"
+#include "core_base/field_bus.hpp"
+#include "core_base/scene_file.hpp"
+#include "core_base/world_snapshot.hpp"
+#include "shared/mesh_build.hpp"
+#include <new>
 
+namespace rphys {
+
+namespace {
+    void* cloth_create(std::uint32_t domain) {
+        auto* c = new (std::nothrow) cloth_domain_context{};
+        if (c) c->domain = domain;
+        return c;
+    }
+
+    void cloth_destroy(void* state) { delete static_cast<cloth_domain_context*>(state); }
+
+    // Cooked arrays in scene files, one section each (see cloth_cooked_mesh).
+    enum cloth_section : std::uint32_t {
+        k_section_position = scene_section_cloth_base,
+        k_section_mass,
+        k_section_inv_mass,
+        k_section_triangles,
+        k_section_edges,
+        k_section_color_offsets,
+        k_section_rest_length,
+    };
+    static_assert(sizeof(vec3f) == 3 * sizeof(float));
+    static_assert(sizeof(cloth_contact_plane) == 4 * sizeof(float));
+
+    cloth_mesh_build mesh_from_context(const cloth_domain_context& c) {
+        cloth_mesh_build mesh;
+        mesh.positions = c.position;
+        mesh.masses    = c.mass.values();
+        mesh.triangles = c.triangles.values();
+        mesh.pinned.resize(c.position.size());
+        for (std::size_t i = 0; i < c.position.size(); ++i) mesh.pinned[i] = c.inv_mass[i] == 0.0f ? 1 : 0;
+        return mesh;
+    }
+
+    bool append_inputs(cloth_mesh_build& mesh, const scene_primitive_list& prims, std::span<const scene_mesh> meshes) {
+        for (const auto& p : prims) {
+            if (p.type != scene_primitive_type::cloth_grid) continue;
+            if (!cloth_mesh_append_grid(mesh, p)) return false;
+        }
+        for (const auto& m : meshes) {
+            if (!cloth_mesh_append_mesh(mesh, m)) return false;
+        }
+        return true;
+    }
+
+    // Velocities of vertices that already existed are kept; new ones start at rest.
+    void install_mesh(cloth_domain_context& c, cloth_cooked_mesh&& m) {
+        c.position      = std::move(m.position);
+        c.mass          = std::move(m.mass);
+        c.inv_mass      = std::move(m.inv_mass);
+        c.triangles     = std::move(m.triangles);
+        c.edges         = std::move(m.edges);
+        c.color_offsets = std::move(m.color_offsets);
+        c.rest_length   = std::move(m.rest_length);
+        c.velocity.resize(c.position.size());
+        c.predicted = c.position;
+        c.lambda.assign(c.rest_length.size(), 0.0f);
+        c.contact_plane.assign(c.position.size(), cloth_contact_plane{});
+    }
+
+    bool cloth_build_static(void* state, const scene_primitive_list& prims) {
+        auto& c = *static_cast<cloth_domain_context*>(state);
+        cloth_mesh_build mesh = mesh_from_context(c);
+        if (!append_inputs(mesh, prims, {}) || mesh.positions.empty()) return false;
+        install_mesh(c, cloth_cook_mesh(std::move(mesh)));
+        return true;
+    }
+
+    bool cloth_cook_scene(const scene_primitive_list& prims, std::span<const scene_mesh> meshes, scene_file_writer& out) {
+        cloth_mesh_build mesh;
+        if (!append_inputs(mesh, prims, meshes)) return false;
+        if (mesh.positions.empty()) return true; // no cloth in this scene
+        cloth_cooked_mesh m = cloth_cook_mesh(std::move(mesh));
+        out.add_owned(k_section_position, std::move(m.position));
+        out.add_owned(k_section_mass, std::move(m.mass.mutate()));
+        out.add_owned(k_section_inv_mass, std::move(m.inv_mass));
+        out.add_owned(k_section_triangles, std::move(m.triangles.mutate()));
+        out.add_owned(k_section_edges, std::move(m.edges.mutate()));
+        out.add_owned(k_section_color_offsets, std::move(m.color_offsets.mutate()));
+        out.add_owned(k_section_rest_length, std::move(m.rest_length.mutate()));
+        return true;
+    }
+
+    // Into an empty domain the sections stream straight into the arrays the solver uses, and the
+    // immutable ones are shared with every world that already loaded this file; appending to
+    // existing cloth merges the meshes and re-cooks, like build_static.
+    bool cloth_load_scene(void* state, const scene_file& file) {
+        auto& c = *static_cast<cloth_domain_context*>(state);
+        cloth_cooked_mesh m;
+        const bool read = scene_file_read(file, k_section_position, m.position) && scene_file_read_shared(file, k_section_mass, m.mass) &&
+                          scene_file_read(file, k_section_inv_mass, m.inv_mass) && scene_file_read_shared(file, k_section_triangles, m.triangles) &&
+                          scene_file_read_shared(file, k_section_edges, m.edges) &&
+                          scene_file_read_shared(file, k_section_color_offsets, m.color_offsets) &&
+                          scene_file_read_shared(file, k_section_rest_length, m.rest_length);
+        if (!read || !cloth_cooked_mesh_valid(m)) return false;
+        if (c.position.empty()) {
+            install_mesh(c, std::move(m));
+            return true;
+        }
+        cloth_mesh_build mesh = mesh_from_context(c);
+        const auto base = static_cast<std::uint32_t>(mesh.positions.size());
+        mesh.positions.insert(mesh.positions.end(), m.position.begin(), m.position.end());
+        mesh.masses.insert(mesh.masses.end(), m.mass.begin(), m.mass.end());
+        for (float w : m.inv_mass) mesh.pinned.push_back(w == 0.0f ? 1 : 0);
+        for (std::uint32_t v : m.triangles) mesh.triangles.push_back(base + v);
+        install_mesh(c, cloth_cook_mesh(std::move(mesh)));
+        return true;
+    }
+
+    bool cloth_apply_command(void* state, const command_record& cmd) {
+        auto& c = *static_cast<cloth_domain_context*>(state);
+        if (cmd.index >= c.position.size()) return false;
+        const std::uint32_t i = cmd.index;
+        switch (cmd.kind) {
+            case command_kind::pin:
+                c.inv_mass[i] = 0.0f;
+                c.velocity[i] = vec3f{};
+                return true;
+            case command_kind::unpin:
+                c.inv_mass[i] = c.mass[i] > 0.0f ? 1.0f / c.mass[i] : 0.0f;
+                return true;
+            case command_kind::impulse:
+                c.velocity[i] += vec3f{static_cast<float>(cmd.value[0]), static_cast<float>(cmd.value[1]), static_cast<float>(cmd.value[2])} * c.inv_mass[i];
+                return true;
+            default: return false;
+        }
+    }
+
+    void cloth_export_fields(void* state, field_bus& bus) {
+        auto& c = *static_cast<cloth_domain_context*>(state);
+        const std::size_t n = c.position.size();
+        export_field(&bus, c.domain, "cloth.position", c.position.data(), n, field_scalar::f32, 3, true);
+        export_field(&bus, c.domain, "cloth.velocity", c.velocity.data(), n, field_scalar::f32, 3, true);
+        export_field(&bus, c.domain, "cloth.predicted", c.predicted.data(), n, field_scalar::f32, 3, true);
+        export_field(&bus, c.domain, "cloth.inv_mass", c.inv_mass.data(), n, field_scalar::f32, 1, true);
+        export_field(&bus, c.domain, "cloth.contact_plane", c.contact_plane.data(), n, field_scalar::f32, 4, true);
+        // Read-only exports of shared arrays; the bus never writes through non-writable fields.
+        export_field(&bus, c.domain, "cloth.triangles", const_cast<std::uint32_t*>(c.triangles.data()), c.triangles.size() / 3, field_scalar::u32, 3, false);
+        export_field(&bus, c.domain, "cloth.edges", const_cast<std::uint32_t*>(c.edges.data()), c.edges.size() / 2, field_scalar::u32, 2, false);
+    }
+
+    // Hot: what stepping and commands touch. Cold: the cooked mesh, which only build_static changes.
+    // Contact planes are not saved: every step clears and regenerates them before the solve.
+    void cloth_save_state(const void* state, snapshot_writer& out) {
+        const auto& c = *static_cast<const cloth_domain_context*>(state);
+        using enum snapshot_tier;
+        out.write_array(hot, c.position);
+        out.write_array(hot, c.velocity);
+        out.write_array(hot, c.predicted);
+        out.write_array(hot, c.inv_mass);
+        out.write_array(hot, c.lambda);
+        out.write_array(cold, c.mass.values());
+        out.write_array(cold, c.triangles.values());
+        out.write_array(cold, c.edges.values());
+        out.write_array(cold, c.color_offsets.values());
+        out.write_array(cold, c.rest_length.values());
+    }
+
+    bool cloth_load_state(void* state, snapshot_reader& in) {
+        auto& c = *static_cast<cloth_domain_context*>(state);
+        using enum snapshot_tier;
+        cloth_cooked_mesh  m;
+        std::vector<vec3f> velocity, predicted;
+        std::vector<float> lambda;
+        in.read_array(hot, m.position);
+        in.read_array(hot, velocity);
+        in.read_array(hot, predicted);
+        in.read_array(hot, m.inv_mass);
+        in.read_array(hot, lambda);
+        in.read_array(cold, m.mass.mutate());
+        in.read_array(cold, m.triangles.mutate());
+        in.read_array(cold, m.edges.mutate());
+        in.read_array(cold, m.color_offsets.mutate());
+        in.read_array(cold, m.rest_length.mutate());
+        const std::size_t n = m.position.size();
+        if (!in.ok() || !cloth_cooked_mesh_valid(m) || velocity.size() != n || predicted.size() != n || lambda.size() != m.rest_length.size()) return false;
+        install_mesh(c, std::move(m));
+        c.velocity  = std::move(velocity);
+        c.predicted = std::move(predicted);
+        c.lambda    = std::move(lambda);
+        return true;
+    }
+
+    void run_predict(void* state, step_context& ctx) { xpbd_cloth_predict(*static_cast<cloth_domain_context*>(state), ctx); }
+    void run_solve(void* state, step_context& ctx) { xpbd_cloth_solve(*static_cast<cloth_domain_context*>(state), ctx); }
+    void run_finalize(void* state, step_context& ctx) { xpbd_cloth_finalize(*static_cast<cloth_domain_context*>(state), ctx); }
+
+    const char* const k_predict_reads[]   = {"cloth.position", "cloth.inv_mass"};
+    const char* const k_predict_writes[]  = {"cloth.velocity", "cloth.predicted", "cloth.lambda", "cloth.contact_plane"};
+    const char* const k_solve_reads[]     = {"cloth.inv_mass", "cloth.edges", "cloth.contact_plane"};
+    const char* const k_solve_writes[]    = {"cloth.predicted", "cloth.lambda"};
+    const char* const k_finalize_reads[]  = {"cloth.predicted"};
+    const char* const k_finalize_writes[] = {"cloth.position", "cloth.velocity"};
+
+    const domain_phase k_phases[] = {
+        {"predict", phase_stage::prepare, k_predict_reads, std::size(k_predict_reads), k_predict_writes, std::size(k_predict_writes), run_predict},
+        {"solve", phase_stage::solve, k_solve_reads, std::size(k_solve_reads), k_solve_writes, std::size(k_solve_writes), run_solve},
+        {"finalize", phase_stage::finalize, k_finalize_reads, std::size(k_finalize_reads), k_finalize_writes, std::size(k_finalize_writes), run_finalize},
+    };
+} // namespace
+
+const domain_pipeline_contract& cloth_domain_contract() {
+    static const domain_pipeline_contract contract{
+        "cloth", cloth_create, cloth_destroy, cloth_build_static, cloth_apply_command, cloth_export_fields, k_phases, std::size(k_phases), cloth_cook_scene, cloth_load_scene,
+        cloth_save_state, cloth_load_state,
+    };
+    return contract;
+}
+
+} // namespace rphys
@@ -1,10 +1,45 @@
 #ifndef RPHYS_DOMAIN_CLOTH_PIPELINE_CONTRACT_HPP
 #define RPHYS_DOMAIN_CLOTH_PIPELINE_CONTRACT_HPP
 
+#include <cstdint>
+#include <vector>
+#include "core_base/domain_core.hpp"
+#include "core_base/shared_asset.hpp"
+#include "core_base/vec_math.hpp"
+
 namespace rphys {
-struct cloth_domain_context; // opaque
-struct cloth_pipeline_contract; // opaque contract descriptor
-}
 
-#endif // RPHYS_DOMAIN_CLOTH_PIPELINE_CONTRACT_HPP
+// One-sided contact for a vertex, kept as dot(normal, x) >= offset by every solver iteration;
+// a zero normal means no contact.
+struct cloth_contact_plane {
+    vec3f normal{};
+    float offset{0.0f};
+};
+
+// Cloth state shared by the pipeline and its algorithms. Exported fields:
+//   cloth.position, cloth.velocity, cloth.predicted (f32 x3, writable), cloth.inv_mass (f32, writable),
+//   cloth.triangles (u32 x3), cloth.edges (u32 x2), cloth.contact_plane (f32 x4: normal, offset;
+//   writable, cleared by predict and filled by collision couplings before the solve).
+// The cooked mesh arrays are copy-on-write and shared with every other world loaded from the same
+// scene file.
+struct cloth_domain_context {
+    std::uint32_t                    domain{0};
+    std::vector<vec3f>               position;
+    std::vector<vec3f>               velocity;
+    std::vector<vec3f>               predicted;
+    cow_vector<float>                mass;
+    std::vector<float>               inv_mass; // 0 for pinned vertices
+    cow_vector<std::uint32_t>        triangles;
+    cow_vector<std::uint32_t>        edges;         // grouped by colour
+    cow_vector<std::uint32_t>        color_offsets; // edge ranges of one colour touch disjoint vertices
+    cow_vector<float>                rest_length;
+    std::vector<float>               lambda;
+    std::vector<cloth_contact_plane> contact_plane;
+    std::vector<std::uint32_t>       contact_vertices; // solve scratch: vertices with an active plane
+};
 
+const domain_pipeline_contract& cloth_domain_contract();
+
+} // namespace rphys
+
+#endif // RPHYS_DOMAIN_CLOTH_PIPELINE_CONTRACT_HPP
@@ -1,3 +1,148 @@
 #include "mesh_build.hpp"
-// skeleton
+#include <algorithm>
+#include <bit>
+#include <utility>
 
+namespace rphys {
+
+bool cloth_mesh_append_grid(cloth_mesh_build& m, const scene_primitive& p) {
+    const std::uint32_t nx = p.resolution[0], ny = p.resolution[1];
+    if (nx < 2 || ny < 2 || p.mass <= 0.0f || p.extent[0] <= 0.0f || p.extent[1] <= 0.0f) return false;
+    const std::uint32_t base = static_cast<std::uint32_t>(m.positions.size());
+    const float dx = p.extent[0] / static_cast<float>(nx - 1);
+    const float dy = p.extent[1] / static_cast<float>(ny - 1);
+    const float vertex_mass = p.mass / static_cast<float>(nx * ny);
+    for (std::uint32_t j = 0; j < ny; ++j) {
+        for (std::uint32_t i = 0; i < nx; ++i) {
+            m.positions.push_back(vec3f{p.origin[0] + dx * static_cast<float>(i), p.origin[1] + dy * static_cast<float>(j), p.origin[2]});
+            m.masses.push_back(vertex_mass);
+            const bool top = j == ny - 1;
+            const bool pin = top && ((p.flags & scene_pin_top_row) || ((p.flags & scene_pin_top_corners) && (i == 0 || i == nx - 1)));
+            m.pinned.push_back(pin ? 1 : 0);
+        }
+    }
+    for (std::uint32_t j = 0; j + 1 < ny; ++j) {
+        for (std::uint32_t i = 0; i + 1 < nx; ++i) {
+            std::uint32_t a = base + j * nx + i, b = a + 1, c = a + nx, d = c + 1;
+            if ((i + j) % 2 == 0) m.triangles.insert(m.triangles.end(), {a, b, d, a, d, c});
+            else m.triangles.insert(m.triangles.end(), {a, b, c, b, d, c});
+        }
+    }
+    return true;
+}
+
+bool cloth_mesh_append_mesh(cloth_mesh_build& m, const scene_mesh& mesh) {
+    if (!mesh.positions || !mesh.indices || mesh.vertex_count == 0 || mesh.triangle_count == 0 || mesh.mass <= 0.0f) return false;
+    if (mesh.pinned_count && !mesh.pinned) return false;
+    const std::size_t tri_indices = std::size_t{mesh.triangle_count} * 3;
+    for (std::size_t i = 0; i < tri_indices; ++i) {
+        if (mesh.indices[i] >= mesh.vertex_count) return false;
+    }
+    for (std::uint32_t i = 0; i < mesh.pinned_count; ++i) {
+        if (mesh.pinned[i] >= mesh.vertex_count) return false;
+    }
+    const std::uint32_t base = static_cast<std::uint32_t>(m.positions.size());
+    const float vertex_mass  = mesh.mass / static_cast<float>(mesh.vertex_count);
+    for (std::uint32_t i = 0; i < mesh.vertex_count; ++i) m.positions.push_back(vec3f{mesh.positions[3 * i], mesh.positions[3 * i + 1], mesh.positions[3 * i + 2]});
+    m.masses.resize(m.positions.size(), vertex_mass);
+    m.pinned.resize(m.positions.size(), 0);
+    for (std::uint32_t i = 0; i < mesh.pinned_count; ++i) m.pinned[base + mesh.pinned[i]] = 1;
+    for (std::size_t i = 0; i < tri_indices; ++i) m.triangles.push_back(base + mesh.indices[i]);
+    return true;
+}
+
+std::vector<std::uint32_t> cloth_mesh_edges(const std::vector<std::uint32_t>& triangles) {
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+    pairs.reserve(triangles.size());
+    for (std::size_t t = 0; t + 2 < triangles.size(); t += 3) {
+        for (int k = 0; k < 3; ++k) {
+            std::uint32_t a = triangles[t + k], b = triangles[t + (k + 1) % 3];
+            pairs.emplace_back(std::min(a, b), std::max(a, b));
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    std::vector<std::uint32_t> edges;
+    edges.reserve(pairs.size() * 2);
+    for (const auto& [a, b] : pairs) edges.insert(edges.end(), {a, b});
+    return edges;
+}
+
+std::vector<std::uint32_t> cloth_color_edges(std::vector<std::uint32_t>& edges, std::size_t vertex_count) {
+    const std::size_t edge_count = edges.size() / 2;
+    // Colours 0..63 via per-vertex bitmasks; anything beyond lands in one overflow colour that is
+    // split again recursively (only reachable for vertices of degree > 63).
+    std::vector<std::uint64_t> used(vertex_count, 0);
+    std::vector<std::uint32_t> color(edge_count);
+    std::uint32_t color_count = 0;
+    for (std::size_t e = 0; e < edge_count; ++e) {
+        std::uint32_t a = edges[2 * e], b = edges[2 * e + 1];
+        std::uint64_t taken = used[a] | used[b];
+        std::uint32_t c     = taken == ~std::uint64_t{0} ? 64u : static_cast<std::uint32_t>(std::countr_one(taken));
+        if (c < 64) {
+            used[a] |= std::uint64_t{1} << c;
+            used[b] |= std::uint64_t{1} << c;
+        }
+        color[e]    = c;
+        color_count = std::max(color_count, c + 1);
+    }
+    std::vector<std::uint32_t> offsets(color_count + 1, 0);
+    for (std::uint32_t c : color) ++offsets[c + 1];
+    for (std::uint32_t c = 0; c < color_count; ++c) offsets[c + 1] += offsets[c];
+    std::vector<std::uint32_t> sorted(edges.size());
+    std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (std::size_t e = 0; e < edge_count; ++e) {
+        std::uint32_t slot   = cursor[color[e]]++;
+        sorted[2 * slot]     = edges[2 * e];
+        sorted[2 * slot + 1] = edges[2 * e + 1];
+    }
+    edges.swap(sorted);
+    if (color_count <= 64) return offsets;
+
+    // Overflow colour: recolour its edges in isolation and splice the result in.
+    const std::uint32_t first = offsets[64];
+    std::vector<std::uint32_t> rest(edges.begin() + 2 * first, edges.end());
+    std::vector<std::uint32_t> sub = cloth_color_edges(rest, vertex_count);
+    std::copy(rest.begin(), rest.end(), edges.begin() + 2 * first);
+    offsets.resize(64);
+    for (std::uint32_t o : sub) offsets.push_back(first + o);
+    return offsets;
+}
+
+cloth_cooked_mesh cloth_cook_mesh(cloth_mesh_build&& mesh) {
+    cloth_cooked_mesh out;
+    out.position = std::move(mesh.positions);
+    out.inv_mass.resize(out.position.size());
+    for (std::size_t i = 0; i < out.position.size(); ++i) out.inv_mass[i] = mesh.pinned[i] ? 0.0f : 1.0f / mesh.masses[i];
+    std::vector<std::uint32_t> edges         = cloth_mesh_edges(mesh.triangles);
+    std::vector<std::uint32_t> color_offsets = cloth_color_edges(edges, out.position.size());
+    std::vector<float>         rest_length(edges.size() / 2);
+    for (std::size_t e = 0; e < rest_length.size(); ++e) rest_length[e] = length(out.position[edges[2 * e]] - out.position[edges[2 * e + 1]]);
+    out.mass          = std::move(mesh.masses);
+    out.triangles     = std::move(mesh.triangles);
+    out.edges         = std::move(edges);
+    out.color_offsets = std::move(color_offsets);
+    out.rest_length   = std::move(rest_length);
+    return out;
+}
+
+bool cloth_cooked_mesh_valid(const cloth_cooked_mesh& m) {
+    const std::size_t n = m.position.size();
+    if (n == 0 || m.mass.size() != n || m.inv_mass.size() != n) return false;
+    if (m.triangles.size() % 3 != 0 || m.edges.size() % 2 != 0 || m.rest_length.size() != m.edges.size() / 2) return false;
+    auto in_range = [n](std::uint32_t v) { return v < n; };
+    if (!std::all_of(m.triangles.begin(), m.triangles.end(), in_range) || !std::all_of(m.edges.begin(), m.edges.end(), in_range)) return false;
+    const auto& offsets = m.color_offsets;
+    if (offsets.empty() || offsets.front() != 0 || offsets.back() != m.rest_length.size() || !std::is_sorted(offsets.begin(), offsets.end())) return false;
+    std::vector<std::uint32_t> stamp(n, ~0u);
+    for (std::uint32_t c = 0; c + 1 < offsets.size(); ++c) {
+        for (std::uint32_t e = offsets[c]; e < offsets[c + 1]; ++e) {
+            std::uint32_t a = m.edges[2 * e], b = m.edges[2 * e + 1];
+            if (a == b || stamp[a] == c || stamp[b] == c) return false;
+            stamp[a] = stamp[b] = c;
+        }
+    }
+    return true;
+}
+
+} // namespace rphys
@@ -1,7 +1,56 @@
 #ifndef RPHYS_DOMAIN_CLOTH_SHARED_MESH_BUILD_HPP
 #define RPHYS_DOMAIN_CLOTH_SHARED_MESH_BUILD_HPP
 
-namespace rphys { struct cloth_mesh_build; }
+#include <cstdint>
+#include <vector>
+#include "core_base/shared_asset.hpp"
+#include "core_base/vec_math.hpp"
+#include "rphys/api_scene.h"
 
-#endif // RPHYS_DOMAIN_CLOTH_SHARED_MESH_BUILD_HPP
+namespace rphys {
+
+// Triangle mesh accumulated from scene primitives (several grids may share one cloth domain).
+struct cloth_mesh_build {
+    std::vector<vec3f>         positions;
+    std::vector<float>         masses;
+    std::vector<std::uint8_t>  pinned;
+    std::vector<std::uint32_t> triangles; // 3 indices per triangle
+};
+
+// Appends a regular grid with alternating diagonals. Returns false for degenerate input.
+bool cloth_mesh_append_grid(cloth_mesh_build&, const scene_primitive&);
+
+// Appends a host triangle mesh. Returns false for empty input or out-of-range indices.
+bool cloth_mesh_append_mesh(cloth_mesh_build&, const scene_mesh&);
+
+// Unique undirected edges of the triangle list, 2 indices per edge, ordered by (min, max).
+std::vector<std::uint32_t> cloth_mesh_edges(const std::vector<std::uint32_t>& triangles);
+
+// Greedy edge colouring: reorders `edges` so that edges sharing a colour touch disjoint vertices,
+// and returns colour offsets into the edge list (size colours + 1). Edges of one colour can be
+// projected concurrently without atomics.
+std::vector<std::uint32_t> cloth_color_edges(std::vector<std::uint32_t>& edges, std::size_t vertex_count);
 
+// Everything build_static derives from a mesh: the arrays of cloth_domain_context that do not
+// change while stepping. Scene files store exactly these arrays. Position and inv_mass are the
+// initial values of per-world state; the rest is immutable and shared copy-on-write, so worlds
+// loaded from one scene file keep a single copy of topology and rest data.
+struct cloth_cooked_mesh {
+    std::vector<vec3f>        position;
+    cow_vector<float>         mass;
+    std::vector<float>        inv_mass;
+    cow_vector<std::uint32_t> triangles;
+    cow_vector<std::uint32_t> edges;
+    cow_vector<std::uint32_t> color_offsets;
+    cow_vector<float>         rest_length;
+};
+
+cloth_cooked_mesh cloth_cook_mesh(cloth_mesh_build&&);
+
+// Checks what a solver relies on without re-deriving it: array sizes agree, indices are in range
+// and no two edges of one colour share a vertex.
+bool cloth_cooked_mesh_valid(const cloth_cooked_mesh&);
+
+} // namespace rphys
+
+#endif // RPHYS_DOMAIN_CLOTH_SHARED_MESH_BUILD_HPP
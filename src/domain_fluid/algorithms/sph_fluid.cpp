@@ -1,3 +1,152 @@
 #include "sph_fluid.hpp"
-// skeleton
+#include "core_base/param_store.hpp"
+#include "core_base/telemetry_core.hpp"
+#include "domain_fluid/shared/kernel_weights.hpp"
+#include "perf_layers/simd_vec.hpp"
+#include <algorithm>
+#include <cmath>
 
+namespace rphys {
+
+namespace {
+    constexpr std::size_t k_particle_grain = 256;
+
+    float param_or(const param_store* ps, std::string_view key, float fallback) {
+        double v = fallback;
+        return ps && ps_get_double(ps, key, v) ? static_cast<float>(v) : fallback;
+    }
+
+    // Neighbour candidates reach the SIMD kernels in fixed-size batches, in visit order.
+    constexpr std::size_t k_candidate_batch = 256;
+
+    template <class Fn>
+    void visit_candidate_batches(const fluid_neighbor_search& g, vec3f p, Fn&& fn) {
+        std::uint32_t batch[k_candidate_batch];
+        std::size_t   n = 0;
+        neighbor_search_visit(g, p, [&](std::uint32_t j) {
+            batch[n++] = j;
+            if (n == k_candidate_batch) {
+                fn(batch, n);
+                n = 0;
+            }
+        });
+        if (n > 0) fn(batch, n);
+    }
+
+    simd_sph_args sph_args(const fluid_domain_context& f, const fluid_kernel_weights& k) {
+        simd_sph_args a{};
+        a.position   = reinterpret_cast<const float*>(f.position.data());
+        a.velocity   = reinterpret_cast<const float*>(f.velocity.data());
+        a.density    = f.density.data();
+        a.pressure   = f.pressure.data();
+        a.mass       = f.particle_mass;
+        a.h          = k.h;
+        a.h2         = k.h2;
+        a.poly6      = k.poly6;
+        a.spiky_grad = k.spiky_grad;
+        a.visc_lap   = k.visc_lap;
+        return a;
+    }
+
+    void clamp_axis(float& x, float& v, float lo, float hi, float restitution) {
+        if (x < lo) {
+            x = lo;
+            if (v < 0.0f) v = -v * restitution;
+        } else if (x > hi) {
+            x = hi;
+            if (v > 0.0f) v = -v * restitution;
+        }
+    }
+} // namespace
+
+sph_fluid_settings sph_fluid_read_settings(const param_store* ps) {
+    sph_fluid_settings s{};
+    s.rest_density = std::max(1e-3f, param_or(ps, "fluid.rest_density", 1000.0f));
+    s.stiffness    = std::max(0.0f, param_or(ps, "fluid.stiffness", 200.0f));
+    s.viscosity    = std::max(0.0f, param_or(ps, "fluid.viscosity", 0.05f));
+    s.restitution  = std::clamp(param_or(ps, "fluid.restitution", 0.2f), 0.0f, 1.0f);
+    s.gravity      = vec3f{param_or(ps, "gravity.x", 0.0f), param_or(ps, "gravity.y", -9.81f), param_or(ps, "gravity.z", 0.0f)};
+    return s;
+}
+
+void sph_fluid_neighbors(fluid_domain_context& f, const step_context& ctx) {
+    neighbor_search_build(f.grid, f.position, f.smoothing_radius, ctx);
+}
+
+void sph_fluid_density(fluid_domain_context& f, const step_context& ctx) {
+    const sph_fluid_settings s    = sph_fluid_read_settings(ctx.params);
+    const simd_sph_args      args = sph_args(f, make_kernel_weights(f.smoothing_radius));
+    const simd_kernels&      simd = simd_kernels_for(ctx.simd);
+    parallel_for(ctx.exec, f.position.size(), k_particle_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto self = static_cast<std::uint32_t>(i);
+            float      rho  = 0.0f;
+            visit_candidate_batches(f.grid, f.position[i], [&](const std::uint32_t* nbr, std::size_t n) { rho = simd.sph_density(args, self, nbr, n, rho); });
+            rho *= f.particle_mass;
+            f.density[i]  = rho;
+            f.pressure[i] = std::max(0.0f, s.stiffness * (rho - s.rest_density));
+        }
+    });
+    if (ctx.profiler) {
+        // Compression residual: largest relative density excess over rest density.
+        const float excess = parallel_reduce(ctx, f.density.size(), k_particle_grain, 0.0f, [&](std::size_t begin, std::size_t end) {
+            float r = 0.0f;
+            for (std::size_t i = begin; i < end; ++i) r = std::max(r, f.density[i] - s.rest_density);
+            return r;
+        }, [](float a, float b) { return std::max(a, b); });
+        profile_note(ctx.profiler, 0, excess / s.rest_density);
+    }
+}
+
+void sph_fluid_forces(fluid_domain_context& f, const step_context& ctx) {
+    const sph_fluid_settings s    = sph_fluid_read_settings(ctx.params);
+    const simd_sph_args      args = sph_args(f, make_kernel_weights(f.smoothing_radius));
+    const simd_kernels&      simd = simd_kernels_for(ctx.simd);
+    parallel_for(ctx.exec, f.position.size(), k_particle_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto self = static_cast<std::uint32_t>(i);
+            float      acc[6]{}; // pressure xyz, viscosity xyz
+            visit_candidate_batches(f.grid, f.position[i], [&](const std::uint32_t* nbr, std::size_t n) { simd.sph_forces(args, self, nbr, n, acc); });
+            const vec3f a_pressure{acc[0], acc[1], acc[2]}, a_visc{acc[3], acc[4], acc[5]};
+            f.acceleration[i] = a_pressure + a_visc * s.viscosity + s.gravity;
+        }
+    });
+}
+
+void sph_fluid_integrate(fluid_domain_context& f, const step_context& ctx) {
+    const sph_fluid_settings s = sph_fluid_read_settings(ctx.params);
+    const float dt = static_cast<float>(ctx.dt);
+    const simd_kernels& simd = simd_kernels_for(ctx.simd);
+    parallel_for(ctx.exec, f.position.size(), k_particle_grain, [&](std::size_t begin, std::size_t end) {
+        const std::size_t n = 3 * (end - begin);
+        simd.axpy(&f.velocity[begin].x, &f.velocity[begin].x, &f.acceleration[begin].x, dt, n);
+        for (std::size_t i = begin; i < end; ++i) {
+            if (f.pinned[i]) f.velocity[i] = vec3f{};
+        }
+        simd.axpy(&f.position[begin].x, &f.position[begin].x, &f.velocity[begin].x, dt, n); // pinned particles have v = 0
+        if (!f.has_bounds) return;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (f.pinned[i]) continue;
+            vec3f& x = f.position[i];
+            vec3f& v = f.velocity[i];
+            clamp_axis(x.x, v.x, f.bounds_min.x, f.bounds_max.x, s.restitution);
+            clamp_axis(x.y, v.y, f.bounds_min.y, f.bounds_max.y, s.restitution);
+            clamp_axis(x.z, v.z, f.bounds_min.z, f.bounds_max.z, s.restitution);
+        }
+    });
+}
+
+double sph_fluid_stable_dt(const fluid_domain_context& f, const param_store* ps) {
+    if (f.position.empty() || !(f.smoothing_radius > 0.0f)) return 0.0;
+    const sph_fluid_settings s = sph_fluid_read_settings(ps);
+    float v_max = 0.0f, a_max = 0.0f;
+    for (std::size_t i = 0; i < f.position.size(); ++i) {
+        v_max = std::max(v_max, length_sq(f.velocity[i]));
+        a_max = std::max(a_max, length_sq(f.acceleration[i]));
+    }
+    const double h   = f.smoothing_radius;
+    const double cfl = 0.4 * h / (std::sqrt(static_cast<double>(s.stiffness)) + std::sqrt(static_cast<double>(v_max)) + 1e-6);
+    return a_max > 0.0f ? std::min(cfl, 0.25 * std::sqrt(h / std::sqrt(static_cast<double>(a_max)))) : cfl;
+}
+
+} // namespace rphys
@@ -1,7 +1,33 @@
 #ifndef RPHYS_DOMAIN_FLUID_ALGORITHMS_SPH_FLUID_HPP
 #define RPHYS_DOMAIN_FLUID_ALGORITHMS_SPH_FLUID_HPP
 
-namespace rphys { struct sph_fluid_algorithm; }
+#include "core_base/vec_math.hpp"
+#include "domain_fluid/pipeline_contract.hpp"
 
-#endif // RPHYS_DOMAIN_FLUID_ALGORITHMS_SPH_FLUID_HPP
+namespace rphys {
+
+// Weakly compressible SPH. Parameters: fluid.rest_density (1000), fluid.stiffness (200),
+// fluid.viscosity (0.05), fluid.restitution (0.2, boundary bounce), gravity.x/y/z.
+struct sph_fluid_settings {
+    float rest_density{1000.0f};
+    float stiffness{200.0f};
+    float viscosity{0.05f};
+    float restitution{0.2f};
+    vec3f gravity{0.0f, -9.81f, 0.0f};
+};
+
+sph_fluid_settings sph_fluid_read_settings(const param_store*);
+
+void sph_fluid_neighbors(fluid_domain_context&, const step_context&);
+void sph_fluid_density(fluid_domain_context&, const step_context&);
+void sph_fluid_forces(fluid_domain_context&, const step_context&);
+void sph_fluid_integrate(fluid_domain_context&, const step_context&);
 
+// Largest dt the explicit integrator takes safely from the current state: the CFL bound
+// 0.4 h / (c + |v|max) with sound speed c = sqrt(stiffness), and 0.25 sqrt(h / |a|max).
+// 0 without particles.
+double sph_fluid_stable_dt(const fluid_domain_context&, const param_store*);
+
+} // namespace rphys
+
+#endif // RPHYS_DOMAIN_FLUID_ALGORITHMS_SPH_FLUID_HPP
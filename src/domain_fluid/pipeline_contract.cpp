@@ -1,3 +1,167 @@
 #include "pipeline_contract.hpp"
-// skeleton
+#include "algorithms/sph_fluid.hpp"
+#include "core_base/command_queue.hpp"
+#include "core_base/field_bus.hpp"
+#include "core_base/world_snapshot.hpp"
+#include <algorithm>
+#include <new>
 
+namespace rphys {
+
+namespace {
+    void* fluid_create(std::uint32_t domain) {
+        auto* f = new (std::nothrow) fluid_domain_context{};
+        if (f) f->domain = domain;
+        return f;
+    }
+
+    void fluid_destroy(void* state) { delete static_cast<fluid_domain_context*>(state); }
+
+    // Particles sit on a lattice with spacing s and mass 1000 * s^3 (default rest density); the
+    // smoothing radius is 2 s. The first box of a domain fixes the spacing for later ones.
+    bool fluid_build_static(void* state, const scene_primitive_list& prims) {
+        auto& f = *static_cast<fluid_domain_context*>(state);
+        const float rest_density = sph_fluid_read_settings(nullptr).rest_density;
+        for (const auto& p : prims) {
+            if (p.type == scene_primitive_type::fluid_bounds) {
+                if (p.extent[0] <= 0.0f || p.extent[1] <= 0.0f || p.extent[2] <= 0.0f) return false;
+                f.has_bounds = true;
+                f.bounds_min = vec3f{p.origin[0], p.origin[1], p.origin[2]};
+                f.bounds_max = f.bounds_min + vec3f{p.extent[0], p.extent[1], p.extent[2]};
+                continue;
+            }
+            if (p.type != scene_primitive_type::particle_box) continue;
+            const std::uint32_t nx = p.resolution[0], ny = p.resolution[1], nz = p.resolution[2];
+            if (nx == 0 || ny == 0 || nz == 0) return false;
+            const float spacing = std::max({p.extent[0] / static_cast<float>(nx), p.extent[1] / static_cast<float>(ny), p.extent[2] / static_cast<float>(nz)});
+            if (spacing <= 0.0f) return false;
+            if (f.smoothing_radius == 0.0f) {
+                f.smoothing_radius = 2.0f * spacing;
+                f.particle_mass    = rest_density * spacing * spacing * spacing;
+            }
+            for (std::uint32_t k = 0; k < nz; ++k)
+                for (std::uint32_t j = 0; j < ny; ++j)
+                    for (std::uint32_t i = 0; i < nx; ++i) {
+                        const float half = 0.5f * spacing;
+                        f.position.push_back(vec3f{p.origin[0] + half + spacing * static_cast<float>(i), p.origin[1] + half + spacing * static_cast<float>(j),
+                                                   p.origin[2] + half + spacing * static_cast<float>(k)});
+                    }
+        }
+        if (f.position.empty()) return false;
+        const std::size_t n = f.position.size();
+        f.velocity.resize(n);
+        f.acceleration.resize(n);
+        f.density.resize(n);
+        f.pressure.resize(n);
+        f.pinned.resize(n);
+        neighbor_search_prepare(f.grid, n, f.smoothing_radius);
+        return true;
+    }
+
+    bool fluid_apply_command(void* state, const command_record& cmd) {
+        auto& f = *static_cast<fluid_domain_context*>(state);
+        if (cmd.index >= f.position.size()) return false;
+        switch (cmd.kind) {
+            case command_kind::pin: f.pinned[cmd.index] = 1; return true;
+            case command_kind::unpin: f.pinned[cmd.index] = 0; return true;
+            case command_kind::impulse:
+                if (f.pinned[cmd.index] || f.particle_mass <= 0.0f) return false;
+                f.velocity[cmd.index] += vec3f{static_cast<float>(cmd.value[0]), static_cast<float>(cmd.value[1]), static_cast<float>(cmd.value[2])} * (1.0f / f.particle_mass);
+                return true;
+            default: return false;
+        }
+    }
+
+    void fluid_export_fields(void* state, field_bus& bus) {
+        auto& f = *static_cast<fluid_domain_context*>(state);
+        const std::size_t n = f.position.size();
+        export_field(&bus, f.domain, "fluid.position", f.position.data(), n, field_scalar::f32, 3, true);
+        export_field(&bus, f.domain, "fluid.velocity", f.velocity.data(), n, field_scalar::f32, 3, true);
+        export_field(&bus, f.domain, "fluid.acceleration", f.acceleration.data(), n, field_scalar::f32, 3, false);
+        export_field(&bus, f.domain, "fluid.density", f.density.data(), n, field_scalar::f32, 1, false);
+        export_field(&bus, f.domain, "fluid.pressure", f.pressure.data(), n, field_scalar::f32, 1, false);
+        export_field(&bus, f.domain, "fluid.particle_mass", &f.particle_mass, 1, field_scalar::f32, 1, false);
+        export_field(&bus, f.domain, "fluid.smoothing_radius", &f.smoothing_radius, 1, field_scalar::f32, 1, false);
+        export_field(&bus, f.domain, "fluid.grid_bucket", f.grid.particle_bucket.data(), f.grid.particle_bucket.size(), field_scalar::u32, 1, false);
+        export_field(&bus, f.domain, "fluid.grid_bucket_start", f.grid.bucket_start.data(), f.grid.bucket_start.size(), field_scalar::u32, 1, false);
+    }
+
+    // The neighbour grid is not saved: the neighbors phase rebuilds it before anything reads it.
+    void fluid_save_state(const void* state, snapshot_writer& out) {
+        const auto& f = *static_cast<const fluid_domain_context*>(state);
+        using enum snapshot_tier;
+        out.write_array(hot, f.position);
+        out.write_array(hot, f.velocity);
+        out.write_array(hot, f.acceleration);
+        out.write_array(hot, f.density);
+        out.write_array(hot, f.pressure);
+        out.write_array(hot, f.pinned);
+        out.write(cold, f.particle_mass);
+        out.write(cold, f.smoothing_radius);
+        out.write(cold, static_cast<std::uint8_t>(f.has_bounds));
+        out.write(cold, f.bounds_min);
+        out.write(cold, f.bounds_max);
+    }
+
+    bool fluid_load_state(void* state, snapshot_reader& in) {
+        auto& f = *static_cast<fluid_domain_context*>(state);
+        using enum snapshot_tier;
+        fluid_domain_context next{};
+        std::uint8_t has_bounds = 0;
+        in.read_array(hot, next.position);
+        in.read_array(hot, next.velocity);
+        in.read_array(hot, next.acceleration);
+        in.read_array(hot, next.density);
+        in.read_array(hot, next.pressure);
+        in.read_array(hot, next.pinned);
+        in.read(cold, next.particle_mass);
+        in.read(cold, next.smoothing_radius);
+        in.read(cold, has_bounds);
+        in.read(cold, next.bounds_min);
+        in.read(cold, next.bounds_max);
+        const std::size_t n = next.position.size();
+        if (!in.ok() || next.velocity.size() != n || next.acceleration.size() != n || next.density.size() != n || next.pressure.size() != n ||
+            next.pinned.size() != n || (n && !(next.smoothing_radius > 0.0f)))
+            return false;
+        next.domain     = f.domain;
+        next.has_bounds = has_bounds != 0;
+        neighbor_search_prepare(next.grid, n, next.smoothing_radius);
+        f               = std::move(next);
+        return true;
+    }
+
+    double fluid_stable_dt(const void* state, const param_store& params) {
+        return sph_fluid_stable_dt(*static_cast<const fluid_domain_context*>(state), &params);
+    }
+
+    void run_neighbors(void* state, step_context& ctx) { sph_fluid_neighbors(*static_cast<fluid_domain_context*>(state), ctx); }
+    void run_density(void* state, step_context& ctx) { sph_fluid_density(*static_cast<fluid_domain_context*>(state), ctx); }
+    void run_forces(void* state, step_context& ctx) { sph_fluid_forces(*static_cast<fluid_domain_context*>(state), ctx); }
+    void run_integrate(void* state, step_context& ctx) { sph_fluid_integrate(*static_cast<fluid_domain_context*>(state), ctx); }
+
+    const char* const k_neighbors_reads[]  = {"fluid.position"};
+    const char* const k_neighbors_writes[] = {"fluid.grid"};
+    const char* const k_density_reads[]    = {"fluid.position", "fluid.grid"};
+    const char* const k_density_writes[]   = {"fluid.density", "fluid.pressure"};
+    const char* const k_forces_reads[]     = {"fluid.position", "fluid.velocity", "fluid.grid", "fluid.density", "fluid.pressure"};
+    const char* const k_forces_writes[]    = {"fluid.acceleration"};
+    const char* const k_integrate_reads[]  = {"fluid.acceleration"};
+    const char* const k_integrate_writes[] = {"fluid.position", "fluid.velocity"};
+
+    const domain_phase k_phases[] = {
+        {"neighbors", phase_stage::prepare, k_neighbors_reads, std::size(k_neighbors_reads), k_neighbors_writes, std::size(k_neighbors_writes), run_neighbors},
+        {"density", phase_stage::solve, k_density_reads, std::size(k_density_reads), k_density_writes, std::size(k_density_writes), run_density},
+        {"forces", phase_stage::solve, k_forces_reads, std::size(k_forces_reads), k_forces_writes, std::size(k_forces_writes), run_forces},
+        {"integrate", phase_stage::finalize, k_integrate_reads, std::size(k_integrate_reads), k_integrate_writes, std::size(k_integrate_writes), run_integrate},
+    };
+} // namespace
+
+const domain_pipeline_contract& fluid_domain_contract() {
+    static const domain_pipeline_contract contract{
+        "fluid", fluid_create, fluid_destroy, fluid_build_static, fluid_apply_command, fluid_export_fields, k_phases, std::size(k_phases), nullptr, nullptr,
+        fluid_save_state, fluid_load_state, fluid_stable_dt,
+    };
+    return contract;
+}
+
+} // namespace rphys
@@ -1,7 +1,38 @@
 #ifndef RPHYS_DOMAIN_FLUID_PIPELINE_CONTRACT_HPP
 #define RPHYS_DOMAIN_FLUID_PIPELINE_CONTRACT_HPP
 
-namespace rphys { struct fluid_domain_contract; }
+#include <cstdint>
+#include <vector>
+#include "core_base/domain_core.hpp"
+#include "core_base/vec_math.hpp"
+#include "shared/neighbor_search.hpp"
 
-#endif // RPHYS_DOMAIN_FLUID_PIPELINE_CONTRACT_HPP
+namespace rphys {
+
+// Particle fluid state. Exported fields: fluid.position, fluid.velocity (f32 x3, writable),
+// fluid.acceleration (f32 x3, written by the forces phase and applied in integrate),
+// fluid.density, fluid.pressure (f32), fluid.particle_mass, fluid.smoothing_radius (f32, one
+// element), and the neighbour grid for couplings that bin their own primitives into it:
+// fluid.grid_bucket (u32 per particle) and fluid.grid_bucket_start (u32, buckets + 1), both
+// rebuilt by the neighbors phase (resource "fluid.grid") with cell size smoothing_radius.
+struct fluid_domain_context {
+    std::uint32_t         domain{0};
+    std::vector<vec3f>    position;
+    std::vector<vec3f>    velocity;
+    std::vector<vec3f>    acceleration;
+    std::vector<float>    density;
+    std::vector<float>    pressure;
+    std::vector<std::uint8_t> pinned;
+    float                 particle_mass{0.0f};
+    float                 smoothing_radius{0.0f};
+    bool                  has_bounds{false};
+    vec3f                 bounds_min{};
+    vec3f                 bounds_max{};
+    fluid_neighbor_search grid;
+};
+
+const domain_pipeline_contract& fluid_domain_contract();
 
+} // namespace rphys
+
+#endif // RPHYS_DOMAIN_FLUID_PIPELINE_CONTRACT_HPP
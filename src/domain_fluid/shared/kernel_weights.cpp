@@ -1,3 +1,19 @@
 #include "kernel_weights.hpp"
-// skeleton
+#include <numbers>
 
+namespace rphys {
+
+fluid_kernel_weights make_kernel_weights(float h) {
+    fluid_kernel_weights k{};
+    const float pi = std::numbers::pi_v<float>;
+    const float h3 = h * h * h;
+    const float h6 = h3 * h3;
+    k.h          = h;
+    k.h2         = h * h;
+    k.poly6      = 315.0f / (64.0f * pi * h6 * h3);
+    k.spiky_grad = -45.0f / (pi * h6);
+    k.visc_lap   = 45.0f / (pi * h6);
+    return k;
+}
+
+} // namespace rphys
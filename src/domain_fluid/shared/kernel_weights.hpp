@@ -1,7 +1,40 @@
 #ifndef RPHYS_DOMAIN_FLUID_SHARED_KERNEL_WEIGHTS_HPP
 #define RPHYS_DOMAIN_FLUID_SHARED_KERNEL_WEIGHTS_HPP
 
-namespace rphys { struct fluid_kernel_weights; }
+#include "core_base/vec_math.hpp"
 
-#endif // RPHYS_DOMAIN_FLUID_SHARED_KERNEL_WEIGHTS_HPP
+namespace rphys {
+
+// Standard SPH kernels (Mueller et al. 2003) with support radius h; coefficients precomputed.
+// The density and force passes evaluate them per lane in perf_layers/simd_vec (sph_density,
+// sph_forces), which must stay in step with the functions below.
+struct fluid_kernel_weights {
+    float h{0.1f};
+    float h2{0.01f};
+    float poly6{0.0f};      // 315 / (64 pi h^9)
+    float spiky_grad{0.0f}; // -45 / (pi h^6)
+    float visc_lap{0.0f};   // 45 / (pi h^6)
+};
+
+fluid_kernel_weights make_kernel_weights(float h);
+
+inline float kernel_poly6(const fluid_kernel_weights& k, float r2) {
+    if (r2 >= k.h2) return 0.0f;
+    float d = k.h2 - r2;
+    return k.poly6 * d * d * d;
+}
 
+// Gradient of the spiky kernel w.r.t. x_i for offset r = x_i - x_j of length len (> 0).
+inline vec3f kernel_spiky_grad(const fluid_kernel_weights& k, vec3f r, float len) {
+    if (len >= k.h || len <= 0.0f) return vec3f{};
+    float d = k.h - len;
+    return r * (k.spiky_grad * d * d / len);
+}
+
+inline float kernel_visc_lap(const fluid_kernel_weights& k, float len) {
+    return len < k.h ? k.visc_lap * (k.h - len) : 0.0f;
+}
+
+} // namespace rphys
+
+#endif // RPHYS_DOMAIN_FLUID_SHARED_KERNEL_WEIGHTS_HPP
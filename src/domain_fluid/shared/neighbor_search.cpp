@@ -1,3 +1,54 @@
 #include "neighbor_search.hpp"
-// skeleton
+#include <atomic>
+#include <bit>
 
+namespace rphys {
+
+namespace {
+    constexpr std::size_t k_particle_grain = 2048;
+    constexpr std::size_t k_bucket_grain   = 4096;
+} // namespace
+
+void neighbor_search_prepare(fluid_neighbor_search& g, std::size_t n, float cell_size) {
+    const std::size_t buckets = std::bit_ceil(std::max<std::size_t>(2 * n, 64));
+    g.cell_size   = cell_size > 0.0f ? cell_size : 1.0f;
+    g.bucket_mask = static_cast<std::uint32_t>(buckets - 1);
+    g.bucket_start.resize(buckets + 1);
+    g.particle_bucket.resize(n);
+    g.entries.resize(n);
+}
+
+void neighbor_search_build(fluid_neighbor_search& g, std::span<const vec3f> positions, float cell_size, const step_context& ctx) {
+    const std::size_t n = positions.size();
+    neighbor_search_prepare(g, n, cell_size);
+    const std::size_t buckets = std::size_t{g.bucket_mask} + 1;
+    std::fill(g.bucket_start.begin(), g.bucket_start.end(), 0u);
+
+    parallel_for(ctx.exec, n, k_particle_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::uint32_t b = grid_bucket_of(g, grid_cell_of(g, positions[i]));
+            g.particle_bucket[i]  = b;
+            std::atomic_ref<std::uint32_t>(g.bucket_start[b + 1]).fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    for (std::size_t b = 0; b < buckets; ++b) g.bucket_start[b + 1] += g.bucket_start[b];
+
+    g.cursor.assign(g.bucket_start.begin(), g.bucket_start.end() - 1);
+    parallel_for(ctx.exec, n, k_particle_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::uint32_t slot = std::atomic_ref<std::uint32_t>(g.cursor[g.particle_bucket[i]]).fetch_add(1, std::memory_order_relaxed);
+            g.entries[slot] = static_cast<std::uint32_t>(i);
+        }
+    });
+
+    // Canonical bucket order (ascending particle index) so neighbour sums do not depend on threads.
+    if (ordered_merges(ctx) && ctx.exec.concurrency > 1) {
+        parallel_for(ctx.exec, buckets, k_bucket_grain, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t b = begin; b < end; ++b) {
+                if (g.bucket_start[b + 1] - g.bucket_start[b] > 1) std::sort(g.entries.begin() + g.bucket_start[b], g.entries.begin() + g.bucket_start[b + 1]);
+            }
+        });
+    }
+}
+
+} // namespace rphys
@@ -1,7 +1,66 @@
 #ifndef RPHYS_DOMAIN_FLUID_SHARED_NEIGHBOR_SEARCH_HPP
 #define RPHYS_DOMAIN_FLUID_SHARED_NEIGHBOR_SEARCH_HPP
 
-namespace rphys { struct fluid_neighbor_search; }
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "core_base/domain_core.hpp"
+#include "core_base/vec_math.hpp"
 
-#endif // RPHYS_DOMAIN_FLUID_SHARED_NEIGHBOR_SEARCH_HPP
+namespace rphys {
+
+// Cell-sorted spatial hash: particles are counting-sorted by the hash bucket of their cell, so
+// one bucket is a contiguous range of `entries`. Buckets may hold several cells; queries filter by
+// distance. The parallel scatter leaves the order inside a bucket thread-dependent unless the
+// step asks for ordered merges, in which case each bucket is sorted by particle index.
+struct fluid_neighbor_search {
+    float                      cell_size{0.1f};
+    std::uint32_t              bucket_mask{0};
+    std::vector<std::uint32_t> bucket_start; // bucket_mask + 2 entries
+    std::vector<std::uint32_t> entries;      // particle indices grouped by bucket
+    std::vector<std::uint32_t> particle_bucket;
+    std::vector<std::uint32_t> cursor; // scatter positions, kept to avoid reallocation
+};
+
+struct grid_cell {
+    std::int32_t x{0}, y{0}, z{0};
+};
+
+inline grid_cell grid_cell_of(const fluid_neighbor_search& g, vec3f p) {
+    const float inv = 1.0f / g.cell_size;
+    return {static_cast<std::int32_t>(std::floor(p.x * inv)), static_cast<std::int32_t>(std::floor(p.y * inv)), static_cast<std::int32_t>(std::floor(p.z * inv))};
+}
+
+inline std::uint32_t grid_bucket_of(const fluid_neighbor_search& g, grid_cell c) {
+    const std::uint32_t h = (static_cast<std::uint32_t>(c.x) * 73856093u) ^ (static_cast<std::uint32_t>(c.y) * 19349663u) ^ (static_cast<std::uint32_t>(c.z) * 83492791u);
+    return h & g.bucket_mask;
+}
 
+// Sizes the arrays for `count` particles without filling them. Builds for the same count never
+// reallocate, so exported views of bucket_start / particle_bucket stay valid across steps.
+void neighbor_search_prepare(fluid_neighbor_search&, std::size_t count, float cell_size);
+void neighbor_search_build(fluid_neighbor_search&, std::span<const vec3f> positions, float cell_size, const step_context& ctx);
+
+// Calls fn(j) for every particle j whose bucket neighbours p's cell (3x3x3 cells, each bucket
+// visited once). Callers test the actual distance.
+template <class Fn>
+void neighbor_search_visit(const fluid_neighbor_search& g, vec3f p, Fn&& fn) {
+    if (g.entries.empty()) return;
+    const grid_cell c = grid_cell_of(g, p);
+    std::uint32_t buckets[27];
+    int n = 0;
+    for (int dz = -1; dz <= 1; ++dz)
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dx = -1; dx <= 1; ++dx) buckets[n++] = grid_bucket_of(g, grid_cell{c.x + dx, c.y + dy, c.z + dz});
+    std::sort(buckets, buckets + n);
+    n = static_cast<int>(std::unique(buckets, buckets + n) - buckets);
+    for (int b = 0; b < n; ++b) {
+        for (std::uint32_t k = g.bucket_start[buckets[b]]; k < g.bucket_start[buckets[b] + 1]; ++k) fn(g.entries[k]);
+    }
+}
+
+} // namespace rphys
+
+#endif // RPHYS_DOMAIN_FLUID_SHARED_NEIGHBOR_SEARCH_HPP
@@ -1,3 +1,386 @@
 #include "impulse_rigid.hpp"
-// skeleton
+#include "core_base/param_store.hpp"
+#include "core_base/telemetry_core.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
 
+namespace rphys {
+
+namespace {
+    constexpr std::size_t k_body_grain   = 256;
+    constexpr float       k_baumgarte    = 0.2f;
+    constexpr float       k_slop         = 0.005f;
+    constexpr float       k_bounce_speed = 0.5f; // slower approaches do not bounce
+    constexpr std::size_t k_sweep_chunk  = 64;   // bodies per broadphase task
+
+    float param_or(const param_store* ps, std::string_view key, float fallback) {
+        double v = fallback;
+        return ps && ps_get_double(ps, key, v) ? static_cast<float>(v) : fallback;
+    }
+
+    vec3f mul(vec3f a, vec3f b) { return {a.x * b.x, a.y * b.y, a.z * b.z}; }
+
+    // World-space inverse inertia applied to v: R * diag(inv_i) * R^T * v.
+    vec3f apply_inv_inertia(const rigid_domain_context& r, std::uint32_t i, vec3f v) {
+        return rotate(r.orientation[i], mul(r.inv_inertia[i], rotate_inverse(r.orientation[i], v)));
+    }
+
+    float bounding_radius(const rigid_domain_context& r, std::uint32_t i) {
+        return r.shape[i] == static_cast<std::uint32_t>(rigid_shape::sphere) ? r.half_extent[i].x : length(r.half_extent[i]);
+    }
+
+    vec3f velocity_at(const rigid_domain_context& r, std::uint32_t i, vec3f arm) {
+        return r.linear_velocity[i] + cross(r.angular_velocity[i], arm);
+    }
+
+    using contact_list = std::vector<rigid_contact>;
+
+    void add_contact(const rigid_domain_context& r, contact_list& out, std::uint32_t a, std::uint32_t b, vec3f n, vec3f p, float depth, float restitution) {
+        rigid_contact c{};
+        c.a = a;
+        c.b = b;
+        c.normal = n;
+        c.point  = p;
+        c.depth  = depth;
+        vec3f rel = velocity_at(r, a, p - r.position[a]);
+        if (b != rigid_ground) rel -= velocity_at(r, b, p - r.position[b]);
+        const float vn = dot(rel, n);
+        c.target_speed = vn < -k_bounce_speed ? -restitution * vn : 0.0f;
+        out.push_back(c);
+    }
+
+    void collide_ground(const rigid_domain_context& r, contact_list& out, std::uint32_t i, const impulse_rigid_settings& s) {
+        const vec3f up{0.0f, 1.0f, 0.0f};
+        if (r.shape[i] == static_cast<std::uint32_t>(rigid_shape::sphere)) {
+            const float depth = s.ground_height - (r.position[i].y - r.half_extent[i].x);
+            if (depth > 0.0f) add_contact(r, out, i, rigid_ground, up, r.position[i] - up * r.half_extent[i].x, depth, s.restitution);
+            return;
+        }
+        const vec3f h = r.half_extent[i];
+        for (int k = 0; k < 8; ++k) {
+            const vec3f local{(k & 1) ? h.x : -h.x, (k & 2) ? h.y : -h.y, (k & 4) ? h.z : -h.z};
+            const vec3f p     = r.position[i] + rotate(r.orientation[i], local);
+            const float depth = s.ground_height - p.y;
+            if (depth > 0.0f) add_contact(r, out, i, rigid_ground, up, p, depth, s.restitution);
+        }
+    }
+
+    void collide_sphere_sphere(const rigid_domain_context& r, contact_list& out, std::uint32_t a, std::uint32_t b, float restitution) {
+        const vec3f d   = r.position[a] - r.position[b];
+        const float rs  = r.half_extent[a].x + r.half_extent[b].x;
+        const float len = length(d);
+        if (len >= rs) return;
+        const vec3f n = len > 1e-6f ? d * (1.0f / len) : vec3f{0.0f, 1.0f, 0.0f};
+        add_contact(r, out, a, b, n, r.position[b] + n * r.half_extent[b].x, rs - len, restitution);
+    }
+
+    // Sphere `s` against box `b`; the normal points from the box towards the sphere.
+    void collide_sphere_box(const rigid_domain_context& r, contact_list& out, std::uint32_t s, std::uint32_t b, bool sphere_first, float restitution) {
+        const vec3f h     = r.half_extent[b];
+        const vec3f local = rotate_inverse(r.orientation[b], r.position[s] - r.position[b]);
+        const vec3f q{std::clamp(local.x, -h.x, h.x), std::clamp(local.y, -h.y, h.y), std::clamp(local.z, -h.z, h.z)};
+        const vec3f d   = local - q;
+        const float len = length(d);
+        const float rad = r.half_extent[s].x;
+        if (len >= rad) return;
+        vec3f n_local{0.0f, 1.0f, 0.0f};
+        float depth = rad - len;
+        if (len > 1e-6f) {
+            n_local = d * (1.0f / len);
+        } else { // centre inside the box: push out along the axis of least penetration
+            const float gap[3] = {h.x - std::abs(local.x), h.y - std::abs(local.y), h.z - std::abs(local.z)};
+            const float sign[3] = {local.x < 0.0f ? -1.0f : 1.0f, local.y < 0.0f ? -1.0f : 1.0f, local.z < 0.0f ? -1.0f : 1.0f};
+            const int   axis   = gap[0] <= gap[1] && gap[0] <= gap[2] ? 0 : (gap[1] <= gap[2] ? 1 : 2);
+            float axis_dir[3]  = {0.0f, 0.0f, 0.0f};
+            axis_dir[axis]     = sign[axis];
+            n_local            = vec3f{axis_dir[0], axis_dir[1], axis_dir[2]};
+            depth              = gap[axis] + rad;
+        }
+        const vec3f n = rotate(r.orientation[b], n_local);
+        const vec3f p = r.position[b] + rotate(r.orientation[b], q);
+        if (sphere_first) add_contact(r, out, s, b, n, p, depth, restitution);
+        else add_contact(r, out, b, s, -n, p, depth, restitution);
+    }
+
+    struct box_frame {
+        vec3f centre;
+        vec3f axis[3];
+        float half[3];
+    };
+
+    box_frame frame_of(const rigid_domain_context& r, std::uint32_t i) {
+        const quatf q = r.orientation[i];
+        const vec3f h = r.half_extent[i];
+        return box_frame{r.position[i], {rotate(q, vec3f{1.0f, 0.0f, 0.0f}), rotate(q, vec3f{0.0f, 1.0f, 0.0f}), rotate(q, vec3f{0.0f, 0.0f, 1.0f})}, {h.x, h.y, h.z}};
+    }
+
+    // Half length of the box's projection onto unit direction n.
+    float projected_radius(const box_frame& f, vec3f n) {
+        return f.half[0] * std::abs(dot(f.axis[0], n)) + f.half[1] * std::abs(dot(f.axis[1], n)) + f.half[2] * std::abs(dot(f.axis[2], n));
+    }
+
+    // Middle of an edge of `f` parallel to axis `edge`, on the side facing direction `towards`.
+    vec3f support_edge(const box_frame& f, int edge, vec3f towards) {
+        vec3f p = f.centre;
+        for (int k = 0; k < 3; ++k) {
+            if (k != edge) p += f.axis[k] * (dot(f.axis[k], towards) >= 0.0f ? f.half[k] : -f.half[k]);
+        }
+        return p;
+    }
+
+    // Clips polygon `in` (count points) to dot(p - origin, axis) <= limit; returns the new count.
+    int clip_polygon(const vec3f* in, int count, vec3f* out, vec3f origin, vec3f axis, float limit) {
+        int kept = 0;
+        for (int k = 0; k < count; ++k) {
+            const vec3f p = in[k], q = in[(k + 1) % count];
+            const float dp = dot(p - origin, axis) - limit, dq = dot(q - origin, axis) - limit;
+            if (dp <= 0.0f) out[kept++] = p;
+            if ((dp < 0.0f) != (dq < 0.0f) && dp != dq) out[kept++] = p + (q - p) * (dp / (dp - dq));
+        }
+        return kept;
+    }
+
+    // Box against box by separating axes (3 + 3 face normals, 9 edge crossings). The axis of least
+    // overlap gives the normal (b towards a) and depth; face axes win near-ties so resting stacks
+    // keep a stable normal. A face axis clips the most anti-parallel face of the other (incident) box
+    // against the reference face's side planes and keeps the points below it; an edge axis gives one
+    // contact between the closest points of the two supporting edges.
+    void collide_box_box(const rigid_domain_context& r, contact_list& out, std::uint32_t a, std::uint32_t b, float restitution) {
+        enum class axis_owner { face_a, face_b, edges };
+        const box_frame fa = frame_of(r, a), fb = frame_of(r, b);
+        const vec3f     d  = fa.centre - fb.centre;
+        float      best = std::numeric_limits<float>::max();
+        vec3f      normal{0.0f, 1.0f, 0.0f};
+        axis_owner owner = axis_owner::face_a;
+        int        axis_a = 0, axis_b = 0;
+        auto test = [&](vec3f axis, axis_owner kind, int ia, int ib) {
+            const float len = length(axis);
+            if (len < 1e-5f) return true; // parallel edges: covered by the face axes
+            axis = axis * (1.0f / len);
+            const float overlap = projected_radius(fa, axis) + projected_radius(fb, axis) - std::abs(dot(d, axis));
+            if (overlap < 0.0f) return false;
+            const float score = kind == axis_owner::edges ? overlap * 1.05f : overlap;
+            if (score < best) {
+                best   = score;
+                normal = dot(d, axis) < 0.0f ? -axis : axis;
+                owner  = kind;
+                axis_a = ia;
+                axis_b = ib;
+            }
+            return true;
+        };
+        for (int k = 0; k < 3; ++k) {
+            if (!test(fa.axis[k], axis_owner::face_a, k, 0) || !test(fb.axis[k], axis_owner::face_b, 0, k)) return;
+        }
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                if (!test(cross(fa.axis[i], fb.axis[j]), axis_owner::edges, i, j)) return;
+            }
+        }
+        const float depth = projected_radius(fa, normal) + projected_radius(fb, normal) - dot(d, normal);
+        if (depth <= 0.0f) return;
+
+        if (owner == axis_owner::edges) {
+            // Closest points of the two lines, clamped to the edges; contact halfway between.
+            const vec3f pa = support_edge(fa, axis_a, -normal), pb = support_edge(fb, axis_b, normal);
+            const vec3f da = fa.axis[axis_a], db = fb.axis[axis_b], w = pa - pb;
+            const float c = dot(da, db), denom = 1.0f - c * c;
+            float       s = denom > 1e-6f ? (c * dot(db, w) - dot(da, w)) / denom : 0.0f;
+            s             = std::clamp(s, -fa.half[axis_a], fa.half[axis_a]);
+            const float t = std::clamp(dot(db, w) + s * c, -fb.half[axis_b], fb.half[axis_b]);
+            add_contact(r, out, a, b, normal, (pa + da * s + pb + db * t) * 0.5f, depth, restitution);
+            return;
+        }
+
+        // Reference face: the owner's face pointing at the other box.
+        const bool       ref_is_b = owner == axis_owner::face_b;
+        const box_frame& ref      = ref_is_b ? fb : fa;
+        const box_frame& inc      = ref_is_b ? fa : fb;
+        const int        ref_axis = ref_is_b ? axis_b : axis_a;
+        const vec3f      n_ref    = ref_is_b ? normal : -normal;
+        const vec3f      face     = ref.centre + n_ref * ref.half[ref_axis];
+
+        // Incident face: the face of the other box most anti-parallel to n_ref.
+        int   inc_axis = 0;
+        float inc_dot  = 0.0f;
+        for (int k = 0; k < 3; ++k) {
+            const float c = dot(inc.axis[k], n_ref);
+            if (std::abs(c) > std::abs(inc_dot)) {
+                inc_axis = k;
+                inc_dot  = c;
+            }
+        }
+        const vec3f inc_normal = inc.axis[inc_axis] * (inc_dot > 0.0f ? -1.0f : 1.0f);
+        const int   u = (inc_axis + 1) % 3, v = (inc_axis + 2) % 3;
+        const vec3f centre = inc.centre + inc_normal * inc.half[inc_axis];
+        const vec3f eu = inc.axis[u] * inc.half[u], ev = inc.axis[v] * inc.half[v];
+        vec3f poly[8] = {centre + eu + ev, centre - eu + ev, centre - eu - ev, centre + eu - ev};
+        vec3f tmp[8];
+        int   count = 4;
+        for (int k = 1; k < 3 && count > 0; ++k) {
+            const vec3f side = ref.axis[(ref_axis + k) % 3];
+            const float half = ref.half[(ref_axis + k) % 3];
+            count = clip_polygon(poly, count, tmp, ref.centre, side, half);
+            count = clip_polygon(tmp, count, poly, ref.centre, -side, half);
+        }
+        for (int k = 0; k < count; ++k) {
+            const float separation = dot(poly[k] - face, n_ref);
+            if (separation < 0.0f) add_contact(r, out, a, b, normal, poly[k], std::min(-separation, depth), restitution);
+        }
+    }
+
+    void apply_impulse(rigid_domain_context& r, std::uint32_t i, vec3f arm, vec3f impulse) {
+        r.linear_velocity[i] += impulse * r.inv_mass[i];
+        r.angular_velocity[i] += apply_inv_inertia(r, i, cross(arm, impulse));
+    }
+
+    float effective_mass_term(const rigid_domain_context& r, std::uint32_t i, vec3f arm, vec3f dir) {
+        return r.inv_mass[i] + dot(dir, cross(apply_inv_inertia(r, i, cross(arm, dir)), arm));
+    }
+} // namespace
+
+impulse_rigid_settings impulse_rigid_read_settings(const param_store* ps) {
+    impulse_rigid_settings s{};
+    s.iterations    = std::max(1, static_cast<int>(param_or(ps, "rigid.iterations", 8.0f)));
+    s.restitution   = std::clamp(param_or(ps, "rigid.restitution", 0.2f), 0.0f, 1.0f);
+    s.friction      = std::max(0.0f, param_or(ps, "rigid.friction", 0.5f));
+    s.ground        = param_or(ps, "rigid.ground", 1.0f) != 0.0f;
+    s.ground_height = param_or(ps, "rigid.ground_height", 0.0f);
+    s.gravity       = vec3f{param_or(ps, "gravity.x", 0.0f), param_or(ps, "gravity.y", -9.81f), param_or(ps, "gravity.z", 0.0f)};
+    return s;
+}
+
+void impulse_rigid_apply_forces(rigid_domain_context& r, const step_context& ctx) {
+    const impulse_rigid_settings s = impulse_rigid_read_settings(ctx.params);
+    const float dt = static_cast<float>(ctx.dt);
+    parallel_for(ctx.exec, r.position.size(), k_body_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (r.inv_mass[i] > 0.0f) r.linear_velocity[i] += s.gravity * dt;
+        }
+    });
+}
+
+void impulse_rigid_find_contacts(rigid_domain_context& r, const step_context& ctx) {
+    const impulse_rigid_settings s = impulse_rigid_read_settings(ctx.params);
+    const std::uint32_t n = static_cast<std::uint32_t>(r.position.size());
+    auto& order = r.sweep_order;
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+        const float la = r.position[a].x - bounding_radius(r, a), lb = r.position[b].x - bounding_radius(r, b);
+        return la < lb || (la == lb && a < b);
+    });
+
+    // Sweep chunks run in parallel into private lists, merged afterwards.
+    const std::size_t chunks = (n + k_sweep_chunk - 1) / k_sweep_chunk;
+    r.contact_chunks.resize(chunks);
+    r.chunk_completion.resize(chunks);
+    std::atomic<std::uint32_t> finished{0};
+    const auto sphere = static_cast<std::uint32_t>(rigid_shape::sphere);
+    parallel_for(ctx.exec, chunks, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t chunk = begin; chunk < end; ++chunk) {
+            contact_list& out = r.contact_chunks[chunk];
+            out.clear();
+            const std::size_t last = std::min<std::size_t>(n, (chunk + 1) * k_sweep_chunk);
+            for (std::size_t k = chunk * k_sweep_chunk; k < last; ++k) {
+                const std::uint32_t i = order[k];
+                if (s.ground) collide_ground(r, out, i, s);
+                const float max_x = r.position[i].x + bounding_radius(r, i);
+                for (std::size_t m = k + 1; m < n; ++m) {
+                    const std::uint32_t j = order[m];
+                    if (r.position[j].x - bounding_radius(r, j) > max_x) break;
+                    if (r.inv_mass[i] == 0.0f && r.inv_mass[j] == 0.0f) continue;
+                    const std::uint32_t a = std::min(i, j), b = std::max(i, j);
+                    if (r.shape[a] == sphere && r.shape[b] == sphere) collide_sphere_sphere(r, out, a, b, s.restitution);
+                    else if (r.shape[a] == sphere) collide_sphere_box(r, out, a, b, true, s.restitution);
+                    else if (r.shape[b] == sphere) collide_sphere_box(r, out, b, a, false, s.restitution);
+                    else collide_box_box(r, out, a, b, s.restitution);
+                }
+            }
+            r.chunk_completion[finished.fetch_add(1, std::memory_order_relaxed)] = static_cast<std::uint32_t>(chunk);
+        }
+    });
+
+    // The solver is Gauss-Seidel, so contact order changes the result: fast mode keeps completion
+    // order, ordered modes use chunk order, bit_stable additionally sorts pairs canonically.
+    r.contacts.clear();
+    for (std::size_t k = 0; k < chunks; ++k) {
+        const contact_list& part = r.contact_chunks[ordered_merges(ctx) ? k : r.chunk_completion[k]];
+        r.contacts.insert(r.contacts.end(), part.begin(), part.end());
+    }
+    if (ctx.determinism == determinism_level::bit_stable) {
+        // Stable by pair: merge position breaks ties. Sorted through step scratch, since
+        // std::stable_sort takes its buffer from the heap.
+        frame_arena                 own;
+        frame_arena&                scratch = step_scratch_or(ctx, own);
+        frame_vector<std::uint32_t> order_by_pair(r.contacts.size(), 0u, frame_allocator<std::uint32_t>(scratch));
+        frame_vector<rigid_contact> sorted{frame_allocator<rigid_contact>(scratch)};
+        std::iota(order_by_pair.begin(), order_by_pair.end(), 0u);
+        std::sort(order_by_pair.begin(), order_by_pair.end(), [&](std::uint32_t x, std::uint32_t y) {
+            const rigid_contact &cx = r.contacts[x], &cy = r.contacts[y];
+            return std::tie(cx.a, cx.b, x) < std::tie(cy.a, cy.b, y);
+        });
+        sorted.reserve(r.contacts.size());
+        for (std::uint32_t k : order_by_pair) sorted.push_back(r.contacts[k]);
+        std::copy(sorted.begin(), sorted.end(), r.contacts.begin());
+    }
+}
+
+void impulse_rigid_solve_contacts(rigid_domain_context& r, const step_context& ctx) {
+    if (ctx.dt <= 0.0 || r.contacts.empty()) return;
+    const impulse_rigid_settings s = impulse_rigid_read_settings(ctx.params);
+    const float inv_dt = static_cast<float>(1.0 / ctx.dt);
+    for (int it = 0; it < s.iterations; ++it) {
+        for (rigid_contact& c : r.contacts) {
+            const bool  has_b = c.b != rigid_ground;
+            const vec3f ra    = c.point - r.position[c.a];
+            const vec3f rb    = has_b ? c.point - r.position[c.b] : vec3f{};
+            vec3f rel = velocity_at(r, c.a, ra);
+            if (has_b) rel -= velocity_at(r, c.b, rb);
+
+            const float k_n = effective_mass_term(r, c.a, ra, c.normal) + (has_b ? effective_mass_term(r, c.b, rb, c.normal) : 0.0f);
+            if (k_n <= 0.0f) continue;
+            const float bias     = std::max(k_baumgarte * inv_dt * (c.depth - k_slop), c.target_speed);
+            const float previous = c.normal_impulse;
+            c.normal_impulse     = std::max(previous + (bias - dot(rel, c.normal)) / k_n, 0.0f);
+            const vec3f jn       = c.normal * (c.normal_impulse - previous);
+            apply_impulse(r, c.a, ra, jn);
+            if (has_b) apply_impulse(r, c.b, rb, -jn);
+
+            // Coulomb friction against the current tangential slip, bounded by mu * normal impulse.
+            rel = velocity_at(r, c.a, ra);
+            if (has_b) rel -= velocity_at(r, c.b, rb);
+            vec3f       t    = rel - c.normal * dot(rel, c.normal);
+            const float slip = length(t);
+            if (slip <= 1e-6f) continue;
+            t = t * (1.0f / slip);
+            const float k_t = effective_mass_term(r, c.a, ra, t) + (has_b ? effective_mass_term(r, c.b, rb, t) : 0.0f);
+            if (k_t <= 0.0f) continue;
+            const float jt = std::min(slip / k_t, s.friction * c.normal_impulse);
+            apply_impulse(r, c.a, ra, t * -jt);
+            if (has_b) apply_impulse(r, c.b, rb, t * jt);
+        }
+    }
+    profile_note(ctx.profiler, static_cast<std::uint32_t>(s.iterations), 0.0f);
+}
+
+void impulse_rigid_integrate(rigid_domain_context& r, const step_context& ctx) {
+    const float dt = static_cast<float>(ctx.dt);
+    parallel_for(ctx.exec, r.position.size(), k_body_grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (r.inv_mass[i] == 0.0f) continue;
+            r.position[i] += r.linear_velocity[i] * dt;
+            const vec3f w = r.angular_velocity[i];
+            const quatf q = r.orientation[i];
+            const quatf dq{w.x * q.w + w.y * q.z - w.z * q.y, w.y * q.w + w.z * q.x - w.x * q.z, w.z * q.w + w.x * q.y - w.y * q.x, -w.x * q.x - w.y * q.y - w.z * q.z};
+            const float h = 0.5f * dt;
+            r.orientation[i] = normalized(quatf{q.x + dq.x * h, q.y + dq.y * h, q.z + dq.z * h, q.w + dq.w * h});
+        }
+    });
+}
+
+} // namespace rphys
@@ -1,7 +1,33 @@
 #ifndef RPHYS_DOMAIN_RIGID_ALGORITHMS_IMPULSE_RIGID_HPP
 #define RPHYS_DOMAIN_RIGID_ALGORITHMS_IMPULSE_RIGID_HPP
 
-namespace rphys { struct impulse_rigid_algorithm; }
+#include "core_base/vec_math.hpp"
+#include "domain_rigid/pipeline_contract.hpp"
 
-#endif // RPHYS_DOMAIN_RIGID_ALGORITHMS_IMPULSE_RIGID_HPP
+namespace rphys {
+
+// Sequential-impulse rigid bodies: spheres and boxes against a ground plane and each other
+// (box-box by separating axes). Parameters: rigid.iterations (8),
+// rigid.restitution (0.2), rigid.friction (0.5), rigid.ground (1 = plane enabled),
+// rigid.ground_height (0), gravity.x/y/z.
+struct impulse_rigid_settings {
+    int   iterations{8};
+    float restitution{0.2f};
+    float friction{0.5f};
+    bool  ground{true};
+    float ground_height{0.0f};
+    vec3f gravity{0.0f, -9.81f, 0.0f};
+};
+
+impulse_rigid_settings impulse_rigid_read_settings(const param_store*);
 
+void impulse_rigid_apply_forces(rigid_domain_context&, const step_context&);
+// Parallel sweep-and-prune on x plus narrowphase. Contact order follows the step's determinism
+// level (see impulse_rigid.cpp); bit_stable yields contacts sorted by (a, b).
+void impulse_rigid_find_contacts(rigid_domain_context&, const step_context&);
+void impulse_rigid_solve_contacts(rigid_domain_context&, const step_context&);
+void impulse_rigid_integrate(rigid_domain_context&, const step_context&);
+
+} // namespace rphys
+
+#endif // RPHYS_DOMAIN_RIGID_ALGORITHMS_IMPULSE_RIGID_HPP
@@ -1,3 +1,171 @@
 #include "pipeline_contract.hpp"
-// skeleton
+#include "algorithms/impulse_rigid.hpp"
+#include "core_base/command_queue.hpp"
+#include "core_base/field_bus.hpp"
+#include "core_base/world_snapshot.hpp"
+#include <algorithm>
+#include <new>
 
+namespace rphys {
+
+namespace {
+    void* rigid_create(std::uint32_t domain) {
+        auto* r = new (std::nothrow) rigid_domain_context{};
+        if (r) r->domain = domain;
+        return r;
+    }
+
+    void rigid_destroy(void* state) { delete static_cast<rigid_domain_context*>(state); }
+
+    vec3f body_inv_inertia(rigid_shape shape, vec3f half, float mass) {
+        if (shape == rigid_shape::sphere) {
+            const float i = 0.4f * mass * half.x * half.x;
+            return vec3f{1.0f / i, 1.0f / i, 1.0f / i};
+        }
+        const float k = mass / 3.0f;
+        return vec3f{1.0f / (k * (half.y * half.y + half.z * half.z)), 1.0f / (k * (half.x * half.x + half.z * half.z)), 1.0f / (k * (half.x * half.x + half.y * half.y))};
+    }
+
+    void add_body(rigid_domain_context& r, rigid_shape shape, vec3f at, vec3f half, float mass) {
+        r.position.push_back(at);
+        r.orientation.push_back(quatf{});
+        r.linear_velocity.push_back(vec3f{});
+        r.angular_velocity.push_back(vec3f{});
+        r.mass.push_back(mass);
+        r.inv_mass.push_back(1.0f / mass);
+        r.inv_inertia.push_back(body_inv_inertia(shape, half, mass));
+        r.half_extent.push_back(half);
+        r.shape.push_back(static_cast<std::uint32_t>(shape));
+    }
+
+    // A primitive with resolution (nx, ny, nz) produces a lattice of bodies starting at origin,
+    // spaced 2.2 half extents apart so that neighbours start separated.
+    bool rigid_build_static(void* state, const scene_primitive_list& prims) {
+        auto& r = *static_cast<rigid_domain_context*>(state);
+        const std::size_t before = r.position.size();
+        for (const auto& p : prims) {
+            if (p.type != scene_primitive_type::rigid_sphere && p.type != scene_primitive_type::rigid_box) continue;
+            if (p.mass <= 0.0f) return false;
+            const bool  sphere = p.type == scene_primitive_type::rigid_sphere;
+            const vec3f half   = sphere ? vec3f{p.extent[0], p.extent[0], p.extent[0]} : vec3f{0.5f * p.extent[0], 0.5f * p.extent[1], 0.5f * p.extent[2]};
+            if (half.x <= 0.0f || half.y <= 0.0f || half.z <= 0.0f) return false;
+            const std::uint32_t nx = std::max(1u, p.resolution[0]), ny = std::max(1u, p.resolution[1]), nz = std::max(1u, p.resolution[2]);
+            for (std::uint32_t k = 0; k < nz; ++k)
+                for (std::uint32_t j = 0; j < ny; ++j)
+                    for (std::uint32_t i = 0; i < nx; ++i) {
+                        const vec3f at{p.origin[0] + 2.2f * half.x * static_cast<float>(i), p.origin[1] + 2.2f * half.y * static_cast<float>(j),
+                                       p.origin[2] + 2.2f * half.z * static_cast<float>(k)};
+                        add_body(r, sphere ? rigid_shape::sphere : rigid_shape::box, at, half, p.mass);
+                    }
+        }
+        return r.position.size() > before;
+    }
+
+    bool rigid_apply_command(void* state, const command_record& cmd) {
+        auto& r = *static_cast<rigid_domain_context*>(state);
+        if (cmd.index >= r.position.size()) return false;
+        const std::uint32_t i = cmd.index;
+        switch (cmd.kind) {
+            case command_kind::pin:
+                r.inv_mass[i]         = 0.0f;
+                r.inv_inertia[i]      = vec3f{};
+                r.linear_velocity[i]  = vec3f{};
+                r.angular_velocity[i] = vec3f{};
+                return true;
+            case command_kind::unpin:
+                r.inv_mass[i]    = 1.0f / r.mass[i];
+                r.inv_inertia[i] = body_inv_inertia(static_cast<rigid_shape>(r.shape[i]), r.half_extent[i], r.mass[i]);
+                return true;
+            case command_kind::impulse:
+                r.linear_velocity[i] += vec3f{static_cast<float>(cmd.value[0]), static_cast<float>(cmd.value[1]), static_cast<float>(cmd.value[2])} * r.inv_mass[i];
+                return true;
+            default: return false;
+        }
+    }
+
+    void rigid_export_fields(void* state, field_bus& bus) {
+        auto& r = *static_cast<rigid_domain_context*>(state);
+        const std::size_t n = r.position.size();
+        export_field(&bus, r.domain, "rigid.position", r.position.data(), n, field_scalar::f32, 3, true);
+        export_field(&bus, r.domain, "rigid.orientation", r.orientation.data(), n, field_scalar::f32, 4, true);
+        export_field(&bus, r.domain, "rigid.linear_velocity", r.linear_velocity.data(), n, field_scalar::f32, 3, true);
+        export_field(&bus, r.domain, "rigid.angular_velocity", r.angular_velocity.data(), n, field_scalar::f32, 3, true);
+        export_field(&bus, r.domain, "rigid.inv_mass", r.inv_mass.data(), n, field_scalar::f32, 1, false);
+        export_field(&bus, r.domain, "rigid.half_extent", r.half_extent.data(), n, field_scalar::f32, 3, false);
+        export_field(&bus, r.domain, "rigid.shape", r.shape.data(), n, field_scalar::u32, 1, false);
+    }
+
+    // inv_mass / inv_inertia are hot because pin / unpin rewrite them; the contact list is the
+    // previous step's, kept so a restored world exports exactly what the saved one did.
+    void rigid_save_state(const void* state, snapshot_writer& out) {
+        const auto& r = *static_cast<const rigid_domain_context*>(state);
+        using enum snapshot_tier;
+        out.write_array(hot, r.position);
+        out.write_array(hot, r.orientation);
+        out.write_array(hot, r.linear_velocity);
+        out.write_array(hot, r.angular_velocity);
+        out.write_array(hot, r.inv_mass);
+        out.write_array(hot, r.inv_inertia);
+        out.write_array(hot, r.contacts);
+        out.write_array(cold, r.mass);
+        out.write_array(cold, r.half_extent);
+        out.write_array(cold, r.shape);
+    }
+
+    bool rigid_load_state(void* state, snapshot_reader& in) {
+        auto& r = *static_cast<rigid_domain_context*>(state);
+        using enum snapshot_tier;
+        rigid_domain_context next{};
+        in.read_array(hot, next.position);
+        in.read_array(hot, next.orientation);
+        in.read_array(hot, next.linear_velocity);
+        in.read_array(hot, next.angular_velocity);
+        in.read_array(hot, next.inv_mass);
+        in.read_array(hot, next.inv_inertia);
+        in.read_array(hot, next.contacts);
+        in.read_array(cold, next.mass);
+        in.read_array(cold, next.half_extent);
+        in.read_array(cold, next.shape);
+        const std::size_t n = next.position.size();
+        if (!in.ok() || next.orientation.size() != n || next.linear_velocity.size() != n || next.angular_velocity.size() != n || next.inv_mass.size() != n ||
+            next.inv_inertia.size() != n || next.mass.size() != n || next.half_extent.size() != n || next.shape.size() != n)
+            return false;
+        const auto body_ok    = [](std::uint32_t s) { return s <= static_cast<std::uint32_t>(rigid_shape::box); };
+        const auto contact_ok = [n](const rigid_contact& c) { return c.a < n && (c.b < n || c.b == rigid_ground); };
+        if (!std::all_of(next.shape.begin(), next.shape.end(), body_ok) || !std::all_of(next.contacts.begin(), next.contacts.end(), contact_ok)) return false;
+        next.domain = r.domain;
+        r           = std::move(next);
+        return true;
+    }
+
+    void run_forces(void* state, step_context& ctx) { impulse_rigid_apply_forces(*static_cast<rigid_domain_context*>(state), ctx); }
+    void run_contacts(void* state, step_context& ctx) { impulse_rigid_find_contacts(*static_cast<rigid_domain_context*>(state), ctx); }
+    void run_solve(void* state, step_context& ctx) { impulse_rigid_solve_contacts(*static_cast<rigid_domain_context*>(state), ctx); }
+    void run_integrate(void* state, step_context& ctx) { impulse_rigid_integrate(*static_cast<rigid_domain_context*>(state), ctx); }
+
+    const char* const k_forces_reads[]     = {"rigid.inv_mass"};
+    const char* const k_forces_writes[]    = {"rigid.linear_velocity"};
+    const char* const k_contacts_reads[]   = {"rigid.position", "rigid.orientation", "rigid.half_extent", "rigid.shape", "rigid.inv_mass", "rigid.linear_velocity", "rigid.angular_velocity"};
+    const char* const k_contacts_writes[]  = {"rigid.contacts"};
+    const char* const k_solve_reads[]      = {"rigid.contacts", "rigid.position", "rigid.orientation", "rigid.inv_mass"};
+    const char* const k_solve_writes[]     = {"rigid.linear_velocity", "rigid.angular_velocity", "rigid.contacts"};
+    const char* const k_integrate_reads[]  = {"rigid.linear_velocity", "rigid.angular_velocity", "rigid.inv_mass"};
+    const char* const k_integrate_writes[] = {"rigid.position", "rigid.orientation"};
+
+    const domain_phase k_phases[] = {
+        {"forces", phase_stage::prepare, k_forces_reads, std::size(k_forces_reads), k_forces_writes, std::size(k_forces_writes), run_forces},
+        {"contacts", phase_stage::solve, k_contacts_reads, std::size(k_contacts_reads), k_contacts_writes, std::size(k_contacts_writes), run_contacts},
+        {"solve", phase_stage::solve, k_solve_reads, std::size(k_solve_reads), k_solve_writes, std::size(k_solve_writes), run_solve},
+        {"integrate", phase_stage::finalize, k_integrate_reads, std::size(k_integrate_reads), k_integrate_writes, std::size(k_integrate_writes), run_integrate},
+    };
+} // namespace
+
+const domain_pipeline_contract& rigid_domain_contract() {
+    static const domain_pipeline_contract contract{
+        "rigid", rigid_create, rigid_destroy, rigid_build_static, rigid_apply_command, rigid_export_fields, k_phases, std::size(k_phases), nullptr, nullptr,
+        rigid_save_state, rigid_load_state,
+    };
+    return contract;
+}
+
+} // namespace rphys
@@ -1,7 +1,51 @@
 #ifndef RPHYS_DOMAIN_RIGID_PIPELINE_CONTRACT_HPP
 #define RPHYS_DOMAIN_RIGID_PIPELINE_CONTRACT_HPP
 
-namespace rphys { struct rigid_pipeline_contract; }
+#include <cstdint>
+#include <vector>
+#include "core_base/domain_core.hpp"
+#include "core_base/vec_math.hpp"
 
-#endif // RPHYS_DOMAIN_RIGID_PIPELINE_CONTRACT_HPP
+namespace rphys {
+
+enum class rigid_shape : std::uint8_t { sphere, box };
+
+constexpr std::uint32_t rigid_ground = ~std::uint32_t{0}; // contact partner for the ground plane
+
+struct rigid_contact {
+    std::uint32_t a{0};
+    std::uint32_t b{rigid_ground};
+    vec3f         normal{};   // unit, pointing from b towards a
+    vec3f         point{};
+    float         depth{0.0f};
+    float         target_speed{0.0f}; // restitution target along the normal
+    float         normal_impulse{0.0f};
+};
 
+// Rigid bodies (structure of arrays). Exported fields: rigid.position (f32 x3, writable),
+// rigid.orientation (f32 x4 quaternion xyzw, writable), rigid.linear_velocity,
+// rigid.angular_velocity (f32 x3, writable), rigid.inv_mass (f32), rigid.half_extent (f32 x3;
+// x = radius for spheres), rigid.shape (u32, rigid_shape).
+struct rigid_domain_context {
+    std::uint32_t              domain{0};
+    std::vector<vec3f>         position;
+    std::vector<quatf>         orientation;
+    std::vector<vec3f>         linear_velocity;
+    std::vector<vec3f>         angular_velocity;
+    std::vector<float>         mass;
+    std::vector<float>         inv_mass;     // 0 = kinematic / pinned
+    std::vector<vec3f>         inv_inertia;  // body-space diagonal
+    std::vector<vec3f>         half_extent;
+    std::vector<std::uint32_t> shape;        // rigid_shape values
+    std::vector<rigid_contact> contacts;     // rebuilt every step
+    // Broadphase scratch, reused across steps.
+    std::vector<std::uint32_t>              sweep_order;
+    std::vector<std::vector<rigid_contact>> contact_chunks;
+    std::vector<std::uint32_t>              chunk_completion;
+};
+
+const domain_pipeline_contract& rigid_domain_contract();
+
+} // namespace rphys
+
+#endif // RPHYS_DOMAIN_RIGID_PIPELINE_CONTRACT_HPP
@@ -1,7 +1,105 @@
 #ifndef RPHYS_PERF_LAYERS_LAYOUT_PACK_HPP
 #define RPHYS_PERF_LAYERS_LAYOUT_PACK_HPP
 
-namespace rphys { struct perf_layout_pack; }
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "core_base/vec_math.hpp"
 
-#endif // RPHYS_PERF_LAYERS_LAYOUT_PACK_HPP
+namespace rphys {
+
+// Compile-time storage layouts for per-particle float channels (ROADMAP_XPBD §3). A layout
+// policy maps (particle i, channel c) to a float offset given the padded particle count; the
+// mapping is constexpr and inlines into plain address arithmetic, so a kernel written against
+// particle_pack compiles to the same loads a hand-written loop over that layout would use.
+// Every layout starts each particle / channel / block on a 64 B boundary where it can.
+// Domains do not store their state in packs: a field bus entry has a single stride, which SoA
+// and AoSoA cannot express, so the exported packed arrays stay the canonical storage.
+constexpr std::size_t k_pack_alignment = 64;
+
+constexpr std::size_t pack_round_up(std::size_t n, std::size_t multiple) { return (n + multiple - 1) / multiple * multiple; }
+
+// [p0: c0 c1 ..][p1: c0 c1 ..] — one record per particle; best for scattered per-particle access.
+struct aos_layout {
+    static constexpr std::size_t padded(std::size_t n) { return n; }
+    template <std::size_t Channels>
+    static constexpr std::size_t index(std::size_t i, std::size_t c, std::size_t) { return i * Channels + c; }
+};
+
+// [c0: p0 p1 ..][c1: p0 p1 ..] — one array per channel, each padded to a cache line.
+struct soa_layout {
+    static constexpr std::size_t padded(std::size_t n) { return pack_round_up(n, k_pack_alignment / sizeof(float)); }
+    template <std::size_t Channels>
+    static constexpr std::size_t index(std::size_t i, std::size_t c, std::size_t padded_n) { return c * padded_n + i; }
+};
+
+// Blocks of B particles, channel-major inside a block: [b0: c0 x B][c1 x B]..[b1: ..]. B = 8
+// matches one AVX2 register of floats, B = 16 one AVX-512 register.
+template <std::size_t B>
+struct aosoa_layout {
+    static_assert(B == 8 || B == 16, "blocks match one AVX2 or AVX-512 register of floats");
+    static constexpr std::size_t block = B;
+    static constexpr std::size_t padded(std::size_t n) { return pack_round_up(n, B); }
+    template <std::size_t Channels>
+    static constexpr std::size_t index(std::size_t i, std::size_t c, std::size_t) { return (i / B) * (B * Channels) + c * B + (i % B); }
+};
+
+template <class T, std::size_t Align>
+struct aligned_allocator {
+    using value_type = T;
+    template <class U>
+    struct rebind {
+        using other = aligned_allocator<U, Align>;
+    };
+
+    aligned_allocator() = default;
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Align>&) noexcept {}
+
+    T*   allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Align})); }
+    void deallocate(T* p, std::size_t) noexcept { ::operator delete(p, std::align_val_t{Align}); }
 
+    template <class U>
+    bool operator==(const aligned_allocator<U, Align>&) const noexcept { return true; }
+};
+
+// `Channels` floats per particle stored in `Layout`. Padding lanes are zero and never read by
+// kernels that stay within size(). resize is a no-op for an unchanged count, so a solver can
+// reload the pack every step without allocating or clearing it.
+template <class Layout, std::size_t Channels>
+class particle_pack {
+public:
+    using layout_type = Layout;
+    static constexpr std::size_t channels = Channels;
+
+    void resize(std::size_t n) {
+        if (n == size_) return;
+        size_   = n;
+        padded_ = Layout::padded(n);
+        data_.assign(padded_ * Channels, 0.0f);
+    }
+
+    std::size_t size() const { return size_; }
+    std::size_t storage_size() const { return data_.size(); }
+    const float* data() const { return data_.data(); }
+
+    float& operator()(std::size_t i, std::size_t c) { return data_[Layout::template index<Channels>(i, c, padded_)]; }
+    float  operator()(std::size_t i, std::size_t c) const { return data_[Layout::template index<Channels>(i, c, padded_)]; }
+
+    // Three consecutive channels starting at c as one vector.
+    vec3f load3(std::size_t i, std::size_t c) const { return vec3f{(*this)(i, c), (*this)(i, c + 1), (*this)(i, c + 2)}; }
+    void  store3(std::size_t i, std::size_t c, const vec3f& v) {
+        (*this)(i, c)     = v.x;
+        (*this)(i, c + 1) = v.y;
+        (*this)(i, c + 2) = v.z;
+    }
+
+private:
+    std::vector<float, aligned_allocator<float, k_pack_alignment>> data_;
+    std::size_t                                                    size_{0};
+    std::size_t                                                    padded_{0};
+};
+
+} // namespace rphys
+
+#endif // RPHYS_PERF_LAYERS_LAYOUT_PACK_HPP
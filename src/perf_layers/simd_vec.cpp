@@ -1,3 +1,759 @@
 #include "simd_vec.hpp"
-// skeleton
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 
+#if defined(HINAPE_HAVE_SIMD_DISPATCH) && (defined(__x86_64__) || defined(_M_X64))
+#define RPHYS_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define RPHYS_TARGET(isa) // MSVC emits any intrinsic without per-function flags
+#else
+#include <cpuid.h>
+#define RPHYS_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace rphys {
+
+namespace {
+    void axpy_scalar(float* out, const float* x, const float* y, float a, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = x[i] + y[i] * a;
+    }
+
+    void sub_scale_scalar(float* out, const float* x, const float* y, float s, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) out[i] = (x[i] - y[i]) * s;
+    }
+
+    constexpr float k_inf = std::numeric_limits<float>::infinity();
+
+    // Position in the ordered sequence of floats; -0 and +0 share 0.
+    std::int32_t float_order(float x) {
+        const auto         u = std::bit_cast<std::uint32_t>(x);
+        const std::int32_t m = static_cast<std::int32_t>(u & 0x7fffffffu);
+        return u >> 31 ? -m : m;
+    }
+
+    // Bit tests rather than std::isnan / comparisons with inf, which fast-math builds may fold away.
+    bool is_nan(float x) { return (std::bit_cast<std::uint32_t>(x) & 0x7fffffffu) > 0x7f800000u; }
+    bool is_finite(float x) { return (std::bit_cast<std::uint32_t>(x) & 0x7f800000u) != 0x7f800000u; }
+
+    std::uint32_t order_distance(std::int32_t a, std::int32_t b) {
+        return a >= b ? static_cast<std::uint32_t>(a) - static_cast<std::uint32_t>(b) : static_cast<std::uint32_t>(b) - static_cast<std::uint32_t>(a);
+    }
+
+    // Reference for one element; the vector kernels use the same operations lane by lane and call
+    // this for their tails.
+    void diff_element(float x, float y, std::size_t i, std::size_t n, const simd_diff_limits& lim, simd_diff_result& r) {
+        if (x == y || (is_nan(x) && is_nan(y))) return;
+        const float ax = std::fabs(x), ay = std::fabs(y);
+        const bool  finite = is_finite(x) && is_finite(y);
+        const float mag    = std::max(ax, ay);
+        const float abs    = finite ? std::fabs(x - y) : k_inf;
+        const float rel    = finite ? abs / std::max(mag, FLT_MIN) : k_inf;
+        const std::uint32_t ulp = is_nan(x) || is_nan(y) ? ~0u : order_distance(float_order(x), float_order(y));
+        r.max_abs = std::max(r.max_abs, abs);
+        r.max_rel = std::max(r.max_rel, rel);
+        r.max_ulp = std::max(r.max_ulp, ulp);
+        const bool violates = !finite || (abs > lim.atol + lim.rtol * mag && ulp > lim.ulps);
+        if (violates && r.first_violation == n) r.first_violation = i;
+    }
+
+    void diff_scalar(const float* a, const float* b, std::size_t n, const simd_diff_limits& lim, simd_diff_result& r) {
+        r = simd_diff_result{0.0f, 0.0f, 0, n};
+        for (std::size_t i = 0; i < n; ++i) diff_element(a[i], b[i], i, n, lim, r);
+    }
+
+    // Reference for one XPBD edge; the vector kernels solve one edge per lane with the same
+    // operations and call this for their tails.
+    void xpbd_edge(float* x, const float* w, const std::uint32_t* edges, const float* rest, float* lambda, std::size_t e, float alpha) {
+        const std::uint32_t a = edges[2 * e], b = edges[2 * e + 1];
+        const float wa = w[a], wb = w[b];
+        const float den = wa + wb + alpha;
+        if (den <= 0.0f) return;
+        float*      xa = x + 3 * std::size_t{a};
+        float*      xb = x + 3 * std::size_t{b};
+        const float dx = xa[0] - xb[0], dy = xa[1] - xb[1], dz = xa[2] - xb[2];
+        const float len = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (len <= 1e-9f) return;
+        const float dl = (-(len - rest[e]) - alpha * lambda[e]) / den;
+        lambda[e] += dl;
+        const float s = dl / len;
+        const float cx = dx * s, cy = dy * s, cz = dz * s;
+        xa[0] = xa[0] + cx * wa;
+        xa[1] = xa[1] + cy * wa;
+        xa[2] = xa[2] + cz * wa;
+        xb[0] = xb[0] - cx * wb;
+        xb[1] = xb[1] - cy * wb;
+        xb[2] = xb[2] - cz * wb;
+    }
+
+    void xpbd_distance_scalar(float* x, const float* w, const std::uint32_t* edges, const float* rest, float* lambda, std::size_t first, std::size_t last, float alpha) {
+        for (std::size_t e = first; e < last; ++e) xpbd_edge(x, w, edges, rest, lambda, e, alpha);
+    }
+
+    // Solved endpoints of one batch, [component][lane]: a.xyz, b.xyz.
+    template <int Lanes>
+    void xpbd_scatter(float* x, const std::uint32_t* ia, const std::uint32_t* ib, const float (&out)[6][Lanes], unsigned active) {
+        for (int l = 0; l < Lanes; ++l) {
+            if (!(active >> l & 1)) continue;
+            float* xa = x + 3 * std::size_t{ia[l]};
+            float* xb = x + 3 * std::size_t{ib[l]};
+            for (int c = 0; c < 3; ++c) {
+                xa[c] = out[c][l];
+                xb[c] = out[3 + c][l];
+            }
+        }
+    }
+
+    // Reference poly6 weight of candidate j around xi.
+    float sph_density_term(const simd_sph_args& s, const float* xi, std::uint32_t j) {
+        const float* xj = s.position + 3 * std::size_t{j};
+        const float  rx = xi[0] - xj[0], ry = xi[1] - xj[1], rz = xi[2] - xj[2];
+        const float  r2 = rx * rx + ry * ry + rz * rz;
+        if (r2 >= s.h2) return 0.0f;
+        const float d = s.h2 - r2;
+        return s.poly6 * d * d * d;
+    }
+
+    float sph_density_scalar(const simd_sph_args& s, std::uint32_t i, const std::uint32_t* nbr, std::size_t n, float rho) {
+        const float* xi = s.position + 3 * std::size_t{i};
+        for (std::size_t k = 0; k < n; ++k) rho += sph_density_term(s, xi, nbr[k]);
+        return rho;
+    }
+
+    // Reference force terms of candidate j; pressure_i is p_i / rho_i^2.
+    void sph_force_term(const simd_sph_args& s, std::uint32_t i, float pressure_i, std::uint32_t j, float* acc) {
+        if (j == i) return;
+        const float* xi = s.position + 3 * std::size_t{i};
+        const float* xj = s.position + 3 * std::size_t{j};
+        const float  rx = xi[0] - xj[0], ry = xi[1] - xj[1], rz = xi[2] - xj[2];
+        const float  r2 = rx * rx + ry * ry + rz * rz;
+        if (r2 >= s.h2) return;
+        const float len  = std::sqrt(r2);
+        const float rhoj = std::max(s.density[j], 1e-6f);
+        const bool  grad = !(len >= s.h || len <= 0.0f);
+        const float d    = s.h - len;
+        const float g    = s.spiky_grad * d * d / len;
+        const float coef = s.mass * (pressure_i + s.pressure[j] / (rhoj * rhoj));
+        acc[0] = acc[0] - (grad ? rx * g : 0.0f) * coef;
+        acc[1] = acc[1] - (grad ? ry * g : 0.0f) * coef;
+        acc[2] = acc[2] - (grad ? rz * g : 0.0f) * coef;
+        const float  visc = len < s.h ? s.visc_lap * (s.h - len) : 0.0f;
+        const float  fv   = s.mass * visc / rhoj;
+        const float* vi   = s.velocity + 3 * std::size_t{i};
+        const float* vj   = s.velocity + 3 * std::size_t{j};
+        acc[3] = acc[3] + (vj[0] - vi[0]) * fv;
+        acc[4] = acc[4] + (vj[1] - vi[1]) * fv;
+        acc[5] = acc[5] + (vj[2] - vi[2]) * fv;
+    }
+
+    float sph_pressure_term(const simd_sph_args& s, std::uint32_t i) {
+        const float rhoi = std::max(s.density[i], 1e-6f);
+        return s.pressure[i] / (rhoi * rhoi);
+    }
+
+    void sph_forces_scalar(const simd_sph_args& s, std::uint32_t i, const std::uint32_t* nbr, std::size_t n, float* acc) {
+        const float pressure_i = sph_pressure_term(s, i);
+        for (std::size_t k = 0; k < n; ++k) sph_force_term(s, i, pressure_i, nbr[k], acc);
+    }
+
+    // Force terms of one batch, [component][lane]: pressure xyz (subtracted), viscosity xyz (added),
+    // accumulated lane by lane so the sums keep candidate order.
+    template <int Lanes>
+    void sph_accumulate(float* acc, const float (&terms)[6][Lanes], unsigned valid) {
+        for (int l = 0; l < Lanes; ++l) {
+            if (!(valid >> l & 1)) continue;
+            for (int c = 0; c < 3; ++c) acc[c] = acc[c] - terms[c][l];
+            for (int c = 3; c < 6; ++c) acc[c] = acc[c] + terms[c][l];
+        }
+    }
+
+#ifdef RPHYS_SIMD_X86
+    struct cpuid_regs {
+        unsigned a{0}, b{0}, c{0}, d{0};
+    };
+
+    cpuid_regs cpuid(unsigned leaf) {
+        cpuid_regs r;
+#if defined(_MSC_VER) && !defined(__clang__)
+        int v[4];
+        __cpuidex(v, static_cast<int>(leaf), 0);
+        r = cpuid_regs{static_cast<unsigned>(v[0]), static_cast<unsigned>(v[1]), static_cast<unsigned>(v[2]), static_cast<unsigned>(v[3])};
+#else
+        __cpuid_count(leaf, 0, r.a, r.b, r.c, r.d);
+#endif
+        return r;
+    }
+
+    // OS-enabled register state (XCR0); only valid when CPUID reports OSXSAVE.
+    std::uint64_t xgetbv0() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return _xgetbv(0);
+#else
+        unsigned lo = 0, hi = 0;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return std::uint64_t{hi} << 32 | lo;
+#endif
+    }
+
+    simd_level detect_x86() {
+        const unsigned max_leaf = cpuid(0).a;
+        if (max_leaf < 1) return simd_level::scalar;
+        const cpuid_regs l1 = cpuid(1);
+        if (!(l1.c >> 20 & 1)) return simd_level::scalar;
+        const cpuid_regs l7 = max_leaf >= 7 ? cpuid(7) : cpuid_regs{};
+        const bool          osxsave = l1.c >> 27 & 1;
+        const std::uint64_t xcr0    = osxsave ? xgetbv0() : 0;
+        const bool ymm = (xcr0 & 0x6) == 0x6;    // SSE + AVX state
+        const bool zmm = (xcr0 & 0xe6) == 0xe6;  // + opmask, ZMM0-15 upper halves, ZMM16-31
+        if (zmm && (l7.b >> 16 & 1)) return simd_level::avx512;
+        if (ymm && (l7.b >> 5 & 1)) return simd_level::avx2;
+        return simd_level::sse42;
+    }
+
+    // Multiply and add stay separate instructions (CMake builds this file with -ffp-contract=off):
+    // a fused multiply-add rounds once and would diverge from the scalar table.
+    RPHYS_TARGET("sse4.2")
+    void axpy_sse42(float* out, const float* x, const float* y, float a, std::size_t n) {
+        const __m128 va = _mm_set1_ps(a);
+        std::size_t  i  = 0;
+        for (; i + 4 <= n; i += 4) _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(y + i), va)));
+        for (; i < n; ++i) out[i] = x[i] + y[i] * a;
+    }
+
+    RPHYS_TARGET("sse4.2")
+    void sub_scale_sse42(float* out, const float* x, const float* y, float s, std::size_t n) {
+        const __m128 vs = _mm_set1_ps(s);
+        std::size_t  i  = 0;
+        for (; i + 4 <= n; i += 4) _mm_storeu_ps(out + i, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)), vs));
+        for (; i < n; ++i) out[i] = (x[i] - y[i]) * s;
+    }
+
+    // The diff kernels compute per lane exactly what diff_element computes, with masks instead of
+    // branches; maxima are NaN-free, so lane order does not matter.
+    RPHYS_TARGET("sse4.2")
+    void diff_sse42(const float* a, const float* b, std::size_t n, const simd_diff_limits& lim, simd_diff_result& r) {
+        r = simd_diff_result{0.0f, 0.0f, 0, n};
+        const __m128  inf = _mm_set1_ps(k_inf), fmin = _mm_set1_ps(FLT_MIN), sign = _mm_set1_ps(-0.0f);
+        const __m128  atol = _mm_set1_ps(lim.atol), rtol = _mm_set1_ps(lim.rtol);
+        const __m128i magmask = _mm_set1_epi32(0x7fffffff), bias = _mm_set1_epi32(INT32_MIN);
+        const __m128i ulps = _mm_xor_si128(_mm_set1_epi32(static_cast<std::int32_t>(lim.ulps)), bias);
+        __m128  vabs = _mm_setzero_ps(), vrel = _mm_setzero_ps();
+        __m128i vulp = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m128 va = _mm_loadu_ps(a + i), vb = _mm_loadu_ps(b + i);
+            const __m128 eq     = _mm_or_ps(_mm_cmpeq_ps(va, vb), _mm_and_ps(_mm_cmpunord_ps(va, va), _mm_cmpunord_ps(vb, vb)));
+            const __m128 ax     = _mm_andnot_ps(sign, va), ay = _mm_andnot_ps(sign, vb);
+            const __m128 finite = _mm_and_ps(_mm_cmplt_ps(ax, inf), _mm_cmplt_ps(ay, inf));
+            const __m128 mag    = _mm_max_ps(ax, ay);
+            const __m128 absd   = _mm_andnot_ps(sign, _mm_sub_ps(va, vb));
+            const __m128 abs    = _mm_andnot_ps(eq, _mm_blendv_ps(inf, absd, finite));
+            const __m128 rel    = _mm_andnot_ps(eq, _mm_blendv_ps(inf, _mm_div_ps(absd, _mm_max_ps(mag, fmin)), finite));
+            const __m128i ia = _mm_castps_si128(va), ib = _mm_castps_si128(vb);
+            const __m128i sa  = _mm_sub_epi32(_mm_xor_si128(_mm_and_si128(ia, magmask), _mm_srai_epi32(ia, 31)), _mm_srai_epi32(ia, 31));
+            const __m128i sb  = _mm_sub_epi32(_mm_xor_si128(_mm_and_si128(ib, magmask), _mm_srai_epi32(ib, 31)), _mm_srai_epi32(ib, 31));
+            __m128i       ulp = _mm_blendv_epi8(_mm_sub_epi32(sa, sb), _mm_sub_epi32(sb, sa), _mm_cmpgt_epi32(sb, sa));
+            ulp               = _mm_andnot_si128(_mm_castps_si128(eq), _mm_or_si128(ulp, _mm_castps_si128(_mm_cmpunord_ps(va, vb))));
+            const __m128 bad_ulp = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_xor_si128(ulp, bias), ulps));
+            const __m128 over    = _mm_and_ps(_mm_cmpgt_ps(abs, _mm_add_ps(atol, _mm_mul_ps(rtol, mag))), bad_ulp);
+            const __m128 viol    = _mm_or_ps(over, _mm_andnot_ps(_mm_or_ps(eq, finite), _mm_castsi128_ps(_mm_set1_epi32(-1))));
+            vabs = _mm_max_ps(vabs, abs);
+            vrel = _mm_max_ps(vrel, rel);
+            vulp = _mm_max_epu32(vulp, ulp);
+            const int mask = _mm_movemask_ps(viol);
+            if (mask && r.first_violation == n) r.first_violation = i + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+        }
+        alignas(16) float         fa[4], fr[4];
+        alignas(16) std::uint32_t fu[4];
+        _mm_store_ps(fa, vabs);
+        _mm_store_ps(fr, vrel);
+        _mm_store_si128(reinterpret_cast<__m128i*>(fu), vulp);
+        for (int k = 0; k < 4; ++k) {
+            r.max_abs = std::max(r.max_abs, fa[k]);
+            r.max_rel = std::max(r.max_rel, fr[k]);
+            r.max_ulp = std::max(r.max_ulp, fu[k]);
+        }
+        for (; i < n; ++i) diff_element(a[i], b[i], i, n, lim, r);
+    }
+
+    // SSE has no gathers: lanes are loaded one by one from base[stride * idx[l] + c].
+    RPHYS_TARGET("sse4.2")
+    inline __m128 gather_sse42(const float* base, const std::uint32_t* idx, std::size_t stride, std::size_t c) {
+        return _mm_set_ps(base[stride * idx[3] + c], base[stride * idx[2] + c], base[stride * idx[1] + c], base[stride * idx[0] + c]);
+    }
+
+    // The XPBD and SPH kernels evaluate xpbd_edge / sph_*_term per lane; compares are the negated
+    // forms of the reference's early-outs so NaN lanes take the same branch.
+    RPHYS_TARGET("sse4.2")
+    void xpbd_distance_sse42(float* x, const float* w, const std::uint32_t* edges, const float* rest, float* lambda, std::size_t first, std::size_t last, float alpha) {
+        const __m128 va = _mm_set1_ps(alpha), eps = _mm_set1_ps(1e-9f), zero = _mm_setzero_ps(), sign = _mm_set1_ps(-0.0f);
+        std::size_t  e  = first;
+        for (; e + 4 <= last; e += 4) {
+            std::uint32_t ia[4], ib[4];
+            for (int l = 0; l < 4; ++l) {
+                ia[l] = edges[2 * (e + l)];
+                ib[l] = edges[2 * (e + l) + 1];
+            }
+            const __m128 wa = gather_sse42(w, ia, 1, 0), wb = gather_sse42(w, ib, 1, 0);
+            const __m128 den = _mm_add_ps(_mm_add_ps(wa, wb), va);
+            const __m128 xa[3] = {gather_sse42(x, ia, 3, 0), gather_sse42(x, ia, 3, 1), gather_sse42(x, ia, 3, 2)};
+            const __m128 xb[3] = {gather_sse42(x, ib, 3, 0), gather_sse42(x, ib, 3, 1), gather_sse42(x, ib, 3, 2)};
+            const __m128 dx = _mm_sub_ps(xa[0], xb[0]), dy = _mm_sub_ps(xa[1], xb[1]), dz = _mm_sub_ps(xa[2], xb[2]);
+            const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+            const __m128 ok  = _mm_and_ps(_mm_cmpnle_ps(den, zero), _mm_cmpnle_ps(len, eps));
+            const unsigned active = static_cast<unsigned>(_mm_movemask_ps(ok));
+            if (!active) continue;
+            const __m128 lam = _mm_loadu_ps(lambda + e);
+            const __m128 dl  = _mm_div_ps(_mm_sub_ps(_mm_xor_ps(_mm_sub_ps(len, _mm_loadu_ps(rest + e)), sign), _mm_mul_ps(va, lam)), den);
+            _mm_storeu_ps(lambda + e, _mm_blendv_ps(lam, _mm_add_ps(lam, dl), ok));
+            const __m128 sc   = _mm_div_ps(dl, len);
+            const __m128 c[3] = {_mm_mul_ps(dx, sc), _mm_mul_ps(dy, sc), _mm_mul_ps(dz, sc)};
+            alignas(16) float out[6][4];
+            for (int k = 0; k < 3; ++k) {
+                _mm_store_ps(out[k], _mm_add_ps(xa[k], _mm_mul_ps(c[k], wa)));
+                _mm_store_ps(out[3 + k], _mm_sub_ps(xb[k], _mm_mul_ps(c[k], wb)));
+            }
+            xpbd_scatter<4>(x, ia, ib, out, active);
+        }
+        for (; e < last; ++e) xpbd_edge(x, w, edges, rest, lambda, e, alpha);
+    }
+
+    RPHYS_TARGET("sse4.2")
+    float sph_density_sse42(const simd_sph_args& s, std::uint32_t i, const std::uint32_t* nbr, std::size_t n, float rho) {
+        const float* xi = s.position + 3 * std::size_t{i};
+        const __m128 px = _mm_set1_ps(xi[0]), py = _mm_set1_ps(xi[1]), pz = _mm_set1_ps(xi[2]);
+        const __m128 h2 = _mm_set1_ps(s.h2), poly6 = _mm_set1_ps(s.poly6);
+        std::size_t  k  = 0;
+        for (; k + 4 <= n; k += 4) {
+            const __m128 rx = _mm_sub_ps(px, gather_sse42(s.position, nbr + k, 3, 0));
+            const __m128 ry = _mm_sub_ps(py, gather_sse42(s.position, nbr + k, 3, 1));
+            const __m128 rz = _mm_sub_ps(pz, gather_sse42(s.position, nbr + k, 3, 2));
+            const __m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)), _mm_mul_ps(rz, rz));
+            const __m128 d  = _mm_sub_ps(h2, r2);
+            alignas(16) float t[4];
+            _mm_store_ps(t, _mm_andnot_ps(_mm_cmpge_ps(r2, h2), _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(poly6, d), d), d)));
+            for (int l = 0; l < 4; ++l) rho += t[l];
+        }
+        for (; k < n; ++k) rho += sph_density_term(s, xi, nbr[k]);
+        return rho;
+    }
+
+    RPHYS_TARGET("sse4.2")
+    void sph_forces_sse42(const simd_sph_args& s, std::uint32_t i, const std::uint32_t* nbr, std::size_t n, float* acc) {
+        const float  pressure_i = sph_pressure_term(s, i);
+        const float* xi = s.position + 3 * std::size_t{i};
+        const float* vi = s.velocity + 3 * std::size_t{i};
+        const __m128 h = _mm_set1_ps(s.h), h2 = _mm_set1_ps(s.h2), zero = _mm_setzero_ps(), rho_min = _mm_set1_ps(1e-6f);
+        const __m128 mass = _mm_set1_ps(s.mass), spiky = _mm_set1_ps(s.spiky_grad), visc_lap = _mm_set1_ps(s.visc_lap), pi = _mm_set1_ps(pressure_i);
+        const __m128i self = _mm_set1_epi32(static_cast<std::int32_t>(i));
+        std::size_t   k    = 0;
+        for (; k + 4 <= n; k += 4) {
+            const __m128 r[3] = {_mm_sub_ps(_mm_set1_ps(xi[0]), gather_sse42(s.position, nbr + k, 3, 0)),
+                                 _mm_sub_ps(_mm_set1_ps(xi[1]), gather_sse42(s.position, nbr + k, 3, 1)),
+                                 _mm_sub_ps(_mm_set1_ps(xi[2]), gather_sse42(s.position, nbr + k, 3, 2))};
+            const __m128 r2    = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[0], r[0]), _mm_mul_ps(r[1], r[1])), _mm_mul_ps(r[2], r[2]));
+            const __m128 other = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(nbr + k)), self));
+            const unsigned valid = static_cast<unsigned>(_mm_movemask_ps(_mm_andnot_ps(other, _mm_cmpnge_ps(r2, h2))));
+            if (!valid) continue;
+            const __m128 len  = _mm_sqrt_ps(r2);
+            const __m128 rhoj = _mm_max_ps(rho_min, gather_sse42(s.density, nbr + k, 1, 0));
+            const __m128 grad = _mm_and_ps(_mm_cmpnge_ps(len, h), _mm_cmpnle_ps(len, zero));
+            const __m128 d    = _mm_sub_ps(h, len);
+            const __m128 g    = _mm_div_ps(_mm_mul_ps(_mm_mul_ps(spiky, d), d), len);
+            const __m128 coef = _mm_mul_ps(mass, _mm_add_ps(pi, _mm_div_ps(gather_sse42(s.pressure, nbr + k, 1, 0), _mm_mul_ps(rhoj, rhoj))));
+            const __m128 visc = _mm_and_ps(_mm_cmplt_ps(len, h), _mm_mul_ps(visc_lap, _mm_sub_ps(h, len)));
+            const __m128 fv   = _mm_div_ps(_mm_mul_ps(mass, visc), rhoj);
+            alignas(16) float terms[6][4];
+            for (int c = 0; c < 3; ++c) {
+                _mm_store_ps(terms[c], _mm_mul_ps(_mm_and_ps(grad, _mm_mul_ps(r[c], g)), coef));
+                _mm_store_ps(terms[3 + c], _mm_mul_ps(_mm_sub_ps(gather_sse42(s.velocity, nbr + k, 3, static_cast<std::size_t>(c)), _mm_set1_ps(vi[c])), fv));
+            }
+            sph_accumulate<4>(acc, terms, valid);
+        }
+        for (; k < n; ++k) sph_force_term(s, i, pressure_i, nbr[k], acc);
+    }
+
+    RPHYS_TARGET("avx2")
+    void axpy_avx2(float* out, const float* x, const float* y, float a, std::size_t n) {
+        const __m256 va = _mm256_set1_ps(a);
+        std::size_t  i  = 0;
+        for (; i + 8 <= n; i += 8) _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(y + i), va)));
+        for (; i < n; ++i) out[i] = x[i] + y[i] * a;
+    }
+
+    RPHYS_TARGET("avx2")
+    void sub_scale_avx2(float* out, const float* x, const float* y, float s, std::size_t n) {
+        const __m256 vs = _mm256_set1_ps(s);
+        std::size_t  i  = 0;
+        for (; i + 8 <= n; i += 8) _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)), vs));
+        for (; i < n; ++i) out[i] = (x[i] - y[i]) * s;
+    }
+
+    RPHYS_TARGET("avx2")
+    void diff_avx2(const float* a, const float* b, std::size_t n, const simd_diff_limits& lim, simd_diff_result& r) {
+        r = simd_diff_result{0.0f, 0.0f, 0, n};
+        const __m256  inf = _mm256_set1_ps(k_inf), fmin = _mm256_set1_ps(FLT_MIN), sign = _mm256_set1_ps(-0.0f);
+        const __m256  atol = _mm256_set1_ps(lim.atol), rtol = _mm256_set1_ps(lim.rtol);
+        const __m256i magmask = _mm256_set1_epi32(0x7fffffff), bias = _mm256_set1_epi32(INT32_MIN);
+        const __m256i ulps = _mm256_xor_si256(_mm256_set1_epi32(static_cast<std::int32_t>(lim.ulps)), bias);
+        __m256  vabs = _mm256_setzero_ps(), vrel = _mm256_setzero_ps();
+        __m256i vulp = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m256 va = _mm256_loadu_ps(a + i), vb = _mm256_loadu_ps(b + i);
+            const __m256 eq = _mm256_or_ps(_mm256_cmp_ps(va, vb, _CMP_EQ_OQ), _mm256_and_ps(_mm256_cmp_ps(va, va, _CMP_UNORD_Q), _mm256_cmp_ps(vb, vb, _CMP_UNORD_Q)));
+            const __m256 ax     = _mm256_andnot_ps(sign, va), ay = _mm256_andnot_ps(sign, vb);
+            const __m256 finite = _mm256_and_ps(_mm256_cmp_ps(ax, inf, _CMP_LT_OQ), _mm256_cmp_ps(ay, inf, _CMP_LT_OQ));
+            const __m256 mag    = _mm256_max_ps(ax, ay);
+            const __m256 absd   = _mm256_andnot_ps(sign, _mm256_sub_ps(va, vb));
+            const __m256 abs    = _mm256_andnot_ps(eq, _mm256_blendv_ps(inf, absd, finite));
+            const __m256 rel    = _mm256_andnot_ps(eq, _mm256_blendv_ps(inf, _mm256_div_ps(absd, _mm256_max_ps(mag, fmin)), finite));
+            const __m256i ia = _mm256_castps_si256(va), ib = _mm256_castps_si256(vb);
+            const __m256i sa  = _mm256_sub_epi32(_mm256_xor_si256(_mm256_and_si256(ia, magmask), _mm256_srai_epi32(ia, 31)), _mm256_srai_epi32(ia, 31));
+            const __m256i sb  = _mm256_sub_epi32(_mm256_xor_si256(_mm256_and_si256(ib, magmask), _mm256_srai_epi32(ib, 31)), _mm256_srai_epi32(ib, 31));
+            __m256i       ulp = _mm256_blendv_epi8(_mm256_sub_epi32(sa, sb), _mm256_sub_epi32(sb, sa), _mm256_cmpgt_epi32(sb, sa));
+            ulp = _mm256_andnot_si256(_mm256_castps_si256(eq), _mm256_or_si256(ulp, _mm256_castps_si256(_mm256_cmp_ps(va, vb, _CMP_UNORD_Q))));
+            const __m256 bad_ulp = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_xor_si256(ulp, bias), ulps));
+            const __m256 over    = _mm256_and_ps(_mm256_cmp_ps(abs, _mm256_add_ps(atol, _mm256_mul_ps(rtol, mag)), _CMP_GT_OQ), bad_ulp);
+            const __m256 viol    = _mm256_or_ps(over, _mm256_andnot_ps(_mm256_or_ps(eq, finite), _mm256_castsi256_ps(_mm256_set1_epi32(-1))));
+            vabs = _mm256_max_ps(vabs, abs);
+            vrel = _mm256_max_ps(vrel, rel);
+            vulp = _mm256_max_epu32(vulp, ulp);
+            const int mask = _mm256_movemask_ps(viol);
+            if (mask && r.first_violation == n) r.first_violation = i + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+        }
+        alignas(32) float         fa[8], fr[8];
+        alignas(32) std::uint32_t fu[8];
+        _mm256_store_ps(fa, vabs);
+        _mm256_store_ps(fr, vrel);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(fu), vulp);
+        for (int k = 0; k < 8; ++k) {
+            r.max_abs = std::max(r.max_abs, fa[k]);
+            r.max_rel = std::max(r.max_rel, fr[k]);
+            r.max_ulp = std::max(r.max_ulp, fu[k]);
+        }
+        for (; i < n; ++i) diff_element(a[i], b[i], i, n, lim, r);
+    }
+
+    RPHYS_TARGET("avx2")
+    void xpbd_distance_avx2(float* x, const float* w, const std::uint32_t* edges, const float* rest, float* lambda, std::size_t first, std::size_t last, float alpha) {
+        const __m256  va = _mm256_set1_ps(alpha), eps = _mm256_set1_ps(1e-9f), zero = _mm256_setzero_ps(), sign = _mm256_set1_ps(-0.0f);
+        const __m256i pairs = _mm256_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14), three = _mm256_set1_epi32(3);
+        std::size_t   e = first;
+        for (; e + 8 <= last; e += 8) {
+            const int*    ends = reinterpret_cast<const int*>(edges + 2 * e);
+            const __m256i ia = _mm256_i32gather_epi32(ends, pairs, 4), ib = _mm256_i32gather_epi32(ends + 1, pairs, 4);
+            const __m256i oa = _mm256_mullo_epi32(ia, three), ob = _mm256_mullo_epi32(ib, three);
+            const __m256  wa = _mm256_i32gather_ps(w, ia, 4), wb = _mm256_i32gather_ps(w, ib, 4);
+            const __m256  den = _mm256_add_ps(_mm256_add_ps(wa, wb), va);
+            const __m256  xa[3] = {_mm256_i32gather_ps(x, oa, 4), _mm256_i32gather_ps(x + 1, oa, 4), _mm256_i32gather_ps(x + 2, oa, 4)};
+            const __m256  xb[3] = {_mm256_i32gather_ps(x, ob, 4), _mm256_i32gather_ps(x + 1, ob, 4), _mm256_i32gather_ps(x + 2, ob, 4)};
+            const __m256  dx = _mm256_sub_ps(xa[0], xb[0]), dy = _mm256_sub_ps(xa[1], xb[1]), dz = _mm256_sub_ps(xa[2], xb[2]);
+            const __m256  len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz)));
+            const __m256  ok  = _mm256_and_ps(_mm256_cmp_ps(den, zero, _CMP_NLE_UQ), _mm256_cmp_ps(len, eps, _CMP_NLE_UQ));
+            const unsigned active = static_cast<unsigned>(_mm256_movemask_ps(ok));
+            if (!active) continue;
+            const __m256 lam = _mm256_loadu_ps(lambda + e);
+            const __m256 dl  = _mm256_div_ps(_mm256_sub_ps(_mm256_xor_ps(_mm256_sub_ps(len, _mm256_loadu_ps(rest + e)), sign), _mm256_mul_ps(va, lam)), den);
+            _mm256_storeu_ps(lambda + e, _mm256_blendv_ps(lam, _mm256_add_ps(lam, dl), ok));
+            const __m256 sc   = _mm256_div_ps(dl, len);
+            const __m256 c[3] = {_mm256_mul_ps(dx, sc), _mm256_mul_ps(dy, sc), _mm256_mul_ps(dz, sc)};
+            alignas(32) float         out[6][8];
+            alignas(32) std::uint32_t va_idx[8], vb_idx[8];
+            for (int k = 0; k < 3; ++k) {
+                _mm256_store_ps(out[k], _mm256_add_ps(xa[k], _mm256_mul_ps(c[k], wa)));
+                _mm256_store_ps(out[3 + k], _mm256_sub_ps(xb[k], _mm256_mul_ps(c[k], wb)));
+            }
+            _mm256_store_si256(reinterpret_cast<__m256i*>(va_idx), ia);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(vb_idx), ib);
+            xpbd_scatter<8>(x, va_idx, vb_idx, out, active);
+        }
+        for (; e < last; ++e) xpbd_edge(x, w, edges, rest, lambda, e, alpha);
+    }
+
+    RPHYS_TARGET("avx2")
+    float sph_density_avx2(const simd_sph_args& s, std::uint32_t i, const std::uint32_t* nbr, std::size_t n, float rho) {
+        const float*  xi = s.position + 3 * std::size_t{i};
+        const __m256  px = _mm256_set1_ps(xi[0]), py = _mm256_set1_ps(xi[1]), pz = _mm256_set1_ps(xi[2]);
+        const __m256  h2 = _mm256_set1_ps(s.h2), poly6 = _mm256_set1_ps(s.poly6);
+        const __m256i three = _mm256_set1_epi32(3);
+        std::size_t   k = 0;
+        for (; k + 8 <= n; k += 8) {
+            const __m256i o  = _mm256_mullo_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(nbr + k)), three);
+            const __m256  rx = _mm256_sub_ps(px, _mm256_i32gather_ps(s.position, o, 4));
+            const __m256  ry = _mm256_sub_ps(py, _mm256_i32gather_ps(s.position + 1, o, 4));
+            const __m256  rz = _mm256_sub_ps(pz, _mm256_i32gather_ps(s.position + 2, o, 4));
+            const __m256  r2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(rx, rx), _mm256_mul_ps(ry, ry)), _mm256_mul_ps(rz, rz));
+            const __m256  d  = _mm256_sub_ps(h2, r2);
+            alignas(32) float t[8];
+            _mm256_store_ps(t, _mm256_andnot_ps(_mm256_cmp_ps(r2, h2, _CMP_GE_OQ), _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(poly6, d), d), d)));
+            for (int l = 0; l < 8; ++l) rho += t[l];
+        }
+        for (; k < n; ++k) rho += sph_density_term(s, xi, nbr[k]);
+        return rho;
+    }
+
+    RPHYS_TARGET("avx2")
+    void sph_forces_avx2(const simd_sph_args& s, std::uint32_t i, const std::uint32_t* nbr, std::size_t n, float* acc) {
+        const float   pressure_i = sph_pressure_term(s, i);
+        const float*  xi = s.position + 3 * std::size_t{i};
+        const float*  vi = s.velocity + 3 * std::size_t{i};
+        const __m256  h = _mm256_set1_ps(s.h), h2 = _mm256_set1_ps(s.h2), zero = _mm256_setzero_ps(), rho_min = _mm256_set1_ps(1e-6f);
+        const __m256  mass = _mm256_set1_ps(s.mass), spiky = _mm256_set1_ps(s.spiky_grad), visc_lap = _mm256_set1_ps(s.visc_lap), pi = _mm256_set1_ps(pressure_i);
+        const __m256i self = _mm256_set1_epi32(static_cast<std::int32_t>(i)), three = _mm256_set1_epi32(3);
+        std::size_t   k = 0;
+        for (; k + 8 <= n; k += 8) {
+            const __m256i j = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nbr + k));
+            const __m256i o = _mm256_mullo_epi32(j, three);
+            const __m256  r[3] = {_mm256_sub_ps(_mm256_set1_ps(xi[0]), _mm256_i32gather_ps(s.position, o, 4)),
+                                  _mm256_sub_ps(_mm256_set1_ps(xi[1]), _mm256_i32gather_ps(s.position + 1, o, 4)),
+                                  _mm256_sub_ps(_mm256_set1_ps(xi[2]), _mm256_i32gather_ps(s.position + 2, o, 4))};
+            const __m256  r2    = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r[0], r[0]), _mm256_mul_ps(r[1], r[1])), _mm256_mul_ps(r[2], r[2]));
+            const __m256  other = _mm256_castsi256_ps(_mm256_cmpeq_epi32(j, self));
+            const unsigned valid = static_cast<unsigned>(_mm256_movemask_ps(_mm256_andnot_ps(other, _mm256_cmp_ps(r2, h2, _CMP_NGE_UQ))));
+            if (!valid) continue;
+            const __m256 len  = _mm256_sqrt_ps(r2);
+            const __m256 rhoj = _mm256_max_ps(rho_min, _mm256_i32gather_ps(s.density, j, 4));
+            const __m256 grad = _mm256_and_ps(_mm256_cmp_ps(len, h, _CMP_NGE_UQ), _mm256_cmp_ps(len, zero, _CMP_NLE_UQ));
+            const __m256 d    = _mm256_sub_ps(h, len);
+            const __m256 g    = _mm256_div_ps(_mm256_mul_ps(_mm256_mul_ps(spiky, d), d), len);
+            const __m256 coef = _mm256_mul_ps(mass, _mm256_add_ps(pi, _mm256_div_ps(_mm256_i32gather_ps(s.pressure, j, 4), _mm256_mul_ps(rhoj, rhoj))));
+            const __m256 visc = _mm256_and_ps(_mm256_cmp_ps(len, h, _CMP_LT_OQ), _mm256_mul_ps(visc_lap, _mm256_sub_ps(h, len)));
+            const __m256 fv   = _mm256_div_ps(_mm256_mul_ps(mass, visc), rhoj);
+            alignas(32) float terms[6][8];
+            for (int c = 0; c < 3; ++c) {
+                _mm256_store_ps(terms[c], _mm256_mul_ps(_mm256_and_ps(grad, _mm256_mul_ps(r[c], g)), coef));
+                _mm256_store_ps(terms[3 + c], _mm256_mul_ps(_mm256_sub_ps(_mm256_i32gather_ps(s.velocity + c, o, 4), _mm256_set1_ps(vi[c])), fv));
+            }
+            sph_accumulate<8>(acc, terms, valid);
+        }
+        for (; k < n; ++k) sph_force_term(s, i, pressure_i, nbr[k], acc);
+    }
+
+    RPHYS_TARGET("avx512f")
+    void axpy_avx512(float* out, const float* x, const float* y, float a, std::size_t n) {
+        const __m512 va = _mm512_set1_ps(a);
+        std::size_t  i  = 0;
+        for (; i + 16 <= n; i += 16) _mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(x + i), _mm512_mul_ps(_mm512_loadu_ps(y + i), va)));
+        for (; i < n; ++i) out[i] = x[i] + y[i] * a;
+    }
+
+    RPHYS_TARGET("avx512f")
+    void sub_scale_avx512(float* out, const float* x, const float* y, float s, std::size_t n) {
+        const __m512 vs = _mm512_set1_ps(s);
+        std::size_t  i  = 0;
+        for (; i + 16 <= n; i += 16) _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_sub_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)), vs));
+        for (; i < n; ++i) out[i] = (x[i] - y[i]) * s;
+    }
+
+    // Masked forms with an explicit pass-through: GCC 12's unmasked AVX-512 max / sqrt intrinsics
+    // pass an undefined vector and trip -Wmaybe-uninitialized.
+    RPHYS_TARGET("avx512f")
+    inline __m512 max_ps512(__m512 a, __m512 b) { return _mm512_mask_max_ps(a, 0xffff, a, b); }
+
+    RPHYS_TARGET("avx512f")
+    inline __m512 sqrt_ps512(__m512 a) { return _mm512_mask_sqrt_ps(a, 0xffff, a); }
+
+    RPHYS_TARGET("avx512f")
+    inline __m512i max_epu32_512(__m512i a, __m512i b) { return _mm512_mask_max_epu32(a, 0xffff, a, b); }
+
+    RPHYS_TARGET("avx512f")
+    void diff_avx512(const float* a, const float* b, std::size_t n, const simd_diff_limits& lim, simd_diff_result& r) {
+        r = simd_diff_result{0.0f, 0.0f, 0, n};
+        const __m512  inf = _mm512_set1_ps(k_inf), fmin = _mm512_set1_ps(FLT_MIN);
+        const __m512  atol = _mm512_set1_ps(lim.atol), rtol = _mm512_set1_ps(lim.rtol);
+        const __m512i magmask = _mm512_set1_epi32(0x7fffffff), ulps = _mm512_set1_epi32(static_cast<std::int32_t>(lim.ulps));
+        const __m512i zero    = _mm512_setzero_si512();
+        __m512  vabs = _mm512_setzero_ps(), vrel = _mm512_setzero_ps();
+        __m512i vulp = _mm512_setzero_si512();
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m512 va = _mm512_loadu_ps(a + i), vb = _mm512_loadu_ps(b + i);
+            const __mmask16 eq = _mm512_cmp_ps_mask(va, vb, _CMP_EQ_OQ) | (_mm512_cmp_ps_mask(va, va, _CMP_UNORD_Q) & _mm512_cmp_ps_mask(vb, vb, _CMP_UNORD_Q));
+            const __m512    ax = _mm512_abs_ps(va), ay = _mm512_abs_ps(vb);
+            const __mmask16 finite = _mm512_cmp_ps_mask(ax, inf, _CMP_LT_OQ) & _mm512_cmp_ps_mask(ay, inf, _CMP_LT_OQ);
+            const __m512    mag    = max_ps512(ax, ay);
+            const __m512    absd   = _mm512_abs_ps(_mm512_sub_ps(va, vb));
+            const __m512    abs    = _mm512_maskz_mov_ps(static_cast<__mmask16>(~eq), _mm512_mask_blend_ps(finite, inf, absd));
+            const __m512    rel    = _mm512_maskz_mov_ps(static_cast<__mmask16>(~eq), _mm512_mask_blend_ps(finite, inf, _mm512_div_ps(absd, max_ps512(mag, fmin))));
+            const __m512i ia = _mm512_castps_si512(va), ib = _mm512_castps_si512(vb);
+            const __m512i ma = _mm512_and_si512(ia, magmask), mb = _mm512_and_si512(ib, magmask);
+            const __m512i sa = _mm512_mask_sub_epi32(ma, _mm512_cmplt_epi32_mask(ia, zero), zero, ma);
+            const __m512i sb = _mm512_mask_sub_epi32(mb, _mm512_cmplt_epi32_mask(ib, zero), zero, mb);
+            __m512i       ulp = _mm512_mask_blend_epi32(_mm512_cmpgt_epi32_mask(sb, sa), _mm512_sub_epi32(sa, sb), _mm512_sub_epi32(sb, sa));
+            ulp = _mm512_mask_mov_epi32(ulp, _mm512_cmp_ps_mask(va, vb, _CMP_UNORD_Q), _mm512_set1_epi32(-1));
+            ulp = _mm512_maskz_mov_epi32(static_cast<__mmask16>(~eq), ulp);
+            const __mmask16 over = _mm512_cmp_ps_mask(abs, _mm512_add_ps(atol, _mm512_mul_ps(rtol, mag)), _CMP_GT_OQ) & _mm512_cmpgt_epu32_mask(ulp, ulps);
+            const unsigned  viol = static_cast<unsigned>(over | static_cast<__mmask16>(~(eq | finite)));
+            vabs = max_ps512(vabs, abs);
+            vrel = max_ps512(vrel, rel);
+            vulp = max_epu32_512(vulp, ulp);
+            if (viol && r.first_violation == n) r.first_violation = i + static_cast<std::size_t>(std::countr_zero(viol));
+        }
+        alignas(64) float         fa[16], fr[16];
+        alignas(64) std::uint32_t fu[16];
+        _mm512_store_ps(fa, vabs);
+        _mm512_store_ps(fr, vrel);
+        _mm512_store_si512(fu, vulp);
+        for (int k = 0; k < 16; ++k) {
+            r.max_abs = std::max(r.max_abs, fa[k]);
+            r.max_rel = std::max(r.max_rel, fr[k]);
+            r.max_ulp = std::max(r.max_ulp, fu[k]);
+        }
+        for (; i < n; ++i) diff_element(a[i], b[i], i, n, lim, r);
+    }
+
+    // Gathers with an explicit zero pass-through, for the same reason.
+    RPHYS_TARGET("avx512f")
+    inline __m512 gather_ps512(const float* base, __m512i idx) { return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xffff, idx, base, 4); }
+
+    RPHYS_TARGET("avx512f")
+    inline __m512i gather_epi32_512(const std::uint32_t* base, __m512i idx) { return _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xffff, idx, base, 4); }
+
+    // AVX-512F has no float xor (that is DQ); flip the sign bit on the integer side.
+    RPHYS_TARGET("avx512f")
+    inline __m512 negate_ps512(__m512 a) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(INT32_MIN))); }
+
+    // Lanes of one colour never share a vertex, so the masked scatters cannot collide.
+    RPHYS_TARGET("avx512f")
+    void xpbd_distance_avx512(float* x, const float* w, const std::uint32_t* edges, const float* rest, float* lambda, std::size_t first, std::size_t last, float alpha) {
+        const __m512  va = _mm512_set1_ps(alpha), eps = _mm512_set1_ps(1e-9f), zero = _mm512_setzero_ps();
+        const __m512i pairs = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30), three = _mm512_set1_epi32(3);
+        std::size_t   e = first;
+        for (; e + 16 <= last; e += 16) {
+            const __m512i ia = gather_epi32_512(edges + 2 * e, pairs), ib = gather_epi32_512(edges + 2 * e + 1, pairs);
+            const __m512i oa = _mm512_mullo_epi32(ia, three), ob = _mm512_mullo_epi32(ib, three);
+            const __m512  wa = gather_ps512(w, ia), wb = gather_ps512(w, ib);
+            const __m512  den = _mm512_add_ps(_mm512_add_ps(wa, wb), va);
+            const __m512  xa[3] = {gather_ps512(x, oa), gather_ps512(x + 1, oa), gather_ps512(x + 2, oa)};
+            const __m512  xb[3] = {gather_ps512(x, ob), gather_ps512(x + 1, ob), gather_ps512(x + 2, ob)};
+            const __m512  dx = _mm512_sub_ps(xa[0], xb[0]), dy = _mm512_sub_ps(xa[1], xb[1]), dz = _mm512_sub_ps(xa[2], xb[2]);
+            const __m512  len = sqrt_ps512(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)), _mm512_mul_ps(dz, dz)));
+            const __mmask16 ok = _mm512_cmp_ps_mask(den, zero, _CMP_NLE_UQ) & _mm512_cmp_ps_mask(len, eps, _CMP_NLE_UQ);
+            if (!ok) continue;
+            const __m512 lam = _mm512_loadu_ps(lambda + e);
+            const __m512 dl  = _mm512_div_ps(_mm512_sub_ps(negate_ps512(_mm512_sub_ps(len, _mm512_loadu_ps(rest + e))), _mm512_mul_ps(va, lam)), den);
+            _mm512_mask_storeu_ps(lambda + e, ok, _mm512_add_ps(lam, dl));
+            const __m512 sc   = _mm512_div_ps(dl, len);
+            const __m512 c[3] = {_mm512_mul_ps(dx, sc), _mm512_mul_ps(dy, sc), _mm512_mul_ps(dz, sc)};
+            for (int k = 0; k < 3; ++k) {
+                _mm512_mask_i32scatter_ps(x + k, ok, oa, _mm512_add_ps(xa[k], _mm512_mul_ps(c[k], wa)), 4);
+                _mm512_mask_i32scatter_ps(x + k, ok, ob, _mm512_sub_ps(xb[k], _mm512_mul_ps(c[k], wb)), 4);
+            }
+        }
+        for (; e < last; ++e) xpbd_edge(x, w, edges, rest, lambda, e, alpha);
+    }
+
+    RPHYS_TARGET("avx512f")
+    float sph_density_avx512(const simd_sph_args& s, std::uint32_t i, const std::uint32_t* nbr, std::size_t n, float rho) {
+        const float*  xi = s.position + 3 * std::size_t{i};
+        const __m512  px = _mm512_set1_ps(xi[0]), py = _mm512_set1_ps(xi[1]), pz = _mm512_set1_ps(xi[2]);
+        const __m512  h2 = _mm512_set1_ps(s.h2), poly6 = _mm512_set1_ps(s.poly6);
+        const __m512i three = _mm512_set1_epi32(3);
+        std::size_t   k = 0;
+        for (; k + 16 <= n; k += 16) {
+            const __m512i o  = _mm512_mullo_epi32(_mm512_loadu_si512(nbr + k), three);
+            const __m512  rx = _mm512_sub_ps(px, gather_ps512(s.position, o));
+            const __m512  ry = _mm512_sub_ps(py, gather_ps512(s.position + 1, o));
+            const __m512  rz = _mm512_sub_ps(pz, gather_ps512(s.position + 2, o));
+            const __m512  r2 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(rx, rx), _mm512_mul_ps(ry, ry)), _mm512_mul_ps(rz, rz));
+            const __m512  d  = _mm512_sub_ps(h2, r2);
+            const __mmask16 inside = static_cast<__mmask16>(~_mm512_cmp_ps_mask(r2, h2, _CMP_GE_OQ));
+            alignas(64) float t[16];
+            _mm512_store_ps(t, _mm512_maskz_mov_ps(inside, _mm512_mul_ps(_mm512_mul_ps(_mm512_mul_ps(poly6, d), d), d)));
+            for (int l = 0; l < 16; ++l) rho += t[l];
+        }
+        for (; k < n; ++k) rho += sph_density_term(s, xi, nbr[k]);
+        return rho;
+    }
+
+    RPHYS_TARGET("avx512f")
+    void sph_forces_avx512(const simd_sph_args& s, std::uint32_t i, const std::uint32_t* nbr, std::size_t n, float* acc) {
+        const float   pressure_i = sph_pressure_term(s, i);
+        const float*  xi = s.position + 3 * std::size_t{i};
+        const float*  vi = s.velocity + 3 * std::size_t{i};
+        const __m512  h = _mm512_set1_ps(s.h), h2 = _mm512_set1_ps(s.h2), zero = _mm512_setzero_ps(), rho_min = _mm512_set1_ps(1e-6f);
+        const __m512  mass = _mm512_set1_ps(s.mass), spiky = _mm512_set1_ps(s.spiky_grad), visc_lap = _mm512_set1_ps(s.visc_lap), pi = _mm512_set1_ps(pressure_i);
+        const __m512i self = _mm512_set1_epi32(static_cast<std::int32_t>(i)), three = _mm512_set1_epi32(3);
+        std::size_t   k = 0;
+        for (; k + 16 <= n; k += 16) {
+            const __m512i j = _mm512_loadu_si512(nbr + k);
+            const __m512i o = _mm512_mullo_epi32(j, three);
+            const __m512  r[3] = {_mm512_sub_ps(_mm512_set1_ps(xi[0]), gather_ps512(s.position, o)),
+                                  _mm512_sub_ps(_mm512_set1_ps(xi[1]), gather_ps512(s.position + 1, o)),
+                                  _mm512_sub_ps(_mm512_set1_ps(xi[2]), gather_ps512(s.position + 2, o))};
+            const __m512  r2 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(r[0], r[0]), _mm512_mul_ps(r[1], r[1])), _mm512_mul_ps(r[2], r[2]));
+            const unsigned valid = static_cast<unsigned>(_mm512_cmpneq_epi32_mask(j, self) & _mm512_cmp_ps_mask(r2, h2, _CMP_NGE_UQ));
+            if (!valid) continue;
+            const __m512    len  = sqrt_ps512(r2);
+            const __m512    rhoj = max_ps512(rho_min, gather_ps512(s.density, j));
+            const __mmask16 grad = _mm512_cmp_ps_mask(len, h, _CMP_NGE_UQ) & _mm512_cmp_ps_mask(len, zero, _CMP_NLE_UQ);
+            const __m512    d    = _mm512_sub_ps(h, len);
+            const __m512    g    = _mm512_div_ps(_mm512_mul_ps(_mm512_mul_ps(spiky, d), d), len);
+            const __m512    coef = _mm512_mul_ps(mass, _mm512_add_ps(pi, _mm512_div_ps(gather_ps512(s.pressure, j), _mm512_mul_ps(rhoj, rhoj))));
+            const __m512    visc = _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(len, h, _CMP_LT_OQ), _mm512_mul_ps(visc_lap, _mm512_sub_ps(h, len)));
+            const __m512    fv   = _mm512_div_ps(_mm512_mul_ps(mass, visc), rhoj);
+            alignas(64) float terms[6][16];
+            for (int c = 0; c < 3; ++c) {
+                _mm512_store_ps(terms[c], _mm512_mul_ps(_mm512_maskz_mov_ps(grad, _mm512_mul_ps(r[c], g)), coef));
+                _mm512_store_ps(terms[3 + c], _mm512_mul_ps(_mm512_sub_ps(gather_ps512(s.velocity + c, o), _mm512_set1_ps(vi[c])), fv));
+            }
+            sph_accumulate<16>(acc, terms, valid);
+        }
+        for (; k < n; ++k) sph_force_term(s, i, pressure_i, nbr[k], acc);
+    }
+#endif
+
+    constexpr simd_kernels k_scalar{simd_level::scalar, axpy_scalar, sub_scale_scalar, diff_scalar, xpbd_distance_scalar, sph_density_scalar, sph_forces_scalar};
+#ifdef RPHYS_SIMD_X86
+    constexpr simd_kernels k_sse42{simd_level::sse42, axpy_sse42, sub_scale_sse42, diff_sse42, xpbd_distance_sse42, sph_density_sse42, sph_forces_sse42};
+    constexpr simd_kernels k_avx2{simd_level::avx2, axpy_avx2, sub_scale_avx2, diff_avx2, xpbd_distance_avx2, sph_density_avx2, sph_forces_avx2};
+    constexpr simd_kernels k_avx512{simd_level::avx512, axpy_avx512, sub_scale_avx512, diff_avx512, xpbd_distance_avx512, sph_density_avx512, sph_forces_avx512};
+#endif
+} // namespace
+
+simd_level simd_detect() {
+#ifdef RPHYS_SIMD_X86
+    static const simd_level detected = detect_x86();
+    return detected;
+#else
+    return simd_level::scalar;
+#endif
+}
+
+simd_level simd_resolve(simd_level requested) {
+    const simd_level best = simd_detect();
+    return requested == simd_level::automatic || requested > best ? best : requested;
+}
+
+const simd_kernels& simd_kernels_for(simd_level resolved) {
+#ifdef RPHYS_SIMD_X86
+    switch (resolved) {
+        case simd_level::sse42: return k_sse42;
+        case simd_level::avx2: return k_avx2;
+        case simd_level::avx512: return k_avx512;
+        default: break;
+    }
+#else
+    (void)resolved;
+#endif
+    return k_scalar;
+}
+
+const char* simd_level_name(simd_level level) {
+    switch (level) {
+        case simd_level::scalar: return "scalar";
+        case simd_level::sse42: return "sse42";
+        case simd_level::avx2: return "avx2";
+        case simd_level::avx512: return "avx512";
+        default: return "automatic";
+    }
+}
+
+} // namespace rphys
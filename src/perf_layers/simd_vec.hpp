@@ -1,7 +1,80 @@
 #ifndef RPHYS_PERF_LAYERS_SIMD_VEC_HPP
 #define RPHYS_PERF_LAYERS_SIMD_VEC_HPP
 
-namespace rphys { struct perf_simd_vec; }
+#include <cstddef>
+#include <cstdint>
+#include "rphys/forward.h"
 
-#endif // RPHYS_PERF_LAYERS_SIMD_VEC_HPP
+namespace rphys {
+
+// Element i of a diff violates the limits when a[i] and b[i] differ (+0 == -0, NaN == NaN) and
+// either one is not finite, or |a - b| > atol + rtol * max(|a|, |b|) and their ULP distance
+// exceeds `ulps`. Zero limits mean bit-equal up to the sign of zero and NaN payloads.
+struct simd_diff_limits {
+    float         atol{0.0f};
+    float         rtol{0.0f};
+    std::uint32_t ulps{0};
+};
+
+// Differences of unequal elements: |a - b|, |a - b| / max(|a|, |b|, FLT_MIN) and the distance of
+// the values in the ordered float sequence. Pairs with a non-finite member count as inf / inf and
+// their ULP distance (UINT32_MAX with a NaN).
+struct simd_diff_result {
+    float         max_abs{0.0f};
+    float         max_rel{0.0f};
+    std::uint32_t max_ulp{0};
+    std::size_t   first_violation{0}; // n when no element violates the limits
+};
+
+// Particle arrays and kernel weights for the SPH neighbour sums. Arrays are packed: position and
+// velocity hold xyz per particle.
+struct simd_sph_args {
+    const float* position{nullptr};
+    const float* velocity{nullptr};
+    const float* density{nullptr};
+    const float* pressure{nullptr};
+    float        mass{0.0f};
+    float        h{0.0f};
+    float        h2{0.0f};
+    float        poly6{0.0f};
+    float        spiky_grad{0.0f};
+    float        visc_lap{0.0f};
+};
 
+// Float kernels compiled once per instruction set (SSE4.2, AVX2, AVX-512F) and picked
+// at runtime, so one binary runs on every node of a mixed farm. Each element is computed with the
+// same IEEE operations at every level (no FMA contraction, no reassociation), so switching levels
+// never changes results. Without HINAPE_HAVE_SIMD_DISPATCH (non-x86 targets, or the CMake option
+// off) only the scalar table exists and every level resolves to scalar.
+struct simd_kernels {
+    simd_level level{simd_level::scalar};
+    // out[i] = x[i] + y[i] * a; out may alias x or y.
+    void (*axpy)(float* out, const float* x, const float* y, float a, std::size_t n){nullptr};
+    // out[i] = (x[i] - y[i]) * s; out may alias x or y.
+    void (*sub_scale)(float* out, const float* x, const float* y, float s, std::size_t n){nullptr};
+    // Maxima and first violation over a[0..n) against b[0..n); see simd_diff_limits.
+    void (*diff)(const float* a, const float* b, std::size_t n, const simd_diff_limits& limits, simd_diff_result& out){nullptr};
+    // XPBD distance constraints of edges [first, last) of one colour: x holds packed xyz, edges the
+    // vertex pairs. Edges of a colour share no vertex, so the vector kernels solve one edge per lane.
+    void (*xpbd_distance)(float* x, const float* inv_mass, const std::uint32_t* edges, const float* rest_length, float* lambda, std::size_t first, std::size_t last, float alpha){nullptr};
+    // Returns rho plus the poly6 weights of candidates nbr[0..n) around particle i. Lanes evaluate
+    // several candidates at once; their weights are still added one by one in candidate order.
+    float (*sph_density)(const simd_sph_args& s, std::uint32_t i, const std::uint32_t* nbr, std::size_t n, float rho){nullptr};
+    // Adds the pressure (acc[0..3)) and viscosity (acc[3..6)) accelerations of candidates
+    // nbr[0..n) within h of particle i (i itself skipped) to acc, in candidate order.
+    void (*sph_forces)(const simd_sph_args& s, std::uint32_t i, const std::uint32_t* nbr, std::size_t n, float* acc){nullptr};
+};
+
+// Best level this CPU and OS support (CPUID + XGETBV), detected once per process.
+simd_level simd_detect();
+// Maps a requested level to one that can run here: automatic -> simd_detect(), anything higher
+// than the CPU supports -> simd_detect().
+simd_level simd_resolve(simd_level requested);
+// Kernel table of a resolved level.
+const simd_kernels& simd_kernels_for(simd_level resolved);
+// "scalar", "sse42", "avx2", "avx512" ("automatic" for the unresolved request).
+const char* simd_level_name(simd_level);
+
+} // namespace rphys
+
+#endif // RPHYS_PERF_LAYERS_SIMD_VEC_HPP
@@ -0,0 +1,139 @@
+#include "frame_graph.hpp"
+#include <algorithm>
+#include <string_view>
+#include <tuple>
+
+namespace rphys {
+
+namespace {
+    struct node_key {
+        phase_stage   stage{};
+        std::uint8_t  owner_kind{0}; // 0 domain, 1 coupling
+        std::uint32_t owner_id{0};
+        std::uint32_t order{0};
+        std::uint32_t node{0};
+
+        bool operator<(const node_key& o) const {
+            return std::tie(stage, owner_kind, owner_id, order) < std::tie(o.stage, o.owner_kind, o.owner_id, o.order);
+        }
+    };
+
+    struct resource_state {
+        std::uint32_t              domain{0};
+        std::string_view           name;
+        std::int64_t               last_writer{-1};
+        std::vector<std::uint32_t> readers; // since last_writer
+    };
+
+    struct access {
+        std::uint32_t    domain{0};
+        std::string_view name;
+        bool             write{false};
+    };
+
+    resource_state& resource_for(std::vector<resource_state>& rs, std::uint32_t domain, std::string_view name) {
+        for (auto& r : rs) {
+            if (r.domain == domain && r.name == name) return r;
+        }
+        rs.push_back(resource_state{domain, name, -1, {}});
+        return rs.back();
+    }
+
+    void collect_accesses(const frame_node& n, std::vector<access>& out) {
+        out.clear();
+        if (n.phase) {
+            for (std::size_t i = 0; i < n.phase->read_count; ++i) out.push_back({n.domain->id, n.phase->reads[i], false});
+            for (std::size_t i = 0; i < n.phase->write_count; ++i) out.push_back({n.domain->id, n.phase->writes[i], true});
+        } else {
+            const coupling_contract& c = *n.coupling->contract;
+            for (std::size_t i = 0; i < c.read_count; ++i) out.push_back({n.coupling->domains[c.reads[i].endpoint & 1u], c.reads[i].name, false});
+            for (std::size_t i = 0; i < c.write_count; ++i) out.push_back({n.coupling->domains[c.writes[i].endpoint & 1u], c.writes[i].name, true});
+        }
+        // A field both read and written counts as a write.
+        std::sort(out.begin(), out.end(), [](const access& a, const access& b) { return std::tie(a.domain, a.name, b.write) < std::tie(b.domain, b.name, a.write); });
+        out.erase(std::unique(out.begin(), out.end(), [](const access& a, const access& b) { return a.domain == b.domain && a.name == b.name; }), out.end());
+    }
+} // namespace
+
+bool frame_graph_update(frame_graph& g, const frame_view& view) {
+    if (g.topology_version == view.topology_version) return false;
+    g.topology_version = view.topology_version;
+    g.nodes.clear();
+    g.successors.clear();
+    g.roots.clear();
+
+    std::vector<node_key>   keys;
+    std::vector<frame_node> unordered;
+    for (std::size_t d = 0; d < view.domain_count; ++d) {
+        domain_core* dom = view.domains[d];
+        if (dom->inert) continue;
+        for (std::size_t p = 0; p < dom->contract->phase_count; ++p) {
+            const domain_phase& ph = dom->contract->phases[p];
+            keys.push_back({ph.stage, 0, dom->id, static_cast<std::uint32_t>(p), static_cast<std::uint32_t>(unordered.size())});
+            unordered.push_back(frame_node{dom, &ph, nullptr});
+        }
+    }
+    for (std::size_t c = 0; c < view.coupling_count; ++c) {
+        coupling_core* cp = view.couplings[c];
+        keys.push_back({cp->contract->stage, 1, cp->id, 0, static_cast<std::uint32_t>(unordered.size())});
+        unordered.push_back(frame_node{nullptr, nullptr, cp});
+    }
+    std::stable_sort(keys.begin(), keys.end());
+    g.nodes.reserve(keys.size());
+    for (const auto& k : keys) g.nodes.push_back(unordered[k.node]);
+
+    // Predecessors per node, derived from field hazards in canonical order.
+    std::vector<std::vector<std::uint32_t>> preds(g.nodes.size());
+    std::vector<resource_state> resources;
+    std::vector<access> accesses;
+    for (std::uint32_t n = 0; n < g.nodes.size(); ++n) {
+        collect_accesses(g.nodes[n], accesses);
+        auto& p = preds[n];
+        for (const auto& a : accesses) {
+            resource_state& r = resource_for(resources, a.domain, a.name);
+            // A writer after readers only waits for the readers; they already follow the last writer.
+            if (a.write && !r.readers.empty()) p.insert(p.end(), r.readers.begin(), r.readers.end());
+            else if (r.last_writer >= 0) p.push_back(static_cast<std::uint32_t>(r.last_writer));
+        }
+        for (const auto& a : accesses) {
+            resource_state& r = resource_for(resources, a.domain, a.name);
+            if (a.write) {
+                r.last_writer = n;
+                r.readers.clear();
+            } else {
+                r.readers.push_back(n);
+            }
+        }
+        std::sort(p.begin(), p.end());
+        p.erase(std::unique(p.begin(), p.end()), p.end());
+        g.nodes[n].predecessor_count = static_cast<std::uint32_t>(p.size());
+        if (p.empty()) g.roots.push_back(n);
+    }
+
+    // Invert into CSR successor lists.
+    for (const auto& p : preds) {
+        for (std::uint32_t from : p) ++g.nodes[from].successor_count;
+    }
+    std::uint32_t offset = 0;
+    for (auto& node : g.nodes) {
+        node.first_successor = offset;
+        offset += node.successor_count;
+        node.successor_count = 0;
+    }
+    g.successors.resize(offset);
+    for (std::uint32_t n = 0; n < preds.size(); ++n) {
+        for (std::uint32_t from : preds[n]) {
+            frame_node& f = g.nodes[from];
+            g.successors[f.first_successor + f.successor_count++] = n;
+        }
+    }
+    return true;
+}
+
+void frame_graph_run_node(const frame_node& n, const frame_view& view, const step_context& ctx) {
+    step_context local = ctx;
+    if (n.phase) run_domain_phase(*n.domain, *n.phase, local);
+    else run_coupling_exchange(*n.coupling, *view.fields, local);
+}
+
+} // namespace rphys
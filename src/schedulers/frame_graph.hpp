@@ -0,0 +1,41 @@
+#ifndef RPHYS_SCHEDULERS_FRAME_GRAPH_HPP
+#define RPHYS_SCHEDULERS_FRAME_GRAPH_HPP
+
+#include <cstdint>
+#include <vector>
+#include "core_base/scheduler_core.hpp"
+
+namespace rphys {
+
+// One unit of frame work: a domain phase or a coupling exchange.
+struct frame_node {
+    domain_core*        domain{nullptr}; // set for phases
+    const domain_phase* phase{nullptr};
+    coupling_core*      coupling{nullptr}; // set for coupling exchanges
+    std::uint32_t       first_successor{0};
+    std::uint32_t       successor_count{0};
+    std::uint32_t       predecessor_count{0};
+};
+
+// Dependency DAG over a world's phases and couplings. Nodes are stored in canonical serial order
+// (stage, domains before couplings, owner id, declaration index) and every edge points forward,
+// so running nodes in index order is always a valid schedule. Two nodes are ordered when one
+// writes a field (domain id + name) the other reads or writes; edges are taken from the last
+// writer and the readers since that write only, which keeps the graph close to its transitive
+// reduction without an extra pass.
+struct frame_graph {
+    std::uint64_t              topology_version{~std::uint64_t{0}};
+    std::vector<frame_node>    nodes;
+    std::vector<std::uint32_t> successors; // CSR targets indexed by frame_node::first_successor
+    std::vector<std::uint32_t> roots;      // nodes without predecessors
+};
+
+// Rebuilds the graph when the view's topology differs from the cached one; returns true if it did.
+bool frame_graph_update(frame_graph&, const frame_view&);
+
+// Executes one node with a private copy of the step context.
+void frame_graph_run_node(const frame_node&, const frame_view&, const step_context&);
+
+} // namespace rphys
+
+#endif // RPHYS_SCHEDULERS_FRAME_GRAPH_HPP
@@ -0,0 +1,94 @@
+#include "job_system.hpp"
+#include "frame_graph.hpp"
+#include <atomic>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace rphys {
+
+namespace {
+    struct scheduler_job_system;
+
+    struct node_task {
+        scheduler_job_system* system{nullptr};
+        std::uint32_t         index{0};
+    };
+
+    struct scheduler_job_system {
+        scheduler_task_pool*                         pool{nullptr};
+        frame_graph                                  graph;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> remaining;
+        std::vector<node_task>                       tasks;
+        // Valid only while run_frame is executing.
+        const frame_view*   view{nullptr};
+        const step_context* ctx{nullptr};
+        task_group*         group{nullptr};
+    };
+
+    // Runs a node, then releases its successors. The last successor that becomes ready runs on
+    // this thread instead of going through the pool (a chain costs no queue round trip).
+    void run_node_task(void* arg) {
+        const node_task* t = static_cast<const node_task*>(arg);
+        scheduler_job_system& s = *t->system;
+        while (t) {
+            const frame_node& n = s.graph.nodes[t->index];
+            frame_graph_run_node(n, *s.view, *s.ctx);
+            const node_task* next = nullptr;
+            for (std::uint32_t k = 0; k < n.successor_count; ++k) {
+                std::uint32_t succ = s.graph.successors[n.first_successor + k];
+                if (s.remaining[succ].fetch_sub(1, std::memory_order_acq_rel) != 1) continue;
+                if (next) s.group->run(run_node_task, const_cast<node_task*>(next));
+                next = &s.tasks[succ];
+            }
+            t = next;
+        }
+    }
+
+    void job_system_run_frame(void* self, const frame_view& view, step_context& ctx) {
+        auto& s = *static_cast<scheduler_job_system*>(self);
+        if (frame_graph_update(s.graph, view)) {
+            const std::size_t n = s.graph.nodes.size();
+            s.remaining = std::make_unique<std::atomic<std::uint32_t>[]>(n);
+            s.tasks.resize(n);
+            for (std::uint32_t i = 0; i < n; ++i) s.tasks[i] = node_task{&s, i};
+        }
+        if (s.graph.nodes.empty()) return;
+        for (std::size_t i = 0; i < s.graph.nodes.size(); ++i) s.remaining[i].store(s.graph.nodes[i].predecessor_count, std::memory_order_relaxed);
+
+        task_group group(s.pool);
+        s.view  = &view;
+        s.ctx   = &ctx;
+        s.group = &group;
+        const auto& roots = s.graph.roots;
+        for (std::size_t i = 1; i < roots.size(); ++i) group.run(run_node_task, &s.tasks[roots[i]]);
+        run_node_task(&s.tasks[roots[0]]);
+        group.wait();
+        s.group = nullptr;
+    }
+
+    void job_system_destroy(void* self) { delete static_cast<scheduler_job_system*>(self); }
+
+    void pool_parallel_for(void* self, std::size_t count, std::size_t grain, range_fn fn, void* user) {
+        task_pool_parallel_for(static_cast<scheduler_task_pool*>(self), count, grain, fn, user);
+    }
+} // namespace
+
+world_scheduler make_job_system_scheduler(task_backend backend, std::size_t threads) {
+    world_scheduler s{};
+    scheduler_task_pool* pool = task_pool_for(backend, threads);
+    if (!pool) return s;
+    auto* js = new (std::nothrow) scheduler_job_system{};
+    if (!js) return s;
+    js->pool    = pool;
+    s.self      = js;
+    s.name      = backend == task_backend::tbb ? "tbb" : "work_stealing";
+    s.run_frame = job_system_run_frame;
+    s.destroy   = job_system_destroy;
+    s.exec.self        = pool;
+    s.exec.run         = pool_parallel_for;
+    s.exec.concurrency = task_pool_concurrency(pool);
+    return s;
+}
+
+} // namespace rphys
@@ -0,0 +1,18 @@
+#ifndef RPHYS_SCHEDULERS_JOB_SYSTEM_HPP
+#define RPHYS_SCHEDULERS_JOB_SYSTEM_HPP
+
+#include "core_base/scheduler_core.hpp"
+#include "task_pool.hpp"
+
+namespace rphys {
+
+// Executes the frame graph on a task pool: nodes start as soon as their last predecessor
+// finishes, so independent domains (and phases of one domain touching disjoint fields) overlap.
+// The graph is rebuilt only when the world's topology changes. Phases get a parallel_executor
+// backed by the same pool. `threads` > 0 runs on a pool of that size (see task_pool_for). Returns
+// an unbound scheduler (null run_frame) when `backend` is not compiled in.
+world_scheduler make_job_system_scheduler(task_backend backend, std::size_t threads = 0);
+
+} // namespace rphys
+
+#endif // RPHYS_SCHEDULERS_JOB_SYSTEM_HPP
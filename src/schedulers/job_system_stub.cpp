@@ -1,3 +0,0 @@
-#include "job_system_stub.hpp"
-// skeleton
-
@@ -1,7 +0,0 @@
-#ifndef RPHYS_SCHEDULERS_JOB_SYSTEM_STUB_HPP
-#define RPHYS_SCHEDULERS_JOB_SYSTEM_STUB_HPP
-
-namespace rphys { struct scheduler_job_system_stub; }
-
-#endif // RPHYS_SCHEDULERS_JOB_SYSTEM_STUB_HPP
-
@@ -1,3 +1,31 @@
 #include "serial.hpp"
-// skeleton
+#include "frame_graph.hpp"
+#include <new>
 
+namespace rphys {
+
+namespace {
+    struct scheduler_serial {
+        frame_graph graph;
+    };
+
+    void serial_run_frame(void* self, const frame_view& view, step_context& ctx) {
+        auto& s = *static_cast<scheduler_serial*>(self);
+        frame_graph_update(s.graph, view);
+        for (const frame_node& n : s.graph.nodes) frame_graph_run_node(n, view, ctx);
+    }
+
+    void serial_destroy(void* self) { delete static_cast<scheduler_serial*>(self); }
+} // namespace
+
+world_scheduler make_serial_scheduler() {
+    world_scheduler s{};
+    s.self = new (std::nothrow) scheduler_serial{};
+    if (!s.self) return s;
+    s.name      = "serial";
+    s.run_frame = serial_run_frame;
+    s.destroy   = serial_destroy;
+    return s;
+}
+
+} // namespace rphys
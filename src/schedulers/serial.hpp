@@ -1,7 +1,14 @@
 #ifndef RPHYS_SCHEDULERS_SERIAL_HPP
 #define RPHYS_SCHEDULERS_SERIAL_HPP
 
-namespace rphys { struct scheduler_serial; }
+#include "core_base/scheduler_core.hpp"
 
-#endif // RPHYS_SCHEDULERS_SERIAL_HPP
+namespace rphys {
+
+// Runs every phase and coupling on the stepping thread in canonical order; data-parallel loops
+// inside phases run inline. Reference schedule for debugging and determinism comparisons.
+world_scheduler make_serial_scheduler();
 
+} // namespace rphys
+
+#endif // RPHYS_SCHEDULERS_SERIAL_HPP
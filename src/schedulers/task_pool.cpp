@@ -1,3 +1,325 @@
 #include "task_pool.hpp"
-// skeleton
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
+#if defined(HINAPE_HAVE_TBB)
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#endif
+
+namespace rphys {
+
+namespace {
+    struct task_item {
+        task_fn     fn{nullptr};
+        void*       arg{nullptr};
+        task_group* group{nullptr};
+    };
+
+    // Spinlock-guarded growable ring. The owning worker pushes/pops at the back (LIFO keeps its
+    // cache warm); thieves and the injection path take from the front (oldest, usually largest).
+    class work_deque {
+    public:
+        work_deque() : buf_(64) {}
+
+        void push_back(const task_item& t) {
+            lock();
+            if (size_ == buf_.size()) grow();
+            buf_[(head_ + size_) % buf_.size()] = t;
+            ++size_;
+            unlock();
+        }
+
+        bool pop_back(task_item& out) {
+            if (empty_hint()) return false;
+            lock();
+            bool ok = size_ > 0;
+            if (ok) out = buf_[(head_ + --size_) % buf_.size()];
+            unlock();
+            return ok;
+        }
+
+        bool pop_front(task_item& out) {
+            if (empty_hint()) return false;
+            lock();
+            bool ok = size_ > 0;
+            if (ok) {
+                out   = buf_[head_];
+                head_ = (head_ + 1) % buf_.size();
+                --size_;
+            }
+            unlock();
+            return ok;
+        }
+
+    private:
+        bool empty_hint() const { return approx_size_.load(std::memory_order_relaxed) == 0; }
+        void lock() {
+            while (locked_.exchange(true, std::memory_order_acquire)) {
+                while (locked_.load(std::memory_order_relaxed)) std::this_thread::yield();
+            }
+        }
+        void unlock() {
+            approx_size_.store(size_, std::memory_order_relaxed);
+            locked_.store(false, std::memory_order_release);
+        }
+        void grow() {
+            std::vector<task_item> next(buf_.size() * 2);
+            for (std::size_t i = 0; i < size_; ++i) next[i] = buf_[(head_ + i) % buf_.size()];
+            buf_.swap(next);
+            head_ = 0;
+        }
+
+        std::atomic<bool>        locked_{false};
+        std::atomic<std::size_t> approx_size_{0};
+        std::vector<task_item>   buf_;
+        std::size_t              head_{0};
+        std::size_t              size_{0};
+    };
+
+    constexpr std::size_t k_max_pool_threads = 256;
+
+    struct worker_tls {
+        const scheduler_task_pool* pool{nullptr};
+        std::size_t                index{0};
+    };
+    thread_local worker_tls t_worker;
+
+    struct loop_job {
+        task_range_fn            fn{nullptr};
+        void*                    user{nullptr};
+        std::size_t              count{0};
+        std::size_t              grain{1};
+        std::atomic<std::size_t> next{0};
+    };
+
+    void run_chunks(void* arg) {
+        auto& job = *static_cast<loop_job*>(arg);
+        for (;;) {
+            std::size_t begin = job.next.fetch_add(job.grain, std::memory_order_relaxed);
+            if (begin >= job.count) return;
+            job.fn(job.user, begin, std::min(job.count, begin + job.grain));
+        }
+    }
+} // namespace
+
+struct scheduler_task_pool {
+    task_backend backend{task_backend::builtin};
+    std::size_t  concurrency{1};
+#if defined(HINAPE_HAVE_TBB)
+    std::unique_ptr<tbb::task_arena> arena; // tbb pools of a fixed size; null for the global arena
+#endif
+
+    // builtin backend: deques[0..workers) belong to workers, deques[workers] takes external pushes.
+    std::vector<std::unique_ptr<work_deque>> deques;
+    std::vector<std::thread>                 threads;
+    std::atomic<std::size_t>                 queued{0};
+    std::atomic<int>                         sleepers{0};
+    std::mutex                               sleep_mutex;
+    std::condition_variable                  sleep_cv;
+    bool                                     stopping{false};
+
+    scheduler_task_pool(task_backend b, std::size_t threads_total, bool own_arena = false) : backend(b), concurrency(std::max<std::size_t>(threads_total, 1)) {
+#if defined(HINAPE_HAVE_TBB)
+        if (backend == task_backend::tbb && own_arena) arena = std::make_unique<tbb::task_arena>(static_cast<int>(concurrency));
+#else
+        (void)own_arena;
+#endif
+        if (backend != task_backend::builtin) return;
+        const std::size_t workers = concurrency - 1;
+        for (std::size_t i = 0; i <= workers; ++i) deques.push_back(std::make_unique<work_deque>());
+        threads.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) threads.emplace_back([this, i] { worker_loop(i); });
+    }
+
+    ~scheduler_task_pool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        sleep_cv.notify_all();
+        for (auto& t : threads) t.join();
+    }
+
+    std::size_t injection_index() const { return deques.size() - 1; }
+
+    void push(const task_item& t) {
+        const bool own = t_worker.pool == this;
+        deques[own ? t_worker.index : injection_index()]->push_back(t);
+        queued.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            sleep_cv.notify_one();
+        }
+    }
+
+    bool find(task_item& out) {
+        const bool  own  = t_worker.pool == this;
+        std::size_t self = own ? t_worker.index : injection_index();
+        if (own && deques[self]->pop_back(out)) return taken();
+        if (deques[injection_index()]->pop_front(out)) return taken();
+        const std::size_t n = deques.size() - 1;
+        for (std::size_t k = 1; k <= n; ++k) {
+            std::size_t victim = (self + k) % n;
+            if (victim != self && deques[victim]->pop_front(out)) return taken();
+        }
+        return false;
+    }
+
+    bool taken() {
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    static void execute(const task_item& t) {
+        task_group* g = t.group;
+        t.fn(t.arg);
+        g->pending_.fetch_sub(1, std::memory_order_release); // g may be gone after this
+    }
+
+    void worker_loop(std::size_t index) {
+        t_worker = {this, index};
+        task_item t;
+        int spins = 0;
+        for (;;) {
+            while (find(t)) {
+                execute(t);
+                spins = 0;
+            }
+            if (++spins < 64) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            sleep_cv.wait(lock, [&] { return stopping || queued.load(std::memory_order_seq_cst) > 0; });
+            sleepers.fetch_sub(1, std::memory_order_seq_cst);
+            if (stopping) return;
+            spins = 0;
+        }
+    }
+};
+
+scheduler_task_pool* task_pool_for(task_backend backend) {
+    if (backend == task_backend::builtin) {
+        static scheduler_task_pool pool{task_backend::builtin, std::thread::hardware_concurrency()};
+        return &pool;
+    }
+#if defined(HINAPE_HAVE_TBB)
+    static scheduler_task_pool pool{task_backend::tbb, static_cast<std::size_t>(std::max(1, tbb::this_task_arena::max_concurrency()))};
+    return &pool;
+#else
+    return nullptr;
+#endif
+}
+
+scheduler_task_pool* task_pool_for(task_backend backend, std::size_t threads) {
+    if (threads == 0) return task_pool_for(backend);
+    if (!task_pool_for(backend)) return nullptr;
+    threads = std::min(threads, k_max_pool_threads);
+    // Sized pools are created on first request and live until exit, like the default pools.
+    static std::mutex                                        mutex;
+    static std::vector<std::unique_ptr<scheduler_task_pool>> sized;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& p : sized) {
+        if (p->backend == backend && p->concurrency == threads) return p.get();
+    }
+    sized.push_back(std::make_unique<scheduler_task_pool>(backend, threads, true));
+    return sized.back().get();
+}
+
+scheduler_task_pool* default_task_pool() {
+    static scheduler_task_pool* pool = [] {
+        scheduler_task_pool* tbb_pool = task_pool_for(task_backend::tbb);
+        return tbb_pool ? tbb_pool : task_pool_for(task_backend::builtin);
+    }();
+    return pool;
+}
+
+task_backend task_pool_backend(const scheduler_task_pool* pool) {
+    return pool ? pool->backend : task_backend::builtin;
+}
+
+std::size_t task_pool_concurrency(const scheduler_task_pool* pool) {
+    return pool ? pool->concurrency : 1;
+}
+
+task_group::task_group(scheduler_task_pool* pool) : pool_(pool ? pool : default_task_pool()) {
+#if defined(HINAPE_HAVE_TBB)
+    if (pool_->backend == task_backend::tbb) backend_ = new tbb::task_group();
+#endif
+}
+
+task_group::~task_group() {
+    wait();
+#if defined(HINAPE_HAVE_TBB)
+    delete static_cast<tbb::task_group*>(backend_);
+#endif
+}
+
+void task_group::run(task_fn fn, void* arg) {
+    if (!fn) return;
+#if defined(HINAPE_HAVE_TBB)
+    if (backend_) {
+        auto* tg = static_cast<tbb::task_group*>(backend_);
+        if (pool_->arena) pool_->arena->execute([&] { tg->run([fn, arg] { fn(arg); }); });
+        else tg->run([fn, arg] { fn(arg); });
+        return;
+    }
+#endif
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    pool_->push(task_item{fn, arg, this});
+}
+
+void task_group::wait() {
+#if defined(HINAPE_HAVE_TBB)
+    if (backend_) {
+        auto* tg = static_cast<tbb::task_group*>(backend_);
+        if (pool_->arena) pool_->arena->execute([&] { tg->wait(); });
+        else tg->wait();
+        return;
+    }
+#endif
+    task_item t;
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (pool_->find(t)) scheduler_task_pool::execute(t);
+        else std::this_thread::yield();
+    }
+}
+
+void task_pool_parallel_for(scheduler_task_pool* pool, std::size_t count, std::size_t grain, task_range_fn fn, void* user) {
+    if (count == 0 || !fn) return;
+    if (!pool) pool = default_task_pool();
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = (count + grain - 1) / grain;
+    if (pool->concurrency == 1 || chunks == 1) {
+        fn(user, 0, count);
+        return;
+    }
+#if defined(HINAPE_HAVE_TBB)
+    if (pool->backend == task_backend::tbb) {
+        auto loop = [&] { tbb::parallel_for(tbb::blocked_range<std::size_t>(0, count, grain), [&](const tbb::blocked_range<std::size_t>& r) { fn(user, r.begin(), r.end()); }); };
+        if (pool->arena) pool->arena->execute(loop);
+        else loop();
+        return;
+    }
+#endif
+    loop_job job;
+    job.fn    = fn;
+    job.user  = user;
+    job.count = count;
+    job.grain = grain;
+    task_group group(pool);
+    const std::size_t helpers = std::min(chunks, pool->concurrency) - 1;
+    for (std::size_t i = 0; i < helpers; ++i) group.run(run_chunks, &job);
+    run_chunks(&job);
+    group.wait();
+}
+
+} // namespace rphys
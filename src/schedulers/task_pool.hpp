@@ -1,7 +1,65 @@
 #ifndef RPHYS_SCHEDULERS_TASK_POOL_HPP
 #define RPHYS_SCHEDULERS_TASK_POOL_HPP
 
-namespace rphys { struct scheduler_task_pool; }
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
-#endif // RPHYS_SCHEDULERS_TASK_POOL_HPP
+namespace rphys {
+
+// Process-wide worker pools for data-parallel loops and task graphs (multi-world stepping,
+// frame graphs, solver batches). Two backends share one interface:
+//  - builtin: work-stealing pool, one deque per worker, idle workers steal the oldest task;
+//  - tbb:     forwards to oneTBB (only when built with HINAPE_HAVE_TBB).
+struct scheduler_task_pool;
+
+enum class task_backend : std::uint8_t { builtin, tbb };
+
+using task_fn       = void (*)(void* arg);
+using task_range_fn = void (*)(void* user, std::size_t begin, std::size_t end);
+
+scheduler_task_pool* default_task_pool();            // tbb when available, else builtin
+scheduler_task_pool* task_pool_for(task_backend);    // nullptr when the backend is not compiled in
+// Pool limited to `threads` threads including the caller (builtin: its own workers; tbb: its own
+// task_arena), shared by every caller asking for the same size. 0 returns task_pool_for(backend).
+scheduler_task_pool* task_pool_for(task_backend, std::size_t threads);
+task_backend task_pool_backend(const scheduler_task_pool*);
+std::size_t  task_pool_concurrency(const scheduler_task_pool*);
+
+// Join counter for tasks spawned onto a pool. run() may be called from inside tasks of the same
+// group (graph executors release successors that way); wait() helps execute queued work instead
+// of blocking, so waiting inside a pool task cannot deadlock.
+class task_group {
+public:
+    explicit task_group(scheduler_task_pool* pool);
+    ~task_group();
+    task_group(const task_group&)            = delete;
+    task_group& operator=(const task_group&) = delete;
+
+    void run(task_fn fn, void* arg);
+    void wait();
 
+    scheduler_task_pool* pool() const { return pool_; }
+
+private:
+    friend struct scheduler_task_pool;
+    scheduler_task_pool*     pool_{nullptr};
+    std::atomic<std::size_t> pending_{0};
+    void*                    backend_{nullptr}; // tbb::task_group for the tbb backend
+};
+
+// Splits [0, count) into chunks of at least `grain` items and runs them on the pool.
+// The calling thread participates; returns once every chunk has finished. Safe to nest.
+void task_pool_parallel_for(scheduler_task_pool*, std::size_t count, std::size_t grain, task_range_fn fn, void* user);
+
+template <class Fn>
+void parallel_for(scheduler_task_pool* pool, std::size_t count, std::size_t grain, Fn&& fn) {
+    using fn_type = std::remove_reference_t<Fn>;
+    void* user = const_cast<std::remove_const_t<fn_type>*>(&fn);
+    task_pool_parallel_for(pool, count, grain, [](void* u, std::size_t begin, std::size_t end) { (*static_cast<fn_type*>(u))(begin, end); }, user);
+}
+
+} // namespace rphys
+
+#endif // RPHYS_SCHEDULERS_TASK_POOL_HPP
@@ -1,3 +1,39 @@
 #include "csv_dump.hpp"
-// skeleton
+#include "core_base/telemetry_stream.hpp"
+#include <cstdio>
 
+namespace rphys {
+
+namespace {
+    std::size_t fitted(int n, std::size_t capacity) { return n > 0 && static_cast<std::size_t>(n) < capacity ? static_cast<std::size_t>(n) : 0; }
+
+    std::size_t csv_header(char* out, std::size_t capacity) {
+        return fitted(std::snprintf(out, capacity,
+                                    "record,world,frame,sim_time,frame_ms,scratch_bytes,scratch_heap_allocs,commands_applied,commands_rejected,"
+                                    "commands_dropped,events_pending,profile_events_dropped,stream_frames_dropped,"
+                                    "phase,owner,coupling,calls,phase_ms,iterations,residual,phase_scratch_allocs\n"),
+                      capacity);
+    }
+
+    std::size_t csv_record(char* out, std::size_t capacity, const telemetry_record& r) {
+        const frame_stats& f = r.frame;
+        if (r.type == telemetry_record::kind::frame) {
+            return fitted(std::snprintf(out, capacity, "frame,%u,%llu,%.9g,%.6f,%zu,%u,%u,%u,%llu,%u,%llu,%llu,,,,,,,,\n", r.world, static_cast<unsigned long long>(f.frame_index),
+                                        r.sim_time, f.frame_ms, f.scratch_bytes, f.scratch_heap_allocs, f.commands_applied, f.commands_rejected,
+                                        static_cast<unsigned long long>(f.commands_dropped), f.events_pending, static_cast<unsigned long long>(f.profile_events_dropped),
+                                        static_cast<unsigned long long>(f.stream_frames_dropped)),
+                          capacity);
+        }
+        // Phase names are identifiers (no commas or quotes), so they are written unquoted.
+        const phase_stats& p = r.phase;
+        return fitted(std::snprintf(out, capacity, "phase,%u,%llu,%.9g,,,,,,,,,,%s,%u,%d,%u,%.6f,%u,%.9g,%u\n", r.world, static_cast<unsigned long long>(f.frame_index), r.sim_time,
+                                    p.name ? p.name : "", p.owner, p.coupling ? 1 : 0, p.calls, p.ms, p.iterations, p.residual, p.scratch_allocs),
+                      capacity);
+    }
+
+    constexpr telemetry_format_ops k_csv{csv_header, csv_record};
+} // namespace
+
+const telemetry_format_ops& csv_stream_format() { return k_csv; }
+
+} // namespace rphys
@@ -1,7 +1,14 @@
 #ifndef RPHYS_TELEMETRY_EXPORT_CSV_DUMP_HPP
 #define RPHYS_TELEMETRY_EXPORT_CSV_DUMP_HPP
 
-namespace rphys { struct telemetry_csv_dump; }
+namespace rphys {
 
-#endif // RPHYS_TELEMETRY_EXPORT_CSV_DUMP_HPP
+struct telemetry_format_ops;
+
+// Stream format: a header row, then one row per frame (`record` = frame, phase columns empty) and
+// one per profiled phase (`record` = phase, repeating the frame index and sim time).
+const telemetry_format_ops& csv_stream_format();
 
+} // namespace rphys
+
+#endif // RPHYS_TELEMETRY_EXPORT_CSV_DUMP_HPP
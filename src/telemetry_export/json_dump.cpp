@@ -1,3 +1,109 @@
 #include "json_dump.hpp"
-// skeleton
+#include "core_base/telemetry_core.hpp"
+#include "core_base/telemetry_stream.hpp"
+#include <cstdio>
 
+namespace rphys {
+
+namespace {
+    const char* kind_category(profile_kind k) {
+        switch (k) {
+            case profile_kind::step: return "step";
+            case profile_kind::commands: return "commands";
+            case profile_kind::phase: return "phase";
+            case profile_kind::coupling: return "coupling";
+            default: return "scope";
+        }
+    }
+
+    // Names are identifiers and literals from the library, but escape anyway so a custom phase
+    // name cannot break the document.
+    void append_escaped(std::string& out, const char* s) {
+        for (; s && *s; ++s) {
+            const unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += static_cast<char>(c);
+            } else if (c < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            } else {
+                out += static_cast<char>(c);
+            }
+        }
+    }
+
+    void append_separator(std::string& out) {
+        if (out.back() != '[') out += ",\n";
+    }
+
+    std::size_t fitted(int n, std::size_t capacity) { return n > 0 && static_cast<std::size_t>(n) < capacity ? static_cast<std::size_t>(n) : 0; }
+
+    std::size_t jsonl_header(char*, std::size_t) { return 0; }
+
+    std::size_t jsonl_record(char* out, std::size_t capacity, const telemetry_record& r) {
+        const frame_stats& f = r.frame;
+        if (r.type == telemetry_record::kind::frame) {
+            return fitted(std::snprintf(out, capacity,
+                                        "{\"record\":\"frame\",\"world\":%u,\"frame\":%llu,\"sim_time\":%.9g,\"frame_ms\":%.6f,\"scratch_bytes\":%zu,\"scratch_heap_allocs\":%u,"
+                                        "\"commands_applied\":%u,\"commands_rejected\":%u,\"commands_dropped\":%llu,\"events_pending\":%u,"
+                                        "\"profile_events_dropped\":%llu,\"stream_frames_dropped\":%llu}\n",
+                                        r.world, static_cast<unsigned long long>(f.frame_index), r.sim_time, f.frame_ms, f.scratch_bytes, f.scratch_heap_allocs, f.commands_applied,
+                                        f.commands_rejected, static_cast<unsigned long long>(f.commands_dropped), f.events_pending,
+                                        static_cast<unsigned long long>(f.profile_events_dropped), static_cast<unsigned long long>(f.stream_frames_dropped)),
+                          capacity);
+        }
+        // Phase names are identifiers or module type names; none needs escaping.
+        const phase_stats& p = r.phase;
+        return fitted(std::snprintf(out, capacity,
+                                    "{\"record\":\"phase\",\"world\":%u,\"frame\":%llu,\"sim_time\":%.9g,\"phase\":\"%s\",\"owner\":%u,\"coupling\":%s,\"calls\":%u,"
+                                    "\"ms\":%.6f,\"iterations\":%u,\"residual\":%.9g,\"scratch_allocs\":%u}\n",
+                                    r.world, static_cast<unsigned long long>(f.frame_index), r.sim_time, p.name ? p.name : "", p.owner, p.coupling ? "true" : "false", p.calls,
+                                    p.ms, p.iterations, p.residual, p.scratch_allocs),
+                      capacity);
+    }
+
+    constexpr telemetry_format_ops k_json_lines{jsonl_header, jsonl_record};
+} // namespace
+
+void json_trace_begin(std::string& out) { out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["; }
+
+void json_trace_append(std::string& out, const world_profiler& p) {
+    const double        us_per_tick = profile_ns_per_tick() * 1e-3;
+    const std::uint64_t epoch       = profile_epoch_ticks();
+    char                buf[256];
+
+    append_separator(out);
+    std::snprintf(buf, sizeof(buf), "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%u,\"args\":{\"name\":\"world %u\"}}", p.world, p.world);
+    out += buf;
+    const std::uint32_t threads = p.thread_count.load(std::memory_order_relaxed);
+    for (std::uint32_t t = 0; t < threads; ++t) {
+        std::snprintf(buf, sizeof(buf), ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}", p.world, t, t);
+        out += buf;
+    }
+
+    profiler_for_each_event(p, [&](std::uint32_t thread, const profile_event& e) {
+        const double ts  = static_cast<double>(static_cast<std::int64_t>(e.begin - epoch)) * us_per_tick;
+        const double dur = static_cast<double>(e.end - e.begin) * us_per_tick;
+        out += ",\n{\"ph\":\"X\",\"name\":\"";
+        append_escaped(out, e.name);
+        std::snprintf(buf, sizeof(buf), "\",\"cat\":\"%s\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"owner\":%u", kind_category(e.kind), p.world, thread, ts, dur, e.owner);
+        out += buf;
+        if (e.iterations || e.residual != 0.0f) {
+            std::snprintf(buf, sizeof(buf), ",\"iterations\":%u,\"residual\":%.9g", e.iterations, static_cast<double>(e.residual));
+            out += buf;
+        }
+        if (e.scratch_allocs) {
+            std::snprintf(buf, sizeof(buf), ",\"scratch_allocs\":%u", e.scratch_allocs);
+            out += buf;
+        }
+        out += "}}";
+    });
+}
+
+void json_trace_end(std::string& out) { out += "]}\n"; }
+
+const telemetry_format_ops& json_lines_stream_format() { return k_json_lines; }
+
+} // namespace rphys
@@ -1,7 +1,24 @@
 #ifndef RPHYS_TELEMETRY_EXPORT_JSON_DUMP_HPP
 #define RPHYS_TELEMETRY_EXPORT_JSON_DUMP_HPP
 
-namespace rphys { struct telemetry_json_dump; }
+#include <string>
 
-#endif // RPHYS_TELEMETRY_EXPORT_JSON_DUMP_HPP
+namespace rphys {
+
+struct world_profiler;
+struct telemetry_format_ops;
+
+// Chrome trace event format (JSON object form): complete ("X") events with microsecond
+// timestamps relative to the profiler epoch, plus process / thread name metadata. A trace is
+// json_trace_begin, any number of json_trace_append (one process per world), json_trace_end.
+void json_trace_begin(std::string& out);
+void json_trace_append(std::string& out, const world_profiler&);
+void json_trace_end(std::string& out);
 
+// Stream format (JSON Lines): one object per frame ({"record":"frame",...}) followed by one per
+// profiled phase ({"record":"phase",...}); no header, so rotated files parse on their own.
+const telemetry_format_ops& json_lines_stream_format();
+
+} // namespace rphys
+
+#endif // RPHYS_TELEMETRY_EXPORT_JSON_DUMP_HPP
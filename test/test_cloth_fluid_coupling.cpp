@@ -0,0 +1,174 @@
+#include <catch2/catch_test_macros.hpp>
+#include "test_support.hpp"
+#include "coupling_modules/cloth_fluid_exchange_contract.hpp"
+#include "domain_fluid/shared/neighbor_search.hpp"
+#include "rphys/api_commands.h"
+#include "rphys/api_coupling.h"
+#include "rphys/api_domain.h"
+#include "rphys/api_params.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+    struct scene {
+        rphys::world_id  world{};
+        rphys::domain_id cloth{}, fluid{};
+    };
+
+    // The shared test sheet at 100 kg with its top row pinned, and an 8 x 8 x 4 block of particles
+    // (spacing 0.05, h = 0.1) in front of it moving towards it at 1 m/s.
+    scene make_scene(rphys::scheduler_kind scheduler, rphys::determinism_level level) {
+        scene s;
+        rphys::world_desc wd{};
+        wd.scheduler   = scheduler;
+        wd.determinism = level;
+        s.world = rphys::create_world(wd);
+        rphys::set_param(s.world, "gravity.y", 0.0);
+        s.cloth = rphys::add_domain(s.world, rphys::domain_desc{0, "cloth"});
+        s.fluid = rphys::add_domain(s.world, rphys::domain_desc{0, "fluid"});
+        rphys::scene_primitive sheet = rphys_test::cloth_sheet(24, rphys::scene_pin_top_row);
+        sheet.mass = 100.0f;
+        rphys::build_scene(s.world, s.cloth, {sheet});
+        rphys::scene_primitive block{};
+        block.type = rphys::scene_primitive_type::particle_box;
+        block.origin[0] = 0.3f;
+        block.origin[1] = 1.2f;
+        block.origin[2] = 0.1f;
+        block.extent[0] = block.extent[1] = 0.4f;
+        block.extent[2] = 0.2f;
+        block.resolution[0] = block.resolution[1] = 8;
+        block.resolution[2] = 4;
+        rphys::build_scene(s.world, s.fluid, {block});
+        const float particle_mass = 1000.0f * 0.05f * 0.05f * 0.05f;
+        for (std::uint32_t i = 0; i < 8 * 8 * 4; ++i) {
+            rphys::command_desc push{};
+            push.kind     = rphys::command_kind::impulse;
+            push.domain   = s.fluid;
+            push.index    = i;
+            push.value[2] = -particle_mass;
+            rphys::enqueue_command(s.world, push);
+        }
+        return s;
+    }
+
+    std::vector<rphys::vec3f> read_vec3(const scene& s, rphys::domain_id d, const char* name) { return rphys_test::read_vec3(s.world, d, name); }
+
+    struct outcome {
+        std::size_t crossed{0}; // particles behind the sheet
+        float       cloth_z{0.0f};
+        float       fluid_vz{0.0f}; // mean
+    };
+
+    outcome run(const char* coupling, int frames = 60) {
+        scene s = make_scene(rphys::scheduler_kind::serial, rphys::determinism_level::fast);
+        if (coupling) REQUIRE(rphys::register_coupling(s.world, rphys::coupling_desc{0, coupling, s.cloth, s.fluid}).value != 0);
+        for (int f = 0; f < frames; ++f) rphys::step_world(s.world, 1.0 / 60.0);
+        outcome o;
+        const auto cloth = read_vec3(s, s.cloth, "cloth.position");
+        for (const auto& p : cloth) o.cloth_z = std::min(o.cloth_z, p.z);
+        for (const auto& p : read_vec3(s, s.fluid, "fluid.position")) {
+            // Compare against the sheet vertex nearest in the plane of the sheet.
+            const auto nearest = std::min_element(cloth.begin(), cloth.end(), [&](const rphys::vec3f& a, const rphys::vec3f& b) {
+                return (a.x - p.x) * (a.x - p.x) + (a.y - p.y) * (a.y - p.y) < (b.x - p.x) * (b.x - p.x) + (b.y - p.y) * (b.y - p.y);
+            });
+            o.crossed += p.z < nearest->z - 0.02f ? 1 : 0;
+        }
+        const auto v = read_vec3(s, s.fluid, "fluid.velocity");
+        for (const auto& u : v) o.fluid_vz += u.z / static_cast<float>(v.size());
+        rphys::destroy_world(s.world);
+        return o;
+    }
+} // namespace
+
+TEST_CASE("binned contacts match a brute force closest-triangle search", "[cloth_fluid]") {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(-1.0f, 1.0f), jitter(-0.05f, 0.05f);
+    // A crumpled 16 x 16 sheet and particles scattered around it.
+    std::vector<rphys::vec3f>  cloth;
+    std::vector<std::uint32_t> triangles;
+    for (std::uint32_t j = 0; j < 16; ++j)
+        for (std::uint32_t i = 0; i < 16; ++i) cloth.push_back(rphys::vec3f{-0.8f + 0.1f * i + jitter(rng), -0.8f + 0.1f * j + jitter(rng), 0.2f * std::sin(0.7f * i) + jitter(rng)});
+    for (std::uint32_t j = 0; j + 1 < 16; ++j)
+        for (std::uint32_t i = 0; i + 1 < 16; ++i) {
+            const std::uint32_t a = j * 16 + i;
+            triangles.insert(triangles.end(), {a, a + 1, a + 16, a + 1, a + 17, a + 16});
+        }
+    std::vector<rphys::vec3f> particles(4000);
+    for (auto& p : particles) p = rphys::vec3f{coord(rng), coord(rng), 0.4f * coord(rng)};
+
+    const float                  h = 0.08f;
+    rphys::fluid_neighbor_search grid;
+    const rphys::step_context    ctx{};
+    rphys::neighbor_search_build(grid, particles, h, ctx);
+    rphys::cloth_fluid_exchange e;
+    rphys::cloth_fluid_find_contacts(e, cloth.data(), triangles.data(), triangles.size() / 3, particles.data(), grid.particle_bucket.data(), particles.size(),
+                                     grid.bucket_mask + 1, h, ctx);
+    REQUIRE(e.hits.size() == particles.size());
+
+    std::size_t touching = 0;
+    for (std::size_t i = 0; i < particles.size(); ++i) {
+        // Brute force: densely sampled distance to every triangle.
+        float best = 1e30f;
+        for (std::size_t t = 0; t < triangles.size() / 3; ++t) {
+            const rphys::vec3f a = cloth[triangles[3 * t]], b = cloth[triangles[3 * t + 1]], c = cloth[triangles[3 * t + 2]];
+            for (int u = 0; u <= 40; ++u)
+                for (int v = 0; u + v <= 40; ++v) {
+                    const rphys::vec3f q = a * (1.0f - (u + v) / 40.0f) + b * (u / 40.0f) + c * (v / 40.0f);
+                    best = std::min(best, rphys::length(particles[i] - q));
+                }
+        }
+        const rphys::cloth_fluid_hit& hit = e.hits[i];
+        if (best < h - 0.005f) {
+            REQUIRE(hit.triangle != rphys::cloth_fluid_no_triangle);
+            ++touching;
+        }
+        if (hit.triangle == rphys::cloth_fluid_no_triangle) continue;
+        CHECK(hit.distance < h);
+        CHECK(hit.distance <= best + 1e-5f);
+        CHECK(best - hit.distance < 0.005f); // sampling resolution
+        const std::uint32_t* t = &triangles[3 * hit.triangle];
+        const rphys::vec3f   q = cloth[t[0]] * hit.bary.x + cloth[t[1]] * hit.bary.y + cloth[t[2]] * hit.bary.z;
+        CHECK(rphys::length(q + hit.normal * hit.distance - particles[i]) < 1e-4f);
+    }
+    CHECK(touching > 200);
+}
+
+TEST_CASE("pressure coupling stops the fluid at the sheet and pushes the sheet back", "[cloth_fluid]") {
+    const outcome free_flow = run(nullptr);
+    const outcome coupled   = run("cloth_fluid_two_way_pressure");
+    CHECK(free_flow.crossed > 200);        // without the coupling the block passes straight through
+    CHECK(free_flow.cloth_z == 0.0f);
+    CHECK(coupled.crossed < 8);            // at most a few percent leak through
+    CHECK(coupled.cloth_z < -0.1f);        // the sheet bulges away from the fluid
+    CHECK(coupled.fluid_vz > -0.5f);
+}
+
+TEST_CASE("drag slows the fluid and drags the sheet along", "[cloth_fluid]") {
+    const outcome free_flow = run(nullptr, 30);
+    const outcome dragged   = run("cloth_fluid_simple_drag", 30);
+    CHECK(free_flow.fluid_vz < -0.99f);
+    CHECK(dragged.fluid_vz > free_flow.fluid_vz + 0.3f);
+    CHECK(dragged.cloth_z < -0.05f);
+}
+
+TEST_CASE("exchange is reproducible across schedulers", "[cloth_fluid]") {
+    auto positions = [](rphys::scheduler_kind scheduler) {
+        scene s = make_scene(scheduler, rphys::determinism_level::bit_stable);
+        REQUIRE(rphys::register_coupling(s.world, rphys::coupling_desc{0, "cloth_fluid_two_way_pressure", s.cloth, s.fluid}).value != 0);
+        REQUIRE(rphys::register_coupling(s.world, rphys::coupling_desc{0, "cloth_fluid_simple_drag", s.fluid, s.cloth}).value == 0);
+        for (int f = 0; f < 20; ++f) rphys::step_world(s.world, 1.0 / 60.0);
+        auto out = read_vec3(s, s.cloth, "cloth.position");
+        const auto fluid = read_vec3(s, s.fluid, "fluid.position");
+        out.insert(out.end(), fluid.begin(), fluid.end());
+        rphys::destroy_world(s.world);
+        return out;
+    };
+    const auto a = positions(rphys::scheduler_kind::serial);
+    const auto b = positions(rphys::scheduler_kind::work_stealing);
+    REQUIRE(a.size() == b.size());
+    CHECK(rphys_test::same_bits(a, b));
+}
@@ -0,0 +1,172 @@
+#include <catch2/catch_test_macros.hpp>
+#include "test_support.hpp"
+#include "core_base/shared_asset.hpp"
+#include "coupling_modules/cloth_rigid_contact_contract.hpp"
+#include "rphys/api_commands.h"
+#include "rphys/api_coupling.h"
+#include "rphys/api_domain.h"
+#include "rphys/api_params.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+    struct scene {
+        rphys::world_id  world{};
+        rphys::domain_id cloth{}, rigid{};
+    };
+
+    // The shared test sheet and one sphere per centre.
+    scene make_scene(std::uint32_t flags, std::initializer_list<rphys::vec3f> spheres, float radius, bool pin_spheres) {
+        scene s;
+        rphys::world_desc wd{};
+        wd.scheduler = rphys::scheduler_kind::serial;
+        s.world = rphys::create_world(wd);
+        s.cloth = rphys::add_domain(s.world, rphys::domain_desc{0, "cloth"});
+        s.rigid = rphys::add_domain(s.world, rphys::domain_desc{0, "rigid"});
+        rphys::build_scene(s.world, s.cloth, {rphys_test::cloth_sheet(24, flags)});
+        rphys::scene_primitive_list bodies;
+        for (const auto& c : spheres) {
+            rphys::scene_primitive b{};
+            b.type = rphys::scene_primitive_type::rigid_sphere;
+            b.origin[0] = c.x;
+            b.origin[1] = c.y;
+            b.origin[2] = c.z;
+            b.extent[0] = radius;
+            bodies.push_back(b);
+        }
+        rphys::build_scene(s.world, s.rigid, bodies);
+        for (std::uint32_t i = 0; pin_spheres && i < bodies.size(); ++i) {
+            rphys::command_desc pin{};
+            pin.kind   = rphys::command_kind::pin;
+            pin.domain = s.rigid;
+            pin.index  = i;
+            rphys::enqueue_command(s.world, pin);
+        }
+        return s;
+    }
+
+    std::vector<rphys::vec3f> read_vec3(const scene& s, rphys::domain_id d, const char* name) { return rphys_test::read_vec3(s.world, d, name); }
+
+    float deepest(const std::vector<rphys::vec3f>& x, rphys::vec3f center, float radius) {
+        float d = 1e30f;
+        for (const auto& p : x) d = std::min(d, rphys::length(p - center) - radius);
+        return d;
+    }
+} // namespace
+
+TEST_CASE("shape distances and normals are exact", "[cloth_rigid]") {
+    const rphys::vec3f half{0.3f, 0.2f, 0.5f};
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coord(-0.8f, 0.8f);
+    for (int i = 0; i < 2000; ++i) {
+        const rphys::vec3f p{coord(rng), coord(rng), coord(rng)};
+        rphys::vec3f       normal;
+        CHECK(rphys::rigid_shape_distance(0, rphys::vec3f{0.3f, 9.0f, 9.0f}, p, normal) == rphys::length(p) - 0.3f); // radius only
+        CHECK(std::abs(rphys::length(normal) - 1.0f) < 1e-5f);
+        const rphys::vec3f q{std::abs(p.x) - half.x, std::abs(p.y) - half.y, std::abs(p.z) - half.z};
+        const rphys::vec3f outside{std::max(q.x, 0.0f), std::max(q.y, 0.0f), std::max(q.z, 0.0f)};
+        const float        exact = rphys::length(outside) + std::min(std::max(q.x, std::max(q.y, q.z)), 0.0f);
+        const float        d     = rphys::rigid_shape_distance(1, half, p, normal);
+        CHECK(std::abs(d - exact) < 1e-6f);
+        CHECK(std::abs(rphys::length(normal) - 1.0f) < 1e-5f);
+        // Moving along the normal moves away from the surface at unit rate (outside, and inside
+        // while the nearest face stays the nearest).
+        const float step = 1e-3f;
+        rphys::vec3f unused;
+        CHECK(std::abs(rphys::rigid_shape_distance(1, half, p + normal * step, unused) - (d + step)) < 1e-4f);
+    }
+    rphys::vec3f normal;
+    CHECK(std::abs(rphys::rigid_shape_distance(1, half, rphys::vec3f{0.0f, -0.15f, 0.0f}, normal) + 0.05f) < 1e-6f);
+    CHECK(normal.y == -1.0f);
+}
+
+TEST_CASE("hierarchy queries return exactly the overlapping bodies", "[cloth_rigid]") {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coord(-10.0f, 10.0f), size(0.1f, 1.5f);
+    std::vector<rphys::vec3f> lo(500), hi(500);
+    for (std::size_t i = 0; i < lo.size(); ++i) {
+        lo[i] = rphys::vec3f{coord(rng), coord(rng), coord(rng)};
+        hi[i] = lo[i] + rphys::vec3f{size(rng), size(rng), size(rng)};
+    }
+    rphys::body_bvh bvh;
+    rphys::body_bvh_build(bvh, lo.data(), hi.data(), lo.size());
+    for (int q = 0; q < 200; ++q) {
+        const rphys::vec3f qlo{coord(rng), coord(rng), coord(rng)};
+        const rphys::vec3f qhi = qlo + rphys::vec3f{2.0f, 2.0f, 2.0f};
+        std::vector<std::uint32_t> found, expected;
+        rphys::body_bvh_query(bvh, qlo, qhi, found);
+        for (std::uint32_t i = 0; i < lo.size(); ++i) {
+            if (lo[i].x <= qhi.x && qlo.x <= hi[i].x && lo[i].y <= qhi.y && qlo.y <= hi[i].y && lo[i].z <= qhi.z && qlo.z <= hi[i].z) expected.push_back(i);
+        }
+        std::sort(found.begin(), found.end());
+        CHECK(found == expected);
+    }
+}
+
+TEST_CASE("projection keeps falling cloth outside a fixed sphere", "[cloth_rigid]") {
+    const rphys::vec3f center{0.5f, 0.4f, 0.0f};
+    const float        radius = 0.3f, thickness = 0.01f;
+    scene free_fall = make_scene(0, {center}, radius, true);
+    scene draped    = make_scene(0, {center}, radius, true);
+    const rphys::coupling_id id = rphys::register_coupling(draped.world, rphys::coupling_desc{0, "cloth_rigid_projection", draped.cloth, draped.rigid});
+    REQUIRE(id.value != 0);
+    REQUIRE(rphys::register_coupling(draped.world, rphys::coupling_desc{0, "cloth_rigid_projection", draped.rigid, draped.cloth}).value == 0);
+    // The sheet wraps the sphere edge-on and its vertices travel up to ~6.5 cm per solve, so the
+    // contact margin has to cover that travel.
+    rphys::set_param(draped.world, "cloth_rigid.margin", 0.08);
+
+    float free_min = 1e30f, draped_min = 1e30f;
+    for (int f = 0; f < 90; ++f) {
+        rphys::step_world(free_fall.world, 1.0 / 60.0);
+        rphys::step_world(draped.world, 1.0 / 60.0);
+        free_min   = std::min(free_min, deepest(read_vec3(free_fall, free_fall.cloth, "cloth.position"), center, radius));
+        draped_min = std::min(draped_min, deepest(read_vec3(draped, draped.cloth, "cloth.position"), center, radius));
+    }
+    CHECK(free_min < -0.1f);                 // without the coupling the sheet falls straight through
+    CHECK(draped_min > thickness - 0.005f); // planes are linearised, so allow a little sliding
+    const auto x = read_vec3(draped, draped.cloth, "cloth.position");
+    CHECK(std::all_of(x.begin(), x.end(), [](const rphys::vec3f& p) { return std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z); }));
+
+    for (auto w : {free_fall.world, draped.world}) rphys::destroy_world(w);
+}
+
+TEST_CASE("contact queries need no per-shape assets", "[cloth_rigid]") {
+    const std::size_t before = rphys::shared_asset_count();
+    scene a = make_scene(rphys::scene_pin_top_row, {{0.2f, 0.5f, 0.0f}, {0.5f, 0.5f, 0.0f}, {0.8f, 0.5f, 0.0f}}, 0.123f, true);
+    scene b = make_scene(rphys::scene_pin_top_row, {{0.5f, 0.5f, 0.0f}}, 0.123f, true);
+    for (const scene* s : {&a, &b}) {
+        REQUIRE(rphys::register_coupling(s->world, rphys::coupling_desc{0, "cloth_rigid_projection", s->cloth, s->rigid}).value != 0);
+        rphys::step_world(s->world, 1.0 / 60.0);
+    }
+    CHECK(rphys::shared_asset_count() == before); // distances are analytic, nothing is cached
+    for (auto w : {a.world, b.world}) rphys::destroy_world(w);
+}
+
+TEST_CASE("penalty contact pushes back on the body, projection does not", "[cloth_rigid]") {
+    auto run = [](const char* type) {
+        scene s = make_scene(rphys::scene_pin_top_row, {{0.5f, 1.5f, 0.5f}}, 0.2f, false);
+        rphys::set_param(s.world, "gravity.y", 0.0);
+        rphys::command_desc push{};
+        push.kind     = rphys::command_kind::impulse;
+        push.domain   = s.rigid;
+        push.value[2] = -2.0;
+        rphys::enqueue_command(s.world, push);
+        REQUIRE(rphys::register_coupling(s.world, rphys::coupling_desc{0, type, s.cloth, s.rigid}).value != 0);
+        for (int f = 0; f < 30; ++f) rphys::step_world(s.world, 1.0 / 60.0);
+        const float vz = read_vec3(s, s.rigid, "rigid.linear_velocity")[0].z;
+        float       pushed = 0.0f;
+        for (const auto& p : read_vec3(s, s.cloth, "cloth.position")) pushed = std::min(pushed, p.z);
+        rphys::destroy_world(s.world);
+        return std::make_pair(vz, pushed);
+    };
+    const auto [penalty_v, penalty_z]       = run("cloth_rigid_penalty");
+    const auto [projection_v, projection_z] = run("cloth_rigid_projection");
+    CHECK(penalty_v > -1.9f);
+    CHECK(penalty_z < -0.05f);
+    CHECK(projection_v == -2.0f);
+    CHECK(projection_z < -0.05f);
+}
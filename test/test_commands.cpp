@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "rphys/api_commands.h"
+#include "rphys/api_events.h"
+#include "rphys/api_params.h"
+#include "rphys/api_telemetry.h"
+#include "rphys/api_world.h"
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace {
+    rphys::command_desc param_command(const char* name, double value) {
+        rphys::command_desc c{};
+        c.name     = name;
+        c.kind     = rphys::command_kind::set_param;
+        c.value[0] = value;
+        return c;
+    }
+} // namespace
+
+TEST_CASE("commands_apply_at_next_step", "[commands]") {
+    auto wid = rphys::create_world(rphys::world_desc{});
+    REQUIRE(rphys::enqueue_command(wid, param_command("solver.iterations", 8.0)));
+    REQUIRE(rphys::enqueue_command(wid, param_command("solver.iterations", 12.0)));
+    REQUIRE(rphys::get_param(wid, "solver.iterations", -1.0) == Catch::Approx(-1.0));
+
+    rphys::step_world(wid, 0.01);
+    REQUIRE(rphys::get_param(wid, "solver.iterations") == Catch::Approx(12.0)); // applied in enqueue order
+    REQUIRE(rphys::get_last_frame_stats(wid)->commands_applied == 2);
+
+    // Domain commands without a registered target are rejected, not fatal
+    rphys::command_desc pin{};
+    pin.kind   = rphys::command_kind::pin;
+    pin.domain = rphys::domain_id{42};
+    REQUIRE(rphys::enqueue_command(wid, pin));
+    rphys::step_world(wid, 0.01);
+    REQUIRE(rphys::get_last_frame_stats(wid)->commands_rejected == 1);
+
+    REQUIRE_FALSE(rphys::enqueue_command(rphys::world_id{0}, param_command("x", 1.0)));
+    REQUIRE_FALSE(rphys::enqueue_command(wid, param_command("a_name_that_is_far_too_long_for_the_fixed_size_command_record", 1.0)));
+    rphys::destroy_world(wid);
+}
+
+TEST_CASE("events_fire_at_sim_time", "[commands][events]") {
+    auto wid = rphys::create_world(rphys::world_desc{});
+    rphys::event_desc late{param_command("gravity", 2.0), 0.035};
+    rphys::event_desc early{param_command("gravity", 1.0), 0.015};
+    REQUIRE(rphys::schedule_event(wid, late));
+    REQUIRE(rphys::schedule_event(wid, early));
+
+    rphys::step_world(wid, 0.01); // [0, 0.01)
+    REQUIRE(rphys::get_param(wid, "gravity", 0.0) == Catch::Approx(0.0));
+    REQUIRE(rphys::get_last_frame_stats(wid)->events_pending == 2);
+    rphys::step_world(wid, 0.01); // reaches 0.02
+    REQUIRE(rphys::get_param(wid, "gravity", 0.0) == Catch::Approx(1.0));
+    rphys::step_world(wid, 0.01);
+    REQUIRE(rphys::get_param(wid, "gravity", 0.0) == Catch::Approx(1.0));
+    rphys::step_world(wid, 0.01); // reaches 0.04
+    REQUIRE(rphys::get_param(wid, "gravity", 0.0) == Catch::Approx(2.0));
+    REQUIRE(rphys::get_last_frame_stats(wid)->events_pending == 0);
+    rphys::destroy_world(wid);
+}
+
+TEST_CASE("command_queue_bounded_and_multi_producer", "[commands]") {
+    rphys::world_desc desc{};
+    desc.command_capacity = 64;
+    auto wid = rphys::create_world(desc);
+
+    int accepted = 0;
+    for (int i = 0; i < 100; ++i) accepted += rphys::enqueue_command(wid, param_command("k", i)) ? 1 : 0;
+    REQUIRE(accepted == 64);
+    rphys::step_world(wid, 0.01);
+    REQUIRE(rphys::get_last_frame_stats(wid)->commands_applied == 64);
+    REQUIRE(rphys::get_last_frame_stats(wid)->commands_dropped == 36);
+
+    // Several producers racing a stepping thread: every accepted command is applied exactly once
+    std::vector<std::thread> producers;
+    std::atomic<int> pushed{0};
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([&] {
+            for (int i = 0; i < 2000; ++i) {
+                if (rphys::enqueue_command(wid, param_command("k", i))) pushed.fetch_add(1);
+            }
+        });
+    }
+    std::uint64_t applied = 0;
+    for (int f = 0; f < 200; ++f) {
+        rphys::step_world(wid, 0.001);
+        applied += rphys::get_last_frame_stats(wid)->commands_applied;
+    }
+    for (auto& p : producers) p.join();
+    rphys::step_world(wid, 0.001);
+    applied += rphys::get_last_frame_stats(wid)->commands_applied;
+    REQUIRE(applied == static_cast<std::uint64_t>(pushed.load()));
+    rphys::destroy_world(wid);
+}
+
+TEST_CASE("pending_events_bounded_by_queue_capacity", "[commands][events]") {
+    rphys::world_desc desc{};
+    desc.command_capacity = 64;
+    auto wid = rphys::create_world(desc);
+
+    // Far-future events fill the wait list; those drained into a full list are dropped and counted
+    for (int i = 0; i < 64; ++i) REQUIRE(rphys::schedule_event(wid, rphys::event_desc{param_command("k", i), 10.0 + i}));
+    rphys::step_world(wid, 0.01);
+    REQUIRE(rphys::get_last_frame_stats(wid)->events_pending == 64);
+    for (int i = 0; i < 10; ++i) REQUIRE(rphys::schedule_event(wid, rphys::event_desc{param_command("k", -i), 5.0}));
+    rphys::step_world(wid, 0.01);
+    REQUIRE(rphys::get_last_frame_stats(wid)->events_pending == 64);
+    REQUIRE(rphys::get_last_frame_stats(wid)->commands_dropped == 10);
+
+    // Immediate commands still pass while the wait list is full
+    REQUIRE(rphys::enqueue_command(wid, param_command("k", 1.0)));
+    rphys::step_world(wid, 0.01);
+    REQUIRE(rphys::get_last_frame_stats(wid)->commands_applied == 1);
+    REQUIRE(rphys::get_param(wid, "k", 0.0) == Catch::Approx(1.0));
+    rphys::destroy_world(wid);
+}
+
+TEST_CASE("events_with_non_finite_time_rejected", "[commands][events]") {
+    auto wid = rphys::create_world(rphys::world_desc{});
+    const double bad[] = {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    for (double t : bad) REQUIRE_FALSE(rphys::schedule_event(wid, rphys::event_desc{param_command("gravity", 1.0), t}));
+    REQUIRE(rphys::schedule_event(wid, rphys::event_desc{param_command("gravity", 2.0), 0.005}));
+
+    rphys::step_world(wid, 0.01);
+    REQUIRE(rphys::get_param(wid, "gravity", 0.0) == Catch::Approx(2.0));
+    REQUIRE(rphys::get_last_frame_stats(wid)->commands_applied == 1);
+    REQUIRE(rphys::get_last_frame_stats(wid)->commands_dropped == 0);
+    REQUIRE(rphys::get_last_frame_stats(wid)->events_pending == 0);
+    rphys::destroy_world(wid);
+}
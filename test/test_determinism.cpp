@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core_base/domain_core.hpp"
+#include "schedulers/job_system.hpp"
+#include "rphys/api_domain.h"
+#include "rphys/api_fields.h"
+#include "rphys/api_params.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+    struct snapshot {
+        std::vector<unsigned char> cloth, fluid, rigid;
+        bool operator==(const snapshot&) const = default;
+    };
+
+    std::vector<unsigned char> field_bytes(rphys::world_id w, rphys::domain_id d, const char* name) {
+        rphys::field_view v{};
+        if (!rphys::get_field(w, d, name, v)) return {};
+        std::vector<unsigned char> out(v.count * v.stride);
+        std::memcpy(out.data(), v.data, out.size());
+        return out;
+    }
+
+    // Enough bodies / particles that every parallel phase splits into several chunks.
+    snapshot run(rphys::scheduler_kind scheduler, rphys::determinism_level level, int steps, std::uint32_t threads = 0) {
+        rphys::world_desc wd{};
+        wd.scheduler   = scheduler;
+        wd.determinism = level;
+        wd.threads     = threads;
+        auto w = rphys::create_world(wd);
+        rphys::set_param(w, "cloth.damping", 0.5);
+
+        auto cloth = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+        rphys::scene_primitive grid{};
+        grid.type = rphys::scene_primitive_type::cloth_grid;
+        grid.origin[1] = 1.0f;
+        grid.resolution[0] = grid.resolution[1] = 48;
+        grid.flags = rphys::scene_pin_top_corners;
+        REQUIRE(rphys::build_scene(w, cloth, {grid}));
+
+        auto fluid = rphys::add_domain(w, rphys::domain_desc{0, "fluid"});
+        rphys::scene_primitive box{};
+        box.type = rphys::scene_primitive_type::particle_box;
+        box.origin[0] = 3.0f;
+        box.extent[0] = box.extent[1] = box.extent[2] = 0.5f;
+        box.resolution[0] = box.resolution[1] = box.resolution[2] = 16;
+        rphys::scene_primitive bounds{};
+        bounds.type = rphys::scene_primitive_type::fluid_bounds;
+        bounds.origin[0] = 3.0f;
+        bounds.extent[0] = bounds.extent[1] = bounds.extent[2] = 1.0f;
+        REQUIRE(rphys::build_scene(w, fluid, {box, bounds}));
+
+        auto rigid = rphys::add_domain(w, rphys::domain_desc{0, "rigid"});
+        rphys::scene_primitive balls{};
+        balls.type = rphys::scene_primitive_type::rigid_sphere;
+        balls.origin[0] = -3.0f;
+        balls.origin[1] = 0.2f;
+        balls.extent[0] = 0.1f;
+        balls.resolution[0] = balls.resolution[1] = balls.resolution[2] = 6;
+        REQUIRE(rphys::build_scene(w, rigid, {balls}));
+
+        for (int i = 0; i < steps; ++i) rphys::step_world(w, 1.0 / 600.0);
+        snapshot s{field_bytes(w, cloth, "cloth.position"), field_bytes(w, fluid, "fluid.position"), field_bytes(w, rigid, "rigid.position")};
+        rphys::destroy_world(w);
+        return s;
+    }
+} // namespace
+
+TEST_CASE("bit_stable_matches_across_thread_counts", "[determinism]") {
+    // The serial scheduler runs every loop on one thread; the graph schedulers use the whole pool.
+    const snapshot reference = run(rphys::scheduler_kind::serial, rphys::determinism_level::bit_stable, 40);
+    REQUIRE_FALSE(reference.cloth.empty());
+    REQUIRE(run(rphys::scheduler_kind::work_stealing, rphys::determinism_level::bit_stable, 40) == reference);
+    REQUIRE(run(rphys::scheduler_kind::automatic, rphys::determinism_level::bit_stable, 40) == reference);
+}
+
+TEST_CASE("bit_stable_matches_for_explicit_thread_counts", "[determinism]") {
+    const snapshot reference = run(rphys::scheduler_kind::serial, rphys::determinism_level::bit_stable, 20);
+    for (std::uint32_t threads : {1u, 2u, 3u}) {
+        REQUIRE(run(rphys::scheduler_kind::work_stealing, rphys::determinism_level::bit_stable, 20, threads) == reference);
+        REQUIRE(run(rphys::scheduler_kind::automatic, rphys::determinism_level::bit_stable, 20, threads) == reference);
+    }
+}
+
+TEST_CASE("bit_stable_repeats_across_runs", "[determinism]") {
+    const snapshot a = run(rphys::scheduler_kind::automatic, rphys::determinism_level::bit_stable, 40);
+    const snapshot b = run(rphys::scheduler_kind::automatic, rphys::determinism_level::bit_stable, 40);
+    REQUIRE(a == b);
+}
+
+TEST_CASE("task_stable_matches_across_thread_counts", "[determinism]") {
+    const snapshot reference = run(rphys::scheduler_kind::serial, rphys::determinism_level::task_stable, 20);
+    REQUIRE_FALSE(reference.cloth.empty());
+    for (std::uint32_t threads : {0u, 2u, 3u}) {
+        REQUIRE(run(rphys::scheduler_kind::work_stealing, rphys::determinism_level::task_stable, 20, threads) == reference);
+        REQUIRE(run(rphys::scheduler_kind::automatic, rphys::determinism_level::task_stable, 20, threads) == reference);
+    }
+}
+
+TEST_CASE("task_stable_reductions_ignore_thread_count", "[determinism]") {
+    // A float sum is order sensitive, so any completion-order merge shows up in the bits.
+    std::vector<float> values(100000);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = 1.0f / static_cast<float>(i + 1) * (i % 3 == 0 ? -1.0f : 1.0f);
+    auto sum = [&](const rphys::step_context& ctx) {
+        return rphys::parallel_reduce(ctx, values.size(), 64, 0.0f, [&](std::size_t begin, std::size_t end) {
+            float s = 0.0f;
+            for (std::size_t i = begin; i < end; ++i) s += values[i];
+            return s;
+        }, [](float a, float b) { return a + b; });
+    };
+    rphys::step_context serial{};
+    serial.determinism = rphys::determinism_level::task_stable;
+    const float reference = sum(serial);
+
+    rphys::world_scheduler pool = rphys::make_job_system_scheduler(rphys::task_backend::builtin, 4);
+    REQUIRE(pool.self);
+    rphys::step_context parallel = serial;
+    parallel.exec = pool.exec;
+    for (int run = 0; run < 20; ++run) {
+        const float s = sum(parallel);
+        REQUIRE(std::memcmp(&s, &reference, sizeof(float)) == 0);
+    }
+    pool.destroy(pool.self);
+}
+
+TEST_CASE("fast_mode_still_steps", "[determinism]") {
+    const snapshot s = run(rphys::scheduler_kind::automatic, rphys::determinism_level::fast, 5);
+    REQUIRE(s.cloth.size() == 48u * 48u * 12u);
+    REQUIRE(s.rigid.size() == 216u * 12u);
+}
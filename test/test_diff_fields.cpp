@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+#include "algo_sandbox/diff_fields.hpp"
+#include "rphys/api_domain.h"
+#include "rphys/api_params.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+    const rphys::simd_level k_levels[] = {rphys::simd_level::scalar, rphys::simd_level::sse42, rphys::simd_level::avx2, rphys::simd_level::avx512};
+
+    // Random values with a sprinkling of the cases the kernels branch on: signed zeros, denormals,
+    // infinities, NaNs and exact matches.
+    void make_inputs(std::size_t n, std::uint32_t seed, std::vector<float>& a, std::vector<float>& b) {
+        std::mt19937                          rng(seed);
+        std::uniform_real_distribution<float> value(-4.0f, 4.0f);
+        std::uniform_int_distribution<int>    kind(0, 15);
+        const float specials[] = {0.0f, -0.0f, std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::infinity(),
+                                  -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(), 1e38f, -1e38f};
+        a.resize(n);
+        b.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = value(rng);
+            switch (kind(rng)) {
+                case 0: b[i] = specials[rng() % std::size(specials)]; break;
+                case 1: a[i] = specials[rng() % std::size(specials)]; b[i] = specials[rng() % std::size(specials)]; break;
+                case 2: b[i] = std::nextafter(a[i], 10.0f); break;
+                case 3: b[i] = a[i] * (1.0f + 1e-4f); break;
+                default: b[i] = a[i]; break;
+            }
+        }
+    }
+
+    rphys::world_id cloth_world(double compliance) {
+        rphys::world_desc wd{};
+        wd.scheduler = rphys::scheduler_kind::serial;
+        const rphys::world_id  w = rphys::create_world(wd);
+        const rphys::domain_id d = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+        rphys::scene_primitive grid{};
+        grid.type = rphys::scene_primitive_type::cloth_grid;
+        grid.resolution[0] = grid.resolution[1] = 32;
+        grid.flags = rphys::scene_pin_top_corners;
+        rphys::build_scene(w, d, {grid});
+        rphys::set_param(w, "cloth.compliance", compliance);
+        return w;
+    }
+} // namespace
+
+TEST_CASE("every SIMD level reports exactly what the scalar kernel reports", "[diff_fields]") {
+    const rphys::diff_tolerance policies[] = {
+        {rphys::diff_policy::exact, 0.0f, 0.0f, 0, false},
+        {rphys::diff_policy::absolute, 1e-3f, 0.0f, 0, false},
+        {rphys::diff_policy::relative, 0.0f, 1e-3f, 0, false},
+        {rphys::diff_policy::ulp, 0.0f, 0.0f, 4, false},
+        {rphys::diff_policy::combined, 1e-6f, 1e-5f, 0, false},
+    };
+    for (std::size_t n : {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{33}, std::size_t{70000}, std::size_t{300001}}) {
+        std::vector<float> a, b;
+        make_inputs(n, static_cast<std::uint32_t>(n) + 1, a, b);
+        for (const auto& tol : policies) {
+            rphys::diff_report ref;
+            rphys::diff_arrays(a.data(), b.data(), n, tol, ref, rphys::simd_level::scalar);
+            REQUIRE(ref.compared == n);
+            for (auto level : k_levels) {
+                rphys::diff_report r;
+                rphys::diff_arrays(a.data(), b.data(), n, tol, r, level);
+                CHECK(r.compared == ref.compared);
+                CHECK(r.max_abs == ref.max_abs);
+                CHECK(r.max_rel == ref.max_rel);
+                CHECK(r.max_ulp == ref.max_ulp);
+                CHECK(r.first_divergence == ref.first_divergence);
+            }
+        }
+    }
+}
+
+TEST_CASE("diff metrics on known pairs", "[diff_fields]") {
+    const float        nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<float> a = {1.0f, 0.0f, nan, 2.0f, 1.0f};
+    std::vector<float> b = {1.0f, -0.0f, nan, std::nextafter(2.0f, 3.0f), 1.0f};
+    rphys::diff_report r;
+    rphys::diff_arrays(a.data(), b.data(), a.size(), {}, r);
+    CHECK(r.max_ulp == 1);
+    CHECK(r.max_abs == static_cast<double>(std::nextafter(2.0f, 3.0f) - 2.0f));
+    CHECK(r.first_divergence == 3);
+    rphys::diff_arrays(a.data(), b.data(), a.size(), {rphys::diff_policy::ulp, 0.0f, 0.0f, 1}, r);
+    CHECK(r.within_tolerance());
+
+    b[4] = nan; // one-sided NaN never passes
+    rphys::diff_arrays(a.data(), b.data(), a.size(), {rphys::diff_policy::absolute, 1e30f}, r);
+    CHECK(r.first_divergence == 4);
+    CHECK(r.max_ulp == std::numeric_limits<std::uint32_t>::max());
+    CHECK(std::isinf(r.max_abs));
+}
+
+TEST_CASE("early exit keeps the first divergence exact", "[diff_fields]") {
+    const std::size_t  n = std::size_t{3} << 20;
+    std::vector<float> a(n), b;
+    for (std::size_t i = 0; i < n; ++i) a[i] = static_cast<float>(i % 1000) * 0.01f;
+    b = a;
+    b[200000] += 1.0f;
+    b[n - 5] += 1.0f;
+
+    rphys::diff_report full, early;
+    rphys::diff_arrays(a.data(), b.data(), n, {rphys::diff_policy::absolute, 1e-3f, 0.0f, 0, false}, full);
+    rphys::diff_arrays(a.data(), b.data(), n, {rphys::diff_policy::absolute, 1e-3f, 0.0f, 0, true}, early);
+    CHECK(full.compared == n);
+    CHECK(full.first_divergence == 200000);
+    CHECK(early.first_divergence == 200000);
+    CHECK(early.compared < n);
+}
+
+TEST_CASE("world fields and checkpoints", "[diff_fields]") {
+    const rphys::world_id a = cloth_world(0.0), b = cloth_world(0.0), c = cloth_world(1e-3);
+    for (int f = 0; f < 10; ++f) {
+        rphys::step_world(a, 1.0 / 60.0);
+        rphys::step_world(b, 1.0 / 60.0);
+        rphys::step_world(c, 1.0 / 60.0);
+    }
+    const rphys::domain_id cloth{1};
+    rphys::diff_report r;
+    REQUIRE(rphys::diff_world_fields(a, b, cloth, "cloth.position", {}, r));
+    CHECK(r.within_tolerance());
+    CHECK(r.count == 32 * 32 * 3);
+    REQUIRE(rphys::diff_world_fields(a, c, cloth, "cloth.position", {}, r));
+    CHECK_FALSE(r.within_tolerance());
+    CHECK(r.max_abs > 0.0);
+    CHECK_FALSE(rphys::diff_world_fields(a, b, cloth, "cloth.no_such_field", {}, r));
+    CHECK_FALSE(rphys::diff_world_fields(a, b, cloth, "cloth.triangles", {}, r)); // u32, not f32
+    CHECK_FALSE(rphys::diff_world_fields(a, b, cloth, "cloth.edges", {}, r));
+    REQUIRE(rphys::diff_world_fields(a, b, cloth, "cloth.inv_mass", {}, r));
+    CHECK(r.count == 32 * 32);
+
+    std::vector<std::uint8_t> blob;
+    REQUIRE(rphys::save_world(a, blob));
+    const char* const         fields[] = {"cloth.position", "cloth.velocity"};
+    std::vector<rphys::diff_report> reports;
+    REQUIRE(rphys::diff_world_checkpoint(a, blob, cloth, fields, {}, reports));
+    REQUIRE(reports.size() == 2);
+    CHECK(reports[0].within_tolerance());
+    CHECK(reports[1].within_tolerance());
+    rphys::step_world(a, 1.0 / 60.0);
+    REQUIRE(rphys::diff_world_checkpoint(a, blob, cloth, fields, {}, reports));
+    CHECK_FALSE(reports[0].within_tolerance());
+
+    for (auto w : {a, b, c}) rphys::destroy_world(w);
+}
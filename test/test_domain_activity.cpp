@@ -0,0 +1,259 @@
+#include <catch2/catch_test_macros.hpp>
+#include "test_support.hpp"
+#include "rphys/api_commands.h"
+#include "rphys/api_coupling.h"
+#include "rphys/api_domain.h"
+#include "rphys/api_params.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+    using rphys_test::same_bits;
+
+    struct scene {
+        rphys::world_id  world{};
+        rphys::domain_id cloth{};
+    };
+
+    // The shared test sheet; `pinned` fixes its top row.
+    scene make_cloth(bool pinned, double gravity = -9.81) {
+        scene s;
+        rphys::world_desc wd{};
+        wd.scheduler = rphys::scheduler_kind::serial;
+        s.world = rphys::create_world(wd);
+        rphys::set_param(s.world, "gravity.y", gravity);
+        s.cloth = rphys::add_domain(s.world, rphys::domain_desc{0, "cloth"});
+        rphys::build_scene(s.world, s.cloth, {rphys_test::cloth_sheet(16, pinned ? rphys::scene_pin_top_row : 0u)});
+        return s;
+    }
+
+    std::vector<rphys::vec3f> positions(const scene& s) { return rphys_test::read_vec3(s.world, s.cloth, "cloth.position"); }
+
+    rphys::domain_activity_info info(const scene& s) {
+        rphys::domain_activity_info out{};
+        REQUIRE(rphys::get_domain_activity(s.world, s.cloth, out));
+        return out;
+    }
+} // namespace
+
+TEST_CASE("reduced rate domains fold skipped frames into one step", "[domain_activity]") {
+    scene lod = make_cloth(true), reference = make_cloth(true);
+    rphys::domain_activity_desc desc{};
+    desc.importance = 0.25f;
+    REQUIRE(rphys::set_domain_activity(lod.world, lod.cloth, desc));
+    CHECK_FALSE(rphys::set_domain_activity(lod.world, rphys::domain_id{99}, desc));
+
+    int stepped = 0;
+    for (int f = 0; f < 5; ++f) {
+        rphys::step_world(lod.world, 1.0 / 60.0);
+        const rphys::domain_activity_info i = info(lod);
+        CHECK(i.interval == 4);
+        CHECK(i.stepped == (f % 4 == 0));
+        stepped += i.stepped ? 1 : 0;
+    }
+    CHECK(stepped == 2);
+    CHECK(rphys::world_frame_count(lod.world) == 5);
+
+    double folded = 0.0;
+    for (int f = 0; f < 4; ++f) folded += 1.0 / 60.0;
+    rphys::step_world(reference.world, 1.0 / 60.0);
+    rphys::step_world(reference.world, folded);
+    CHECK(same_bits(positions(lod), positions(reference)));
+    rphys::destroy_world(lod.world);
+    rphys::destroy_world(reference.world);
+}
+
+TEST_CASE("folded steps longer than max_step run as substeps", "[domain_activity]") {
+    scene lod = make_cloth(true), reference = make_cloth(true);
+    rphys::domain_activity_desc desc{};
+    desc.importance = 0.25f;
+    desc.max_step   = 2.5 / 60.0;
+    REQUIRE(rphys::set_domain_activity(lod.world, lod.cloth, desc));
+    rphys::step_world(lod.world, 1.0 / 60.0);
+    CHECK(info(lod).substeps == 1); // nothing folded yet
+    for (int f = 1; f < 5; ++f) rphys::step_world(lod.world, 1.0 / 60.0);
+    CHECK(info(lod).stepped);
+    CHECK(info(lod).substeps == 2);
+
+    double folded = 0.0;
+    for (int f = 0; f < 4; ++f) folded += 1.0 / 60.0;
+    rphys::step_world(reference.world, 1.0 / 60.0);
+    rphys::step_world(reference.world, folded / 2);
+    rphys::step_world(reference.world, folded / 2);
+    CHECK(same_bits(positions(lod), positions(reference)));
+    rphys::destroy_world(lod.world);
+    rphys::destroy_world(reference.world);
+}
+
+TEST_CASE("fluid caps folded steps at its stability limit", "[domain_activity]") {
+    rphys::world_desc wd{};
+    wd.scheduler = rphys::scheduler_kind::serial;
+    const rphys::world_id  w     = rphys::create_world(wd);
+    const rphys::domain_id fluid = rphys::add_domain(w, rphys::domain_desc{0, "fluid"});
+    rphys::scene_primitive box{};
+    box.type = rphys::scene_primitive_type::particle_box;
+    box.extent[0] = box.extent[1] = box.extent[2] = 0.5f;
+    box.resolution[0] = box.resolution[1] = box.resolution[2] = 8;
+    rphys::scene_primitive bounds{};
+    bounds.type = rphys::scene_primitive_type::fluid_bounds;
+    bounds.extent[0] = bounds.extent[1] = bounds.extent[2] = 1.0f;
+    REQUIRE(rphys::build_scene(w, fluid, {box, bounds}));
+    rphys::domain_activity_desc desc{};
+    desc.importance = 0.125f;
+    REQUIRE(rphys::set_domain_activity(w, fluid, desc));
+
+    // 8 folded frames of 1/600 s exceed the WCSPH CFL bound (~3.5 ms at h = 0.125), but each
+    // substep stays at or above the frame dt.
+    std::uint32_t most = 0;
+    for (int f = 0; f < 64; ++f) {
+        rphys::step_world(w, 1.0 / 600.0);
+        rphys::domain_activity_info i{};
+        REQUIRE(rphys::get_domain_activity(w, fluid, i));
+        CHECK(i.interval == 8);
+        if (f > 0 && i.stepped) most = std::max(most, i.substeps);
+    }
+    CHECK(most > 1);
+    CHECK(most < 8);
+
+    const auto particles = rphys_test::read_vec3(w, fluid, "fluid.position");
+    REQUIRE_FALSE(particles.empty());
+    for (const auto& p : particles) {
+        REQUIRE(std::isfinite(p.x + p.y + p.z));
+        CHECK(p.y >= 0.0f);
+        CHECK(p.y <= 1.0f);
+    }
+    rphys::destroy_world(w);
+}
+
+TEST_CASE("camera distance coarsens far domains", "[domain_activity]") {
+    scene s = make_cloth(true);
+    rphys::domain_activity_desc desc{};
+    desc.use_camera_distance = true;
+    desc.near_distance       = 5.0f;
+    desc.max_interval        = 6;
+    REQUIRE(rphys::set_domain_activity(s.world, s.cloth, desc));
+    rphys::set_param(s.world, "lod.camera.x", 100.0);
+    rphys::step_world(s.world, 1.0 / 60.0);
+    rphys::domain_activity_info far = info(s);
+    CHECK(far.interval == 6);
+    CHECK(far.distance > 98.0f);
+
+    rphys::set_param(s.world, "lod.camera.x", 12.0); // ~11 away: every other frame
+    rphys::step_world(s.world, 1.0 / 60.0);
+    CHECK(info(s).interval == 2);
+
+    rphys::set_param(s.world, "lod.camera.x", 0.5);
+    rphys::set_param(s.world, "lod.camera.y", 1.5);
+    rphys::step_world(s.world, 1.0 / 60.0);
+    const rphys::domain_activity_info near = info(s);
+    CHECK(near.interval == 1);
+    CHECK(near.distance == 0.0f);
+    CHECK(near.stepped);
+    rphys::destroy_world(s.world);
+}
+
+TEST_CASE("settled domains sleep until disturbed", "[domain_activity]") {
+    scene s = make_cloth(false, 0.0);
+    rphys::domain_activity_desc desc{};
+    desc.sleep_energy = 1e-6f;
+    desc.sleep_frames = 5;
+    REQUIRE(rphys::set_domain_activity(s.world, s.cloth, desc));
+    for (int f = 0; f < 8; ++f) rphys::step_world(s.world, 1.0 / 60.0);
+    rphys::domain_activity_info i = info(s);
+    CHECK(i.asleep);
+    CHECK_FALSE(i.stepped);
+    CHECK(i.energy == 0.0f);
+
+    const std::vector<rphys::vec3f> before = positions(s);
+    rphys::command_desc kick{};
+    kick.kind     = rphys::command_kind::impulse;
+    kick.domain   = s.cloth;
+    kick.index    = 0;
+    kick.value[2] = 1.0f;
+    REQUIRE(rphys::enqueue_command(s.world, kick));
+    rphys::step_world(s.world, 1.0 / 60.0);
+    i = info(s);
+    CHECK_FALSE(i.asleep);
+    CHECK(i.stepped);
+    CHECK_FALSE(same_bits(before, positions(s)));
+    rphys::destroy_world(s.world);
+
+    // Parameter changes wake it as well, except for the LOD camera.
+    s = make_cloth(false, 0.0);
+    REQUIRE(rphys::set_domain_activity(s.world, s.cloth, desc));
+    for (int f = 0; f < 8; ++f) rphys::step_world(s.world, 1.0 / 60.0);
+    REQUIRE(info(s).asleep);
+    rphys::set_param(s.world, "lod.camera.z", 3.0);
+    rphys::step_world(s.world, 1.0 / 60.0);
+    CHECK(info(s).asleep);
+    rphys::set_param(s.world, "gravity.y", -9.81);
+    rphys::step_world(s.world, 1.0 / 60.0);
+    CHECK_FALSE(info(s).asleep);
+    CHECK(info(s).stepped);
+    rphys::destroy_world(s.world);
+
+    // So does a new coupling partner.
+    s = make_cloth(false, 0.0);
+    REQUIRE(rphys::set_domain_activity(s.world, s.cloth, desc));
+    for (int f = 0; f < 8; ++f) rphys::step_world(s.world, 1.0 / 60.0);
+    REQUIRE(info(s).asleep);
+    const rphys::domain_id rigid = rphys::add_domain(s.world, rphys::domain_desc{0, "rigid"});
+    REQUIRE(rphys::register_coupling(s.world, rphys::coupling_desc{0, "cloth_rigid_projection", s.cloth, rigid}).value != 0);
+    rphys::step_world(s.world, 1.0 / 60.0);
+    CHECK_FALSE(info(s).asleep);
+    CHECK(info(s).stepped);
+    rphys::destroy_world(s.world);
+}
+
+TEST_CASE("coupled domains share one activity plan", "[domain_activity]") {
+    scene s = make_cloth(false, 0.0);
+    const rphys::domain_id rigid = rphys::add_domain(s.world, rphys::domain_desc{0, "rigid"});
+    rphys::scene_primitive ball{};
+    ball.type = rphys::scene_primitive_type::rigid_sphere;
+    ball.origin[0] = 0.5f;
+    ball.origin[1] = 1.5f;
+    ball.origin[2] = -2.0f;
+    ball.extent[0] = 0.2f;
+    rphys::build_scene(s.world, rigid, {ball});
+    const rphys::coupling_id link = rphys::register_coupling(s.world, rphys::coupling_desc{0, "cloth_rigid_projection", s.cloth, rigid});
+    REQUIRE(link.value != 0);
+
+    rphys::domain_activity_desc desc{};
+    desc.importance   = 0.25f;
+    desc.sleep_energy = 1e-6f;
+    desc.sleep_frames = 2;
+    REQUIRE(rphys::set_domain_activity(s.world, s.cloth, desc));
+    // The rigid domain keeps the default plan, so the pair steps every frame and never sleeps.
+    for (int f = 0; f < 10; ++f) {
+        rphys::step_world(s.world, 1.0 / 60.0);
+        const rphys::domain_activity_info i = info(s);
+        CHECK(i.interval == 1);
+        CHECK(i.stepped);
+        CHECK_FALSE(i.asleep);
+    }
+
+    // Once both opt in, the group steps at its finest interval and sleeps as one.
+    rphys::domain_activity_desc rigid_desc{};
+    rigid_desc.importance   = 0.5f;
+    rigid_desc.sleep_energy = 1e-6f;
+    rigid_desc.sleep_frames = 2;
+    REQUIRE(rphys::set_domain_activity(s.world, rigid, rigid_desc));
+    rphys::step_world(s.world, 1.0 / 60.0);
+    rphys::domain_activity_info a = info(s), b{};
+    REQUIRE(rphys::get_domain_activity(s.world, rigid, b));
+    CHECK(a.interval == 2);
+    CHECK(b.interval == 2);
+    CHECK(a.stepped == b.stepped);
+    for (int f = 0; f < 20; ++f) rphys::step_world(s.world, 1.0 / 60.0);
+    a = info(s);
+    REQUIRE(rphys::get_domain_activity(s.world, rigid, b));
+    CHECK(a.asleep);
+    CHECK(b.asleep);
+
+    rphys::remove_coupling(s.world, link);
+    rphys::step_world(s.world, 1.0 / 60.0);
+    CHECK(info(s).interval == 4);
+    rphys::destroy_world(s.world);
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "rphys/api_commands.h"
+#include "rphys/api_domain.h"
+#include "rphys/api_fields.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+    std::vector<float> field_copy(rphys::world_id w, rphys::domain_id d, const char* name) {
+        rphys::field_view v{};
+        if (!rphys::get_field(w, d, name, v)) return {};
+        const auto* bytes = static_cast<const unsigned char*>(v.data);
+        std::vector<float> out(v.count * v.stride / sizeof(float));
+        std::memcpy(out.data(), bytes, v.count * v.stride);
+        return out;
+    }
+} // namespace
+
+TEST_CASE("cloth_sags_from_pinned_corners", "[domains][cloth]") {
+    auto w = rphys::create_world(rphys::world_desc{});
+    auto d = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+    rphys::scene_primitive p{};
+    p.type          = rphys::scene_primitive_type::cloth_grid;
+    p.origin[1]     = 1.0f;
+    p.resolution[0] = 12;
+    p.resolution[1] = 12;
+    p.flags         = rphys::scene_pin_top_corners;
+    REQUIRE(rphys::build_scene(w, d, {p}));
+    for (int i = 0; i < 60; ++i) rphys::step_world(w, 1.0 / 600.0);
+
+    auto cloth = field_copy(w, d, "cloth.position");
+    REQUIRE(cloth.size() == 12u * 12u * 3u);
+    const std::size_t top_left = (11 * 12) * 3;
+    REQUIRE(cloth[top_left + 1] == Catch::Approx(2.0f));
+    REQUIRE(cloth[1] < 1.0f);
+
+    rphys::remove_domain(w, d);
+    rphys::field_view v{};
+    REQUIRE_FALSE(rphys::get_field(w, d, "cloth.position", v));
+    rphys::step_world(w, 1.0 / 600.0);
+    rphys::destroy_world(w);
+}
+
+TEST_CASE("fluid_stays_inside_its_bounds", "[domains][fluid]") {
+    auto w = rphys::create_world(rphys::world_desc{});
+    auto d = rphys::add_domain(w, rphys::domain_desc{0, "fluid"});
+    rphys::scene_primitive box{};
+    box.type      = rphys::scene_primitive_type::particle_box;
+    box.extent[0] = box.extent[1] = box.extent[2] = 0.4f;
+    box.resolution[0] = box.resolution[1] = box.resolution[2] = 8;
+    rphys::scene_primitive bounds{};
+    bounds.type = rphys::scene_primitive_type::fluid_bounds;
+    REQUIRE(rphys::build_scene(w, d, {box, bounds}));
+    for (int i = 0; i < 60; ++i) rphys::step_world(w, 1.0 / 600.0);
+
+    auto fluid = field_copy(w, d, "fluid.position");
+    REQUIRE(fluid.size() == 8u * 8u * 8u * 3u);
+    for (std::size_t i = 0; i < fluid.size(); i += 3) {
+        REQUIRE(fluid[i] >= 0.0f);
+        REQUIRE(fluid[i] <= 1.0f);
+        REQUIRE(fluid[i + 1] >= 0.0f);
+    }
+    rphys::destroy_world(w);
+}
+
+TEST_CASE("rigid_spheres_settle_on_ground", "[domains][rigid]") {
+    auto w = rphys::create_world(rphys::world_desc{});
+    auto d = rphys::add_domain(w, rphys::domain_desc{0, "rigid"});
+    rphys::scene_primitive s{};
+    s.type      = rphys::scene_primitive_type::rigid_sphere;
+    s.origin[1] = 1.0f;
+    s.extent[0] = 0.25f;
+    REQUIRE(rphys::build_scene(w, d, {s}));
+    for (int i = 0; i < 240; ++i) rphys::step_world(w, 1.0 / 120.0);
+    auto pos = field_copy(w, d, "rigid.position");
+    REQUIRE(pos[1] == Catch::Approx(0.25f).margin(0.02f));
+
+    REQUIRE_FALSE(rphys::build_scene(w, rphys::domain_id{99}, {s}));
+    REQUIRE(rphys::add_domain(w, rphys::domain_desc{0, "plasma"}).value == 0);
+    rphys::destroy_world(w);
+}
+
+TEST_CASE("rigid_boxes_stack_and_collide", "[domains][rigid]") {
+    auto w = rphys::create_world(rphys::world_desc{});
+    auto d = rphys::add_domain(w, rphys::domain_desc{0, "rigid"});
+    rphys::scene_primitive column{};
+    column.type      = rphys::scene_primitive_type::rigid_box;
+    column.origin[1] = 0.3f;
+    column.extent[0] = column.extent[1] = column.extent[2] = 0.5f;
+    column.resolution[1] = 3;
+    REQUIRE(rphys::build_scene(w, d, {column}));
+    for (int i = 0; i < 360; ++i) rphys::step_world(w, 1.0 / 120.0);
+    auto pos = field_copy(w, d, "rigid.position");
+    REQUIRE(pos.size() == 9u);
+    for (int k = 0; k < 3; ++k) {
+        CHECK(pos[3 * k + 1] == Catch::Approx(0.25f + 0.5f * k).margin(0.03f));
+        CHECK(std::abs(pos[3 * k]) < 0.02f);
+    }
+
+    // Two boxes pushed into each other along x stop at contact instead of passing through.
+    auto pair = rphys::add_domain(w, rphys::domain_desc{0, "rigid"});
+    rphys::scene_primitive boxes{};
+    boxes.type      = rphys::scene_primitive_type::rigid_box;
+    boxes.origin[0] = 5.0f;
+    boxes.origin[1] = 0.25f;
+    boxes.extent[0] = boxes.extent[1] = boxes.extent[2] = 0.5f;
+    boxes.resolution[0] = 2;
+    REQUIRE(rphys::build_scene(w, pair, {boxes}));
+    for (std::uint32_t i = 0; i < 2; ++i) {
+        rphys::command_desc push{};
+        push.kind     = rphys::command_kind::impulse;
+        push.domain   = pair;
+        push.index    = i;
+        push.value[0] = i == 0 ? 3.0f : -3.0f;
+        REQUIRE(rphys::enqueue_command(w, push));
+    }
+    for (int i = 0; i < 120; ++i) rphys::step_world(w, 1.0 / 120.0);
+    pos = field_copy(w, pair, "rigid.position");
+    CHECK(pos[3] - pos[0] > 0.48f);
+    rphys::destroy_world(w);
+}
@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core_base/frame_arena.hpp"
+#include "rphys/api_telemetry.h"
+#include "rphys/api_world.h"
+#include <cstdint>
+#include <thread>
+
+TEST_CASE("frame_arena_alignment_and_reset", "[arena]") {
+    rphys::frame_arena arena;
+    void* a = rphys::frame_arena_alloc(arena, 3, 1);
+    void* b = rphys::frame_arena_alloc(arena, 16, 64);
+    REQUIRE(a != nullptr);
+    REQUIRE(b != nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 64 == 0);
+    REQUIRE(arena.frame_heap_allocs == 1);
+
+    rphys::frame_arena_reset(arena);
+    REQUIRE(arena.frame_bytes == 0);
+    REQUIRE(rphys::frame_arena_alloc(arena, 3, 1) == a); // memory is reused after reset
+}
+
+TEST_CASE("frame_arena_steady_state_has_no_heap_allocations", "[arena]") {
+    rphys::frame_arena arena;
+    auto frame = [&] {
+        for (int i = 0; i < 64; ++i) REQUIRE(rphys::frame_arena_alloc(arena, 16 * 1024, 16) != nullptr);
+        std::uint32_t allocs = arena.frame_heap_allocs;
+        rphys::frame_arena_reset(arena);
+        return allocs;
+    };
+    REQUIRE(frame() > 1);  // first frame grows block by block
+    REQUIRE(frame() == 0); // coalesced block now fits the whole frame
+    REQUIRE(frame() == 0);
+    REQUIRE(arena.blocks.size() == 1);
+    REQUIRE(arena.high_water >= 64 * 16 * 1024);
+}
+
+TEST_CASE("frame_arena_set_is_per_thread", "[arena]") {
+    rphys::frame_arena_set set;
+    rphys::frame_arena* main_arena = &rphys::frame_arena_local(set);
+    REQUIRE(&rphys::frame_arena_local(set) == main_arena);
+
+    rphys::frame_arena* other_arena = nullptr;
+    std::thread t([&] {
+        other_arena = &rphys::frame_arena_local(set);
+        rphys::frame_vector<int> v{rphys::frame_allocator<int>(*other_arena)};
+        for (int i = 0; i < 1000; ++i) v.push_back(i);
+    });
+    t.join();
+    REQUIRE(other_arena != main_arena);
+
+    auto totals = rphys::frame_arena_reset_all(set);
+    REQUIRE(totals.arenas == 2);
+    REQUIRE(totals.frame_bytes >= 1000 * sizeof(int));
+}
+
+TEST_CASE("frame_stats_report_scratch_usage", "[arena][telemetry]") {
+    auto wid = rphys::create_world(rphys::world_desc{});
+    REQUIRE(rphys::get_last_frame_stats(wid) != nullptr);
+    rphys::step_world(wid, 0.01);
+    rphys::step_world(wid, 0.01);
+    const rphys::frame_stats* stats = rphys::get_last_frame_stats(wid);
+    REQUIRE(stats->frame_index == 2);
+    REQUIRE(stats->frame_ms >= 0.0);
+    REQUIRE(stats->scratch_heap_allocs == 0);
+    rphys::destroy_world(wid);
+    REQUIRE(rphys::get_last_frame_stats(wid) == nullptr);
+}
@@ -0,0 +1,39 @@
+#include <catch2/catch_test_macros.hpp>
+#include "perf_layers/layout_pack.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace {
+    template <class Layout>
+    void check_pack() {
+        rphys::particle_pack<Layout, 4> p;
+        p.resize(37);
+        REQUIRE(p.size() == 37);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p.data()) % rphys::k_pack_alignment == 0);
+        // Every (particle, channel) maps to its own float inside the storage.
+        std::vector<int> hits(p.storage_size(), 0);
+        for (std::size_t i = 0; i < p.size(); ++i) {
+            for (std::size_t c = 0; c < 4; ++c) {
+                const std::size_t at = static_cast<std::size_t>(&p(i, c) - p.data());
+                REQUIRE(at < hits.size());
+                ++hits[at];
+                p(i, c) = static_cast<float>(i * 4 + c);
+            }
+        }
+        for (int h : hits) REQUIRE(h <= 1);
+        p.store3(5, 1, rphys::vec3f{1.0f, 2.0f, 3.0f});
+        const rphys::vec3f v = p.load3(5, 1);
+        REQUIRE((v.x == 1.0f && v.y == 2.0f && v.z == 3.0f));
+        REQUIRE(p(5, 0) == 20.0f);
+        const float* before = p.data();
+        p.resize(37);
+        REQUIRE((p.data() == before && p(36, 3) == 147.0f)); // same count: storage kept as is
+    }
+} // namespace
+
+TEST_CASE("layout policies map every particle channel once", "[layout]") {
+    check_pack<rphys::aos_layout>();
+    check_pack<rphys::soa_layout>();
+    check_pack<rphys::aosoa_layout<8>>();
+    check_pack<rphys::aosoa_layout<16>>();
+}
@@ -0,0 +1,143 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core_base/shared_asset.hpp"
+#include "coupling_modules/multi_field_mix.hpp"
+#include "schedulers/job_system.hpp"
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+    float linear(rphys::vec3f p) { return 0.5f + 2.0f * p.x - 3.0f * p.y + 0.25f * p.z; }
+
+    rphys::vec3f node(const rphys::transfer_grid& g, std::size_t n) {
+        const std::size_t x = n % g.dim[0], y = (n / g.dim[0]) % g.dim[1], z = n / (std::size_t{g.dim[0]} * g.dim[1]);
+        return g.origin + rphys::vec3f{static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)} * g.cell;
+    }
+
+    std::vector<float> sample(const rphys::transfer_grid& g) {
+        std::vector<float> v(rphys::transfer_grid_nodes(g));
+        for (std::size_t n = 0; n < v.size(); ++n) v[n] = linear(node(g, n));
+        return v;
+    }
+} // namespace
+
+TEST_CASE("grid and point operators reproduce linear fields", "[multi_field_mix]") {
+    const rphys::step_context ctx{};
+    const rphys::transfer_grid grid{{-1.0f, -1.0f, -1.0f}, 0.125f, {17, 17, 17}};
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coord(-0.99f, 0.99f);
+    std::vector<rphys::vec3f> points(3000);
+    for (auto& p : points) p = rphys::vec3f{coord(rng), coord(rng), coord(rng)};
+
+    rphys::transfer_operator to_points, to_grid;
+    REQUIRE(rphys::transfer_build_grid_to_points(to_points, grid, points.data(), points.size(), ctx));
+    REQUIRE(to_points.rows == points.size());
+    REQUIRE(to_points.cols == 17 * 17 * 17);
+    const std::vector<float> field = sample(grid);
+    std::vector<float>       at_points(points.size());
+    rphys::transfer_apply(to_points, field.data(), at_points.data(), 1, ctx);
+    for (std::size_t i = 0; i < points.size(); ++i) CHECK(std::abs(at_points[i] - linear(points[i])) < 1e-4f);
+
+    // Splatting a constant back averages to the same constant wherever particles reached.
+    rphys::transfer_build_normalized_transpose(to_grid, to_points);
+    REQUIRE(to_grid.rows == to_points.cols);
+    std::vector<float> ones(points.size(), 1.0f), on_grid(to_grid.rows, -1.0f);
+    rphys::transfer_apply(to_grid, ones.data(), on_grid.data(), 1, ctx);
+    std::size_t reached = 0;
+    for (std::size_t n = 0; n < on_grid.size(); ++n) {
+        const bool touched = to_grid.row_start[n + 1] > to_grid.row_start[n];
+        CHECK(std::abs(on_grid[n] - (touched ? 1.0f : 0.0f)) < 1e-5f);
+        reached += touched ? 1 : 0;
+    }
+    CHECK(reached > on_grid.size() / 2);
+    CHECK_FALSE(rphys::transfer_build_grid_to_points(to_points, rphys::transfer_grid{}, points.data(), points.size(), ctx));
+}
+
+TEST_CASE("grid to grid operators are cached and shared", "[multi_field_mix]") {
+    const rphys::step_context ctx{};
+    const rphys::transfer_grid coarse{{0.0f, 0.0f, 0.0f}, 0.2f, {11, 11, 11}};
+    const rphys::transfer_grid fine{{0.0f, 0.0f, 0.0f}, 0.05f, {41, 41, 41}};
+    const std::size_t before = rphys::shared_asset_count();
+    {
+        const auto prolong     = rphys::transfer_grid_operator(coarse, fine, ctx);
+        const auto restriction = rphys::transfer_grid_operator(fine, coarse, ctx);
+        REQUIRE(prolong);
+        REQUIRE(restriction);
+        CHECK(rphys::transfer_grid_operator(coarse, fine, ctx) == prolong);
+        CHECK(rphys::shared_asset_count() == before + 2);
+        CHECK(prolong->rows == 41 * 41 * 41);
+        CHECK(restriction->rows == 11 * 11 * 11);
+
+        const std::vector<float> c = sample(coarse), f = sample(fine);
+        std::vector<float>       up(prolong->rows), down(restriction->rows);
+        rphys::transfer_apply(*prolong, c.data(), up.data(), 1, ctx);
+        for (std::size_t n = 0; n < up.size(); ++n) CHECK(std::abs(up[n] - f[n]) < 1e-4f);
+        // Restriction averages fine nodes symmetrically around interior coarse nodes, so linear
+        // fields survive there too.
+        rphys::transfer_apply(*restriction, f.data(), down.data(), 1, ctx);
+        for (std::size_t n = 0; n < down.size(); ++n) {
+            const rphys::vec3f p = node(coarse, n);
+            const bool interior  = p.x > 0.1f && p.x < 1.9f && p.y > 0.1f && p.y < 1.9f && p.z > 0.1f && p.z < 1.9f;
+            if (interior) CHECK(std::abs(down[n] - c[n]) < 1e-4f);
+        }
+        CHECK_FALSE(rphys::transfer_grid_operator(coarse, rphys::transfer_grid{}, ctx));
+    }
+    CHECK(rphys::shared_asset_count() == before);
+}
+
+TEST_CASE("parallel SpMV matches the serial result bit for bit", "[multi_field_mix]") {
+    rphys::world_scheduler pool = rphys::make_job_system_scheduler(rphys::task_backend::builtin, 4);
+    REQUIRE(pool.self);
+    rphys::step_context parallel{};
+    parallel.exec = pool.exec;
+    const rphys::step_context serial{};
+
+    const rphys::transfer_grid grid{{0.0f, 0.0f, 0.0f}, 1.0f / 63.0f, {64, 64, 64}};
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<rphys::vec3f> points(200000);
+    for (auto& p : points) p = rphys::vec3f{unit(rng), unit(rng), unit(rng)};
+    rphys::transfer_operator a, b, splat;
+    REQUIRE(rphys::transfer_build_grid_to_points(a, grid, points.data(), points.size(), serial));
+    REQUIRE(rphys::transfer_build_grid_to_points(b, grid, points.data(), points.size(), parallel));
+    CHECK(a.col == b.col);
+    CHECK(std::memcmp(a.weight.data(), b.weight.data(), a.weight.size() * sizeof(float)) == 0);
+    rphys::transfer_build_normalized_transpose(splat, a);
+
+    for (std::uint32_t comps : {1u, 3u, 4u}) {
+        std::vector<float> velocity(points.size() * comps);
+        for (auto& v : velocity) v = unit(rng) - 0.5f;
+        std::vector<float> x(splat.rows * comps), y(splat.rows * comps);
+        rphys::transfer_apply(splat, velocity.data(), x.data(), comps, serial);
+        rphys::transfer_apply(splat, velocity.data(), y.data(), comps, parallel);
+        CHECK(std::memcmp(x.data(), y.data(), x.size() * sizeof(float)) == 0);
+    }
+    pool.destroy(pool.self);
+}
+
+TEST_CASE("point caches rebuild only when the points move", "[multi_field_mix]") {
+    const rphys::step_context  ctx{};
+    const rphys::transfer_grid grid{{0.0f, 0.0f, 0.0f}, 0.1f, {11, 11, 11}};
+    std::vector<rphys::vec3f>  points;
+    for (int i = 0; i < 100; ++i) points.push_back(rphys::vec3f{0.01f * i, 0.5f, 0.5f});
+
+    rphys::transfer_point_cache cache;
+    CHECK(rphys::transfer_point_cache_update(cache, grid, points.data(), points.size(), 0.25f, ctx));
+    for (int step = 0; step < 10; ++step) CHECK_FALSE(rphys::transfer_point_cache_update(cache, grid, points.data(), points.size(), 0.25f, ctx));
+    CHECK(cache.builds == 1);
+
+    points[17].y += 0.02f; // a fifth of a cell: within tolerance
+    CHECK_FALSE(rphys::transfer_point_cache_update(cache, grid, points.data(), points.size(), 0.25f, ctx));
+    CHECK(rphys::transfer_point_cache_update(cache, grid, points.data(), points.size(), 0.0f, ctx));
+    points[17].y += 0.03f;
+    CHECK(rphys::transfer_point_cache_update(cache, grid, points.data(), points.size(), 0.25f, ctx));
+    points.pop_back();
+    CHECK(rphys::transfer_point_cache_update(cache, grid, points.data(), points.size(), 0.25f, ctx));
+    rphys::transfer_grid finer = grid;
+    finer.cell = 0.05f;
+    CHECK(rphys::transfer_point_cache_update(cache, finer, points.data(), points.size(), 0.25f, ctx));
+    CHECK(cache.builds == 5);
+    CHECK(cache.to_points.rows == points.size());
+    CHECK(cache.to_grid.rows == 11 * 11 * 11);
+}
@@ -0,0 +1,152 @@
+#include <catch2/catch_test_macros.hpp>
+#include "test_support.hpp"
+#include "algo_sandbox/param_scan_tool.hpp"
+#include "algo_sandbox/run_matrix.hpp"
+#include "core_base/shared_asset.hpp"
+#include "rphys/api_domain.h"
+#include "rphys/api_fields.h"
+#include "rphys/api_params.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+    std::string temp_path(const char* name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+    rphys::scene_primitive cloth_grid(std::uint32_t n) { return rphys_test::cloth_sheet(n, rphys::scene_pin_top_corners); }
+
+    const void* field_data(rphys::world_id w, rphys::domain_id d, const char* name) {
+        rphys::field_view v{};
+        return rphys::get_field(w, d, name, v) ? v.data : nullptr;
+    }
+
+    std::vector<rphys::vec3f> positions(rphys::world_id w, rphys::domain_id d) { return rphys_test::read_vec3(w, d, "cloth.position"); }
+} // namespace
+
+TEST_CASE("param grid expands the cartesian product, last axis fastest", "[param_sweep]") {
+    rphys::param_grid g;
+    REQUIRE(rphys::param_grid_size(g) == 1);
+    REQUIRE(rphys::param_grid_parse_axis(g, "cloth.compliance=0,1e-6,1e-4"));
+    REQUIRE(rphys::param_grid_parse_axis(g, "cloth.damping=0:0.5:2"));
+    REQUIRE_FALSE(rphys::param_grid_add(g, "cloth.damping", {1.0})); // duplicate axis
+    REQUIRE_FALSE(rphys::param_grid_parse_axis(g, "gravity.y=1,x"));
+    REQUIRE_FALSE(rphys::param_grid_parse_axis(g, "gravity.y=0:1"));
+    REQUIRE(rphys::param_grid_size(g) == 6);
+
+    std::vector<double> p;
+    rphys::param_grid_point(g, 0, p);
+    REQUIRE(p == std::vector<double>{0.0, 0.0});
+    rphys::param_grid_point(g, 1, p);
+    REQUIRE(p == std::vector<double>{0.0, 0.5});
+    rphys::param_grid_point(g, 4, p);
+    REQUIRE(p == std::vector<double>{1e-4, 0.0});
+}
+
+TEST_CASE("cow_vector clones only when a write would be visible to another holder", "[param_sweep]") {
+    rphys::cow_vector<int> a;
+    a = std::vector<int>{1, 2, 3};
+    const int* original = a.data();
+    a.mutate()[0] = 7; // sole owner: in place
+    REQUIRE(a.data() == original);
+
+    rphys::cow_vector<int> b = a;
+    REQUIRE(b.data() == a.data());
+    b.mutate()[1] = 9;
+    REQUIRE(b.data() != a.data());
+    REQUIRE(a.values() == std::vector<int>{7, 2, 3});
+    REQUIRE(b.values() == std::vector<int>{7, 9, 3});
+
+    // Buffers adopted from elsewhere (e.g. the asset registry) are never written in place.
+    auto external = std::make_shared<std::vector<int>>(std::vector<int>{4, 5});
+    rphys::cow_vector<int> c(external);
+    c.mutate()[0] = 0;
+    REQUIRE((*external)[0] == 4);
+}
+
+TEST_CASE("worlds loaded from one scene file share the cooked cloth arrays", "[param_sweep]") {
+    const std::string path = temp_path("rphys_sweep_share.rps");
+    REQUIRE(rphys::write_scene_file(path.c_str(), {cloth_grid(16)}));
+    const std::size_t live_before = rphys::shared_asset_count();
+
+    rphys::world_desc wd{};
+    wd.scheduler = rphys::scheduler_kind::serial;
+    rphys::world_id  w[2];
+    rphys::domain_id d[2];
+    for (int i = 0; i < 2; ++i) {
+        w[i] = rphys::create_world(wd);
+        d[i] = rphys::add_domain(w[i], rphys::domain_desc{0, "cloth"});
+        REQUIRE(rphys::build_scene_file(w[i], d[i], path.c_str()));
+    }
+    REQUIRE(rphys::shared_asset_count() > live_before);
+    REQUIRE(field_data(w[0], d[0], "cloth.edges") == field_data(w[1], d[1], "cloth.edges"));
+    REQUIRE(field_data(w[0], d[0], "cloth.triangles") == field_data(w[1], d[1], "cloth.triangles"));
+    REQUIRE(field_data(w[0], d[0], "cloth.position") != field_data(w[1], d[1], "cloth.position"));
+
+    // Per-world state stays private: stepping one world leaves the other where it was.
+    const auto rest = positions(w[1], d[1]);
+    rphys::step_world(w[0], 1.0 / 60.0);
+    REQUIRE(rphys_test::same_bits(positions(w[1], d[1]), rest));
+    REQUIRE_FALSE(rphys_test::same_bits(positions(w[0], d[0]), rest));
+
+    for (auto id : w) rphys::destroy_world(id);
+    REQUIRE(rphys::shared_asset_count() == live_before);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("sweep runs match worlds stepped on their own", "[param_sweep]") {
+    rphys::run_matrix_desc desc;
+    desc.domains.push_back(rphys::domain_desc{0, "cloth"});
+    desc.primitives = {cloth_grid(12)};
+    desc.fixed_params.emplace_back("cloth.iterations", 8.0);
+    REQUIRE(rphys::param_grid_add(desc.grid, "cloth.compliance", {0.0, 1e-5}));
+    REQUIRE(rphys::param_grid_add(desc.grid, "cloth.damping", {0.0, 0.1}));
+    desc.frames      = 20;
+    desc.concurrency = 3; // two waves
+    desc.telemetry_dir = std::filesystem::temp_directory_path().string();
+
+    std::vector<std::vector<rphys::vec3f>> final_positions(4);
+    std::vector<const void*>        edges(4);
+    desc.inspect = [&](rphys::world_id w, rphys::run_metrics& m) {
+        final_positions[m.index] = positions(w, rphys::domain_id{1});
+        edges[m.index]           = field_data(w, rphys::domain_id{1}, "cloth.edges");
+        m.extra.push_back(final_positions[m.index][0].y);
+    };
+
+    rphys::run_matrix_result result;
+    REQUIRE(rphys::run_matrix_execute(desc, result));
+    REQUIRE(result.concurrency == 3);
+    REQUIRE(result.runs.size() == 4);
+    for (const auto& m : result.runs) {
+        CHECK(m.ok);
+        CHECK(m.frames == 20);
+        CHECK(m.solver_iterations == 20 * 8);
+        CHECK(m.frame_ms_max >= m.frame_ms_mean);
+        CHECK(m.stream_ok);
+        CHECK(m.stream_frames_dropped == 0);
+        CHECK(m.extra.size() == 1);
+        CHECK(edges[m.index] == edges[0]); // both waves share one buffer through the sentinel world
+        char name[32];
+        std::snprintf(name, sizeof(name), "run_%05zu.csv", m.index);
+        const auto csv = std::filesystem::path(desc.telemetry_dir) / name;
+        CHECK(std::filesystem::file_size(csv) > 0);
+        std::filesystem::remove(csv);
+    }
+    REQUIRE_FALSE(rphys_test::same_bits(final_positions[0], final_positions[3]));
+
+    for (const auto& m : result.runs) {
+        rphys::world_desc wd{};
+        wd.scheduler = rphys::scheduler_kind::serial;
+        const rphys::world_id  w = rphys::create_world(wd);
+        const rphys::domain_id d = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+        REQUIRE(rphys::build_scene(w, d, desc.primitives));
+        rphys::set_param(w, "cloth.iterations", 8.0);
+        rphys::set_param(w, "cloth.compliance", m.params[0]);
+        rphys::set_param(w, "cloth.damping", m.params[1]);
+        for (int f = 0; f < 20; ++f) rphys::step_world(w, desc.dt);
+        CHECK(rphys_test::same_bits(positions(w, d), final_positions[m.index]));
+        rphys::destroy_world(w);
+    }
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rphys/api_domain.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_telemetry.h"
+#include "rphys/api_world.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace {
+    struct scene {
+        rphys::world_id  world{};
+        rphys::domain_id cloth{};
+        rphys::domain_id fluid{};
+    };
+
+    scene make_scene(rphys::scheduler_kind scheduler) {
+        rphys::world_desc wd{};
+        wd.scheduler = scheduler;
+        scene s;
+        s.world = rphys::create_world(wd);
+        s.cloth = rphys::add_domain(s.world, rphys::domain_desc{0, "cloth"});
+        rphys::scene_primitive grid{};
+        grid.type = rphys::scene_primitive_type::cloth_grid;
+        grid.resolution[0] = grid.resolution[1] = 16;
+        grid.flags = rphys::scene_pin_top_corners;
+        rphys::build_scene(s.world, s.cloth, {grid});
+        s.fluid = rphys::add_domain(s.world, rphys::domain_desc{0, "fluid"});
+        rphys::scene_primitive box{}, bounds{};
+        box.type = rphys::scene_primitive_type::particle_box;
+        box.extent[0] = box.extent[1] = box.extent[2] = 0.3f;
+        box.resolution[0] = box.resolution[1] = box.resolution[2] = 6;
+        bounds.type = rphys::scene_primitive_type::fluid_bounds;
+        rphys::build_scene(s.world, s.fluid, {box, bounds});
+        return s;
+    }
+
+    const rphys::phase_stats* find_phase(const rphys::frame_stats& f, const char* name, std::uint32_t owner) {
+        for (std::uint32_t i = 0; i < f.phase_count; ++i) {
+            if (f.phases[i].owner == owner && !f.phases[i].coupling && std::strcmp(f.phases[i].name, name) == 0) return &f.phases[i];
+        }
+        return nullptr;
+    }
+} // namespace
+
+TEST_CASE("profiling is off by default and reports phases once enabled", "[profiler]") {
+    for (auto scheduler : {rphys::scheduler_kind::serial, rphys::scheduler_kind::work_stealing}) {
+        scene s = make_scene(scheduler);
+        rphys::step_world(s.world, 1.0 / 60.0);
+        const rphys::frame_stats* f = rphys::get_last_frame_stats(s.world);
+        REQUIRE(f);
+        REQUIRE(f->phase_count == 0);
+
+        REQUIRE(rphys::set_profiling(s.world, true));
+        rphys::step_world(s.world, 1.0 / 60.0);
+        REQUIRE(f->phase_count > 0);
+        const rphys::phase_stats* solve = find_phase(*f, "solve", s.cloth.value);
+        REQUIRE(solve);
+        REQUIRE(solve->calls == 1);
+        REQUIRE(solve->ms > 0.0);
+        REQUIRE(solve->iterations == 10); // cloth.iterations default
+        REQUIRE(solve->residual >= 0.0);
+        REQUIRE(find_phase(*f, "density", s.fluid.value));
+        REQUIRE(f->profile_events_dropped == 0);
+
+        // Every step reports its own phases, not a running total.
+        rphys::step_world(s.world, 1.0 / 60.0);
+        REQUIRE(find_phase(*f, "solve", s.cloth.value)->calls == 1);
+
+        REQUIRE(rphys::set_profiling(s.world, false));
+        rphys::step_world(s.world, 1.0 / 60.0);
+        REQUIRE(f->phase_count == 0);
+        rphys::destroy_world(s.world);
+    }
+}
+
+TEST_CASE("rings wrap across steps without losing a step's events", "[profiler]") {
+    scene s = make_scene(rphys::scheduler_kind::serial);
+    REQUIRE(rphys::set_profiling(s.world, true, 4)); // rounded up to the minimum ring size
+    // Many times the ring capacity in total, but each step is collected before the ring wraps.
+    for (int i = 0; i < 40; ++i) rphys::step_world(s.world, 1.0 / 60.0);
+    const rphys::frame_stats* f = rphys::get_last_frame_stats(s.world);
+    REQUIRE(f->phase_count > 0);
+    REQUIRE(f->profile_events_dropped == 0);
+    REQUIRE(find_phase(*f, "solve", s.cloth.value)->calls == 1);
+    rphys::destroy_world(s.world);
+}
+
+TEST_CASE("chrome trace export writes one process per world", "[profiler]") {
+    scene a = make_scene(rphys::scheduler_kind::work_stealing);
+    scene b = make_scene(rphys::scheduler_kind::serial);
+    const rphys::world_id worlds[] = {a.world, b.world};
+    const char* path = "test_profiler_trace.json";
+    REQUIRE_FALSE(rphys::export_chrome_trace(worlds, path)); // not profiling yet
+
+    for (auto w : worlds) REQUIRE(rphys::set_profiling(w, true));
+    for (int i = 0; i < 3; ++i) rphys::step_worlds(worlds, 1.0 / 60.0);
+    REQUIRE(rphys::export_chrome_trace(worlds, path));
+
+    std::string text;
+    if (std::FILE* f = std::fopen(path, "rb")) {
+        char buf[4096];
+        for (std::size_t n; (n = std::fread(buf, 1, sizeof(buf), f)) > 0;) text.append(buf, n);
+        std::fclose(f);
+    }
+    std::remove(path);
+    REQUIRE(text.rfind("{\"displayTimeUnit\"", 0) == 0);
+    REQUIRE(text.find("]}") != std::string::npos);
+    REQUIRE(text.find("\"name\":\"world " + std::to_string(a.world.value) + "\"") != std::string::npos);
+    REQUIRE(text.find("\"name\":\"world " + std::to_string(b.world.value) + "\"") != std::string::npos);
+    REQUIRE(text.find("\"name\":\"step\"") != std::string::npos);
+    REQUIRE(text.find("\"name\":\"solve\",\"cat\":\"phase\"") != std::string::npos);
+    REQUIRE(text.find("\"iterations\":10") != std::string::npos);
+
+    rphys::destroy_world(a.world);
+    rphys::destroy_world(b.world);
+}
@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+#include "rphys/api_domain.h"
+#include "rphys/api_fields.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+    std::string temp_path(const char* name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+    std::vector<unsigned char> field_bytes(rphys::world_id w, rphys::domain_id d, const char* name) {
+        rphys::field_view v{};
+        if (!rphys::get_field(w, d, name, v)) return {};
+        std::vector<unsigned char> out(v.count * v.stride);
+        std::memcpy(out.data(), v.data, out.size());
+        return out;
+    }
+
+    rphys::scene_primitive cloth_grid(std::uint32_t n, float y) {
+        rphys::scene_primitive grid{};
+        grid.type = rphys::scene_primitive_type::cloth_grid;
+        grid.origin[1] = y;
+        grid.resolution[0] = grid.resolution[1] = n;
+        grid.flags = rphys::scene_pin_top_corners;
+        return grid;
+    }
+
+    rphys::scene_primitive_list mixed_scene() {
+        rphys::scene_primitive box{};
+        box.type = rphys::scene_primitive_type::particle_box;
+        box.origin[0] = 3.0f;
+        box.extent[0] = box.extent[1] = box.extent[2] = 0.5f;
+        box.resolution[0] = box.resolution[1] = box.resolution[2] = 8;
+        rphys::scene_primitive bounds{};
+        bounds.type = rphys::scene_primitive_type::fluid_bounds;
+        bounds.origin[0] = 3.0f;
+        rphys::scene_primitive balls{};
+        balls.type = rphys::scene_primitive_type::rigid_sphere;
+        balls.origin[0] = -3.0f;
+        balls.origin[1] = 0.2f;
+        balls.extent[0] = 0.1f;
+        balls.resolution[0] = balls.resolution[1] = 3;
+        return {cloth_grid(24, 1.0f), box, bounds, balls};
+    }
+
+    struct mixed_world {
+        rphys::world_id  world{};
+        rphys::domain_id cloth{}, fluid{}, rigid{};
+    };
+
+    mixed_world make_world() {
+        rphys::world_desc wd{};
+        wd.scheduler   = rphys::scheduler_kind::serial;
+        wd.determinism = rphys::determinism_level::bit_stable;
+        mixed_world m;
+        m.world = rphys::create_world(wd);
+        m.cloth = rphys::add_domain(m.world, rphys::domain_desc{0, "cloth"});
+        m.fluid = rphys::add_domain(m.world, rphys::domain_desc{0, "fluid"});
+        m.rigid = rphys::add_domain(m.world, rphys::domain_desc{0, "rigid"});
+        return m;
+    }
+} // namespace
+
+TEST_CASE("scene file round trip matches build_scene", "[scene_file]") {
+    const std::string path = temp_path("rphys_scene_roundtrip.rps");
+    const auto scene = mixed_scene();
+    REQUIRE(rphys::write_scene_file(path.c_str(), scene));
+
+    mixed_world direct = make_world(), mapped = make_world();
+    for (auto d : {direct.cloth, direct.fluid, direct.rigid}) REQUIRE(rphys::build_scene(direct.world, d, scene));
+    for (auto d : {mapped.cloth, mapped.fluid, mapped.rigid}) REQUIRE(rphys::build_scene_file(mapped.world, d, path.c_str()));
+
+    for (const char* name : {"cloth.position", "cloth.inv_mass", "cloth.triangles", "cloth.edges"}) {
+        REQUIRE(field_bytes(direct.world, direct.cloth, name) == field_bytes(mapped.world, mapped.cloth, name));
+    }
+    for (int i = 0; i < 10; ++i) {
+        rphys::step_world(direct.world, 1.0 / 60.0);
+        rphys::step_world(mapped.world, 1.0 / 60.0);
+    }
+    REQUIRE(field_bytes(direct.world, direct.cloth, "cloth.position") == field_bytes(mapped.world, mapped.cloth, "cloth.position"));
+    REQUIRE(field_bytes(direct.world, direct.fluid, "fluid.position") == field_bytes(mapped.world, mapped.fluid, "fluid.position"));
+    REQUIRE(field_bytes(direct.world, direct.rigid, "rigid.position") == field_bytes(mapped.world, mapped.rigid, "rigid.position"));
+
+    rphys::destroy_world(direct.world);
+    rphys::destroy_world(mapped.world);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("scene file carries host meshes and appends to existing cloth", "[scene_file]") {
+    const std::string path = temp_path("rphys_scene_mesh.rps");
+    const float positions[] = {0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0};
+    const std::uint32_t indices[] = {0, 1, 2, 0, 2, 3};
+    const std::uint32_t pinned[] = {3};
+    rphys::scene_mesh quad{positions, 4, indices, 2, 4.0f, pinned, 1};
+    REQUIRE(rphys::write_scene_file(path.c_str(), {}, {&quad, 1}));
+
+    rphys::world_desc wd{};
+    auto w = rphys::create_world(wd);
+    auto cloth = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+    REQUIRE(rphys::build_scene_file(w, cloth, path.c_str()));
+    rphys::field_view edges{}, inv_mass{};
+    REQUIRE(rphys::get_field(w, cloth, "cloth.edges", edges));
+    REQUIRE(edges.count == 5);
+    REQUIRE(rphys::get_field(w, cloth, "cloth.inv_mass", inv_mass));
+    REQUIRE(static_cast<const float*>(inv_mass.data)[0] == 1.0f);
+    REQUIRE(static_cast<const float*>(inv_mass.data)[3] == 0.0f);
+
+    // Loading on top of existing cloth re-cooks the combined mesh, like a second build_scene.
+    const std::string grid_path = temp_path("rphys_scene_grid.rps");
+    REQUIRE(rphys::write_scene_file(grid_path.c_str(), {cloth_grid(6, 2.0f)}));
+    REQUIRE(rphys::build_scene_file(w, cloth, grid_path.c_str()));
+    auto reference = rphys::create_world(wd);
+    auto ref_cloth = rphys::add_domain(reference, rphys::domain_desc{0, "cloth"});
+    REQUIRE(rphys::build_scene_file(reference, ref_cloth, path.c_str()));
+    REQUIRE(rphys::build_scene(reference, ref_cloth, {cloth_grid(6, 2.0f)}));
+    for (const char* name : {"cloth.position", "cloth.inv_mass", "cloth.triangles", "cloth.edges"}) {
+        REQUIRE(field_bytes(w, cloth, name) == field_bytes(reference, ref_cloth, name));
+    }
+
+    rphys::destroy_world(w);
+    rphys::destroy_world(reference);
+    std::remove(path.c_str());
+    std::remove(grid_path.c_str());
+}
+
+TEST_CASE("large meshes stream through several blocks", "[scene_file]") {
+    const std::string path = temp_path("rphys_scene_large.rps");
+    const auto grid = cloth_grid(640, 1.0f); // ~400k vertices, sections larger than one stream block
+    REQUIRE(rphys::write_scene_file(path.c_str(), {grid}));
+
+    rphys::world_desc wd{};
+    auto w = rphys::create_world(wd);
+    auto direct = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+    auto mapped = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+    REQUIRE(rphys::build_scene(w, direct, {grid}));
+    REQUIRE(rphys::build_scene_file(w, mapped, path.c_str()));
+    REQUIRE(field_bytes(w, direct, "cloth.position") == field_bytes(w, mapped, "cloth.position"));
+    REQUIRE(field_bytes(w, direct, "cloth.edges") == field_bytes(w, mapped, "cloth.edges"));
+
+    rphys::destroy_world(w);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("malformed scene files are rejected without touching the domain", "[scene_file]") {
+    const std::string path = temp_path("rphys_scene_bad.rps");
+    REQUIRE(rphys::write_scene_file(path.c_str(), {cloth_grid(4, 1.0f)}));
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto rewrite = [&](const std::vector<char>& data) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    };
+
+    rphys::world_desc wd{};
+    auto w = rphys::create_world(wd);
+    auto cloth = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+    REQUIRE_FALSE(rphys::build_scene_file(w, cloth, temp_path("rphys_scene_missing.rps").c_str()));
+
+    rewrite(std::vector<char>(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(bytes.size() / 2)));
+    REQUIRE_FALSE(rphys::build_scene_file(w, cloth, path.c_str()));
+
+    auto future = bytes;
+    future[8] = 2; // version_major
+    rewrite(future);
+    REQUIRE_FALSE(rphys::build_scene_file(w, cloth, path.c_str()));
+
+    // None of the failures above reached the domain, so it still accepts a scene.
+    REQUIRE(rphys::build_scene(w, cloth, {cloth_grid(4, 1.0f)}));
+
+    rphys::destroy_world(w);
+    std::remove(path.c_str());
+}
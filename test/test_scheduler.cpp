@@ -0,0 +1,186 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "rphys/api_capability.h"
+#include "rphys/api_domain.h"
+#include "rphys/api_fields.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include "schedulers/frame_graph.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+    void noop_phase(void*, rphys::step_context&) {}
+
+    bool has_edge(const rphys::frame_graph& g, std::uint32_t from, std::uint32_t to) {
+        const auto& n = g.nodes[from];
+        auto first    = g.successors.begin() + n.first_successor;
+        return std::find(first, first + n.successor_count, to) != first + n.successor_count;
+    }
+
+    rphys::scene_primitive cloth_grid() {
+        rphys::scene_primitive p{};
+        p.type          = rphys::scene_primitive_type::cloth_grid;
+        p.origin[1]     = 1.0f;
+        p.extent[0]     = 1.0f;
+        p.extent[1]     = 1.0f;
+        p.resolution[0] = 12;
+        p.resolution[1] = 12;
+        p.flags         = rphys::scene_pin_top_corners;
+        return p;
+    }
+
+    std::vector<float> field_copy(rphys::world_id w, rphys::domain_id d, const char* name) {
+        rphys::field_view v{};
+        if (!rphys::get_field(w, d, name, v)) return {};
+        const auto* bytes = static_cast<const unsigned char*>(v.data);
+        std::vector<float> out(v.count * v.stride / sizeof(float));
+        std::memcpy(out.data(), bytes, v.count * v.stride);
+        return out;
+    }
+
+    struct mixed_world {
+        rphys::world_id  world{};
+        rphys::domain_id cloth{}, fluid{}, rigid{};
+    };
+
+    mixed_world make_mixed_world(rphys::scheduler_kind kind) {
+        rphys::world_desc wd{};
+        wd.scheduler   = kind;
+        wd.determinism = rphys::determinism_level::bit_stable;
+        mixed_world m{};
+        m.world = rphys::create_world(wd);
+        m.cloth = rphys::add_domain(m.world, rphys::domain_desc{0, "cloth"});
+        m.fluid = rphys::add_domain(m.world, rphys::domain_desc{0, "fluid"});
+        m.rigid = rphys::add_domain(m.world, rphys::domain_desc{0, "rigid"});
+
+        rphys::scene_primitive box{};
+        box.type = rphys::scene_primitive_type::particle_box;
+        box.origin[0] = 2.0f;
+        box.extent[0] = box.extent[1] = box.extent[2] = 0.4f;
+        box.resolution[0] = box.resolution[1] = box.resolution[2] = 8;
+        rphys::scene_primitive bounds{};
+        bounds.type = rphys::scene_primitive_type::fluid_bounds;
+        bounds.origin[0] = 2.0f;
+        bounds.extent[0] = bounds.extent[1] = bounds.extent[2] = 1.0f;
+        rphys::scene_primitive spheres{};
+        spheres.type = rphys::scene_primitive_type::rigid_sphere;
+        spheres.origin[0] = -2.0f;
+        spheres.origin[1] = 0.5f;
+        spheres.extent[0] = 0.1f;
+        spheres.resolution[0] = 3;
+        spheres.resolution[1] = 3;
+
+        REQUIRE(rphys::build_scene(m.world, m.cloth, {cloth_grid()}));
+        REQUIRE(rphys::build_scene(m.world, m.fluid, {box, bounds}));
+        REQUIRE(rphys::build_scene(m.world, m.rigid, {spheres}));
+        return m;
+    }
+} // namespace
+
+TEST_CASE("frame_graph_edges_follow_field_hazards", "[scheduler]") {
+    using rphys::phase_stage;
+    const char* const x[] = {"a.x"};
+    const char* const y[] = {"a.y"};
+    const rphys::domain_phase phases[] = {
+        {"write_x", phase_stage::prepare, nullptr, 0, x, 1, noop_phase},
+        {"read_x_1", phase_stage::solve, x, 1, y, 1, noop_phase},
+        {"read_x_2", phase_stage::solve, x, 1, nullptr, 0, noop_phase},
+        {"rewrite_x", phase_stage::finalize, nullptr, 0, x, 1, noop_phase},
+    };
+    rphys::domain_pipeline_contract contract{};
+    contract.type        = "test";
+    contract.phases      = phases;
+    contract.phase_count = std::size(phases);
+    rphys::domain_core d1{1, &contract, nullptr, false};
+    rphys::domain_core d2{2, &contract, nullptr, false};
+
+    // Exchange-stage coupling reading domain 1's y and writing domain 2's x.
+    const rphys::coupling_field reads[]  = {{0, "a.y"}};
+    const rphys::coupling_field writes[] = {{1, "a.x"}};
+    rphys::coupling_contract cc{};
+    cc.type        = "test_coupling";
+    cc.reads       = reads;
+    cc.read_count  = 1;
+    cc.writes      = writes;
+    cc.write_count = 1;
+    rphys::coupling_core c{1, &cc, nullptr, {1, 2}, false};
+
+    rphys::domain_core*   domains[]   = {&d1, &d2};
+    rphys::coupling_core* couplings[] = {&c};
+    rphys::frame_view view{domains, 2, couplings, 1, nullptr, 7};
+
+    rphys::frame_graph g;
+    REQUIRE(rphys::frame_graph_update(g, view));
+    REQUIRE_FALSE(rphys::frame_graph_update(g, view)); // cached until the topology changes
+    REQUIRE(g.nodes.size() == 9);
+
+    // Canonical order: prepare(d1, d2), solve(d1 x2, d2 x2), exchange(c), finalize(d1, d2).
+    REQUIRE(g.nodes[0].domain == &d1);
+    REQUIRE(g.nodes[1].domain == &d2);
+    REQUIRE(g.nodes[6].coupling == &c);
+    REQUIRE(g.roots == std::vector<std::uint32_t>{0, 1});
+
+    REQUIRE(has_edge(g, 0, 2));       // d1 write_x -> read_x_1
+    REQUIRE(has_edge(g, 0, 3));       // d1 write_x -> read_x_2
+    REQUIRE_FALSE(has_edge(g, 2, 3)); // two readers stay independent
+    REQUIRE_FALSE(has_edge(g, 0, 4)); // domains never depend on each other directly
+    REQUIRE(has_edge(g, 2, 6));       // coupling reads d1.y after read_x_1 wrote it
+    REQUIRE(has_edge(g, 5, 6));       // coupling writes d2.x after d2's readers
+    REQUIRE(has_edge(g, 6, 8));       // d2 rewrite_x after the coupling's write
+    REQUIRE(has_edge(g, 3, 7));       // d1 rewrite_x after its readers
+    REQUIRE(g.nodes[7].predecessor_count == 2);
+
+    d2.inert = true;
+    view.topology_version = 8;
+    REQUIRE(rphys::frame_graph_update(g, view));
+    REQUIRE(g.nodes.size() == 5);
+}
+
+TEST_CASE("schedulers_listed_and_selectable", "[scheduler]") {
+    auto w = rphys::create_world(rphys::world_desc{});
+    rphys::capability_record recs[8]{};
+    std::size_t n = rphys::list_schedulers(w, recs, 8);
+    REQUIRE(n >= 2);
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < n; ++i) names.emplace_back(recs[i].name);
+    REQUIRE(std::find(names.begin(), names.end(), "serial") != names.end());
+    REQUIRE(std::find(names.begin(), names.end(), "work_stealing") != names.end());
+    REQUIRE(rphys::list_schedulers(w, nullptr, 0) == n);
+    rphys::destroy_world(w);
+}
+
+TEST_CASE("multi_domain_world_matches_serial_schedule", "[scheduler]") {
+    mixed_world serial = make_mixed_world(rphys::scheduler_kind::serial);
+    mixed_world graph  = make_mixed_world(rphys::scheduler_kind::work_stealing);
+    for (int i = 0; i < 60; ++i) {
+        rphys::step_world(serial.world, 1.0 / 600.0);
+        rphys::step_world(graph.world, 1.0 / 600.0);
+    }
+    // With ordered merges the graph schedule reproduces the serial one bit for bit.
+    REQUIRE(field_copy(serial.world, serial.cloth, "cloth.position") == field_copy(graph.world, graph.cloth, "cloth.position"));
+    REQUIRE(field_copy(serial.world, serial.fluid, "fluid.position") == field_copy(graph.world, graph.fluid, "fluid.position"));
+    REQUIRE(field_copy(serial.world, serial.rigid, "rigid.position") == field_copy(graph.world, graph.rigid, "rigid.position"));
+
+    // Pinned cloth corners stay put while the rest sags; fluid stays inside its container.
+    auto cloth = field_copy(graph.world, graph.cloth, "cloth.position");
+    const std::size_t top_left = (11 * 12) * 3;
+    REQUIRE(cloth[top_left + 1] == Catch::Approx(2.0f));
+    REQUIRE(cloth[1] < 1.0f);
+    auto fluid = field_copy(graph.world, graph.fluid, "fluid.position");
+    for (std::size_t i = 0; i < fluid.size(); i += 3) {
+        REQUIRE(fluid[i] >= 2.0f);
+        REQUIRE(fluid[i] <= 3.0f);
+        REQUIRE(fluid[i + 1] >= 0.0f);
+    }
+
+    rphys::remove_domain(graph.world, graph.fluid);
+    rphys::field_view v{};
+    REQUIRE_FALSE(rphys::get_field(graph.world, graph.fluid, "fluid.position", v));
+    rphys::step_world(graph.world, 1.0 / 600.0); // graph rebuilt without the fluid phases
+    REQUIRE(rphys::get_field(graph.world, graph.cloth, "cloth.position", v));
+    rphys::destroy_world(serial.world);
+    rphys::destroy_world(graph.world);
+}
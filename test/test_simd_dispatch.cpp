@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+#include "perf_layers/simd_vec.hpp"
+#include "rphys/api_capability.h"
+#include "rphys/api_domain.h"
+#include "rphys/api_fields.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    const rphys::simd_level k_levels[] = {rphys::simd_level::scalar, rphys::simd_level::sse42, rphys::simd_level::avx2, rphys::simd_level::avx512};
+
+    std::vector<unsigned char> field_bytes(rphys::world_id w, rphys::domain_id d, const char* name) {
+        rphys::field_view v{};
+        if (!rphys::get_field(w, d, name, v)) return {};
+        std::vector<unsigned char> out(v.count * v.stride);
+        std::memcpy(out.data(), v.data, out.size());
+        return out;
+    }
+
+    std::vector<std::vector<unsigned char>> run_scene(rphys::simd_level simd) {
+        rphys::world_desc wd{};
+        wd.scheduler = rphys::scheduler_kind::serial;
+        wd.simd      = simd;
+        auto w = rphys::create_world(wd);
+        auto cloth = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+        rphys::scene_primitive grid{};
+        grid.type = rphys::scene_primitive_type::cloth_grid;
+        grid.resolution[0] = grid.resolution[1] = 11;
+        grid.flags = rphys::scene_pin_top_corners;
+        rphys::build_scene(w, cloth, {grid});
+        auto fluid = rphys::add_domain(w, rphys::domain_desc{0, "fluid"});
+        rphys::scene_primitive box{}, bounds{};
+        box.type = rphys::scene_primitive_type::particle_box;
+        box.extent[0] = box.extent[1] = box.extent[2] = 0.3f;
+        box.resolution[0] = box.resolution[1] = box.resolution[2] = 7;
+        bounds.type = rphys::scene_primitive_type::fluid_bounds;
+        rphys::build_scene(w, fluid, {box, bounds});
+        for (int i = 0; i < 20; ++i) rphys::step_world(w, 1.0 / 60.0);
+        std::vector<std::vector<unsigned char>> out{field_bytes(w, cloth, "cloth.position"), field_bytes(w, cloth, "cloth.velocity"),
+                                                    field_bytes(w, fluid, "fluid.position"), field_bytes(w, fluid, "fluid.velocity")};
+        rphys::destroy_world(w);
+        return out;
+    }
+} // namespace
+
+TEST_CASE("every supported kernel level matches scalar bit for bit", "[simd]") {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> u(-10.0f, 10.0f);
+    const std::size_t n = 1000 + 13; // exercises the scalar tails
+    std::vector<float> x(n), y(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = u(rng);
+        y[i] = u(rng);
+    }
+    const auto& ref = rphys::simd_kernels_for(rphys::simd_level::scalar);
+    std::vector<float> expect_axpy(n), expect_sub(n);
+    ref.axpy(expect_axpy.data(), x.data(), y.data(), 0.37f, n);
+    ref.sub_scale(expect_sub.data(), x.data(), y.data(), 59.5f, n);
+    for (rphys::simd_level level : k_levels) {
+        if (level > rphys::simd_detect()) continue;
+        const auto& k = rphys::simd_kernels_for(level);
+        REQUIRE(k.level == level);
+        std::vector<float> out(n);
+        k.axpy(out.data(), x.data(), y.data(), 0.37f, n);
+        REQUIRE(std::memcmp(out.data(), expect_axpy.data(), n * sizeof(float)) == 0);
+        k.sub_scale(out.data(), x.data(), y.data(), 59.5f, n);
+        REQUIRE(std::memcmp(out.data(), expect_sub.data(), n * sizeof(float)) == 0);
+        std::vector<float> in_place = x; // aliasing output and input
+        k.axpy(in_place.data(), in_place.data(), y.data(), 0.37f, n);
+        REQUIRE(std::memcmp(in_place.data(), expect_axpy.data(), n * sizeof(float)) == 0);
+    }
+}
+
+TEST_CASE("constraint and neighbour kernels match scalar bit for bit", "[simd]") {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> u(0.0f, 0.3f);
+
+    // One colour: a random perfect matching of the vertices, with pinned ends and a zero-length edge.
+    const std::size_t vertices = 2 * 83;
+    std::vector<float> x(3 * vertices), w(vertices);
+    for (float& c : x) c = u(rng);
+    for (std::size_t i = 0; i < vertices; ++i) w[i] = i % 7 == 0 ? 0.0f : 1.0f + u(rng);
+    std::vector<std::uint32_t> order(vertices);
+    for (std::size_t i = 0; i < vertices; ++i) order[i] = static_cast<std::uint32_t>(i);
+    std::shuffle(order.begin(), order.end(), rng);
+    const std::size_t edges = vertices / 2;
+    std::vector<float> rest(edges), lambda(edges);
+    for (std::size_t e = 0; e < edges; ++e) {
+        rest[e]   = 0.5f * u(rng);
+        lambda[e] = u(rng) - 0.15f;
+    }
+    std::copy(x.begin() + 3 * order[8], x.begin() + 3 * order[8] + 3, x.begin() + 3 * order[9]); // edge 4
+
+    // Candidates: every particle, so the list holds i itself and particles outside h.
+    const std::size_t particles = 211;
+    std::vector<float> pos(3 * particles), vel(3 * particles), density(particles), pressure(particles);
+    for (float& c : pos) c = u(rng);
+    for (float& c : vel) c = u(rng) - 0.15f;
+    for (std::size_t i = 0; i < particles; ++i) {
+        density[i]  = i % 11 == 0 ? 0.0f : 900.0f + 1000.0f * u(rng);
+        pressure[i] = 100.0f * u(rng);
+    }
+    std::vector<std::uint32_t> candidates(particles);
+    for (std::size_t i = 0; i < particles; ++i) candidates[i] = static_cast<std::uint32_t>(i);
+    std::shuffle(candidates.begin(), candidates.end(), rng);
+    rphys::simd_sph_args sph{};
+    sph.position   = pos.data();
+    sph.velocity   = vel.data();
+    sph.density    = density.data();
+    sph.pressure   = pressure.data();
+    sph.mass       = 0.02f;
+    sph.h          = 0.1f;
+    sph.h2         = 0.01f;
+    sph.poly6      = 1.5e9f;
+    sph.spiky_grad = -1.4e7f;
+    sph.visc_lap   = 1.4e7f;
+
+    auto run = [&](const rphys::simd_kernels& k) {
+        std::vector<float> xs = x, lambdas = lambda, out;
+        k.xpbd_distance(xs.data(), w.data(), order.data(), rest.data(), lambdas.data(), 3, edges, 1e-4f);
+        out.insert(out.end(), xs.begin(), xs.end());
+        out.insert(out.end(), lambdas.begin(), lambdas.end());
+        for (std::uint32_t i = 0; i < particles; i += 13) {
+            out.push_back(k.sph_density(sph, i, candidates.data(), particles, 0.0f));
+            float acc[6]{};
+            k.sph_forces(sph, i, candidates.data(), particles, acc);
+            out.insert(out.end(), acc, acc + 6);
+        }
+        return out;
+    };
+    const std::vector<float> expect = run(rphys::simd_kernels_for(rphys::simd_level::scalar));
+    for (rphys::simd_level level : k_levels) {
+        if (level > rphys::simd_detect()) continue;
+        const std::vector<float> got = run(rphys::simd_kernels_for(level));
+        REQUIRE(got.size() == expect.size());
+        REQUIRE(std::memcmp(got.data(), expect.data(), got.size() * sizeof(float)) == 0);
+    }
+}
+
+TEST_CASE("requested levels resolve to what the CPU supports", "[simd]") {
+    const rphys::simd_level best = rphys::simd_detect();
+    REQUIRE(best != rphys::simd_level::automatic);
+    REQUIRE(rphys::simd_resolve(rphys::simd_level::automatic) == best);
+    REQUIRE(rphys::simd_resolve(rphys::simd_level::scalar) == rphys::simd_level::scalar);
+    REQUIRE(rphys::simd_resolve(rphys::simd_level::avx512) <= best);
+}
+
+TEST_CASE("per-world override is reported and does not change results", "[simd]") {
+    const auto reference = run_scene(rphys::simd_level::scalar);
+    for (rphys::simd_level level : k_levels) REQUIRE(run_scene(level) == reference);
+    REQUIRE(run_scene(rphys::simd_level::automatic) == reference);
+
+    rphys::world_desc wd{};
+    wd.simd = rphys::simd_level::scalar;
+    auto w = rphys::create_world(wd);
+    rphys::capability_record records[8]{};
+    const std::size_t n = rphys::list_perf_layers(w, records, 8);
+    REQUIRE(n >= 2);
+    REQUIRE(std::string(records[0].name) == "simd:scalar");
+    REQUIRE(std::string(records[1].name) == std::string("cpu:") + rphys::simd_level_name(rphys::simd_detect()));
+    REQUIRE(rphys::list_perf_layers(w, nullptr, 0) == n);
+    rphys::destroy_world(w);
+    REQUIRE(rphys::list_perf_layers(w, records, 8) == 0);
+}
@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core_base/lz_codec.hpp"
+#include "rphys/api_domain.h"
+#include "rphys/api_events.h"
+#include "rphys/api_fields.h"
+#include "rphys/api_params.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr double k_dt = 1.0 / 60.0;
+
+    std::vector<unsigned char> field_bytes(rphys::world_id w, rphys::domain_id d, const char* name) {
+        rphys::field_view v{};
+        if (!rphys::get_field(w, d, name, v)) return {};
+        std::vector<unsigned char> out(v.count * v.stride);
+        std::memcpy(out.data(), v.data, out.size());
+        return out;
+    }
+
+    // Domain ids are 1, 2, 3 in creation order, both in the original and in a restored world.
+    struct state {
+        std::vector<unsigned char> cloth, fluid, rigid;
+        std::uint64_t              frame{0};
+        bool operator==(const state&) const = default;
+    };
+
+    state capture(rphys::world_id w) {
+        return state{field_bytes(w, rphys::domain_id{1}, "cloth.position"), field_bytes(w, rphys::domain_id{2}, "fluid.velocity"),
+                     field_bytes(w, rphys::domain_id{3}, "rigid.position"), rphys::world_frame_count(w)};
+    }
+
+    rphys::world_id make_world() {
+        rphys::world_desc wd{};
+        wd.scheduler   = rphys::scheduler_kind::serial;
+        wd.determinism = rphys::determinism_level::bit_stable;
+        auto w = rphys::create_world(wd);
+        rphys::set_param(w, "cloth.damping", 0.2);
+
+        auto cloth = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+        rphys::scene_primitive grid{};
+        grid.type = rphys::scene_primitive_type::cloth_grid;
+        grid.origin[1] = 1.0f;
+        grid.resolution[0] = grid.resolution[1] = 16;
+        grid.flags = rphys::scene_pin_top_corners;
+        rphys::build_scene(w, cloth, {grid});
+
+        auto fluid = rphys::add_domain(w, rphys::domain_desc{0, "fluid"});
+        rphys::scene_primitive box{};
+        box.type = rphys::scene_primitive_type::particle_box;
+        box.extent[0] = box.extent[1] = box.extent[2] = 0.4f;
+        box.resolution[0] = box.resolution[1] = box.resolution[2] = 6;
+        rphys::scene_primitive bounds{};
+        bounds.type = rphys::scene_primitive_type::fluid_bounds;
+        rphys::build_scene(w, fluid, {box, bounds});
+
+        auto rigid = rphys::add_domain(w, rphys::domain_desc{0, "rigid"});
+        rphys::scene_primitive balls{};
+        balls.type = rphys::scene_primitive_type::rigid_sphere;
+        balls.origin[1] = 0.3f;
+        balls.extent[0] = 0.1f;
+        balls.resolution[0] = balls.resolution[1] = 3;
+        rphys::build_scene(w, rigid, {balls});
+        return w;
+    }
+
+    void step(rphys::world_id w, int frames) {
+        for (int i = 0; i < frames; ++i) rphys::step_world(w, k_dt);
+    }
+} // namespace
+
+TEST_CASE("lz codec round trips", "[snapshot]") {
+    std::mt19937 rng(7);
+    std::vector<unsigned char> noise(5000), runs(70000);
+    for (auto& b : noise) b = static_cast<unsigned char>(rng());
+    for (std::size_t i = 0; i < runs.size(); ++i) runs[i] = static_cast<unsigned char>((i / 300) % 7);
+    for (const auto* input : {&noise, &runs}) {
+        std::vector<unsigned char> packed, back(input->size());
+        rphys::lz_compress(input->data(), input->size(), packed);
+        REQUIRE(rphys::lz_decompress(packed.data(), packed.size(), back.data(), back.size()));
+        REQUIRE(back == *input);
+        if (input == &runs) REQUIRE(packed.size() < input->size() / 20);
+        if (!packed.empty()) REQUIRE_FALSE(rphys::lz_decompress(packed.data(), packed.size() - 1, back.data(), back.size()));
+    }
+}
+
+TEST_CASE("save_world / load_world resumes bit-identically", "[snapshot]") {
+    auto w = make_world();
+    step(w, 5);
+    rphys::event_desc ev{};
+    ev.time = rphys::world_total_time(w) + 3.5 * k_dt;
+    ev.command.kind = rphys::command_kind::set_param;
+    ev.command.name = "gravity.y";
+    ev.command.value[0] = -2.0;
+    REQUIRE(rphys::schedule_event(w, ev));
+    step(w, 1); // the event now waits in the world's pending heap
+
+    std::vector<std::uint8_t> blob, raw;
+    REQUIRE(rphys::save_world(w, blob));
+    REQUIRE(rphys::save_world(w, raw, rphys::snapshot_options{false}));
+    REQUIRE(blob.size() < raw.size());
+
+    step(w, 10);
+    const state expected = capture(w);
+
+    // Same world, rewound.
+    REQUIRE(rphys::load_world(w, blob));
+    REQUIRE(rphys::world_frame_count(w) == 6);
+    step(w, 10);
+    REQUIRE(capture(w) == expected);
+
+    // Farm restart: a fresh world picks up from the blob (uncompressed variant).
+    rphys::world_desc wd{};
+    wd.scheduler   = rphys::scheduler_kind::work_stealing;
+    wd.determinism = rphys::determinism_level::bit_stable;
+    auto restarted = rphys::create_world(wd);
+    REQUIRE(rphys::load_world(restarted, raw));
+    REQUIRE(rphys::get_param(restarted, "cloth.damping", 0.0) == 0.2);
+    step(restarted, 10);
+    REQUIRE(capture(restarted) == expected);
+    REQUIRE(rphys::get_param(restarted, "gravity.y", 0.0) == -2.0);
+
+    rphys::destroy_world(w);
+    rphys::destroy_world(restarted);
+}
+
+TEST_CASE("malformed blobs leave the world untouched", "[snapshot]") {
+    auto w = make_world();
+    step(w, 2);
+    std::vector<std::uint8_t> blob;
+    REQUIRE(rphys::save_world(w, blob));
+    step(w, 3);
+    const state before = capture(w);
+
+    auto truncated = blob;
+    truncated.resize(blob.size() - 9);
+    REQUIRE_FALSE(rphys::load_world(w, truncated));
+    auto bad_magic = blob;
+    bad_magic[0] ^= 0xff;
+    REQUIRE_FALSE(rphys::load_world(w, bad_magic));
+    auto bad_body = blob;
+    bad_body[64 + 16] ^= 0x5a; // hot stream parameter count: later reads run off the end
+    REQUIRE_FALSE(rphys::load_world(w, bad_body));
+    REQUIRE_FALSE(rphys::load_world(w, std::span<const std::uint8_t>{}));
+    REQUIRE_FALSE(rphys::load_world(rphys::world_id{0}, blob));
+    REQUIRE(capture(w) == before);
+
+    REQUIRE(rphys::load_world(w, blob));
+    REQUIRE(rphys::world_frame_count(w) == 2);
+    rphys::destroy_world(w);
+}
+
+TEST_CASE("rollback undoes steps from the in-memory history", "[snapshot]") {
+    auto w = make_world();
+    REQUIRE(rphys::set_rollback_depth(w, 4));
+    std::vector<state> history{capture(w)};
+    for (int i = 0; i < 6; ++i) {
+        step(w, 1);
+        history.push_back(capture(w));
+    }
+    REQUIRE_FALSE(rphys::rollback_world(w, 5)); // only 4 steps are kept
+    REQUIRE(rphys::rollback_world(w, 1));
+    REQUIRE(capture(w) == history[5]);
+    REQUIRE(rphys::rollback_world(w, 3));
+    REQUIRE(capture(w) == history[2]);
+    REQUIRE_FALSE(rphys::rollback_world(w, 1)); // everything older was never kept
+
+    // Stepping on from a rolled-back state replays the same trajectory.
+    step(w, 4);
+    REQUIRE(capture(w) == history[6]);
+    REQUIRE(rphys::rollback_world(w, 2));
+    REQUIRE(capture(w) == history[4]);
+
+    REQUIRE(rphys::set_rollback_depth(w, 0));
+    REQUIRE_FALSE(rphys::rollback_world(w, 1));
+    rphys::destroy_world(w);
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include "test_support.hpp"
+#include "rphys/api_coupling.h"
+#include "rphys/api_domain.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_world.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Every global operator new/delete form, nothrow included (std::stable_sort's buffer uses it), is
+// replaced by a counting version. Only allocations made while `armed` is set are counted, from
+// every thread, so pool workers stepping the world are included.
+namespace {
+    std::atomic<bool>        armed{false};
+    std::atomic<std::size_t> allocations{0};
+
+    void* counted_alloc_nothrow(std::size_t size, std::size_t align) noexcept {
+        if (armed.load(std::memory_order_relaxed)) allocations.fetch_add(1, std::memory_order_relaxed);
+        if (size == 0) size = 1;
+        return align <= alignof(std::max_align_t) ? std::malloc(size) : std::aligned_alloc(align, (size + align - 1) / align * align);
+    }
+
+    void* counted_alloc(std::size_t size, std::size_t align) {
+        void* p = counted_alloc_nothrow(size, align);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+} // namespace
+
+void* operator new(std::size_t size) { return counted_alloc(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size) { return counted_alloc(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t align) { return counted_alloc(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return counted_alloc(size, static_cast<std::size_t>(align)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc_nothrow(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc_nothrow(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return counted_alloc_nothrow(size, static_cast<std::size_t>(align)); }
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return counted_alloc_nothrow(size, static_cast<std::size_t>(align)); }
+void  operator delete(void* p) noexcept { std::free(p); }
+void  operator delete[](void* p) noexcept { std::free(p); }
+void  operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void  operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void  operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void  operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void  operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void  operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void  operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void  operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void  operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void  operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+namespace {
+    // Cloth falling onto a sphere next to a stack of boxes, with a block of fluid in front of it:
+    // every domain type plus both cloth couplings.
+    rphys::world_id coupled_world(rphys::scheduler_kind scheduler, rphys::determinism_level level) {
+        rphys::world_desc wd{};
+        wd.scheduler   = scheduler;
+        wd.determinism = level;
+        const rphys::world_id  w     = rphys::create_world(wd);
+        const rphys::domain_id cloth = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+        const rphys::domain_id rigid = rphys::add_domain(w, rphys::domain_desc{0, "rigid"});
+        const rphys::domain_id fluid = rphys::add_domain(w, rphys::domain_desc{0, "fluid"});
+        rphys::build_scene(w, cloth, {rphys_test::cloth_sheet(16, rphys::scene_pin_top_row)});
+
+        rphys::scene_primitive sphere{};
+        sphere.type = rphys::scene_primitive_type::rigid_sphere;
+        sphere.origin[0] = 0.5f;
+        sphere.origin[1] = 1.2f;
+        sphere.origin[2] = -0.3f;
+        sphere.extent[0] = 0.2f;
+        rphys::scene_primitive boxes{};
+        boxes.type = rphys::scene_primitive_type::rigid_box;
+        boxes.origin[0] = 2.0f;
+        boxes.origin[1] = 0.5f;
+        boxes.extent[0] = boxes.extent[1] = boxes.extent[2] = 0.25f;
+        boxes.resolution[0] = boxes.resolution[1] = boxes.resolution[2] = 2;
+        rphys::build_scene(w, rigid, {sphere, boxes});
+
+        rphys::scene_primitive block{};
+        block.type = rphys::scene_primitive_type::particle_box;
+        block.origin[0] = 0.3f;
+        block.origin[1] = 1.2f;
+        block.origin[2] = 0.1f;
+        block.extent[0] = block.extent[1] = 0.4f;
+        block.extent[2] = 0.2f;
+        block.resolution[0] = block.resolution[1] = 8;
+        block.resolution[2] = 4;
+        rphys::build_scene(w, fluid, {block});
+
+        REQUIRE(rphys::register_coupling(w, rphys::coupling_desc{0, "cloth_rigid_projection", cloth, rigid}).value != 0);
+        REQUIRE(rphys::register_coupling(w, rphys::coupling_desc{0, "cloth_fluid_two_way_pressure", cloth, fluid}).value != 0);
+        return w;
+    }
+} // namespace
+
+TEST_CASE("steady_state_stepping_does_not_allocate", "[arena]") {
+    const rphys::scheduler_kind   schedulers[] = {rphys::scheduler_kind::serial, rphys::scheduler_kind::work_stealing};
+    const rphys::determinism_level levels[]    = {rphys::determinism_level::fast, rphys::determinism_level::bit_stable};
+    for (auto scheduler : schedulers) {
+        for (auto level : levels) {
+            const rphys::world_id w = coupled_world(scheduler, level);
+            for (int f = 0; f < 180; ++f) rphys::step_world(w, 1.0 / 60.0); // warm-up: arenas, pools, settled contacts
+
+            allocations.store(0);
+            armed.store(true);
+            for (int f = 0; f < 120; ++f) rphys::step_world(w, 1.0 / 60.0);
+            armed.store(false);
+            CHECK(allocations.load() == 0);
+            rphys::destroy_world(w);
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef RPHYS_TEST_SUPPORT_HPP
+#define RPHYS_TEST_SUPPORT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "core_base/vec_math.hpp"
+#include "rphys/api_fields.h"
+#include "rphys/api_scene.h"
+
+// Scene fixtures shared by the scene-level tests.
+namespace rphys_test {
+
+// A 1 x 1 sheet in the xy plane (z = 0) spanning y in [1, 2], `resolution` vertices per side.
+inline rphys::scene_primitive cloth_sheet(std::uint32_t resolution, std::uint32_t flags = 0) {
+    rphys::scene_primitive sheet{};
+    sheet.type = rphys::scene_primitive_type::cloth_grid;
+    sheet.origin[1] = 1.0f;
+    sheet.resolution[0] = sheet.resolution[1] = resolution;
+    sheet.flags = flags;
+    return sheet;
+}
+
+// Copies a three-component field out element by element, honouring its stride; empty when the
+// field is missing.
+inline std::vector<rphys::vec3f> read_vec3(rphys::world_id w, rphys::domain_id d, const char* name) {
+    rphys::field_view v{};
+    if (!rphys::get_field(w, d, name, v)) return {};
+    std::vector<rphys::vec3f> out(v.count);
+    for (std::size_t i = 0; i < v.count; ++i) std::memcpy(&out[i], static_cast<const char*>(v.data) + i * v.stride, sizeof(rphys::vec3f));
+    return out;
+}
+
+inline bool same_bits(const std::vector<rphys::vec3f>& a, const std::vector<rphys::vec3f>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(rphys::vec3f)) == 0;
+}
+
+} // namespace rphys_test
+
+#endif // RPHYS_TEST_SUPPORT_HPP
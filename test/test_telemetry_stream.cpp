@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core_base/telemetry_stream.hpp"
+#include "rphys/api_domain.h"
+#include "rphys/api_scene.h"
+#include "rphys/api_telemetry.h"
+#include "rphys/api_world.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    rphys::world_id make_world() {
+        rphys::world_desc wd{};
+        wd.scheduler = rphys::scheduler_kind::serial;
+        auto w = rphys::create_world(wd);
+        auto cloth = rphys::add_domain(w, rphys::domain_desc{0, "cloth"});
+        rphys::scene_primitive grid{};
+        grid.type = rphys::scene_primitive_type::cloth_grid;
+        grid.resolution[0] = grid.resolution[1] = 8;
+        rphys::build_scene(w, cloth, {grid});
+        return w;
+    }
+
+    std::vector<std::string> read_lines(const std::string& path) {
+        std::vector<std::string> lines;
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) return lines;
+        std::string text;
+        char buf[4096];
+        for (std::size_t n; (n = std::fread(buf, 1, sizeof(buf), f)) > 0;) text.append(buf, n);
+        std::fclose(f);
+        for (std::size_t at = 0, nl; (nl = text.find('\n', at)) != std::string::npos; at = nl + 1) lines.push_back(text.substr(at, nl - at));
+        return lines;
+    }
+} // namespace
+
+TEST_CASE("spsc ring hands items over in order across threads", "[telemetry_stream]") {
+    rphys::spsc_ring<std::uint64_t> ring(64);
+    constexpr std::uint64_t count = 200000;
+    std::thread producer([&] {
+        for (std::uint64_t i = 0; i < count; ++i) {
+            while (ring.free_slots() == 0) std::this_thread::yield();
+            ring.push(i);
+        }
+    });
+    std::uint64_t expect = 0, v = 0;
+    bool          in_order = true;
+    while (expect < count) {
+        if (ring.try_pop(v)) in_order = in_order && v == expect++;
+    }
+    producer.join();
+    REQUIRE(in_order);
+    REQUIRE_FALSE(ring.try_pop(v));
+}
+
+TEST_CASE("csv stream writes one row per frame and per phase", "[telemetry_stream]") {
+    auto w = make_world();
+    const std::string path = "test_telemetry_stream.csv";
+    REQUIRE(rphys::set_profiling(w, true));
+    rphys::telemetry_stream_desc desc{};
+    desc.path     = path.c_str();
+    desc.overflow = rphys::telemetry_overflow::block;
+    REQUIRE(rphys::open_telemetry_stream(w, desc));
+    for (int i = 0; i < 12; ++i) rphys::step_world(w, 1.0 / 60.0);
+    const std::uint32_t phases = rphys::get_last_frame_stats(w)->phase_count;
+    REQUIRE(phases > 0);
+    REQUIRE(rphys::close_telemetry_stream(w));
+    REQUIRE_FALSE(rphys::close_telemetry_stream(w)); // already closed
+
+    const auto lines = read_lines(path);
+    std::remove(path.c_str());
+    REQUIRE(lines.size() == 1 + 12 * (1 + phases));
+    REQUIRE(lines[0].rfind("record,world,frame,", 0) == 0);
+    const auto columns = std::count(lines[0].begin(), lines[0].end(), ',');
+    std::uint64_t frames = 0;
+    for (std::size_t i = 1; i < lines.size(); ++i) {
+        REQUIRE(std::count(lines[i].begin(), lines[i].end(), ',') == columns);
+        if (lines[i].rfind("frame,", 0) == 0) {
+            ++frames;
+            REQUIRE(lines[i].find("," + std::to_string(frames) + ",") != std::string::npos); // frame index in order
+        } else {
+            REQUIRE(lines[i].rfind("phase,", 0) == 0);
+        }
+    }
+    REQUIRE(frames == 12);
+    rphys::destroy_world(w);
+}
+
+TEST_CASE("json lines stream rotates into numbered files", "[telemetry_stream]") {
+    auto w = make_world();
+    const std::string path = "test_telemetry_stream.jsonl";
+    rphys::telemetry_stream_desc desc{};
+    desc.path         = path.c_str();
+    desc.format       = rphys::telemetry_format::json_lines;
+    desc.rotate_bytes = 1024;
+    desc.overflow     = rphys::telemetry_overflow::block;
+    REQUIRE(rphys::open_telemetry_stream(w, desc));
+    for (int i = 0; i < 30; ++i) rphys::step_world(w, 1.0 / 60.0);
+    rphys::destroy_world(w); // closes and drains the stream
+
+    std::size_t frames = 0, files = 0;
+    for (int i = 0;; ++i) {
+        const std::string name = i == 0 ? path : path + "." + std::to_string(i);
+        const auto lines = read_lines(name);
+        if (lines.empty()) break;
+        std::remove(name.c_str());
+        ++files;
+        for (const auto& l : lines) {
+            REQUIRE((l.front() == '{' && l.back() == '}'));
+            REQUIRE(l.find("\"record\":\"frame\"") != std::string::npos);
+            ++frames;
+        }
+    }
+    REQUIRE(frames == 30);
+    REQUIRE(files > 1);
+}
+
+TEST_CASE("a full stream drops whole frames without blocking the step", "[telemetry_stream]") {
+    auto w = make_world();
+    const std::string path = "test_telemetry_stream_drop.csv";
+    REQUIRE(rphys::set_profiling(w, true));
+    rphys::telemetry_stream_desc desc{};
+    desc.path     = path.c_str();
+    desc.capacity = 2; // smaller than one profiled frame: every frame is dropped
+    REQUIRE(rphys::open_telemetry_stream(w, desc));
+    for (int i = 0; i < 5; ++i) rphys::step_world(w, 1.0 / 60.0);
+    REQUIRE(rphys::get_last_frame_stats(w)->stream_frames_dropped == 5);
+    REQUIRE(rphys::close_telemetry_stream(w));
+    REQUIRE(read_lines(path).size() == 1); // header only
+    std::remove(path.c_str());
+
+    desc.path = "missing_dir/stream.csv";
+    REQUIRE_FALSE(rphys::open_telemetry_stream(w, desc));
+    rphys::destroy_world(w);
+}
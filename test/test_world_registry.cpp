@@ -0,0 +1,68 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "rphys/api_world.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("world_stale_id_does_not_alias", "[world][registry]") {
+    rphys::world_desc desc{};
+    auto w1 = rphys::create_world(desc);
+    REQUIRE(w1.value != 0);
+    rphys::destroy_world(w1);
+
+    auto w2 = rphys::create_world(desc);
+    REQUIRE(w2.value != 0);
+    REQUIRE(w2.value != w1.value);
+
+    // Operations through the stale id must not touch the new world
+    rphys::step_world(w1, 0.5);
+    rphys::destroy_world(w1);
+    REQUIRE(rphys::world_frame_count(w1) == 0ULL);
+    REQUIRE(rphys::world_frame_count(w2) == 0ULL);
+    rphys::step_world(w2, 0.25);
+    REQUIRE(rphys::world_frame_count(w2) == 1ULL);
+    REQUIRE(rphys::world_total_time(w2) == Catch::Approx(0.25));
+    rphys::destroy_world(w2);
+}
+
+TEST_CASE("world_step_many_in_parallel", "[world][registry]") {
+    rphys::world_desc desc{};
+    std::vector<rphys::world_id> ids;
+    for (int i = 0; i < 64; ++i) ids.push_back(rphys::create_world(desc));
+    ids.push_back(rphys::world_id{999999}); // invalid ids are skipped
+
+    for (int f = 0; f < 8; ++f) rphys::step_worlds(ids, 0.01);
+
+    for (std::size_t i = 0; i + 1 < ids.size(); ++i) {
+        REQUIRE(rphys::world_frame_count(ids[i]) == 8ULL);
+        REQUIRE(rphys::world_total_time(ids[i]) == Catch::Approx(0.08));
+        rphys::destroy_world(ids[i]);
+    }
+}
+
+TEST_CASE("world_create_destroy_races_with_step", "[world][registry]") {
+    rphys::world_desc desc{};
+    std::vector<rphys::world_id> shared(16);
+    for (auto& id : shared) id = rphys::create_world(desc);
+
+    std::atomic<bool> stop{false};
+    std::thread stepper([&] {
+        while (!stop.load()) rphys::step_worlds(shared, 0.001);
+    });
+    std::thread churn([&] {
+        for (int i = 0; i < 500; ++i) {
+            auto w = rphys::create_world(desc);
+            rphys::step_world(w, 0.001);
+            rphys::destroy_world(w);
+        }
+    });
+    churn.join();
+    stop.store(true);
+    stepper.join();
+
+    for (auto& id : shared) {
+        REQUIRE(rphys::world_frame_count(id) > 0ULL);
+        rphys::destroy_world(id);
+    }
+}